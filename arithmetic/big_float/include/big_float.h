@@ -0,0 +1,200 @@
+#ifndef MP_OS_BIG_FLOAT_H
+#define MP_OS_BIG_FLOAT_H
+
+#include <big_int.h>
+#include <compare>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <utility>
+
+/** Binary floating-point number mantissa * 2^exponent with an arbitrary precision in bits.
+ *  The mantissa is odd (or zero), so every value has a single representation.
+ *  Arithmetic, sqrt, root and conversions are correctly rounded to nearest, ties to even.
+ *  The transcendental functions are faithful: the error is below one unit in the last place
+ */
+class big_float final
+{
+
+public:
+
+    using exponent_type = int64_t;
+
+    static constexpr size_t default_precision = 64;
+
+private:
+
+    big_int _mantissa;
+    exponent_type _exponent;
+    size_t _precision;
+
+    /** Fixed-point kernels of the transcendental functions: x is kept as round(x * 2^bits) in a big_int.
+     *  Series are summed by binary splitting, long arguments are cut into pieces (bit-burst)
+     */
+    struct series;
+
+    static size_t bit_length(big_int const &value) noexcept;
+
+    static size_t trailing_zeros(big_int const &value) noexcept;
+
+    /** log2 |value| from the two leading digits, -infinity for zero
+     */
+    static double log2_abs(big_int const &value) noexcept;
+
+    /** Quotient and remainder of non-negative values
+     */
+    static std::pair<big_int, big_int> divide(big_int const &numerator, big_int const &denominator);
+
+    /** Rounds mantissa * 2^exponent to precision bits. sticky tells that the exact value
+     *  is a little larger in magnitude than mantissa * 2^exponent
+     */
+    static void round(big_int &mantissa, exponent_type &exponent, size_t precision, bool sticky = false);
+
+    /** *this * 2^bits truncated to an integer
+     */
+    big_int to_fixed(size_t bits) const;
+
+    /** Position of the leading bit: 2^(top - 1) <= |*this| < 2^top
+     */
+    exponent_type top() const noexcept;
+
+    /** *this reduced modulo 2 * pi into [-pi, pi] as a fixed-point value with bits fractional bits
+     */
+    big_int reduced_angle(size_t bits) const;
+
+    /** Raises the working precision of fixed(bits), starting from bits, until the result
+     *  has enough significant bits to be rounded to precision
+     */
+    template<typename Fixed>
+    static big_float evaluate(size_t precision, size_t bits, Fixed const &fixed);
+
+public:
+
+    explicit big_float(size_t precision = default_precision);
+
+    explicit big_float(big_int const &value, size_t precision = default_precision);
+
+    /** numerator / denominator correctly rounded
+     *  @throw std::invalid_argument if denominator is zero
+     */
+    big_float(big_int const &numerator, big_int const &denominator, size_t precision);
+
+    /** Exact when precision >= 53
+     *  @throw std::invalid_argument if value is not finite
+     */
+    explicit big_float(double value, size_t precision = default_precision);
+
+    /** mantissa * 2^exponent rounded to precision bits
+     */
+    static big_float from_parts(big_int mantissa, exponent_type exponent, size_t precision);
+
+public:
+
+    size_t precision() const noexcept;
+
+    /** Rounds the value if the new precision is smaller
+     *  @throw std::invalid_argument if precision is zero
+     */
+    big_float &set_precision(size_t precision) &;
+
+    big_float &&set_precision(size_t precision) &&;
+
+    big_int const &mantissa() const noexcept;
+
+    exponent_type exponent() const noexcept;
+
+    [[nodiscard]] bool is_zero() const noexcept;
+
+    [[nodiscard]] bool is_negative() const noexcept;
+
+    big_float abs() const;
+
+    /** Correctly rounded, subnormal results included
+     */
+    double to_double() const;
+
+    /** Scientific notation with enough decimal digits to restore the value at its precision
+     */
+    std::string to_string() const;
+
+    friend std::ostream &operator<<(std::ostream &stream, big_float const &value);
+
+public:
+
+    /** Results take the larger precision of the operands
+     */
+    big_float &operator+=(big_float const &other) &;
+
+    big_float operator+(big_float const &other) const;
+
+    big_float &operator-=(big_float const &other) &;
+
+    big_float operator-(big_float const &other) const;
+
+    big_float &operator*=(big_float const &other) &;
+
+    big_float operator*(big_float const &other) const;
+
+    /** @throw std::invalid_argument if other is zero
+     */
+    big_float &operator/=(big_float const &other) &;
+
+    big_float operator/(big_float const &other) const;
+
+    big_float operator-() const;
+
+    /** *this - n * other, n = round(*this / other) ties to even, rounded to the larger precision.
+     *  The exact remainder is computed first, so it is not affected by cancellation
+     *  @throw std::invalid_argument if other is zero
+     */
+    big_float remainder(big_float const &other) const;
+
+    /** *this * 2^shift, exact
+     */
+    big_float ldexp(exponent_type shift) const;
+
+public:
+
+    bool operator==(big_float const &other) const noexcept;
+
+    std::strong_ordering operator<=>(big_float const &other) const noexcept;
+
+public:
+
+    /** @throw std::invalid_argument for a negative value
+     */
+    big_float sqrt() const;
+
+    /** @throw std::invalid_argument if degree is zero or an even root of a negative value is requested
+     */
+    big_float root(size_t degree) const;
+
+    /** @throw std::invalid_argument for 0^0
+     */
+    big_float pow(size_t degree) const;
+
+    /** @throw std::overflow_error if the result exponent does not fit exponent_type
+     */
+    big_float exp() const;
+
+    /** @throw std::invalid_argument for a non-positive value
+     */
+    big_float ln() const;
+
+    big_float sin() const;
+
+    big_float cos() const;
+
+    big_float atan() const;
+
+    /** @throw std::invalid_argument if |*this| > 1
+     */
+    big_float asin() const;
+
+    /** Chudnovsky series, the most precise value computed so far is cached and reused
+     */
+    static big_float pi(size_t precision = default_precision);
+
+};
+
+#endif //MP_OS_BIG_FLOAT_H
@@ -0,0 +1,1074 @@
+#include "../include/big_float.h"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <limits>
+#include <mutex>
+#include <numbers>
+#include <sstream>
+#include <stdexcept>
+
+namespace
+{
+    // Защитные биты рабочей точности трансцендентных функций и длина первого куска аргумента
+    constexpr size_t SERIES_GUARD_BITS = 32;
+    constexpr size_t BIT_BURST_FIRST_BITS = 8;
+
+    // Начальная рабочая точность: для малых |x| результат (sin, atan, asin) порядка x,
+    // и значащие биты появляются только после -log2|x| дробных
+    size_t working_bits(size_t precision, big_float::exponent_type top) noexcept
+    {
+        return precision + SERIES_GUARD_BITS + (top < 0 ? static_cast<size_t>(-top) : 0);
+    }
+}
+
+struct big_float::series
+{
+    // Член гипергеометрического ряда: c_k = a(k) / b(k) * p(0)...p(k) / (q(0)...q(k) * 2^(shift * (k + 1)))
+    struct term
+    {
+        big_int p;
+        big_int q;
+        big_int b;
+        big_int a = 1_bi;
+    };
+
+    // Отрезок [first, last): p, q, b - произведения по отрезку, сумма его членов, делённая на
+    // p(0)...p(first - 1) / (q(0)...q(first - 1) * 2^(shift * first)), равна t / (b * q * 2^(shift * (last - first)))
+    struct split
+    {
+        big_int p;
+        big_int q;
+        big_int b;
+        big_int t;
+    };
+
+    template<typename Term>
+    static split binary_split(size_t first, size_t last, Term const &term, size_t shift, bool need_p)
+    {
+        if (last - first == 1) {
+            auto [p, q, b, a] = term(first);
+            big_int t = a == 1_bi ? p : p * a;
+            return {std::move(p), std::move(q), std::move(b), std::move(t)};
+        }
+
+        const size_t middle = first + (last - first) / 2;
+        split left = binary_split(first, middle, term, shift, true);
+        split right = binary_split(middle, last, term, shift, need_p);
+
+        // t = t_л * b_п * q_п * 2^(shift * |п|) + b_л * p_л * t_п
+        split result;
+        result.t = left.t * right.q;
+        if (right.b != 1_bi) {
+            result.t *= right.b;
+        }
+        result.t <<= shift * (last - middle);
+        big_int tail = left.p * right.t;
+        if (left.b != 1_bi) {
+            tail *= left.b;
+        }
+        result.t += tail;
+
+        result.q = left.q * right.q;
+        result.b = left.b == 1_bi ? std::move(right.b) : left.b * right.b;
+        if (need_p) {
+            result.p = left.p * right.p;
+        }
+        return result;
+    }
+
+    // Сумма первых terms членов, умноженная на 2^bits
+    template<typename Term>
+    static big_int sum(size_t terms, Term const &term, size_t shift, size_t bits)
+    {
+        split total = binary_split(0, terms, term, shift, false);
+        const size_t power = shift * terms;
+        big_int denominator = total.b == 1_bi ? std::move(total.q) : total.q * total.b;
+        if (power <= bits) {
+            return (total.t << (bits - power)) / denominator;
+        }
+        return (total.t >> (power - bits)) / denominator;
+    }
+
+    // Число членов, после которых хвост меньше 2^(-bits). ratio(k) - оценка log2 |a_k / a_(k-1)|,
+    // дальше отношения не превосходят max(ratio(k + 1), limit), так что хвост не больше |a_k| / (1 - r)
+    template<typename Ratio>
+    static size_t length(double term_log2, Ratio const &ratio, double limit, size_t bits)
+    {
+        const double target = -static_cast<double>(bits) - 2;
+        for (size_t k = 1; ; ++k) {
+            term_log2 += ratio(k);
+            const double r = std::max(ratio(k + 1), limit);
+            if (r < 0 && term_log2 - std::log2(1 - std::exp2(r)) < target) {
+                return k;
+            }
+        }
+    }
+
+    // Бит-бёрст: x = x_0 + x_1 + ..., x_j = u_j / 2^(s_j), s_j = 8 * 2^j, |x_j| < 2^(-s_(j-1)).
+    // Числитель каждого куска короче его точности, поэтому ряд по куску дешёв
+    template<typename Piece>
+    static void for_each_piece(big_int const &x, size_t bits, Piece const &piece)
+    {
+        big_int previous;
+        size_t previous_shift = 0;
+        for (size_t shift = std::min(BIT_BURST_FIRST_BITS, bits); ; shift = std::min(2 * shift, bits)) {
+            big_int truncated = x >> (bits - shift);
+            big_int u = truncated - (previous << (shift - previous_shift));
+            if (!u.is_zero()) {
+                piece(u, shift);
+            }
+            if (shift == bits) {
+                return;
+            }
+            previous = std::move(truncated);
+            previous_shift = shift;
+        }
+    }
+
+    static double log2_of(big_int const &u, size_t shift)
+    {
+        return log2_abs(u) - static_cast<double>(shift);
+    }
+
+    // exp(u / 2^shift) = sum (u / 2^shift)^k / k!
+    static big_int exp_piece(big_int const &u, size_t shift, size_t bits)
+    {
+        const double x = log2_of(u, shift);
+        const size_t terms = length(0, [x](size_t k) { return x - std::log2(k); },
+                                    -std::numeric_limits<double>::infinity(), bits);
+        return sum(terms, [&u, shift](size_t k) -> term {
+            if (k == 0) {
+                return {1_bi << shift, 1_bi, 1_bi};
+            }
+            return {u, big_int(k), 1_bi};
+        }, shift, bits);
+    }
+
+    // sin(u / 2^shift) = sum (-1)^k x^(2k + 1) / (2k + 1)!
+    static big_int sin_piece(big_int const &u, size_t shift, size_t bits)
+    {
+        const double x = log2_of(u, shift);
+        const size_t terms = length(x, [x](size_t k) { return 2 * x - std::log2(2.0 * k * (2 * k + 1)); },
+                                    -std::numeric_limits<double>::infinity(), bits);
+        const big_int minus_square = -(u * u);
+        return sum(terms, [&u, &minus_square, shift](size_t k) -> term {
+            if (k == 0) {
+                return {u << shift, 1_bi, 1_bi};
+            }
+            return {minus_square, big_int(2 * k * (2 * k + 1)), 1_bi};
+        }, 2 * shift, bits);
+    }
+
+    // cos(u / 2^shift) = sum (-1)^k x^(2k) / (2k)!
+    static big_int cos_piece(big_int const &u, size_t shift, size_t bits)
+    {
+        const double x = log2_of(u, shift);
+        const size_t terms = length(0, [x](size_t k) { return 2 * x - std::log2((2.0 * k - 1) * 2 * k); },
+                                    -std::numeric_limits<double>::infinity(), bits);
+        const big_int minus_square = -(u * u);
+        return sum(terms, [&minus_square, shift](size_t k) -> term {
+            if (k == 0) {
+                return {1_bi << (2 * shift), 1_bi, 1_bi};
+            }
+            return {minus_square, big_int((2 * k - 1) * 2 * k), 1_bi};
+        }, 2 * shift, bits);
+    }
+
+    // atanh(u / v) = sum y^(2k + 1) / (2k + 1), 0 <= u < v
+    static big_int atanh(big_int const &u, big_int const &v, size_t bits)
+    {
+        const double y = log2_abs(u) - log2_abs(v);
+        const size_t terms = length(y, [y](size_t) { return 2 * y; }, 2 * y, bits);
+        const big_int u_square = u * u;
+        const big_int v_square = v * v;
+        return sum(terms, [&](size_t k) -> term {
+            if (k == 0) {
+                return {u, v, 1_bi};
+            }
+            return {u_square, v_square, big_int(2 * k + 1)};
+        }, 0, bits);
+    }
+
+    // Ряд Эйлера atan(x) = sum 2^(2k) (k!)^2 / (2k + 1)! * x^(2k + 1) / (1 + x^2)^(k + 1):
+    // отношение членов меньше x^2 / (1 + x^2) <= 1/2 при |x| <= 1
+    static big_int atan_euler_piece(big_int const &u, size_t shift, size_t bits)
+    {
+        const big_int u_square = u * u;
+        const big_int w = u_square + (1_bi << (2 * shift));
+        const double z = 2 * log2_abs(u) - log2_abs(w);
+        const size_t terms = length(log2_abs(u) + static_cast<double>(shift) - log2_abs(w),
+                                    [z](size_t k) { return z + std::log2(2.0 * k / (2 * k + 1)); }, z, bits);
+        return sum(terms, [&](size_t k) -> term {
+            if (k == 0) {
+                return {u << shift, w, 1_bi};
+            }
+            return {u_square * big_int(2 * k), w * big_int(2 * k + 1), 1_bi};
+        }, 0, bits);
+    }
+
+    // atan(u / 2^shift) = sum (-1)^k x^(2k + 1) / (2k + 1) для малых x
+    static big_int atan_piece(big_int const &u, size_t shift, size_t bits)
+    {
+        const double x = log2_of(u, shift);
+        const size_t terms = length(x, [x](size_t) { return 2 * x; }, 2 * x, bits);
+        const big_int minus_square = -(u * u);
+        return sum(terms, [&u, &minus_square, shift](size_t k) -> term {
+            if (k == 0) {
+                return {u << shift, 1_bi, 1_bi};
+            }
+            return {minus_square, 1_bi, big_int(2 * k + 1)};
+        }, 2 * shift, bits);
+    }
+
+    // exp(x), x >= 0: произведение экспонент кусков
+    static big_int exp(big_int const &x, size_t bits)
+    {
+        big_int result = 1_bi << bits;
+        for_each_piece(x, bits, [&](big_int const &u, size_t shift) {
+            result = (result * exp_piece(u, shift, bits)) >> bits;
+        });
+        return result;
+    }
+
+    // sin(x) и cos(x), x >= 0: формулы сложения по кускам
+    static void sin_cos(big_int const &x, size_t bits, big_int &sin, big_int &cos)
+    {
+        sin = big_int();
+        cos = 1_bi << bits;
+        for_each_piece(x, bits, [&](big_int const &u, size_t shift) {
+            const big_int s = sin_piece(u, shift, bits);
+            const big_int c = cos_piece(u, shift, bits);
+            big_int next_sin = (sin * c + cos * s) >> bits;
+            cos = (cos * c - sin * s) >> bits;
+            sin = std::move(next_sin);
+        });
+    }
+
+    // ln(a), 1 <= a < 2: a = r_0 * r_1 * ..., r_j = m_j / 2^(s_j) - начало остатка a / (r_0...r_(j-1)),
+    // ln(r_j) = 2 atanh((m_j - 2^(s_j)) / (m_j + 2^(s_j)))
+    static big_int ln(big_int const &a, size_t bits)
+    {
+        big_int result;
+        big_int rest = a;
+        for (size_t shift = std::min(BIT_BURST_FIRST_BITS, bits); ; shift = std::min(2 * shift, bits)) {
+            const big_int m = rest >> (bits - shift);
+            const big_int unit = 1_bi << shift;
+            if (m != unit) {
+                result += atanh(m - unit, m + unit, bits) << 1;
+                rest = (rest << shift) / m;
+            }
+            if (shift == bits) {
+                return result;
+            }
+        }
+    }
+
+    // atan(x), 0 <= x <= 1: atan(x) = atan(x_j) + atan((x - x_j) / (1 + x * x_j)), x_j - начало x
+    static big_int atan(big_int const &x, size_t bits)
+    {
+        big_int result;
+        big_int rest = x;
+        bool first = true;
+        for (size_t shift = std::min(BIT_BURST_FIRST_BITS, bits); ; shift = std::min(2 * shift, bits)) {
+            const big_int t = rest >> (bits - shift);
+            if (!t.is_zero()) {
+                // первый кусок может быть близок к 1, на нём знакочередующийся ряд сходится медленно
+                result += first ? atan_euler_piece(t, shift, bits) : atan_piece(t, shift, bits);
+                big_int numerator = (rest << shift) - (t << bits);
+                big_int denominator = (1_bi << (bits + shift)) + rest * t;
+                rest = (numerator << bits) / denominator;
+            }
+            if (shift == bits || rest.is_zero()) {
+                return result;
+            }
+            first = false;
+        }
+    }
+
+    // atan(numerator / denominator), numerator, denominator >= 0: при numerator > denominator
+    // atan(x) = pi/2 - atan(1 / x)
+    static big_int atan_ratio(big_int const &numerator, big_int const &denominator, size_t bits)
+    {
+        if (numerator <= denominator) {
+            return atan((numerator << bits) / denominator, bits);
+        }
+        return (pi(bits) >> 1) - atan((denominator << bits) / numerator, bits);
+    }
+
+    // Формула Чудновских: pi = 426880 * sqrt(10005) / S,
+    // S = sum (-1)^k (6k)! (13591409 + 545140134 k) / ((3k)! (k!)^3 640320^(3k))
+    static big_int chudnovsky(size_t bits)
+    {
+        constexpr double ratio_limit = -47.11; // log2(1 / 151931373056000), ~14.18 десятичных цифр на член
+        const size_t terms = length(std::log2(13591409.0), [](size_t k) {
+            const double x = static_cast<double>(k);
+            return std::log2((6 * x - 5) * (2 * x - 1) * (6 * x - 1) / (x * x * x * 10939058860032000.0))
+                   + std::log2((13591409 + 545140134 * x) / (13591409 + 545140134 * (x - 1)));
+        }, ratio_limit, bits);
+
+        const big_int sum_fixed = sum(terms, [](size_t k) -> term {
+            if (k == 0) {
+                return {1_bi, 1_bi, 1_bi, 13591409_bi};
+            }
+            const auto n = static_cast<unsigned long long>(k);
+            return {-(big_int((6 * n - 5) * (2 * n - 1)) * big_int(6 * n - 1)),
+                    big_int(n * n) * big_int(n) * 10939058860032000_bi,
+                    1_bi,
+                    big_int(13591409 + 545140134 * n)};
+        }, 0, bits);
+
+        const big_int root = sqrt(10005_bi << (2 * bits));
+        return ((root * 426880_bi) << bits) / sum_fixed;
+    }
+
+    // Константа * 2^bits. Самое точное из посчитанных значений кэшируется, запросы не точнее
+    // обслуживаются сдвигом; при нехватке точность растёт не меньше чем в полтора раза
+    struct constant_cache
+    {
+        std::mutex mutex;
+        big_int value;
+        size_t bits = 0;
+
+        big_int get(size_t wanted_bits, big_int (*compute)(size_t))
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (bits < wanted_bits) {
+                const size_t wanted = std::max(wanted_bits, bits + bits / 2);
+                value = compute(wanted + SERIES_GUARD_BITS) >> SERIES_GUARD_BITS;
+                bits = wanted;
+            }
+            return value >> (bits - wanted_bits);
+        }
+    };
+
+    static big_int pi(size_t bits)
+    {
+        static constant_cache cache;
+        return cache.get(bits, chudnovsky);
+    }
+
+    // ln 2 = 2 atanh(1/3)
+    static big_int ln2(size_t bits)
+    {
+        static constant_cache cache;
+        return cache.get(bits, [](size_t wanted) { return atanh(1_bi, 3_bi, wanted) << 1; });
+    }
+
+    // floor(sqrt(value)) методом Ньютона. Корень старшей половины числа даёт половину бит ответа,
+    // один шаг Ньютона от него удваивает их, так что полноразмерное деление одно
+    static big_int sqrt(big_int const &value)
+    {
+        if (value.is_zero()) {
+            return value;
+        }
+        const auto length = static_cast<size_t>(log2_abs(value)) + 1;
+        if (length <= 64) {
+            big_int current = 1_bi << (length / 2 + 1);
+            while (true) {
+                big_int next = (current + value / current) >> 1;
+                if (next >= current) {
+                    return current;
+                }
+                current = std::move(next);
+            }
+        }
+
+        // (sqrt(value / 4^shift) + 1) * 2^shift больше корня, шаг Ньютона сверху не опускается ниже floor
+        const size_t shift = length / 4;
+        big_int root = (sqrt(value >> (2 * shift)) + 1_bi) << shift;
+        root = (root + value / root) >> 1;
+        big_int remainder = value - root * root;
+        while (remainder.is_negative()) {
+            remainder += (root << 1) - 1_bi;
+            --root;
+        }
+        return root;
+    }
+
+    // floor(value^(1/degree)) методом Ньютона. Начальное приближение берётся из double,
+    // первый шаг Ньютона с любого положительного приближения не опускается ниже floor
+    static big_int root(big_int const &value, size_t degree)
+    {
+        if (degree == 2) {
+            return sqrt(value);
+        }
+        if (value.is_zero()) {
+            return value;
+        }
+        const double estimate = log2_abs(value) / static_cast<double>(degree);
+        big_int current;
+        if (estimate < 52) {
+            current = big_int(static_cast<uint64_t>(std::exp2(estimate)) + 1);
+        } else {
+            const auto whole = static_cast<size_t>(estimate) - 52;
+            current = big_int(static_cast<uint64_t>(std::exp2(estimate - static_cast<double>(whole))) + 1) << whole;
+        }
+
+        const big_int scale(degree);
+        const big_int previous_degree(degree - 1);
+        auto step = [&](big_int const &x) {
+            return (x * previous_degree + value / x.pow(degree - 1)) / scale;
+        };
+        current = step(current);
+        while (true) {
+            big_int next = step(current);
+            if (next >= current) {
+                return current;
+            }
+            current = std::move(next);
+        }
+    }
+
+};
+
+size_t big_float::bit_length(big_int const &value) noexcept {
+    const size_t size = value._digits.size();
+    if (size == 0) {
+        return 0;
+    }
+    return 32 * (size - 1) + std::bit_width(value._digits[size - 1]);
+}
+
+size_t big_float::trailing_zeros(big_int const &value) noexcept {
+    size_t i = 0;
+    while (i < value._digits.size() && value._digits[i] == 0) {
+        ++i;
+    }
+    if (i == value._digits.size()) {
+        return 0;
+    }
+    return 32 * i + std::countr_zero(value._digits[i]);
+}
+
+double big_float::log2_abs(big_int const &value) noexcept {
+    const size_t size = value._digits.size();
+    if (size == 0) {
+        return -std::numeric_limits<double>::infinity();
+    }
+    // Два старших разряда дают 32 значащих бита
+    double top = value._digits[size - 1];
+    if (size > 1) {
+        top += std::ldexp(static_cast<double>(value._digits[size - 2]), -32);
+    }
+    return std::log2(top) + 32.0 * static_cast<double>(size - 1);
+}
+
+std::pair<big_int, big_int> big_float::divide(big_int const &numerator, big_int const &denominator) {
+    return big_int::divide_with_remainder(numerator, denominator, numerator.decide_div(denominator._digits.size()));
+}
+
+void big_float::round(big_int &mantissa, exponent_type &exponent, size_t precision, bool sticky) {
+    if (mantissa.is_zero()) {
+        exponent = 0;
+        return;
+    }
+
+    // Округляем модуль, знак возвращаем в конце
+    const bool negative = mantissa.is_negative();
+    mantissa._sign = true;
+
+    const size_t length = bit_length(mantissa);
+    if (length > precision) {
+        const size_t drop = length - precision;
+        const size_t half = drop - 1;
+        const bool half_bit = (mantissa._digits[half / 32] >> (half % 32)) & 1u;
+        const bool below_half = sticky || trailing_zeros(mantissa) < half;
+
+        mantissa >>= drop;
+        exponent += static_cast<exponent_type>(drop);
+
+        // К ближайшему, при равенстве - к чётному
+        if (half_bit && (below_half || (mantissa._digits[0] & 1u))) {
+            mantissa += 1_bi;
+        }
+    }
+
+    // Нечётная мантисса: представление единственно
+    const size_t zeros = trailing_zeros(mantissa);
+    mantissa >>= zeros;
+    exponent += static_cast<exponent_type>(zeros);
+
+    mantissa._sign = !negative;
+}
+
+big_int big_float::to_fixed(size_t bits) const {
+    const exponent_type shift = _exponent + static_cast<exponent_type>(bits);
+    if (shift >= 0) {
+        return _mantissa << static_cast<size_t>(shift);
+    }
+    return _mantissa >> static_cast<size_t>(-shift);
+}
+
+big_float::exponent_type big_float::top() const noexcept {
+    return _exponent + static_cast<exponent_type>(bit_length(_mantissa));
+}
+
+big_int big_float::reduced_angle(size_t bits) const {
+    // k * 2pi вычитается точно при pi с запасом в log2|x| бит
+    const exponent_type leading = top();
+    if (leading <= 1) {
+        return to_fixed(bits);
+    }
+    const size_t extra = static_cast<size_t>(leading) + 2;
+    const size_t wide = bits + extra;
+    big_int x = to_fixed(wide);
+    const big_int pi = series::pi(wide);
+    const big_int two_pi = pi << 1;
+    big_int k = (x.abs() + pi) / two_pi;
+    if (!k.is_zero()) {
+        if (x.is_negative()) {
+            x += k * two_pi;
+        } else {
+            x -= k * two_pi;
+        }
+    }
+    return x >> extra;
+}
+
+template<typename Fixed>
+big_float big_float::evaluate(size_t precision, size_t bits, Fixed const &fixed) {
+    // Ядра ошибаются на несколько единиц 2^(-bits): при precision + 16 значащих битах
+    // округлённый результат отличается от точного меньше чем на единицу последнего разряда
+    const size_t wanted = precision + SERIES_GUARD_BITS / 2;
+    while (true) {
+        big_int value = fixed(bits);
+        const size_t length = bit_length(value);
+        if (length >= wanted) {
+            return from_parts(std::move(value), -static_cast<exponent_type>(bits), precision);
+        }
+        bits += length == 0 ? bits : wanted + SERIES_GUARD_BITS - length;
+    }
+}
+
+big_float::big_float(size_t precision) : _mantissa(), _exponent(0), _precision(precision) {
+    if (precision == 0) {
+        throw std::invalid_argument("Precision must be positive");
+    }
+}
+
+big_float::big_float(big_int const &value, size_t precision) : big_float(precision) {
+    _mantissa = value;
+    round(_mantissa, _exponent, _precision);
+}
+
+big_float::big_float(big_int const &numerator, big_int const &denominator, size_t precision) : big_float(precision) {
+    if (denominator.is_zero()) {
+        throw std::invalid_argument("Zero division");
+    }
+    if (numerator.is_zero()) {
+        return;
+    }
+
+    // Частное берём с precision + 2 битами, остаток даёт бит-липучку
+    const size_t numerator_length = bit_length(numerator);
+    const size_t denominator_length = bit_length(denominator);
+    const size_t shift = precision + 2 + denominator_length > numerator_length
+                         ? precision + 2 + denominator_length - numerator_length : 0;
+    auto [quotient, remainder] = divide(numerator.abs() << shift, denominator.abs());
+    if (numerator.is_negative() != denominator.is_negative()) {
+        quotient = -quotient;
+    }
+    _mantissa = std::move(quotient);
+    _exponent = -static_cast<exponent_type>(shift);
+    round(_mantissa, _exponent, _precision, !remainder.is_zero());
+}
+
+big_float::big_float(double value, size_t precision) : big_float(precision) {
+    if (!std::isfinite(value)) {
+        throw std::invalid_argument("Value is not finite");
+    }
+    if (value == 0) {
+        return;
+    }
+    int exponent = 0;
+    const double fraction = std::frexp(value, &exponent);
+    _mantissa = big_int(static_cast<int64_t>(std::ldexp(fraction, 53)));
+    _exponent = exponent - 53;
+    round(_mantissa, _exponent, _precision);
+}
+
+big_float big_float::from_parts(big_int mantissa, exponent_type exponent, size_t precision) {
+    big_float result(precision);
+    result._mantissa = std::move(mantissa);
+    result._exponent = exponent;
+    round(result._mantissa, result._exponent, precision);
+    return result;
+}
+
+size_t big_float::precision() const noexcept {
+    return _precision;
+}
+
+big_float &big_float::set_precision(size_t precision) & {
+    if (precision == 0) {
+        throw std::invalid_argument("Precision must be positive");
+    }
+    _precision = precision;
+    round(_mantissa, _exponent, _precision);
+    return *this;
+}
+
+big_float &&big_float::set_precision(size_t precision) && {
+    return std::move(set_precision(precision));
+}
+
+big_int const &big_float::mantissa() const noexcept {
+    return _mantissa;
+}
+
+big_float::exponent_type big_float::exponent() const noexcept {
+    return _exponent;
+}
+
+bool big_float::is_zero() const noexcept {
+    return _mantissa.is_zero();
+}
+
+bool big_float::is_negative() const noexcept {
+    return _mantissa.is_negative();
+}
+
+big_float big_float::abs() const {
+    big_float result(*this);
+    result._mantissa._sign = true;
+    return result;
+}
+
+double big_float::to_double() const {
+    if (is_zero()) {
+        return 0.0;
+    }
+
+    // Ниже 2^(-1022) у double остаётся меньше 53 бит мантиссы
+    const exponent_type leading = top();
+    const exponent_type allowed = std::min<exponent_type>(53, leading + 1074);
+    if (allowed <= 0) {
+        // |x| < 2^(-1074): к нулю, кроме значений больше половины наименьшего субнормального
+        const bool above_half = allowed == 0 && !(_exponent == -1075 && _mantissa.abs() == 1_bi);
+        const double result = above_half ? std::numeric_limits<double>::denorm_min() : 0.0;
+        return is_negative() ? -result : result;
+    }
+
+    big_int mantissa = _mantissa;
+    exponent_type exponent = _exponent;
+    round(mantissa, exponent, static_cast<size_t>(allowed));
+
+    uint64_t bits = 0;
+    for (size_t i = mantissa._digits.size(); i-- > 0;) {
+        bits = (bits << 32) | mantissa._digits[i];
+    }
+    if (exponent > std::numeric_limits<int>::max()) {
+        return is_negative() ? -HUGE_VAL : HUGE_VAL;
+    }
+    const double result = std::ldexp(static_cast<double>(bits), static_cast<int>(exponent));
+    return is_negative() ? -result : result;
+}
+
+std::string big_float::to_string() const {
+    if (is_zero()) {
+        return "0";
+    }
+
+    // digits десятичных цифр различают все значения с precision битами
+    const auto digits = static_cast<exponent_type>(std::ceil(static_cast<double>(_precision) * std::numbers::ln2 / std::numbers::ln10)) + 1;
+    auto decimal = static_cast<exponent_type>(std::floor(static_cast<double>(top() - 1) * std::numbers::ln2 / std::numbers::ln10));
+    const big_int lower = big_int(10).pow(static_cast<size_t>(digits - 1));
+    const big_int upper = lower * 10_bi;
+
+    // |x| * 10^(digits - 1 - decimal), округлённое к ближайшему, должно иметь ровно digits цифр
+    big_int scaled;
+    while (true) {
+        const exponent_type power = digits - 1 - decimal;
+        big_int numerator = _mantissa.abs();
+        big_int denominator = 1_bi;
+        if (power >= 0) {
+            numerator *= big_int(10).pow(static_cast<size_t>(power));
+        } else {
+            denominator = big_int(10).pow(static_cast<size_t>(-power));
+        }
+        if (_exponent >= 0) {
+            numerator <<= static_cast<size_t>(_exponent);
+        } else {
+            denominator <<= static_cast<size_t>(-_exponent);
+        }
+        scaled = ((numerator << 1) + denominator) / (denominator << 1);
+        if (scaled >= upper) {
+            ++decimal;
+        } else if (scaled < lower) {
+            --decimal;
+        } else {
+            break;
+        }
+    }
+
+    std::string text = scaled.to_string();
+    const size_t last = text.find_last_not_of('0');
+    text.erase(last + 1);
+
+    std::ostringstream result;
+    if (is_negative()) {
+        result << '-';
+    }
+    result << text[0];
+    if (text.size() > 1) {
+        result << '.' << text.substr(1);
+    }
+    result << 'e' << decimal;
+    return result.str();
+}
+
+std::ostream &operator<<(std::ostream &stream, big_float const &value) {
+    return stream << value.to_string();
+}
+
+big_float &big_float::operator+=(big_float const &other) & {
+    _precision = std::max(_precision, other._precision);
+    if (other.is_zero()) {
+        round(_mantissa, _exponent, _precision);
+        return *this;
+    }
+    if (is_zero()) {
+        _mantissa = other._mantissa;
+        _exponent = other._exponent;
+        round(_mantissa, _exponent, _precision);
+        return *this;
+    }
+
+    big_int const *large = &_mantissa;
+    big_int const *small = &other._mantissa;
+    exponent_type large_exponent = _exponent;
+    exponent_type small_exponent = other._exponent;
+    if (other.top() > top()) {
+        std::swap(large, small);
+        std::swap(large_exponent, small_exponent);
+    }
+
+    // Слагаемое целиком ниже младшего бита большего и на 3 бита ниже точки округления
+    // влияет только как бит-липучка: заменяем его на +-2^(cut - 1), выравнивание остаётся коротким
+    const exponent_type large_top = large_exponent + static_cast<exponent_type>(bit_length(*large));
+    const exponent_type cut = std::min(large_exponent, large_top - static_cast<exponent_type>(_precision) - 3);
+    big_int clipped;
+    if (small_exponent + static_cast<exponent_type>(bit_length(*small)) < cut) {
+        clipped = small->is_negative() ? -1_bi : 1_bi;
+        small = &clipped;
+        small_exponent = cut - 1;
+    }
+
+    const exponent_type exponent = std::min(large_exponent, small_exponent);
+    big_int sum = (*large << static_cast<size_t>(large_exponent - exponent))
+                  + (*small << static_cast<size_t>(small_exponent - exponent));
+    _mantissa = std::move(sum);
+    _exponent = exponent;
+    round(_mantissa, _exponent, _precision);
+    return *this;
+}
+
+big_float big_float::operator+(big_float const &other) const {
+    big_float result(*this);
+    return result += other;
+}
+
+big_float &big_float::operator-=(big_float const &other) & {
+    return *this += -other;
+}
+
+big_float big_float::operator-(big_float const &other) const {
+    big_float result(*this);
+    return result -= other;
+}
+
+big_float &big_float::operator*=(big_float const &other) & {
+    _precision = std::max(_precision, other._precision);
+    _mantissa *= other._mantissa;
+    _exponent = _mantissa.is_zero() ? 0 : _exponent + other._exponent;
+    round(_mantissa, _exponent, _precision);
+    return *this;
+}
+
+big_float big_float::operator*(big_float const &other) const {
+    big_float result(*this);
+    return result *= other;
+}
+
+big_float &big_float::operator/=(big_float const &other) & {
+    if (other.is_zero()) {
+        throw std::invalid_argument("Zero division");
+    }
+    _precision = std::max(_precision, other._precision);
+    if (is_zero()) {
+        return *this;
+    }
+
+    const size_t length = bit_length(_mantissa);
+    const size_t other_length = bit_length(other._mantissa);
+    const size_t shift = _precision + 2 + other_length > length ? _precision + 2 + other_length - length : 0;
+    auto [quotient, remainder] = divide(_mantissa.abs() << shift, other._mantissa.abs());
+    if (is_negative() != other.is_negative()) {
+        quotient = -quotient;
+    }
+    _mantissa = std::move(quotient);
+    _exponent = _exponent - other._exponent - static_cast<exponent_type>(shift);
+    round(_mantissa, _exponent, _precision, !remainder.is_zero());
+    return *this;
+}
+
+big_float big_float::operator/(big_float const &other) const {
+    big_float result(*this);
+    return result /= other;
+}
+
+big_float big_float::operator-() const {
+    big_float result(*this);
+    result._mantissa = -result._mantissa;
+    return result;
+}
+
+big_float big_float::remainder(big_float const &other) const {
+    if (other.is_zero()) {
+        throw std::invalid_argument("Zero division");
+    }
+    const size_t precision = std::max(_precision, other._precision);
+    if (is_zero()) {
+        return big_float(precision);
+    }
+
+    // Точный остаток от деления выровненных мантисс, затем переход к ближайшему частному
+    const exponent_type exponent = std::min(_exponent, other._exponent);
+    const big_int numerator = _mantissa.abs() << static_cast<size_t>(_exponent - exponent);
+    const big_int denominator = other._mantissa.abs() << static_cast<size_t>(other._exponent - exponent);
+    auto [quotient, rest] = divide(numerator, denominator);
+    const auto order = (rest << 1) <=> denominator;
+    if (order == std::strong_ordering::greater
+        || (order == std::strong_ordering::equal && !quotient.is_zero() && (quotient._digits[0] & 1u))) {
+        rest -= denominator;
+    }
+    if (is_negative()) {
+        rest = -rest;
+    }
+    return from_parts(std::move(rest), exponent, precision);
+}
+
+big_float big_float::ldexp(exponent_type shift) const {
+    big_float result(*this);
+    if (!result.is_zero()) {
+        result._exponent += shift;
+    }
+    return result;
+}
+
+bool big_float::operator==(big_float const &other) const noexcept {
+    return _mantissa == other._mantissa && _exponent == other._exponent;
+}
+
+std::strong_ordering big_float::operator<=>(big_float const &other) const noexcept {
+    if (is_negative() != other.is_negative()) {
+        return is_negative() ? std::strong_ordering::less : std::strong_ordering::greater;
+    }
+    if (is_zero() || other.is_zero()) {
+        return _mantissa <=> other._mantissa;
+    }
+
+    // Одного знака: сначала порядок старшего бита, затем выровненные мантиссы
+    const bool negative = is_negative();
+    std::strong_ordering order = top() <=> other.top();
+    if (order == std::strong_ordering::equal) {
+        const exponent_type exponent = std::min(_exponent, other._exponent);
+        order = (_mantissa.abs() << static_cast<size_t>(_exponent - exponent))
+                <=> (other._mantissa.abs() << static_cast<size_t>(other._exponent - exponent));
+    }
+    if (negative) {
+        return 0 <=> order;
+    }
+    return order;
+}
+
+big_float big_float::sqrt() const {
+    return root(2);
+}
+
+big_float big_float::root(size_t degree) const {
+    if (degree == 0) {
+        throw std::invalid_argument("Zero degree root");
+    }
+    if (degree == 1 || is_zero()) {
+        return *this;
+    }
+    if (is_negative()) {
+        if (degree % 2 == 0) {
+            throw std::invalid_argument("Even root of a negative number");
+        }
+        return -abs().root(degree);
+    }
+
+    // mantissa * 2^shift содержит не меньше degree * (precision + 2) бит, exponent - shift делится на degree:
+    // целый корень даёт precision + 2 бита, неточность корня - бит-липучку
+    const auto power = static_cast<exponent_type>(degree);
+    const size_t length = bit_length(_mantissa);
+    const size_t wanted = degree * (_precision + 2);
+    exponent_type shift = wanted > length ? static_cast<exponent_type>(wanted - length) : 0;
+    shift += ((_exponent - shift) % power + power) % power;
+
+    const big_int value = _mantissa << static_cast<size_t>(shift);
+    big_int result = series::root(value, degree);
+    const bool sticky = result.pow(degree) != value;
+    exponent_type exponent = (_exponent - shift) / power;
+    round(result, exponent, _precision, sticky);
+
+    big_float answer(_precision);
+    answer._mantissa = std::move(result);
+    answer._exponent = exponent;
+    return answer;
+}
+
+big_float big_float::pow(size_t degree) const {
+    if (degree == 0) {
+        if (is_zero()) {
+            throw std::invalid_argument("Zero to the zero power");
+        }
+        return big_float(1_bi, _precision);
+    }
+
+    // Короткая точная степень округляется один раз
+    const size_t length = bit_length(_mantissa);
+    if (length * degree <= 8 * (_precision + 64)) {
+        return from_parts(_mantissa.pow(degree), _exponent * static_cast<exponent_type>(degree), _precision);
+    }
+
+    // Бинарное возведение: каждое округление даёт относительную ошибку 2^(-working),
+    // в итоге она не больше degree * 2^(-working)
+    const size_t working = _precision + std::bit_width(degree) + 4;
+    big_float base(*this);
+    base.set_precision(working);
+    big_float result(1_bi, working);
+    for (size_t rest = degree; ; ) {
+        if (rest & 1u) {
+            result *= base;
+        }
+        rest >>= 1;
+        if (rest == 0) {
+            break;
+        }
+        base *= base;
+    }
+    return std::move(result).set_precision(_precision);
+}
+
+big_float big_float::exp() const {
+    if (is_zero()) {
+        return big_float(1_bi, _precision);
+    }
+    if (top() > 62) {
+        throw std::overflow_error("Exponent overflow");
+    }
+
+    // x = k ln 2 + r, |r| около ln 2 / 2: exp(x) = 2^k exp(r). Малые x куски ряда берут и без сдвига
+    const auto k = top() > 1 ? static_cast<exponent_type>(std::llround(to_double() / std::numbers::ln2)) : 0;
+    const size_t k_bits = bit_length(big_int(k));
+    const big_float result = evaluate(_precision, _precision + SERIES_GUARD_BITS, [this, k, k_bits](size_t bits) {
+        const size_t wide = bits + k_bits + 2;
+        const big_int r = k == 0 ? to_fixed(bits) : (to_fixed(wide) - series::ln2(wide) * big_int(k)) >> (wide - bits);
+        if (!r.is_negative()) {
+            return series::exp(r, bits);
+        }
+        return (1_bi << (2 * bits)) / series::exp(r.abs(), bits);
+    });
+    return result.ldexp(k);
+}
+
+big_float big_float::ln() const {
+    if (is_zero() || is_negative()) {
+        throw std::invalid_argument("Logarithm of a non-positive number");
+    }
+    if (_exponent == 0 && _mantissa == 1_bi) {
+        return big_float(_precision);
+    }
+
+    // x = a * 2^k, 1 <= a < 2
+    const exponent_type k = top() - 1;
+    const size_t length = bit_length(_mantissa);
+    return evaluate(_precision, _precision + SERIES_GUARD_BITS, [this, k, length](size_t bits) {
+        const size_t wide = bits + bit_length(big_int(k)) + 2;
+        const big_int a = length - 1 <= wide ? _mantissa << (wide - (length - 1)) : _mantissa >> (length - 1 - wide);
+        big_int result = series::ln(a, wide);
+        if (k != 0) {
+            result += series::ln2(wide) * big_int(k);
+        }
+        return result >> (wide - bits);
+    });
+}
+
+big_float big_float::sin() const {
+    if (is_zero()) {
+        return big_float(_precision);
+    }
+    return evaluate(_precision, working_bits(_precision, top()), [this](size_t bits) {
+        const big_int x = reduced_angle(bits);
+        big_int sin, cos;
+        series::sin_cos(x.abs(), bits, sin, cos);
+        return x.is_negative() ? -sin : sin;
+    });
+}
+
+big_float big_float::cos() const {
+    if (is_zero()) {
+        return big_float(1_bi, _precision);
+    }
+    return evaluate(_precision, _precision + SERIES_GUARD_BITS, [this](size_t bits) {
+        const big_int x = reduced_angle(bits);
+        big_int sin, cos;
+        series::sin_cos(x.abs(), bits, sin, cos);
+        return cos;
+    });
+}
+
+big_float big_float::atan() const {
+    if (is_zero()) {
+        return big_float(_precision);
+    }
+
+    // |x| = numerator / denominator
+    big_int numerator = _mantissa.abs();
+    big_int denominator = 1_bi;
+    if (_exponent > 0) {
+        numerator <<= static_cast<size_t>(_exponent);
+    } else {
+        denominator <<= static_cast<size_t>(-_exponent);
+    }
+    return evaluate(_precision, working_bits(_precision, top()), [&](size_t bits) {
+        big_int result = series::atan_ratio(numerator, denominator, bits);
+        return is_negative() ? -result : result;
+    });
+}
+
+big_float big_float::asin() const {
+    if (is_zero()) {
+        return big_float(_precision);
+    }
+    if (_exponent == 0 && _mantissa.abs() == 1_bi) {
+        const big_float half_pi = pi(_precision).ldexp(-1);
+        return is_negative() ? -half_pi : half_pi;
+    }
+    if (top() >= 1) {
+        throw std::invalid_argument("Arcsine argument is out of [-1, 1]");
+    }
+
+    // При |x| около 1 корень sqrt(1 - x^2) теряет половину бит от 1 - |x| = gap / 2^scale
+    const auto scale = static_cast<size_t>(-_exponent);
+    const big_int gap = (1_bi << scale) - _mantissa.abs();
+    const size_t extra = (scale - bit_length(gap)) / 2 + 2;
+    return evaluate(_precision, working_bits(_precision, top()), [&](size_t bits) {
+        const size_t wide = bits + extra;
+        const big_int x = to_fixed(wide).abs();
+        const big_int root = series::sqrt((1_bi << (2 * wide)) - x * x);
+        big_int result = series::atan_ratio(x, root, wide) >> extra;
+        return is_negative() ? -result : result;
+    });
+}
+
+big_float big_float::pi(size_t precision) {
+    return evaluate(precision, precision + SERIES_GUARD_BITS, [](size_t bits) {
+        return series::pi(bits);
+    });
+}
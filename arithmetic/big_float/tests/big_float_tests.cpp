@@ -0,0 +1,163 @@
+#include <client_logger.h>
+#include <client_logger_builder.h>
+#include <big_float.h>
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <limits>
+
+logger *create_logger(std::vector<std::pair<std::string, logger::severity>> const &output_file_streams_setup,
+                      const bool use_console_stream = true,
+                      const logger::severity console_stream_severity = logger::severity::debug)
+{
+    logger_builder *builder = new client_logger_builder();
+
+    builder->set_format("[%d|%t] %s: %m");
+
+    if (use_console_stream)
+    {
+        builder->add_console_stream(console_stream_severity);
+    }
+
+    for (const auto &[fst, snd] : output_file_streams_setup)
+    {
+        builder->add_file_stream(fst, snd);
+    }
+
+    logger *built_logger = builder->build();
+
+    delete builder;
+
+    return built_logger;
+}
+
+TEST(roundingTests, nearestEven)
+{
+    logger *logger = create_logger(std::vector<std::pair<std::string, logger::severity>>{
+            {"bigfloat_logs.txt", logger::severity::information},
+    });
+
+    // 1011 и 1001 на трёх битах: равноудалённые значения идут к чётной мантиссе
+    EXPECT_TRUE(big_float::from_parts(11_bi, 0, 3) == big_float(12_bi, 3));
+    EXPECT_TRUE(big_float::from_parts(9_bi, 0, 3) == big_float(8_bi, 3));
+    EXPECT_TRUE(big_float::from_parts(-11_bi, 0, 3) == big_float(big_int(-12), 3));
+
+    // 1/3 = 0.0101...: десять значащих бит 1010101010 и хвост больше половины, мантисса хранится нечётной
+    const big_float third(1_bi, 3_bi, 10);
+    EXPECT_TRUE(third.mantissa() == 683_bi);
+    EXPECT_EQ(third.exponent(), -11);
+    EXPECT_TRUE(big_float(1024_bi).mantissa() == 1_bi);
+    EXPECT_EQ(big_float(1024_bi).exponent(), 10);
+
+    // слагаемое далеко ниже точки округления не выравнивается, а учитывается битом-липучкой
+    const big_float one(1_bi, 53);
+    const big_float tiny = big_float(1_bi, 53).ldexp(-1000000);
+    EXPECT_TRUE(one + tiny == one);
+    EXPECT_TRUE(one - tiny == one);
+    EXPECT_TRUE(one + one.ldexp(-53) == one);
+    EXPECT_TRUE(one + one.ldexp(-52) + one.ldexp(-53) == one + one.ldexp(-51));
+    logger->debug(third.to_string());
+
+    delete logger;
+}
+
+TEST(arithmeticTests, correctlyRounded)
+{
+    logger *logger = create_logger(std::vector<std::pair<std::string, logger::severity>>{
+            {"bigfloat_logs.txt", logger::severity::information},
+    });
+
+    const big_float two(2_bi, 64);
+    EXPECT_TRUE(two.sqrt() == big_float::from_parts(13043817825332782212_bi, -63, 64));
+    EXPECT_TRUE(big_float(27_bi).root(3) == big_float(3_bi));
+    EXPECT_TRUE(big_float(big_int(-32), 20).root(5) == big_float(big_int(-2), 20));
+    EXPECT_TRUE(big_float(1_bi, 3_bi, 100) * big_float(3_bi, 100) == big_float(1_bi, 100));
+    EXPECT_TRUE(big_float(10_bi, 100) / big_float(4_bi, 100) == big_float(5_bi, 2_bi, 100));
+    EXPECT_TRUE(big_float(3_bi, 200).pow(100) == big_float(big_int(3).pow(100), 200));
+    EXPECT_THROW(big_float(1_bi) / big_float(), std::invalid_argument);
+    EXPECT_THROW(big_float(big_int(-4)).sqrt(), std::invalid_argument);
+
+    // 7 / 2 = 3.5, частное округляется к чётному 4
+    EXPECT_TRUE(big_float(7_bi).remainder(big_float(2_bi)) == big_float(big_int(-1)));
+    EXPECT_TRUE(big_float(big_int(-9)).remainder(big_float(2_bi)) == big_float(big_int(-1)));
+    logger->debug(two.sqrt().to_string());
+
+    delete logger;
+}
+
+TEST(conversionTests, doubleAndString)
+{
+    logger *logger = create_logger(std::vector<std::pair<std::string, logger::severity>>{
+            {"bigfloat_logs.txt", logger::severity::information},
+    });
+
+    EXPECT_EQ(big_float(0.1).to_double(), 0.1);
+    EXPECT_EQ(big_float(-1e300, 53).to_double(), -1e300);
+    EXPECT_EQ(big_float(1_bi, 3_bi, 200).to_double(), 1.0 / 3);
+    EXPECT_EQ(big_float(1_bi).ldexp(-1074).to_double(), std::numeric_limits<double>::denorm_min());
+    EXPECT_EQ(big_float(1_bi).ldexp(-1075).to_double(), 0.0);
+    EXPECT_EQ(big_float(3_bi).ldexp(-1076).to_double(), std::numeric_limits<double>::denorm_min());
+    EXPECT_EQ(big_float(1_bi).ldexp(1024).to_double(), HUGE_VAL);
+    EXPECT_THROW(big_float(std::nan("")), std::invalid_argument);
+
+    EXPECT_EQ(big_float(1_bi, 3_bi, 10).to_string(), "3.335e-1");
+    EXPECT_EQ(big_float(big_int(-1234500), 64).to_string(), "-1.2345e6");
+    EXPECT_EQ(big_float().to_string(), "0");
+    logger->debug(big_float(0.1).to_string());
+
+    delete logger;
+}
+
+TEST(functionTests, constants)
+{
+    logger *logger = create_logger(std::vector<std::pair<std::string, logger::severity>>{
+            {"bigfloat_logs.txt", logger::severity::information},
+    });
+
+    const size_t precision = 200;
+    const big_float one(1_bi, precision);
+    const big_float pi = big_float::pi(precision);
+
+    EXPECT_EQ(pi.to_string(), "3.1415926535897932384626433832795028841971693993751058209749445e0");
+    EXPECT_EQ(one.exp().to_string(), "2.7182818284590452353602874713526624977572470936999595749669679e0");
+    EXPECT_EQ(big_float(2_bi, precision).ln().to_string(), "6.9314718055994530941723212145817656807550013436025525412067998e-1");
+    EXPECT_TRUE(one.atan().ldexp(2) == pi);
+    EXPECT_TRUE(one.asin().ldexp(1) == pi);
+    logger->debug(pi.to_string());
+
+    delete logger;
+}
+
+TEST(functionTests, identities)
+{
+    logger *logger = create_logger(std::vector<std::pair<std::string, logger::severity>>{
+            {"bigfloat_logs.txt", logger::severity::information},
+    });
+
+    const size_t precision = 300;
+    const big_float x(7_bi, 3_bi, precision);
+    const big_float s = x.sin();
+    const big_float c = x.cos();
+    const big_float tolerance = big_float(1_bi, precision).ldexp(-290);
+
+    EXPECT_TRUE((s * s + c * c - big_float(1_bi, precision)).abs() < tolerance);
+    EXPECT_TRUE((x.exp().ln() - x).abs() < tolerance);
+    EXPECT_TRUE((x.ln().exp() - x).abs() < tolerance);
+
+    // sin(2^100): аргумент сокращается на 2pi с запасом в сто бит
+    const big_float huge = big_float(1_bi, 64).ldexp(100);
+    EXPECT_TRUE((huge.sin() - huge.remainder(big_float::pi(200).ldexp(1)).set_precision(64).sin()).abs()
+                < big_float(1_bi, 64).ldexp(-60));
+    EXPECT_THROW(big_float(big_int(-1)).ln(), std::invalid_argument);
+    EXPECT_THROW(big_float(2_bi).asin(), std::invalid_argument);
+    EXPECT_THROW(big_float(1_bi).ldexp(70).exp(), std::overflow_error);
+    logger->debug(s.to_string());
+
+    delete logger;
+}
+
+auto main(int argc, char **argv) -> int
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
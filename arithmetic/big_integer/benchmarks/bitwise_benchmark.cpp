@@ -0,0 +1,76 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+
+#include <big_int.h>
+
+// Поразрядные операции, сдвиги и popcount на числах из 1k, 4k, ..., 1M разрядов: время одной операции в микросекундах.
+// Запуск: mp_os_arthmtc_bg_intgr_btws_bnchmrk [n], по умолчанию n = 1048576 - наибольшая длина
+
+namespace
+{
+    big_int operand(size_t digits, unsigned int seed)
+    {
+        std::vector<unsigned int> value(digits);
+        for (auto &digit : value)
+        {
+            seed = seed * 1664525u + 1013904223u;
+            digit = seed;
+        }
+        value.back() |= 1u << 31;
+        return big_int(value);
+    }
+
+    // Лучшее время из нескольких повторов; повторов тем больше, чем короче числа
+    template<typename F>
+    double measure(size_t digits, F const &function)
+    {
+        const size_t repeats = std::max<size_t>(3, (size_t(1) << 24) / digits);
+        double best = 0;
+        for (size_t i = 0; i < repeats; ++i)
+        {
+            auto start = std::chrono::steady_clock::now();
+            function();
+            auto finish = std::chrono::steady_clock::now();
+            const double us = std::chrono::duration<double, std::micro>(finish - start).count();
+            best = i == 0 ? us : std::min(best, us);
+        }
+        return best;
+    }
+}
+
+int main(
+    int argc,
+    char **argv)
+{
+    const size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : size_t(1) << 20;
+
+    std::cout << std::setw(8) << "limbs" << std::setw(10) << "&" << std::setw(10) << "|" << std::setw(10) << "^"
+              << std::setw(10) << "~" << std::setw(10) << "<< 77" << std::setw(10) << ">> 77" << std::setw(10) << "&="
+              << std::setw(10) << "popcount" << std::endl;
+
+    size_t checksum = 0;
+    for (size_t digits = 1024; digits <= n; digits *= 4)
+    {
+        const big_int left = operand(digits, 1);
+        const big_int right = operand(digits, 2);
+        big_int result;
+
+        std::cout << std::setw(8) << digits << std::fixed << std::setprecision(1)
+                  << std::setw(10) << measure(digits, [&]() { result = left & right; })
+                  << std::setw(10) << measure(digits, [&]() { result = left | right; })
+                  << std::setw(10) << measure(digits, [&]() { result = left ^ right; })
+                  << std::setw(10) << measure(digits, [&]() { result = ~left; })
+                  << std::setw(10) << measure(digits, [&]() { result = left << 77; })
+                  << std::setw(10) << measure(digits, [&]() { result = left >> 77; })
+                  << std::setw(10) << measure(digits, [&]() { result &= right; })
+                  << std::setw(10) << measure(digits, [&]() { checksum += left.popcount(); })
+                  << std::endl;
+    }
+
+    // контрольная сумма не даёт компилятору выбросить замеры popcount
+    std::cout << "checksum " << checksum << std::endl;
+    return 0;
+}
@@ -0,0 +1,285 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <big_int.h>
+
+// Время операций big_int на числах из 1, 2, 4, ..., n разрядов, показатель степени сложности
+// по хвосту кривой и точки, где асимптотически более быстрый алгоритм обгоняет предыдущий.
+// Ряд обрывается, когда одна операция дольше бюджета или алгоритм отказывается от такой длины.
+// Запуск: mp_os_arthmtc_bg_intgr_cmplx_bnchmrk [n] [бюджет, мс], по умолчанию n = 1048576 и 1000 мс.
+// Таблица печатается в stderr, JSON - в stdout
+
+namespace
+{
+    size_t checksum = 0;
+
+    big_int operand(size_t digits, unsigned int seed)
+    {
+        std::vector<unsigned int> value(digits);
+        for (auto &digit : value)
+        {
+            seed = seed * 1664525u + 1013904223u;
+            digit = seed;
+        }
+        value.back() |= 1u << 31;
+        return big_int(value);
+    }
+
+    struct operation
+    {
+        std::string name;
+        // Алгоритмы одной группы перечислены от простого к асимптотически быстрому, между соседями ищется точка обгона
+        std::string group;
+        // Готовит операнды длины n и возвращает замеряемое действие
+        std::function<std::function<void()>(size_t)> prepare;
+    };
+
+    struct series
+    {
+        const operation *source;
+        std::vector<std::pair<size_t, double>> points; // длина в разрядах, нс на операцию
+        std::string stopped;
+    };
+
+    // Наименьшее из пяти время пачки вызовов, деленное на её длину; пачка не короче 200 мкс,
+    // чтобы на малых длинах не мерить сами часы
+    double measure(std::function<void()> const &action)
+    {
+        using clock = std::chrono::steady_clock;
+        auto run = [&action](size_t count) {
+            auto start = clock::now();
+            for (size_t i = 0; i < count; ++i)
+            {
+                action();
+            }
+            return std::chrono::duration<double, std::nano>(clock::now() - start).count();
+        };
+
+        size_t count = 1;
+        double elapsed = run(count);
+        while (elapsed < 2e5 && count < (size_t(1) << 24))
+        {
+            count *= elapsed < 2e4 ? 16 : 2;
+            elapsed = run(count);
+        }
+
+        double best = elapsed;
+        for (size_t i = elapsed < 5e7 ? 4 : 0; i > 0; --i)
+        {
+            best = std::min(best, run(count));
+        }
+        return best / static_cast<double>(count);
+    }
+
+    // Наклон log t от log n по точкам не короче 1/256 наибольшей длины, NaN если таких точек меньше двух
+    double exponent(series const &curve)
+    {
+        if (curve.points.empty())
+        {
+            return NAN;
+        }
+        const size_t from = std::max<size_t>(2, curve.points.back().first / 256);
+        double n = 0, sx = 0, sy = 0, sxx = 0, sxy = 0;
+        for (auto const &[limbs, ns] : curve.points)
+        {
+            if (limbs < from)
+            {
+                continue;
+            }
+            const double x = std::log(static_cast<double>(limbs)), y = std::log(ns);
+            n += 1;
+            sx += x;
+            sy += y;
+            sxx += x * x;
+            sxy += x * y;
+        }
+        return n < 2 ? NAN : (n * sxy - sx * sy) / (n * sxx - sx * sx);
+    }
+
+    // Наименьшая длина, начиная с которой faster быстрее slower на всех общих длинах; 0 - не обгоняет.
+    // Если ряд slower оборвался раньше, а faster продолжился, это тоже считается обгоном
+    size_t crossover(series const &slower, series const &faster)
+    {
+        size_t result = 0;
+        for (auto const &[limbs, ns] : faster.points)
+        {
+            auto other = std::find_if(slower.points.begin(), slower.points.end(),
+                                      [limbs](auto const &point) { return point.first == limbs; });
+            if (other == slower.points.end())
+            {
+                if (result == 0 && !slower.stopped.empty() && slower.stopped != "max_limbs")
+                {
+                    result = limbs;
+                }
+                continue;
+            }
+            if (ns >= other->second)
+            {
+                result = 0;
+            }
+            else if (result == 0)
+            {
+                result = limbs;
+            }
+        }
+        return result;
+    }
+
+    std::string quoted(std::string const &text)
+    {
+        std::string result = "\"";
+        for (char c : text)
+        {
+            if (c == '"' || c == '\\')
+            {
+                result += '\\';
+            }
+            result += static_cast<unsigned char>(c) < 0x20 ? ' ' : c;
+        }
+        return result + "\"";
+    }
+
+    std::string number(double value)
+    {
+        if (std::isnan(value))
+        {
+            return "null";
+        }
+        std::ostringstream out;
+        out << std::setprecision(4) << value;
+        return out.str();
+    }
+
+    std::vector<operation> operations()
+    {
+        using multiplication = big_int::multiplication_rule;
+        using division = big_int::division_rule;
+
+        auto multiply = [](multiplication rule) {
+            return [rule](size_t n) -> std::function<void()> {
+                return [rule, left = operand(n, 1), right = operand(n, 2)]() {
+                    big_int product = left;
+                    product.multiply_assign(right, rule);
+                };
+            };
+        };
+        // Деление 2n разрядов на n - основной случай для рекурсивных алгоритмов
+        auto divide = [](division rule) {
+            return [rule](size_t n) -> std::function<void()> {
+                return [rule, numerator = operand(2 * n, 3), denominator = operand(n, 4)]() {
+                    big_int quotient = numerator;
+                    quotient.divide_assign(denominator, rule);
+                };
+            };
+        };
+
+        return {
+            {"add", "", [](size_t n) -> std::function<void()> {
+                return [left = operand(n, 1), right = operand(n, 2)]() { big_int sum = left + right; };
+            }},
+            {"subtract", "", [](size_t n) -> std::function<void()> {
+                return [left = operand(n, 1), right = operand(n, 2)]() { big_int difference = left - right; };
+            }},
+            {"multiply_trivial", "multiplication", multiply(multiplication::trivial)},
+            {"multiply_Karatsuba", "multiplication", multiply(multiplication::Karatsuba)},
+            {"multiply_SchonhageStrassen", "multiplication", multiply(multiplication::SchonhageStrassen)},
+            {"divide_trivial", "division", divide(division::trivial)},
+            {"divide_BurnikelZiegler", "division", divide(division::BurnikelZiegler)},
+            {"divide_Newton", "division", divide(division::Newton)},
+            {"to_string", "", [](size_t n) -> std::function<void()> {
+                return [value = operand(n, 5)]() { checksum += value.to_string().size(); };
+            }},
+            {"parse", "", [](size_t n) -> std::function<void()> {
+                return [text = operand(n, 6).to_string()]() { checksum += big_int(text).is_zero(); };
+            }},
+            // НОД, которым дробь сокращается после каждой операции
+            {"gcd", "", [](size_t n) -> std::function<void()> {
+                return [left = operand(n, 7), right = operand(n, 8)]() { checksum += big_int::gcd(left, right).is_zero(); };
+            }},
+        };
+    }
+}
+
+int main(
+    int argc,
+    char **argv)
+{
+    const size_t max_limbs = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : size_t(1) << 20;
+    const double budget_ms = argc > 2 ? std::strtod(argv[2], nullptr) : 1000;
+
+    const std::vector<operation> all = operations();
+    std::vector<series> curves;
+    for (auto const &op : all)
+    {
+        series curve{&op, {}, "max_limbs"};
+        for (size_t limbs = 1; limbs <= max_limbs; limbs *= 2)
+        {
+            double ns;
+            try
+            {
+                ns = measure(op.prepare(limbs));
+            }
+            catch (std::exception const &error)
+            {
+                curve.stopped = error.what();
+                break;
+            }
+            curve.points.emplace_back(limbs, ns);
+            std::cerr << std::setw(28) << op.name << std::setw(10) << limbs << std::setw(16) << std::fixed
+                      << std::setprecision(1) << ns << " ns" << std::endl;
+            if (ns > budget_ms * 1e6)
+            {
+                curve.stopped = limbs < max_limbs ? "budget" : "max_limbs";
+                break;
+            }
+        }
+        curves.push_back(std::move(curve));
+    }
+
+    std::cout << "{\n  \"max_limbs\": " << max_limbs << ",\n  \"budget_ms\": " << number(budget_ms)
+              << ",\n  \"operations\": [";
+    for (size_t i = 0; i < curves.size(); ++i)
+    {
+        auto const &curve = curves[i];
+        const double slope = exponent(curve);
+        std::cerr << curve.source->name << ": exponent " << number(slope) << ", stopped by " << curve.stopped << std::endl;
+
+        std::cout << (i ? "," : "") << "\n    {\"name\": " << quoted(curve.source->name)
+                  << ", \"exponent\": " << number(slope) << ", \"stopped\": " << quoted(curve.stopped) << ", \"points\": [";
+        for (size_t j = 0; j < curve.points.size(); ++j)
+        {
+            std::cout << (j ? ", " : "") << "{\"limbs\": " << curve.points[j].first
+                      << ", \"ns\": " << number(curve.points[j].second) << "}";
+        }
+        std::cout << "]}";
+    }
+
+    std::cout << "\n  ],\n  \"crossovers\": [";
+    bool first = true;
+    for (size_t i = 1; i < curves.size(); ++i)
+    {
+        auto const &slower = curves[i - 1], &faster = curves[i];
+        if (faster.source->group.empty() || faster.source->group != slower.source->group)
+        {
+            continue;
+        }
+        const size_t limbs = crossover(slower, faster);
+        std::cerr << faster.source->name << " overtakes " << slower.source->name << ": "
+                  << (limbs ? std::to_string(limbs) + " limbs" : "never") << std::endl;
+
+        std::cout << (first ? "" : ",") << "\n    {\"group\": " << quoted(faster.source->group)
+                  << ", \"slower\": " << quoted(slower.source->name) << ", \"faster\": " << quoted(faster.source->name)
+                  << ", \"limbs\": " << (limbs ? std::to_string(limbs) : "null") << "}";
+        first = false;
+    }
+    std::cout << "\n  ],\n  \"checksum\": " << checksum << "\n}" << std::endl;
+    return 0;
+}
@@ -0,0 +1,66 @@
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+
+#include <big_int.h>
+
+// Умножение двух чисел по n разрядов при 1, 2, 4, ..., 32 потоках.
+// Запуск: mp_os_arthmtc_bg_intgr_prll_bnchmrk [n], по умолчанию n = 1048576
+
+namespace
+{
+    big_int operand(size_t digits, unsigned int seed)
+    {
+        std::vector<unsigned int> value(digits);
+        for (auto &digit : value)
+        {
+            seed = seed * 1664525u + 1013904223u;
+            digit = seed;
+        }
+        value.back() |= 1u << 31;
+        return big_int(value);
+    }
+
+    double measure(big_int const &left, big_int const &right, big_int &product)
+    {
+        auto start = std::chrono::steady_clock::now();
+        product = left * right;
+        auto finish = std::chrono::steady_clock::now();
+        return std::chrono::duration<double, std::milli>(finish - start).count();
+    }
+}
+
+int main(
+    int argc,
+    char **argv)
+{
+    const size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : size_t(1) << 20;
+
+    const big_int left = operand(n, 1);
+    const big_int right = operand(n, 2);
+
+    big_int expected;
+    double sequential_ms = 0;
+    for (size_t threads = 1; threads <= 32; threads *= 2)
+    {
+        big_int::set_parallel_threads(threads);
+
+        big_int product;
+        const double ms = measure(left, right, product);
+        if (threads == 1)
+        {
+            expected = product;
+            sequential_ms = ms;
+        }
+        else if (product != expected)
+        {
+            std::cerr << threads << " threads: product differs" << std::endl;
+            return 1;
+        }
+
+        std::cout << threads << " threads: " << ms << " ms, speedup " << sequential_ms / ms << std::endl;
+    }
+
+    big_int::set_parallel_threads(1);
+    return 0;
+}
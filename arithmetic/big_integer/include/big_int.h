@@ -8,12 +8,278 @@
 #include <vector>
 #include <utility>
 #include <iostream>
+#include <bit>
+#include <span>
+#include <cstddef>
 #include <concepts>
+#include <iterator>
+#include <algorithm>
+#include <type_traits>
 #include <pp_allocator.h>
 #include <not_implemented.h>
 
+/** Number of digits big_int keeps inside the object before spilling to its allocator.
+ *  Can be overridden at compile time, e.g. -DMP_OS_BIG_INT_INLINE_DIGITS=4
+ */
+#ifndef MP_OS_BIG_INT_INLINE_DIGITS
+#define MP_OS_BIG_INT_INLINE_DIGITS 4
+#endif
+
 namespace __detail
 {
+    /** Vector of trivially copyable values with inline storage for the first inline_capacity elements.
+     *  Heap memory is requested from alloc only when the size grows beyond that; moves of spilled vectors
+     *  steal the buffer, moves of inline ones copy at most inline_capacity values
+     */
+    template<typename T, size_t inline_capacity, typename alloc>
+    class small_vector
+    {
+        static_assert(std::is_trivially_copyable_v<T>);
+        static_assert(inline_capacity > 0);
+
+        using alloc_traits = std::allocator_traits<alloc>;
+
+        alloc _allocator;
+        T *_data;
+        size_t _size;
+        size_t _capacity;
+        T _inline[inline_capacity];
+
+    public:
+
+        using value_type = T;
+        using allocator_type = alloc;
+        using size_type = size_t;
+        using iterator = T *;
+        using const_iterator = const T *;
+
+        explicit small_vector(const alloc &allocator = alloc()) noexcept
+            : _allocator(allocator), _data(_inline), _size(0), _capacity(inline_capacity)
+        {}
+
+        template<std::input_iterator iterator_type>
+        small_vector(iterator_type first, iterator_type last, const alloc &allocator = alloc())
+            : small_vector(allocator)
+        {
+            assign(first, last);
+        }
+
+        small_vector(const small_vector &other)
+            : small_vector(alloc_traits::select_on_container_copy_construction(other._allocator))
+        {
+            assign(other.begin(), other.end());
+        }
+
+        small_vector(small_vector &&other) noexcept
+            : small_vector(other._allocator)
+        {
+            steal(other);
+        }
+
+        small_vector &operator=(const small_vector &other)
+        {
+            if (this != &other)
+            {
+                assign(other.begin(), other.end());
+            }
+            return *this;
+        }
+
+        small_vector &operator=(small_vector &&other) noexcept
+        {
+            if (this == &other)
+            {
+                return *this;
+            }
+
+            if constexpr (alloc_traits::propagate_on_container_move_assignment::value)
+            {
+                release();
+                _allocator = other._allocator;
+                steal(other);
+            }
+            else if (_allocator == other._allocator)
+            {
+                release();
+                steal(other);
+            }
+            else
+            {
+                assign(other.begin(), other.end());
+                other.clear();
+            }
+            return *this;
+        }
+
+        ~small_vector() noexcept
+        {
+            release();
+        }
+
+        void swap(small_vector &other) noexcept
+        {
+            if (!is_inline() && !other.is_inline())
+            {
+                if constexpr (alloc_traits::propagate_on_container_swap::value)
+                {
+                    std::swap(_allocator, other._allocator);
+                }
+                std::swap(_data, other._data);
+                std::swap(_size, other._size);
+                std::swap(_capacity, other._capacity);
+                return;
+            }
+
+            small_vector tmp(std::move(other));
+            other = std::move(*this);
+            *this = std::move(tmp);
+        }
+
+        alloc get_allocator() const noexcept { return _allocator; }
+
+        size_t size() const noexcept { return _size; }
+        size_t capacity() const noexcept { return _capacity; }
+        bool empty() const noexcept { return _size == 0; }
+
+        T *data() noexcept { return _data; }
+        const T *data() const noexcept { return _data; }
+
+        iterator begin() noexcept { return _data; }
+        iterator end() noexcept { return _data + _size; }
+        const_iterator begin() const noexcept { return _data; }
+        const_iterator end() const noexcept { return _data + _size; }
+
+        T &operator[](size_t index) noexcept { return _data[index]; }
+        const T &operator[](size_t index) const noexcept { return _data[index]; }
+
+        T &back() noexcept { return _data[_size - 1]; }
+        const T &back() const noexcept { return _data[_size - 1]; }
+
+        void reserve(size_t capacity)
+        {
+            if (capacity > _capacity)
+            {
+                reallocate(capacity);
+            }
+        }
+
+        void resize(size_t size, const T &value = T())
+        {
+            if (size > _capacity)
+            {
+                const T copy = value;
+                reallocate(std::max(size, 2 * _capacity));
+                std::fill(_data + _size, _data + size, copy);
+            }
+            else if (size > _size)
+            {
+                std::fill(_data + _size, _data + size, value);
+            }
+            _size = size;
+        }
+
+        /** resize without filling the new elements: the caller overwrites them
+         */
+        void resize_for_overwrite(size_t size)
+        {
+            if (size > _capacity)
+            {
+                reallocate(std::max(size, 2 * _capacity));
+            }
+            _size = size;
+        }
+
+        void assign(size_t size, const T &value)
+        {
+            const T copy = value;
+            _size = 0;
+            resize(size, copy);
+        }
+
+        template<std::input_iterator iterator_type>
+        void assign(iterator_type first, iterator_type last)
+        {
+            if constexpr (std::forward_iterator<iterator_type>)
+            {
+                const auto size = static_cast<size_t>(std::distance(first, last));
+                if (size > _capacity)
+                {
+                    // старое содержимое не нужно - перевыделяем без копирования
+                    _size = 0;
+                    reallocate(size);
+                }
+                std::copy(first, last, _data);
+                _size = size;
+            }
+            else
+            {
+                _size = 0;
+                for (; first != last; ++first)
+                {
+                    push_back(*first);
+                }
+            }
+        }
+
+        void push_back(const T &value)
+        {
+            if (_size == _capacity)
+            {
+                const T copy = value;
+                reallocate(2 * _capacity);
+                _data[_size++] = copy;
+                return;
+            }
+            _data[_size++] = value;
+        }
+
+        void pop_back() noexcept { --_size; }
+
+        void clear() noexcept { _size = 0; }
+
+    private:
+
+        bool is_inline() const noexcept { return _data == _inline; }
+
+        void reallocate(size_t capacity)
+        {
+            T *data = alloc_traits::allocate(_allocator, capacity);
+            std::copy(_data, _data + _size, data);
+            release();
+            _data = data;
+            _capacity = capacity;
+        }
+
+        void release() noexcept
+        {
+            if (!is_inline())
+            {
+                alloc_traits::deallocate(_allocator, _data, _capacity);
+                _data = _inline;
+                _capacity = inline_capacity;
+            }
+        }
+
+        // Забирает буфер other (или копирует его встроенные значения), other остаётся пустым
+        void steal(small_vector &other) noexcept
+        {
+            if (other.is_inline())
+            {
+                std::copy(other._data, other._data + other._size, _inline);
+                _data = _inline;
+                _capacity = inline_capacity;
+            }
+            else
+            {
+                _data = other._data;
+                _capacity = other._capacity;
+                other._data = other._inline;
+                other._capacity = inline_capacity;
+            }
+            _size = other._size;
+            other._size = 0;
+        }
+    };
     constexpr unsigned int generate_half_mask()
     {
         unsigned int res = 0;
@@ -70,29 +336,48 @@ namespace __detail
     }
 }
 
-class big_int
+class big_int;
+
+/** Read-only view of an integer whose digits live in memory owned by someone else, e.g. a mapped file.
+ *  Digits are 32-bit, least significant first, in host byte order; leading zero digits are ignored.
+ *  The memory must outlive the view. A big_int converts to a view of itself
+ */
+class big_int_view
 {
+    const unsigned int *_digits;
+    size_t _size;
     bool _sign; // 1 +  0 -
-    std::vector<unsigned int, pp_allocator<unsigned int>> _digits;
 
-    friend class fraction;
+public:
 
-private:
-    void optimise() noexcept;
-    static std::strong_ordering modulo_comparison(const big_int &left, const big_int &right, size_t shift = 0) noexcept;
+    big_int_view() noexcept;
 
-    void get_new_value_from_string(const std::string& num, unsigned int radix);
+    explicit big_int_view(std::span<const unsigned int> digits, bool sign = true) noexcept;
 
-    static void plus_operation_without_sign(big_int &left, const big_int &right, size_t shift = 0) noexcept;
-    static void minus_operation_without_sign(big_int &left, const big_int &right, size_t shift = 0);
+    big_int_view(const big_int &value) noexcept;
 
-    static big_int multiply_table(const big_int &left, const big_int& right) noexcept;
-    static big_int multiply_karatsuba(const big_int& left, const big_int& right);
-    static big_int divide_table(const big_int& numerator, const big_int& denominator);
-    static big_int binary_search_quotient(const big_int& numerator, const big_int& denominator);
+    [[nodiscard]] std::span<const unsigned int> digits() const noexcept;
+
+    [[nodiscard]] bool is_negative() const noexcept;
+    [[nodiscard]] bool is_zero() const noexcept;
+
+    friend std::strong_ordering operator<=>(big_int_view left, big_int_view right) noexcept;
+
+    friend bool operator==(big_int_view left, big_int_view right) noexcept;
+};
+
+class big_int
+{
+    using digits_container = __detail::small_vector<unsigned int, MP_OS_BIG_INT_INLINE_DIGITS, pp_allocator<unsigned int>>;
+
+    bool _sign; // 1 +  0 -
+    digits_container _digits;
+
+    friend class fraction;
+    friend class big_float;
+    friend class big_int_view;
 
 public:
-    static std::strong_ordering compare_with_sign(const big_int &left, const big_int& right, size_t shift = 0) noexcept;
     enum class multiplication_rule
     {
         trivial,
@@ -107,6 +392,102 @@ public:
         BurnikelZiegler
     };
 
+private:
+    void optimise() noexcept;
+    static std::strong_ordering modulo_comparison(const big_int &left, const big_int &right, size_t shift = 0) noexcept;
+
+    void get_new_value_from_string(const std::string& num, unsigned int radix);
+
+    enum class bitwise_operation
+    {
+        conjunction,
+        disjunction,
+        exclusive_disjunction
+    };
+
+    /** destination = left op right in one pass over the digits; destination may be left or right
+     */
+    static void bitwise_into(big_int &destination, const big_int &left, const big_int &right, bitwise_operation operation);
+
+    /** destination = value << shift (>> shift) in one pass; destination may be value itself
+     */
+    static void shift_left_into(big_int &destination, const big_int &value, size_t shift);
+    static void shift_right_into(big_int &destination, const big_int &value, size_t shift);
+
+    static void plus_operation_without_sign(big_int &left, const big_int &right, size_t shift = 0) noexcept;
+    static void minus_operation_without_sign(big_int &left, const big_int &right, size_t shift = 0);
+
+    static big_int multiply_table(const big_int &left, const big_int& right) noexcept;
+    static void multiply_table_into(big_int &destination, const big_int &left, const big_int& right);
+
+    /** left * right by the algorithm decide_mult picks, squaring when both are the same object
+     */
+    static big_int multiply(const big_int& left, const big_int& right);
+
+    /** destination = left * right, schoolbook products are written straight into destination's buffer
+     */
+    static void multiply_into(big_int& destination, const big_int& left, const big_int& right);
+
+    /** *this += other * B^shift, or -= when subtract is set, without copying other
+     */
+    big_int& add_signed(const big_int& other, bool subtract, size_t shift = 0);
+
+    /** *this += value * B^shift, value given by its magnitude and sign and must not point into *this
+     */
+    void add_digits(const unsigned int *value, size_t size, bool sign, size_t shift = 0);
+
+    /** *this += left * right, or -= when subtract is set; left and right may be *this
+     */
+    void accumulate_product(const big_int& left, const big_int& right, bool subtract);
+
+    /** *this += value << bits, or -= when subtract is set; value may be *this
+     */
+    void accumulate_shifted(const big_int& value, size_t bits, bool subtract);
+
+    static big_int multiply_karatsuba(const big_int& left, const big_int& right);
+
+    /** value * value with every cross product computed once (64-bit schoolbook)
+     */
+    static big_int square_table(const big_int& value);
+
+    /** value * value by Karatsuba with three half-size squarings instead of three general products
+     */
+    static big_int square_karatsuba(const big_int& value);
+
+    static big_int square_with_rule(const big_int& value, multiplication_rule rule);
+
+    static big_int divide_table(const big_int& numerator, const big_int& denominator);
+
+    /** Quotient and remainder of |numerator| / |denominator| (Knuth, algorithm D)
+     */
+    static std::pair<big_int, big_int> divide_table_with_remainder(const big_int& numerator, const big_int& denominator);
+
+    /** Quotient and remainder of |numerator| / |denominator| (recursive Burnikel-Ziegler division)
+     */
+    static std::pair<big_int, big_int> divide_burnikel_ziegler(const big_int& numerator, const big_int& denominator);
+
+    /** Quotient and remainder of |numerator| / |denominator|: a reciprocal of the denominator by Newton iteration
+     *  with doubling precision, one multiplication by the numerator and a few correction steps
+     */
+    static std::pair<big_int, big_int> divide_newton(const big_int& numerator, const big_int& denominator);
+
+    /** Truncating division: quotient sign is the product of signs, remainder takes the sign of numerator
+     */
+    static std::pair<big_int, big_int> divide_with_remainder(const big_int& numerator, const big_int& denominator, division_rule rule);
+
+    /** Appends decimal digits of |value|, left-padded with zeros up to width (0 - no padding).
+     *  Small values are converted by 10^9 chunks, large ones are split by cached powers 10^(9 * 2^i)
+     */
+    static void append_decimal(const big_int& value, size_t width, std::string& out);
+
+    /** Value of chunks[from, to) as digits in base radix^k, where radix^k is the largest power fitting in one digit.
+     *  Large ranges are split in halves and joined through cached powers of the chunk base
+     */
+    static big_int from_radix_chunks(const std::vector<unsigned int>& chunks, size_t from, size_t to, unsigned int radix, pp_allocator<unsigned int> allocator);
+
+public:
+    static std::strong_ordering compare_with_sign(const big_int &left, const big_int& right, size_t shift = 0) noexcept;
+
 private:
 
     /** Decides type of mult/div that depends on size of lhs and rhs
@@ -123,7 +504,7 @@ public:
 
     explicit big_int(const std::vector<unsigned int, pp_allocator<unsigned int>> &digits, bool sign = true);
 
-    explicit big_int(std::vector<unsigned int, pp_allocator<unsigned int>> &&digits, bool sign = true) noexcept;
+    explicit big_int(std::vector<unsigned int, pp_allocator<unsigned int>> &&digits, bool sign = true);
 
     explicit big_int(const std::string& num, unsigned int radix = 10, pp_allocator<unsigned int> = pp_allocator<unsigned int>());
 
@@ -138,9 +519,15 @@ public:
 
     big_int(big_int &&other) noexcept;
 
+    /** Copies the digits of view
+     */
+    explicit big_int(big_int_view view, pp_allocator<unsigned int> allocator = pp_allocator<unsigned int>());
+
     big_int& operator=(const big_int &other);
     big_int& operator=(big_int &&other) noexcept;
 
+    friend void swap(big_int &left, big_int &right) noexcept;
+
     explicit operator bool() const noexcept; //false if 0 , else true
 
     big_int& operator++() &;
@@ -153,6 +540,12 @@ public:
 
     big_int& operator+=(const big_int& other) &;
 
+    /** Adds or subtracts digits read straight from the view's memory
+     */
+    big_int& operator+=(big_int_view other) &;
+
+    big_int& operator-=(big_int_view other) &;
+
     /** Shift will be needed for multiplication implementation
      *  @example Shift = 0: 111 + 222 = 333
      *  @example Shift = 1: 111 + 222 = 2331
@@ -164,6 +557,23 @@ public:
 
     big_int& minus_assign(const big_int& other, size_t shift = 0) &;
 
+    /** Fused multiply-add *this += left * right: schoolbook-sized products are accumulated from a stack buffer
+     *  and never reach the allocator, larger ones go through one temporary. left and right may be *this
+     */
+    big_int& add_product(const big_int& left, const big_int& right) &;
+
+    big_int& subtract_product(const big_int& left, const big_int& right) &;
+
+    /** *this = left * right; schoolbook-sized products are written straight into this value's buffer
+     */
+    big_int& assign_product(const big_int& left, const big_int& right) &;
+
+    /** *this += value << bits without building the shifted copy
+     */
+    big_int& add_shifted(const big_int& value, size_t bits) &;
+
+    big_int& subtract_shifted(const big_int& value, size_t bits) &;
+
     /** Delegates to multiply_assign and calls decide_mult
      */
     big_int& operator*=(const big_int& other) &;
@@ -189,8 +599,48 @@ public:
 
     big_int& modulo_assign(const big_int& other, division_rule rule = division_rule::trivial) &;
 
-    big_int operator+(const big_int& other) const;
-    big_int operator-(const big_int& other) const;
+    /** Same as *this * *this, but uses the squaring algorithms, which need about half the digit products
+     */
+    big_int square() const;
+
+    /** Greatest common divisor of |left| and |right|, gcd(0, 0) == 0.
+     *  Lehmer steps on the leading 62 bits, a half-GCD recursion on the upper halves of large operands
+     *  and a binary GCD once both values fit in 64 bits
+     */
+    static big_int gcd(const big_int& left, const big_int& right);
+
+    /** Divides first and second by divisor, which must divide both of them exactly.
+     *  Quotient digits are found from the lowest one up (Jebelean), so this is cheaper than operator/
+     *  @throw std::invalid_argument if divisor is zero
+     */
+    static void divide_exact(big_int& first, big_int& second, const big_int& divisor);
+
+    /** Number of threads large multiplications and squarings may use, the calling thread included.
+     *  1 (the default) keeps them sequential; the others come from one shared work-stealing pool,
+     *  so the allocators of the operands must be safe to use from several threads. Results do not depend on it
+     */
+    static void set_parallel_threads(size_t threads);
+
+    static size_t parallel_threads() noexcept;
+
+    /** *this raised to exp by sliding-window exponentiation, pow(0) == 1
+     */
+    big_int pow(size_t exp) const;
+
+    class montgomery_context;
+
+    /** *this raised to exp modulo mod, result lies in [0, mod).
+     *  Odd moduli go through Montgomery multiplication, use montgomery_context directly to reuse it for one modulus
+     *  @throw std::invalid_argument if mod <= 0 or exp < 0
+     */
+    big_int modpow(const big_int& exp, const big_int& mod) const;
+
+    /** The rvalue overloads add into the buffer of the temporary: a * b + c allocates only for the product
+     */
+    big_int operator+(const big_int& other) const &;
+    big_int operator+(const big_int& other) &&;
+    big_int operator-(const big_int& other) const &;
+    big_int operator-(const big_int& other) &&;
     big_int operator*(const big_int& other) const;
     big_int operator/(const big_int& other) const;
     big_int operator%(const big_int& other) const;
@@ -204,7 +654,8 @@ public:
     big_int& operator>>=(size_t shift) &;
 
 
-    big_int operator<<(size_t shift) const;
+    big_int operator<<(size_t shift) const &;
+    big_int operator<<(size_t shift) &&;
     big_int operator>>(size_t shift) const;
 
     big_int operator~() const;
@@ -226,18 +677,82 @@ public:
 
     [[nodiscard]] std::string to_string() const;
 
+    /** Number of bytes in |*this|, 0 for zero
+     */
+    [[nodiscard]] size_t byte_length() const noexcept;
+
+    /** Writes |*this| into all of bytes as an unsigned number, zero-padded on the most significant side.
+     *  The digits are copied as they are when order matches the host
+     *  @return byte_length()
+     *  @throw std::invalid_argument if bytes is shorter than byte_length()
+     */
+    size_t export_bits(std::span<std::byte> bytes, std::endian order = std::endian::little) const;
+
+    /** Value of the unsigned number stored in bytes, negated when sign is false
+     */
+    static big_int import_bits(std::span<const std::byte> bytes, std::endian order = std::endian::little, bool sign = true,
+                               pp_allocator<unsigned int> allocator = pp_allocator<unsigned int>());
+
+    /** Binary form: LEB128 varint of 2 * byte_length() + (1 if negative), then byte_length() bytes of |*this|,
+     *  least significant first
+     */
+    void serialize(std::ostream &stream) const;
+
+    /** Reads a value written by serialize
+     *  @throw std::invalid_argument if the header is malformed or the stream ends early
+     */
+    static big_int deserialize(std::istream &stream, pp_allocator<unsigned int> allocator = pp_allocator<unsigned int>());
+
+    /** Number of bytes serialize writes
+     */
+    [[nodiscard]] size_t serialized_size() const noexcept;
+
     [[nodiscard]] bool is_negative() const noexcept;
     [[nodiscard]] bool is_positive() const noexcept;
     [[nodiscard]] bool is_zero() const noexcept;
 
+    /** Bit queries and updates work on |*this|, like the bitwise operators
+     */
+    [[nodiscard]] size_t popcount() const noexcept;
+
+    /** Index of the highest set bit plus one, 0 for zero
+     */
+    [[nodiscard]] size_t bit_length() const noexcept;
+
+    [[nodiscard]] bool test_bit(size_t index) const noexcept;
+
+    big_int& set_bit(size_t index, bool value = true) &;
+
     big_int abs() const;
 };
 
-template<class alloc>
-big_int::big_int(const std::vector<unsigned int, alloc> &digits, bool sign, pp_allocator<unsigned int> allocator) : _sign(sign)
+/** Precomputed data for Montgomery multiplication modulo a fixed odd modulus.
+ *  Building it costs one division, after that every exponentiation avoids divisions completely
+ */
+class big_int::montgomery_context
 {
-    _digits = std::vector<unsigned int, pp_allocator<unsigned int>>(digits.begin(), digits.end(), allocator);
+    big_int _modulus;
+    std::vector<uint64_t> _words;     // modulus in 64-bit words
+    std::vector<uint64_t> _r_squared; // 2^(128 * words) mod modulus
+    uint64_t _inverse;                // -modulus^(-1) mod 2^64
+
+public:
 
+    /** @throw std::invalid_argument if modulus is not odd and positive
+     */
+    explicit montgomery_context(const big_int& modulus);
+
+    const big_int& modulus() const noexcept;
+
+    /** base^exp mod modulus, result lies in [0, modulus)
+     *  @throw std::invalid_argument if exp < 0
+     */
+    big_int pow(const big_int& base, const big_int& exp) const;
+};
+
+template<class alloc>
+big_int::big_int(const std::vector<unsigned int, alloc> &digits, bool sign, pp_allocator<unsigned int> allocator) : _sign(sign), _digits(digits.begin(), digits.end(), allocator)
+{
     optimise();
 
 }
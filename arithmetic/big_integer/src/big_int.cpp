@@ -9,6 +9,20 @@
 #include <sstream>
 #include <cmath>
 #include <algorithm>
+#include <bit>
+#include <memory>
+#include <mutex>
+#include <cstring>
+#include <functional>
+#include <work_stealing_pool.h>
+
+#if defined(_MSC_VER) && defined(_M_X64)
+#include <intrin.h>
+#endif
+
+#if defined(__GNUC__) && defined(__x86_64__)
+#include <immintrin.h>
+#endif
 
 
 
@@ -18,6 +32,439 @@ namespace {
     const uint64_t SS_MOD2 = 1004535809;
     const uint64_t SS_ROOT2 = 3;
 
+    // Пороги выбора алгоритмов (в разрядах)
+    // Ниже этого размера Карацуба проигрывает школьному умножению
+    constexpr size_t KARATSUBA_THRESHOLD = 32;
+    // Начиная с этого размера меньшего множителя выгоднее умножение через NTT
+    constexpr size_t SCHONHAGE_STRASSEN_THRESHOLD = 6144;
+    // Размер, на котором рекурсия Буркеля-Циглера переходит к делению Кнута
+    constexpr size_t BURNIKEL_ZIEGLER_THRESHOLD = 64;
+    // Точность (в битах), ниже которой обратная величина в делении Ньютона считается прямым делением
+    constexpr size_t NEWTON_THRESHOLD = 64 * 32;
+    // Начиная с этого размера НОД сокращает старшие половины чисел рекурсивно (half-GCD), ниже - шагами Лемера
+    constexpr size_t HALF_GCD_THRESHOLD = 1024;
+    // Ниже этого размера перевод в строку идёт кусками по 10^9 без разбиения
+    constexpr size_t TO_STRING_THRESHOLD = 64;
+    // Ниже этого числа кусков разбор строки идёт схемой Горнера
+    constexpr size_t FROM_STRING_THRESHOLD = 128;
+    // Длина свёртки NTT: коэффициенты по 20 бит не должны переполнить произведение модулей
+    constexpr size_t SS_MAX_COEFFICIENTS = size_t(1) << 20;
+    // В параллельном режиме Карацуба отдаёт подзадачи пулу начиная с этого размера, ниже накладные расходы больше выигрыша
+    constexpr size_t PARALLEL_KARATSUBA_THRESHOLD = 1024;
+    // Длина NTT, начиная с которой бабочки одного этапа делятся между потоками, и число бабочек в одной части
+    constexpr size_t PARALLEL_NTT_THRESHOLD = size_t(1) << 16;
+    constexpr size_t PARALLEL_NTT_GRAIN = size_t(1) << 13;
+
+    // Общий пул параллельного режима; пустой указатель - последовательный режим
+    std::mutex parallel_mutex;
+    std::shared_ptr<work_stealing_pool> parallel_pool;
+
+    std::shared_ptr<work_stealing_pool> current_parallel_pool() {
+        std::lock_guard<std::mutex> lock(parallel_mutex);
+        return parallel_pool;
+    }
+
+    /*
+     * Бабочки с номерами [first, last) из n / 2 бабочек одного этапа NTT по произвольному модулю,
+     * по кускам внутри блоков длины len
+     */
+    void ntt_butterflies(uint64_t *data, size_t len, uint64_t wlen, size_t first, size_t last, uint64_t mod) {
+        const size_t half = len / 2;
+        while (first < last) {
+            const size_t begin = first % half;
+            const size_t end = std::min(half, begin + (last - first));
+            uint64_t *low = data + (first / half) * len;
+            uint64_t *high = low + half;
+            // множитель первой бабочки куска - wlen^begin
+            uint64_t w = begin == 0 ? 1 : big_int::ss_power(wlen, begin, mod);
+            for (size_t j = begin; j < end; j++) {
+                uint64_t u = low[j];
+                uint64_t v = (high[j] * w) % mod;
+                low[j] = u + v;
+                if (low[j] >= mod) low[j] -= mod;
+                high[j] = u - v + mod;
+                if (high[j] >= mod) high[j] -= mod;
+                w = (w * wlen) % mod;
+            }
+            first += end - begin;
+        }
+    }
+
+    /*
+     * NTT по модулям меньше 2^30 (оба модуля SS_MOD1 и SS_MOD2).
+     * Умножение на известный заранее множитель w идёт по Шупу: вместе с w хранится w' = floor(w * 2^32 / p),
+     * для x < 2^32 частное q = (x * w') >> 32 меньше точного не больше чем на единицу, и x * w - q * p лежит в [0, 2p).
+     * Произведение двух переменных вычетов - умножением Монтгомери с R = 2^32.
+     * Два соседних этапа бабочек сливаются в один проход по данным (radix-4), ядра под AVX2 и AVX-512
+     * выбираются по возможностям процессора. Все пути дают одни и те же приведённые вычеты, что и общий путь
+     */
+    constexpr uint64_t NTT_FAST_MODULUS_LIMIT = uint64_t(1) << 30;
+
+    struct ntt_modulus {
+        uint64_t p;
+        // -p^-1 mod 2^32 и 2^64 mod p для умножения Монтгомери
+        uint64_t montgomery_neg_inverse;
+        uint64_t montgomery_r2;
+
+        explicit ntt_modulus(uint64_t modulus) noexcept : p(modulus) {
+            uint32_t inverse = static_cast<uint32_t>(modulus);
+            for (int i = 0; i < 5; ++i) {
+                inverse *= 2 - static_cast<uint32_t>(modulus) * inverse;
+            }
+            montgomery_neg_inverse = static_cast<uint32_t>(0u - inverse);
+            const uint64_t r = (uint64_t(1) << 32) % modulus;
+            montgomery_r2 = r * r % modulus;
+        }
+    };
+
+    inline uint64_t shoup_companion(uint64_t w, uint64_t p) noexcept {
+        // floor(w * 2^32 / p) через double с точной поправкой: ошибка приближения много меньше единицы
+        uint64_t q = static_cast<uint64_t>(std::ldexp(static_cast<double>(w), 32) / static_cast<double>(p));
+        const int64_t rest = static_cast<int64_t>((w << 32) - q * p);
+        if (rest < 0) {
+            --q;
+        } else if (rest >= static_cast<int64_t>(p)) {
+            ++q;
+        }
+        return q;
+    }
+
+    inline uint64_t reduce_once(uint64_t x, uint64_t p) noexcept {
+        return x >= p ? x - p : x;
+    }
+
+    inline uint64_t shoup_mul(uint64_t x, uint64_t w, uint64_t w_shoup, uint64_t p) noexcept {
+        const uint64_t q = (x * w_shoup) >> 32;
+        return reduce_once(x * w - q * p, p);
+    }
+
+    inline uint64_t montgomery_mul(uint64_t x, uint64_t y, const ntt_modulus &m) noexcept {
+        const uint64_t t = x * y;
+        const uint64_t k = static_cast<uint32_t>(static_cast<uint32_t>(t) * m.montgomery_neg_inverse);
+        return reduce_once((t + k * m.p) >> 32, m.p);
+    }
+
+    /*
+     * Множители всех этапов преобразования длины n: для этапа длины len значения W_len^j, j < len / 2,
+     * лежат с позиции len / 2 - 1, W_len = root^(n / len). Рядом - их спутники Шупа
+     */
+    struct ntt_twiddles {
+        std::vector<uint64_t> w;
+        std::vector<uint64_t> w_shoup;
+
+        ntt_twiddles(size_t n, uint64_t root, uint64_t p) : w(n - 1), w_shoup(n - 1) {
+            uint64_t *top = w.data() + n / 2 - 1, *top_shoup = w_shoup.data() + n / 2 - 1;
+            const uint64_t root_shoup = shoup_companion(root, p);
+            top[0] = 1;
+            top_shoup[0] = shoup_companion(1, p);
+            for (size_t j = 1; j < n / 2; ++j) {
+                top[j] = shoup_mul(top[j - 1], root, root_shoup, p);
+                top_shoup[j] = shoup_companion(top[j], p);
+            }
+            // W_len^j = W_2len^2j: младшие этапы прореживают старшие
+            for (size_t len = n / 2; len >= 2; len /= 2) {
+                for (size_t j = 0; j < len / 2; ++j) {
+                    w[len / 2 - 1 + j] = w[len - 1 + 2 * j];
+                    w_shoup[len / 2 - 1 + j] = w_shoup[len - 1 + 2 * j];
+                }
+            }
+        }
+
+        const uint64_t *stage(size_t len) const noexcept {
+            return w.data() + len / 2 - 1;
+        }
+
+        const uint64_t *stage_shoup(size_t len) const noexcept {
+            return w_shoup.data() + len / 2 - 1;
+        }
+    };
+
+    /*
+     * Проход radix-4: этапы len и 2len над четвёрками x[j], x[j + h], x[j + 2h], x[j + 3h], h = len / 2.
+     * Четвёрки нумеруются подряд по блокам длины 2len, ядро обрабатывает номера [first, last)
+     */
+    struct ntt_pass {
+        uint64_t *data;
+        size_t h;
+        const uint64_t *w1, *w1_shoup;
+        const uint64_t *w2, *w2_shoup;
+        uint64_t p;
+    };
+
+    inline void ntt_quad_scalar(const ntt_pass &pass, uint64_t *x, size_t j) noexcept {
+        const size_t h = pass.h;
+        const uint64_t p = pass.p;
+        const uint64_t v1 = shoup_mul(x[j + h], pass.w1[j], pass.w1_shoup[j], p);
+        const uint64_t v3 = shoup_mul(x[j + 3 * h], pass.w1[j], pass.w1_shoup[j], p);
+        const uint64_t b0 = reduce_once(x[j] + v1, p), b1 = reduce_once(x[j] + p - v1, p);
+        const uint64_t b2 = reduce_once(x[j + 2 * h] + v3, p), b3 = reduce_once(x[j + 2 * h] + p - v3, p);
+        const uint64_t u2 = shoup_mul(b2, pass.w2[j], pass.w2_shoup[j], p);
+        const uint64_t u3 = shoup_mul(b3, pass.w2[j + h], pass.w2_shoup[j + h], p);
+        x[j] = reduce_once(b0 + u2, p);
+        x[j + 2 * h] = reduce_once(b0 + p - u2, p);
+        x[j + h] = reduce_once(b1 + u3, p);
+        x[j + 3 * h] = reduce_once(b1 + p - u3, p);
+    }
+
+    void ntt_pass_scalar(const ntt_pass &pass, size_t first, size_t last) noexcept {
+        while (first < last) {
+            const size_t begin = first % pass.h;
+            const size_t end = std::min(pass.h, begin + (last - first));
+            uint64_t *x = pass.data + (first / pass.h) * 4 * pass.h;
+            for (size_t j = begin; j < end; ++j) {
+                ntt_quad_scalar(pass, x, j);
+            }
+            first += end - begin;
+        }
+    }
+
+    void ntt_pointwise_scalar(uint64_t *c, const uint64_t *a, const uint64_t *b, const ntt_modulus &m, size_t first, size_t last) noexcept {
+        for (size_t i = first; i < last; ++i) {
+            // x * y * R^-1, затем умножение на R^2 * R^-1 возвращает x * y
+            c[i] = montgomery_mul(montgomery_mul(a[i], b[i], m), m.montgomery_r2, m);
+        }
+    }
+
+    void ntt_scale_scalar(uint64_t *data, uint64_t factor, uint64_t factor_shoup, uint64_t p, size_t first, size_t last) noexcept {
+        for (size_t i = first; i < last; ++i) {
+            data[i] = shoup_mul(data[i], factor, factor_shoup, p);
+        }
+    }
+
+#if defined(__GNUC__) && defined(__x86_64__)
+#define BIG_INT_NTT_X86_SIMD
+
+    // Вычеты лежат в 64-битных дорожках, _mm*_mul_epu32 перемножает их младшие 32 бита
+
+    __attribute__((target("avx2"))) inline __m256i load_avx2(const uint64_t *from) noexcept {
+        return _mm256_loadu_si256(reinterpret_cast<const __m256i *>(from));
+    }
+
+    __attribute__((target("avx2"))) inline __m256i reduce_once_avx2(__m256i x, __m256i p) noexcept {
+        const __m256i less = _mm256_cmpgt_epi64(p, x);
+        return _mm256_sub_epi64(x, _mm256_andnot_si256(less, p));
+    }
+
+    __attribute__((target("avx2"))) inline __m256i shoup_mul_avx2(__m256i x, __m256i w, __m256i w_shoup, __m256i p) noexcept {
+        const __m256i q = _mm256_srli_epi64(_mm256_mul_epu32(x, w_shoup), 32);
+        return reduce_once_avx2(_mm256_sub_epi64(_mm256_mul_epu32(x, w), _mm256_mul_epu32(q, p)), p);
+    }
+
+    __attribute__((target("avx2"))) inline __m256i montgomery_mul_avx2(__m256i x, __m256i y, __m256i neg_inverse, __m256i p) noexcept {
+        const __m256i t = _mm256_mul_epu32(x, y);
+        const __m256i k = _mm256_mul_epu32(t, neg_inverse);
+        return reduce_once_avx2(_mm256_srli_epi64(_mm256_add_epi64(t, _mm256_mul_epu32(k, p)), 32), p);
+    }
+
+    __attribute__((target("avx2"))) void ntt_pass_avx2(const ntt_pass &pass, size_t first, size_t last) noexcept {
+        const size_t h = pass.h;
+        const __m256i p = _mm256_set1_epi64x(static_cast<long long>(pass.p));
+        while (first < last) {
+            const size_t begin = first % h;
+            const size_t end = std::min(h, begin + (last - first));
+            uint64_t *x = pass.data + (first / h) * 4 * h;
+            size_t j = begin;
+            for (; j + 4 <= end; j += 4) {
+                const __m256i w1 = load_avx2(pass.w1 + j), w1_shoup = load_avx2(pass.w1_shoup + j);
+                const __m256i v1 = shoup_mul_avx2(load_avx2(x + j + h), w1, w1_shoup, p);
+                const __m256i v3 = shoup_mul_avx2(load_avx2(x + j + 3 * h), w1, w1_shoup, p);
+                const __m256i a0 = load_avx2(x + j), a2 = load_avx2(x + j + 2 * h);
+                const __m256i b0 = reduce_once_avx2(_mm256_add_epi64(a0, v1), p);
+                const __m256i b1 = reduce_once_avx2(_mm256_sub_epi64(_mm256_add_epi64(a0, p), v1), p);
+                const __m256i b2 = reduce_once_avx2(_mm256_add_epi64(a2, v3), p);
+                const __m256i b3 = reduce_once_avx2(_mm256_sub_epi64(_mm256_add_epi64(a2, p), v3), p);
+                const __m256i u2 = shoup_mul_avx2(b2, load_avx2(pass.w2 + j), load_avx2(pass.w2_shoup + j), p);
+                const __m256i u3 = shoup_mul_avx2(b3, load_avx2(pass.w2 + j + h), load_avx2(pass.w2_shoup + j + h), p);
+                _mm256_storeu_si256(reinterpret_cast<__m256i *>(x + j), reduce_once_avx2(_mm256_add_epi64(b0, u2), p));
+                _mm256_storeu_si256(reinterpret_cast<__m256i *>(x + j + 2 * h), reduce_once_avx2(_mm256_sub_epi64(_mm256_add_epi64(b0, p), u2), p));
+                _mm256_storeu_si256(reinterpret_cast<__m256i *>(x + j + h), reduce_once_avx2(_mm256_add_epi64(b1, u3), p));
+                _mm256_storeu_si256(reinterpret_cast<__m256i *>(x + j + 3 * h), reduce_once_avx2(_mm256_sub_epi64(_mm256_add_epi64(b1, p), u3), p));
+            }
+            for (; j < end; ++j) {
+                ntt_quad_scalar(pass, x, j);
+            }
+            first += end - begin;
+        }
+    }
+
+    __attribute__((target("avx2"))) void ntt_pointwise_avx2(uint64_t *c, const uint64_t *a, const uint64_t *b, const ntt_modulus &m, size_t first, size_t last) noexcept {
+        const __m256i p = _mm256_set1_epi64x(static_cast<long long>(m.p));
+        const __m256i neg_inverse = _mm256_set1_epi64x(static_cast<long long>(m.montgomery_neg_inverse));
+        const __m256i r2 = _mm256_set1_epi64x(static_cast<long long>(m.montgomery_r2));
+        size_t i = first;
+        for (; i + 4 <= last; i += 4) {
+            const __m256i product = montgomery_mul_avx2(montgomery_mul_avx2(load_avx2(a + i), load_avx2(b + i), neg_inverse, p), r2, neg_inverse, p);
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(c + i), product);
+        }
+        ntt_pointwise_scalar(c, a, b, m, i, last);
+    }
+
+    __attribute__((target("avx2"))) void ntt_scale_avx2(uint64_t *data, uint64_t factor, uint64_t factor_shoup, uint64_t p, size_t first, size_t last) noexcept {
+        const __m256i modulus = _mm256_set1_epi64x(static_cast<long long>(p));
+        const __m256i w = _mm256_set1_epi64x(static_cast<long long>(factor));
+        const __m256i w_shoup = _mm256_set1_epi64x(static_cast<long long>(factor_shoup));
+        size_t i = first;
+        for (; i + 4 <= last; i += 4) {
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(data + i), shoup_mul_avx2(load_avx2(data + i), w, w_shoup, modulus));
+        }
+        ntt_scale_scalar(data, factor, factor_shoup, p, i, last);
+    }
+
+    // В AVX-512 есть беззнаковый минимум: min(x, x - p) приводит x из [0, 2p).
+    // Немаскированные min/mul_epu32/srli в GCC 12 подставляют _mm512_undefined_epi32() и дают -Wmaybe-uninitialized,
+    // поэтому используются maskz-формы с полной маской: заполнитель - ноль, код тот же
+
+    constexpr __mmask8 all_lanes_avx512 = 0xFF;
+
+    __attribute__((target("avx512f"))) inline __m512i mul_epu32_avx512(__m512i x, __m512i y) noexcept {
+        return _mm512_maskz_mul_epu32(all_lanes_avx512, x, y);
+    }
+
+    __attribute__((target("avx512f"))) inline __m512i high_half_avx512(__m512i x) noexcept {
+        return _mm512_maskz_srli_epi64(all_lanes_avx512, x, 32);
+    }
+
+    __attribute__((target("avx512f"))) inline __m512i reduce_once_avx512(__m512i x, __m512i p) noexcept {
+        return _mm512_maskz_min_epu64(all_lanes_avx512, x, _mm512_sub_epi64(x, p));
+    }
+
+    __attribute__((target("avx512f"))) inline __m512i shoup_mul_avx512(__m512i x, __m512i w, __m512i w_shoup, __m512i p) noexcept {
+        const __m512i q = high_half_avx512(mul_epu32_avx512(x, w_shoup));
+        return reduce_once_avx512(_mm512_sub_epi64(mul_epu32_avx512(x, w), mul_epu32_avx512(q, p)), p);
+    }
+
+    __attribute__((target("avx512f"))) inline __m512i montgomery_mul_avx512(__m512i x, __m512i y, __m512i neg_inverse, __m512i p) noexcept {
+        const __m512i t = mul_epu32_avx512(x, y);
+        const __m512i k = mul_epu32_avx512(t, neg_inverse);
+        return reduce_once_avx512(high_half_avx512(_mm512_add_epi64(t, mul_epu32_avx512(k, p))), p);
+    }
+
+    __attribute__((target("avx512f"))) void ntt_pass_avx512(const ntt_pass &pass, size_t first, size_t last) noexcept {
+        const size_t h = pass.h;
+        const __m512i p = _mm512_set1_epi64(static_cast<long long>(pass.p));
+        while (first < last) {
+            const size_t begin = first % h;
+            const size_t end = std::min(h, begin + (last - first));
+            uint64_t *x = pass.data + (first / h) * 4 * h;
+            size_t j = begin;
+            for (; j + 8 <= end; j += 8) {
+                const __m512i w1 = _mm512_loadu_si512(pass.w1 + j), w1_shoup = _mm512_loadu_si512(pass.w1_shoup + j);
+                const __m512i v1 = shoup_mul_avx512(_mm512_loadu_si512(x + j + h), w1, w1_shoup, p);
+                const __m512i v3 = shoup_mul_avx512(_mm512_loadu_si512(x + j + 3 * h), w1, w1_shoup, p);
+                const __m512i a0 = _mm512_loadu_si512(x + j), a2 = _mm512_loadu_si512(x + j + 2 * h);
+                const __m512i b0 = reduce_once_avx512(_mm512_add_epi64(a0, v1), p);
+                const __m512i b1 = reduce_once_avx512(_mm512_sub_epi64(_mm512_add_epi64(a0, p), v1), p);
+                const __m512i b2 = reduce_once_avx512(_mm512_add_epi64(a2, v3), p);
+                const __m512i b3 = reduce_once_avx512(_mm512_sub_epi64(_mm512_add_epi64(a2, p), v3), p);
+                const __m512i u2 = shoup_mul_avx512(b2, _mm512_loadu_si512(pass.w2 + j), _mm512_loadu_si512(pass.w2_shoup + j), p);
+                const __m512i u3 = shoup_mul_avx512(b3, _mm512_loadu_si512(pass.w2 + j + h), _mm512_loadu_si512(pass.w2_shoup + j + h), p);
+                _mm512_storeu_si512(x + j, reduce_once_avx512(_mm512_add_epi64(b0, u2), p));
+                _mm512_storeu_si512(x + j + 2 * h, reduce_once_avx512(_mm512_sub_epi64(_mm512_add_epi64(b0, p), u2), p));
+                _mm512_storeu_si512(x + j + h, reduce_once_avx512(_mm512_add_epi64(b1, u3), p));
+                _mm512_storeu_si512(x + j + 3 * h, reduce_once_avx512(_mm512_sub_epi64(_mm512_add_epi64(b1, p), u3), p));
+            }
+            for (; j < end; ++j) {
+                ntt_quad_scalar(pass, x, j);
+            }
+            first += end - begin;
+        }
+    }
+
+    __attribute__((target("avx512f"))) void ntt_pointwise_avx512(uint64_t *c, const uint64_t *a, const uint64_t *b, const ntt_modulus &m, size_t first, size_t last) noexcept {
+        const __m512i p = _mm512_set1_epi64(static_cast<long long>(m.p));
+        const __m512i neg_inverse = _mm512_set1_epi64(static_cast<long long>(m.montgomery_neg_inverse));
+        const __m512i r2 = _mm512_set1_epi64(static_cast<long long>(m.montgomery_r2));
+        size_t i = first;
+        for (; i + 8 <= last; i += 8) {
+            const __m512i product = montgomery_mul_avx512(
+                    montgomery_mul_avx512(_mm512_loadu_si512(a + i), _mm512_loadu_si512(b + i), neg_inverse, p), r2, neg_inverse, p);
+            _mm512_storeu_si512(c + i, product);
+        }
+        ntt_pointwise_scalar(c, a, b, m, i, last);
+    }
+
+    __attribute__((target("avx512f"))) void ntt_scale_avx512(uint64_t *data, uint64_t factor, uint64_t factor_shoup, uint64_t p, size_t first, size_t last) noexcept {
+        const __m512i modulus = _mm512_set1_epi64(static_cast<long long>(p));
+        const __m512i w = _mm512_set1_epi64(static_cast<long long>(factor));
+        const __m512i w_shoup = _mm512_set1_epi64(static_cast<long long>(factor_shoup));
+        size_t i = first;
+        for (; i + 8 <= last; i += 8) {
+            _mm512_storeu_si512(data + i, shoup_mul_avx512(_mm512_loadu_si512(data + i), w, w_shoup, modulus));
+        }
+        ntt_scale_scalar(data, factor, factor_shoup, p, i, last);
+    }
+
+#endif
+
+    // Ядра быстрого NTT, выбранные один раз по возможностям процессора
+    struct ntt_kernels {
+        void (*pass)(const ntt_pass &, size_t, size_t) noexcept;
+        void (*pointwise)(uint64_t *, const uint64_t *, const uint64_t *, const ntt_modulus &, size_t, size_t) noexcept;
+        void (*scale)(uint64_t *, uint64_t, uint64_t, uint64_t, size_t, size_t) noexcept;
+    };
+
+    const ntt_kernels &select_ntt_kernels() noexcept {
+        static const ntt_kernels kernels = []() -> ntt_kernels {
+#ifdef BIG_INT_NTT_X86_SIMD
+            __builtin_cpu_init();
+            if (__builtin_cpu_supports("avx512f")) {
+                return {ntt_pass_avx512, ntt_pointwise_avx512, ntt_scale_avx512};
+            }
+            if (__builtin_cpu_supports("avx2")) {
+                return {ntt_pass_avx2, ntt_pointwise_avx2, ntt_scale_avx2};
+            }
+#endif
+            return {ntt_pass_scalar, ntt_pointwise_scalar, ntt_scale_scalar};
+        }();
+        return kernels;
+    }
+
+    // Этапы бабочек после битовой инверсии, модуль меньше NTT_FAST_MODULUS_LIMIT
+    void ntt_fast_stages(std::vector<uint64_t> &data, uint64_t p, uint64_t root, const ntt_kernels &kernels, work_stealing_pool *pool) {
+        const size_t n = data.size();
+        if (n < 2) {
+            return;
+        }
+
+        size_t len = 2;
+        if (std::countr_zero(n) % 2 != 0) {
+            // нечётное число этапов: первый этап с W_2 = 1 идёт отдельно
+            for (size_t i = 0; i < n; i += 2) {
+                const uint64_t u = data[i], v = data[i + 1];
+                data[i] = reduce_once(u + v, p);
+                data[i + 1] = reduce_once(u + p - v, p);
+            }
+            len = 4;
+        }
+        if (len > n) {
+            return;
+        }
+
+        const ntt_twiddles twiddles(n, root, p);
+        for (; 2 * len <= n; len *= 4) {
+            const ntt_pass pass{data.data(), len / 2,
+                                twiddles.stage(len), twiddles.stage_shoup(len),
+                                twiddles.stage(2 * len), twiddles.stage_shoup(2 * len), p};
+            auto quads = [&kernels, &pass](size_t first, size_t last) { kernels.pass(pass, first, last); };
+            if (pool != nullptr) {
+                pool->parallel_for(n / 4, PARALLEL_NTT_GRAIN, quads);
+            } else {
+                quads(0, n / 4);
+            }
+        }
+    }
+
+    // Две независимые части вычисления: на пуле параллельно, без пула одна за другой
+    template<typename F1, typename F2>
+    void run_both(work_stealing_pool *pool, F1 &&first, F2 &&second) {
+        if (pool != nullptr) {
+            pool->invoke(std::forward<F1>(first), std::forward<F2>(second));
+        } else {
+            first();
+            second();
+        }
+    }
+
     uint64_t get_m1_inv_m2() {
         // Вызываем статический метод класса big_int
         static const uint64_t val = big_int::ss_modInverse(SS_MOD1, SS_MOD2);
@@ -27,565 +474,2221 @@ namespace {
         static const uint64_t val = SS_MOD1 * SS_MOD2;
         return val;
     }
+
+    /*
+     * 64-битные ядра.
+     * Разряды хранятся по 32 бита, но внутренние циклы работают парами разрядов как с 64-битными словами:
+     * произведение 64x64 -> 128 и сложение с переносом берутся у __int128 (GCC/Clang) или у
+     * _umul128/_addcarry_u64 (MSVC), иначе используется переносимая реализация.
+     */
+
+    inline uint64_t mul_64(uint64_t a, uint64_t b, uint64_t &high) noexcept {
+#if defined(__SIZEOF_INT128__)
+        const unsigned __int128 product = static_cast<unsigned __int128>(a) * b;
+        high = static_cast<uint64_t>(product >> 64);
+        return static_cast<uint64_t>(product);
+#elif defined(_MSC_VER) && defined(_M_X64)
+        return _umul128(a, b, &high);
+#else
+        const uint64_t a_low = a & 0xFFFFFFFFu, a_high = a >> 32;
+        const uint64_t b_low = b & 0xFFFFFFFFu, b_high = b >> 32;
+        const uint64_t ll = a_low * b_low, lh = a_low * b_high, hl = a_high * b_low, hh = a_high * b_high;
+        const uint64_t mid = (ll >> 32) + (lh & 0xFFFFFFFFu) + (hl & 0xFFFFFFFFu);
+        high = hh + (lh >> 32) + (hl >> 32) + (mid >> 32);
+        return (mid << 32) | (ll & 0xFFFFFFFFu);
+#endif
+    }
+
+    inline uint64_t add_64(uint64_t a, uint64_t b, unsigned char &carry) noexcept {
+#if defined(_MSC_VER) && defined(_M_X64)
+        unsigned long long result;
+        carry = _addcarry_u64(carry, a, b, &result);
+        return result;
+#else
+        const uint64_t sum = a + b;
+        const uint64_t result = sum + carry;
+        carry = static_cast<unsigned char>((sum < a) | (result < sum));
+        return result;
+#endif
+    }
+
+    inline uint64_t sub_64(uint64_t a, uint64_t b, unsigned char &borrow) noexcept {
+#if defined(_MSC_VER) && defined(_M_X64)
+        unsigned long long result;
+        borrow = _subborrow_u64(borrow, a, b, &result);
+        return result;
+#else
+        const uint64_t diff = a - b;
+        const uint64_t result = diff - borrow;
+        borrow = static_cast<unsigned char>((a < b) | (diff < borrow));
+        return result;
+#endif
+    }
+
+    inline uint64_t load_pair(const unsigned int *p) noexcept {
+        return static_cast<uint64_t>(p[0]) | (static_cast<uint64_t>(p[1]) << 32);
+    }
+
+    inline void store_pair(unsigned int *p, uint64_t value) noexcept {
+        p[0] = static_cast<unsigned int>(value);
+        p[1] = static_cast<unsigned int>(value >> 32);
+    }
+
+    // r[0..n) = a[0..n) + b[0..n) + carry, возвращает перенос. r может совпадать с a или b
+    unsigned int add_n(unsigned int *r, const unsigned int *a, const unsigned int *b, size_t n, unsigned int carry = 0) noexcept {
+        unsigned char c = static_cast<unsigned char>(carry);
+        size_t i = 0;
+        for (; i + 1 < n; i += 2) {
+            store_pair(r + i, add_64(load_pair(a + i), load_pair(b + i), c));
+        }
+        if (i < n) {
+            const uint64_t sum = static_cast<uint64_t>(a[i]) + b[i] + c;
+            r[i] = static_cast<unsigned int>(sum);
+            c = static_cast<unsigned char>(sum >> 32);
+        }
+        return c;
+    }
+
+    // r[0..n) = a[0..n) + carry, возвращает перенос
+    unsigned int add_1(unsigned int *r, const unsigned int *a, size_t n, unsigned int carry) noexcept {
+        size_t i = 0;
+        for (; i < n && carry != 0; ++i) {
+            r[i] = a[i] + carry;
+            carry = r[i] < carry ? 1u : 0u;
+        }
+        if (r != a) {
+            std::copy(a + i, a + n, r + i);
+        }
+        return carry;
+    }
+
+    // r[0..n) = a[0..n) - b[0..n) - borrow, возвращает заём
+    unsigned int sub_n(unsigned int *r, const unsigned int *a, const unsigned int *b, size_t n, unsigned int borrow = 0) noexcept {
+        unsigned char c = static_cast<unsigned char>(borrow);
+        size_t i = 0;
+        for (; i + 1 < n; i += 2) {
+            store_pair(r + i, sub_64(load_pair(a + i), load_pair(b + i), c));
+        }
+        if (i < n) {
+            const uint64_t diff = static_cast<uint64_t>(a[i]) - b[i] - c;
+            r[i] = static_cast<unsigned int>(diff);
+            c = static_cast<unsigned char>((diff >> 32) != 0);
+        }
+        return c;
+    }
+
+    // r[0..n) = a[0..n) - borrow, возвращает заём
+    unsigned int sub_1(unsigned int *r, const unsigned int *a, size_t n, unsigned int borrow) noexcept {
+        size_t i = 0;
+        for (; i < n && borrow != 0; ++i) {
+            const unsigned int digit = a[i];
+            r[i] = digit - borrow;
+            borrow = digit < borrow ? 1u : 0u;
+        }
+        if (r != a) {
+            std::copy(a + i, a + n, r + i);
+        }
+        return borrow;
+    }
+
+    // Упаковка пар 32-битных разрядов в (n + 1) / 2 64-битных слов
+    void pack_words(uint64_t *words, const unsigned int *digits, size_t n) noexcept {
+        for (size_t i = 0; i + 1 < n; i += 2) {
+            words[i / 2] = load_pair(digits + i);
+        }
+        if (n % 2 != 0) {
+            words[n / 2] = digits[n - 1];
+        }
+    }
+
+    template<class vector_type>
+    void unpack_words(const uint64_t *words, size_t count, vector_type &digits) {
+        digits.resize(count * 2);
+        for (size_t i = 0; i < count; ++i) {
+            store_pair(digits.data() + 2 * i, words[i]);
+        }
+    }
+
+    // Школьное умножение 64-битных слов: r[0..na + nb) = a * b, r не пересекается с a и b
+    void mul_words(uint64_t *r, const uint64_t *a, size_t na, const uint64_t *b, size_t nb) noexcept {
+        std::fill(r, r + na + nb, 0);
+        for (size_t i = 0; i < na; ++i) {
+            const uint64_t ai = a[i];
+            if (ai == 0) {
+                continue;
+            }
+            uint64_t carry = 0;
+            for (size_t j = 0; j < nb; ++j) {
+                uint64_t high;
+                uint64_t low = mul_64(ai, b[j], high);
+                unsigned char c = 0;
+                low = add_64(low, r[i + j], c);
+                high += c;
+                c = 0;
+                low = add_64(low, carry, c);
+                high += c;
+                r[i + j] = low;
+                carry = high;
+            }
+            r[i + nb] = carry;
+        }
+    }
+
+    // Школьное возведение в квадрат: r[0..2n) = a * a. Каждое произведение a[i] * a[j], i != j,
+    // считается один раз и удваивается сдвигом, после чего добавляются квадраты a[i] * a[i]
+    void sqr_words(uint64_t *r, const uint64_t *a, size_t n) noexcept {
+        std::fill(r, r + 2 * n, 0);
+        for (size_t i = 0; i + 1 < n; ++i) {
+            const uint64_t ai = a[i];
+            if (ai == 0) {
+                continue;
+            }
+            uint64_t carry = 0;
+            for (size_t j = i + 1; j < n; ++j) {
+                uint64_t high;
+                uint64_t low = mul_64(ai, a[j], high);
+                unsigned char c = 0;
+                low = add_64(low, r[i + j], c);
+                high += c;
+                c = 0;
+                low = add_64(low, carry, c);
+                high += c;
+                r[i + j] = low;
+                carry = high;
+            }
+            r[i + n] = carry;
+        }
+
+        uint64_t top = 0;
+        for (size_t i = 0; i < 2 * n; ++i) {
+            const uint64_t word = r[i];
+            r[i] = (word << 1) | top;
+            top = word >> 63;
+        }
+
+        unsigned char carry = 0;
+        for (size_t i = 0; i < n; ++i) {
+            uint64_t high;
+            const uint64_t low = mul_64(a[i], a[i], high);
+            r[2 * i] = add_64(r[2 * i], low, carry);
+            r[2 * i + 1] = add_64(r[2 * i + 1], high, carry);
+        }
+    }
+
+    // Редукция Монтгомери: t[0..2n] (t[2n] - слово переноса) заменяется на t * 2^(-64n) mod m,
+    // результат кладётся в r[0..n). inverse = -m^(-1) mod 2^64, t < m * 2^(64n)
+    void redc_words(uint64_t *r, uint64_t *t, const uint64_t *m, size_t n, uint64_t inverse) noexcept {
+        for (size_t i = 0; i < n; ++i) {
+            const uint64_t u = t[i] * inverse;
+            uint64_t carry = 0;
+            for (size_t j = 0; j < n; ++j) {
+                uint64_t high;
+                uint64_t low = mul_64(u, m[j], high);
+                unsigned char c = 0;
+                low = add_64(low, t[i + j], c);
+                high += c;
+                c = 0;
+                low = add_64(low, carry, c);
+                high += c;
+                t[i + j] = low;
+                carry = high;
+            }
+            for (size_t j = i + n; carry != 0 && j <= 2 * n; ++j) {
+                unsigned char c = 0;
+                t[j] = add_64(t[j], carry, c);
+                carry = c;
+            }
+        }
+
+        // Здесь t[n..2n] < 2m: достаточно одного вычитания
+        bool reduce = t[2 * n] != 0;
+        if (!reduce) {
+            reduce = true;
+            for (size_t i = n; i-- > 0;) {
+                if (t[n + i] != m[i]) {
+                    reduce = t[n + i] > m[i];
+                    break;
+                }
+            }
+        }
+        if (reduce) {
+            unsigned char borrow = 0;
+            for (size_t i = 0; i < n; ++i) {
+                r[i] = sub_64(t[n + i], m[i], borrow);
+            }
+        } else {
+            std::copy(t + n, t + 2 * n, r);
+        }
+    }
+
+    // Число значащих бит в digits[0..n), старший разряд ненулевой
+    size_t bit_length_of(const unsigned int *digits, size_t n) noexcept {
+        return n == 0 ? 0 : (n - 1) * std::numeric_limits<unsigned int>::digits + std::bit_width(digits[n - 1]);
+    }
+
+    // НОД чисел, помещающихся в 64 бита: бинарный алгоритм без делений
+    uint64_t binary_gcd(uint64_t a, uint64_t b) noexcept {
+        if (a == 0 || b == 0) {
+            return a | b;
+        }
+        const int shift = std::countr_zero(a | b);
+        a >>= std::countr_zero(a);
+        do {
+            b >>= std::countr_zero(b);
+            if (a > b) {
+                std::swap(a, b);
+            }
+            b -= a;
+        } while (b != 0);
+        return a << shift;
+    }
+
+    // 64 бита digits[0..n) начиная с бита shift (разряды за пределами числа считаются нулями)
+    uint64_t bits_at(const unsigned int *digits, size_t n, size_t shift) noexcept {
+        const size_t index = shift / 32;
+        const auto offset = static_cast<unsigned int>(shift % 32);
+        auto digit = [=](size_t i) -> uint64_t { return i < n ? digits[i] : 0; };
+        const uint64_t low = digit(index) | (digit(index + 1) << 32);
+        return offset == 0 ? low : (low >> offset) | (digit(index + 2) << (64 - offset));
+    }
+
+    // Матрица шага Лемера: (x, y) -> (a * x + b * y, c * x + d * y). b == 0 - шаг сделать не удалось
+    struct lehmer_matrix
+    {
+        int64_t a, b, c, d;
+    };
+
+    // Частные алгоритма Евклида, общие для всех чисел с ведущими битами x и y (Кнут, алгоритм L).
+    // x, y < 2^62, поэтому коэффициенты и суммы помещаются в int64_t
+    lehmer_matrix lehmer_quotients(int64_t x, int64_t y) noexcept {
+        lehmer_matrix m{1, 0, 0, 1};
+        while (y + m.c > 0 && y + m.d > 0) {
+            const int64_t q = (x + m.a) / (y + m.c);
+            if (q != (x + m.b) / (y + m.d)) {
+                break;
+            }
+            m = {m.c, m.d, m.a - q * m.c, m.b - q * m.d};
+            const int64_t t = x - q * y;
+            x = y;
+            y = t;
+        }
+        return m;
+    }
+
+    // (x, y) = (a * x + b * y, c * x + d * y) на месте, оба числа занимают n разрядов. Коэффициенты каждой
+    // строки разных знаков, результаты неотрицательны, поэтому считается |p| * u - |q| * v с заёмом
+    void lehmer_update(unsigned int *x, unsigned int *y, size_t n, const lehmer_matrix &m) noexcept {
+        const uint64_t ma = m.a < 0 ? 0 - uint64_t(m.a) : uint64_t(m.a), mb = m.b < 0 ? 0 - uint64_t(m.b) : uint64_t(m.b);
+        const uint64_t mc = m.c < 0 ? 0 - uint64_t(m.c) : uint64_t(m.c), md = m.d < 0 ? 0 - uint64_t(m.d) : uint64_t(m.d);
+
+        // Очередной разряд произведения digit * factor с переносом из предыдущих разрядов
+        auto product_digit = [](uint64_t digit, uint64_t factor, uint64_t &carry) {
+            uint64_t high;
+            uint64_t low = mul_64(digit, factor, high);
+            unsigned char c = 0;
+            low = add_64(low, carry, c);
+            high += c;
+            carry = (low >> 32) | (high << 32);
+            return static_cast<uint64_t>(static_cast<unsigned int>(low));
+        };
+
+        uint64_t carry_a = 0, carry_b = 0, carry_c = 0, carry_d = 0;
+        uint64_t borrow_x = 0, borrow_y = 0;
+        for (size_t i = 0; i < n; ++i) {
+            const uint64_t ax = product_digit(x[i], ma, carry_a), by = product_digit(y[i], mb, carry_b);
+            const uint64_t cx = product_digit(x[i], mc, carry_c), dy = product_digit(y[i], md, carry_d);
+
+            const uint64_t new_x = m.b <= 0 ? ax - by - borrow_x : by - ax - borrow_x;
+            const uint64_t new_y = m.d <= 0 ? cx - dy - borrow_y : dy - cx - borrow_y;
+            x[i] = static_cast<unsigned int>(new_x);
+            y[i] = static_cast<unsigned int>(new_y);
+            borrow_x = new_x >> 63;
+            borrow_y = new_y >> 63;
+        }
+    }
+
+    // Точное деление по Йебелеану: q[0..qn) = a / d, если a делится на d нацело, d[0] нечётен,
+    // inverse = d[0]^(-1) mod 2^32. Разряды частного находятся снизу вверх, a[0..qn) портится,
+    // старшие разряды a не нужны вовсе
+    void divexact_n(unsigned int *q, unsigned int *a, size_t qn, const unsigned int *d, size_t m, unsigned int inverse) noexcept {
+        for (size_t i = 0; i < qn; ++i) {
+            const unsigned int digit = a[i] * inverse;
+            q[i] = digit;
+
+            const size_t length = std::min(m, qn - i);
+            uint64_t borrow = 0;
+            for (size_t j = 0; j < length; ++j) {
+                const uint64_t product = static_cast<uint64_t>(digit) * d[j] + borrow;
+                const auto low = static_cast<unsigned int>(product);
+                borrow = (product >> 32) + (a[i + j] < low ? 1 : 0);
+                a[i + j] -= low;
+            }
+            for (size_t j = i + length; borrow != 0 && j < qn; ++j) {
+                const auto value = static_cast<unsigned int>(borrow);
+                borrow = a[j] < value ? 1 : 0;
+                a[j] -= value;
+            }
+        }
+    }
+
+    // Длина окна для возведения в степень со скользящим окном по числу бит показателя
+    size_t pow_window(size_t bits) noexcept {
+        size_t window = 1;
+        for (const size_t bound: {7, 24, 80, 240, 672}) {
+            if (bits > bound) {
+                ++window;
+            }
+        }
+        return window;
+    }
+
+    // Возведение в степень со скользящим окном слева направо. bit(i) - i-й бит показателя, старший бит
+    // (bits - 1) равен единице. square(x) и multiply(x, y) работают на месте: x = x * x, x = x * y
+    template<class value_type, class bit_function, class square_function, class multiply_function>
+    value_type sliding_window_pow(const value_type &base, size_t bits, bit_function bit,
+                                  square_function square, multiply_function multiply) {
+        const size_t window = pow_window(bits);
+
+        // Нечётные степени base^1, base^3, ..., base^(2^window - 1)
+        const size_t count = size_t(1) << (window - 1);
+        std::vector<value_type> odd_powers;
+        odd_powers.reserve(count);
+        odd_powers.push_back(base);
+        if (window > 1) {
+            value_type base_square = base;
+            square(base_square);
+            while (odd_powers.size() < count) {
+                value_type next = odd_powers.back();
+                multiply(next, base_square);
+                odd_powers.push_back(std::move(next));
+            }
+        }
+
+        value_type result = base;
+        bool started = false;
+        size_t i = bits;
+        while (i > 0) {
+            if (!bit(i - 1)) {
+                square(result);
+                --i;
+                continue;
+            }
+
+            // Самое длинное окно [low, i) не длиннее window, которое заканчивается единицей
+            size_t low = i > window ? i - window : 0;
+            while (!bit(low)) {
+                ++low;
+            }
+            size_t value = 0;
+            for (size_t j = i; j-- > low;) {
+                value = (value << 1) | (bit(j) ? 1 : 0);
+            }
+
+            if (started) {
+                for (size_t j = low; j < i; ++j) {
+                    square(result);
+                }
+                multiply(result, odd_powers[value / 2]);
+            } else {
+                result = odd_powers[value / 2];
+                started = true;
+            }
+            i = low;
+        }
+        return result;
+    }
+
+    // r[0..n] = a[0..n) << shift, 0 < shift < 32. Идёт сверху вниз, поэтому допускается r >= a
+    void lshift_n_scalar(unsigned int *r, const unsigned int *a, size_t n, unsigned int shift) noexcept {
+        constexpr unsigned int bits = std::numeric_limits<unsigned int>::digits;
+        r[n] = a[n - 1] >> (bits - shift);
+        size_t i = n - 1;
+        for (; i >= 2; i -= 2) {
+            // окно из трёх разрядов a[i-2..i] даёт два разряда результата за один 64-битный сдвиг
+            const uint64_t window = load_pair(a + i - 1);
+            store_pair(r + i - 1, (window << shift) | (a[i - 2] >> (bits - shift)));
+        }
+        if (i == 1) {
+            r[1] = (a[1] << shift) | (a[0] >> (bits - shift));
+        }
+        r[0] = a[0] << shift;
+    }
+
+    // r[0..n) = a[0..n) >> shift, 0 < shift < 32. Идёт снизу вверх, поэтому допускается r <= a
+    void rshift_n_scalar(unsigned int *r, const unsigned int *a, size_t n, unsigned int shift) noexcept {
+        constexpr unsigned int bits = std::numeric_limits<unsigned int>::digits;
+        size_t i = 0;
+        for (; i + 2 < n; i += 2) {
+            const uint64_t window = load_pair(a + i);
+            store_pair(r + i, (window >> shift) | (static_cast<uint64_t>(a[i + 2]) << (2 * bits - shift)));
+        }
+        for (; i + 1 < n; ++i) {
+            r[i] = (a[i] >> shift) | (a[i + 1] << (bits - shift));
+        }
+        r[n - 1] = a[n - 1] >> shift;
+    }
+
+    /*
+     * Поразрядные операции и сдвиги длинных массивов разрядов.
+     * На x86-64 базовый вариант - SSE2 (есть всегда), AVX2 выбирается во время выполнения;
+     * на остальных платформах работают переносимые циклы по 64-битным парам
+     */
+
+    struct limb_and {
+        template<typename T>
+        static T apply(T a, T b) noexcept { return a & b; }
+    };
+
+    struct limb_or {
+        template<typename T>
+        static T apply(T a, T b) noexcept { return a | b; }
+    };
+
+    struct limb_xor {
+        template<typename T>
+        static T apply(T a, T b) noexcept { return a ^ b; }
+    };
+
+    size_t popcount_n_scalar(const unsigned int *a, size_t n) noexcept {
+        size_t count = 0;
+        size_t i = 0;
+        for (; i + 1 < n; i += 2) {
+            count += static_cast<size_t>(std::popcount(load_pair(a + i)));
+        }
+        if (i < n) {
+            count += static_cast<size_t>(std::popcount(a[i]));
+        }
+        return count;
+    }
+
+#if defined(__GNUC__) && defined(__x86_64__)
+#define BIG_INT_LIMB_X86_SIMD
+
+    // Векторы GCC поддерживают &, |, ^ и ~, поэтому limb_and и другие подходят и для __m128i.
+    // Функция с 256-битным значением должна сама иметь target("avx2"), для AVX2 операция выбирается в apply_avx2
+
+    template<typename operation>
+    void bitwise_n_sse2(unsigned int *r, const unsigned int *a, const unsigned int *b, size_t n) noexcept {
+        size_t i = 0;
+        for (; i + 4 <= n; i += 4) {
+            const __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i *>(a + i));
+            const __m128i y = _mm_loadu_si128(reinterpret_cast<const __m128i *>(b + i));
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(r + i), operation::apply(x, y));
+        }
+        for (; i < n; ++i) {
+            r[i] = operation::apply(a[i], b[i]);
+        }
+    }
+
+    void not_n_sse2(unsigned int *r, const unsigned int *a, size_t n) noexcept {
+        size_t i = 0;
+        for (; i + 4 <= n; i += 4) {
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(r + i), ~_mm_loadu_si128(reinterpret_cast<const __m128i *>(a + i)));
+        }
+        for (; i < n; ++i) {
+            r[i] = ~a[i];
+        }
+    }
+
+    // Сдвиг блока из четырёх разрядов собирается из двух невыровненных загрузок со смещением на один разряд
+    void lshift_n_sse2(unsigned int *r, const unsigned int *a, size_t n, unsigned int shift) noexcept {
+        constexpr unsigned int bits = std::numeric_limits<unsigned int>::digits;
+        const __m128i left = _mm_cvtsi32_si128(static_cast<int>(shift));
+        const __m128i right = _mm_cvtsi32_si128(static_cast<int>(bits - shift));
+        r[n] = a[n - 1] >> (bits - shift);
+        size_t i = n;
+        while (i >= 5) {
+            i -= 4;
+            const __m128i high = _mm_loadu_si128(reinterpret_cast<const __m128i *>(a + i));
+            const __m128i low = _mm_loadu_si128(reinterpret_cast<const __m128i *>(a + i - 1));
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(r + i), _mm_or_si128(_mm_sll_epi32(high, left), _mm_srl_epi32(low, right)));
+        }
+        for (; i-- > 1;) {
+            r[i] = (a[i] << shift) | (a[i - 1] >> (bits - shift));
+        }
+        r[0] = a[0] << shift;
+    }
+
+    void rshift_n_sse2(unsigned int *r, const unsigned int *a, size_t n, unsigned int shift) noexcept {
+        constexpr unsigned int bits = std::numeric_limits<unsigned int>::digits;
+        const __m128i right = _mm_cvtsi32_si128(static_cast<int>(shift));
+        const __m128i left = _mm_cvtsi32_si128(static_cast<int>(bits - shift));
+        size_t i = 0;
+        for (; i + 5 <= n; i += 4) {
+            const __m128i low = _mm_loadu_si128(reinterpret_cast<const __m128i *>(a + i));
+            const __m128i high = _mm_loadu_si128(reinterpret_cast<const __m128i *>(a + i + 1));
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(r + i), _mm_or_si128(_mm_srl_epi32(low, right), _mm_sll_epi32(high, left)));
+        }
+        for (; i + 1 < n; ++i) {
+            r[i] = (a[i] >> shift) | (a[i + 1] << (bits - shift));
+        }
+        r[n - 1] = a[n - 1] >> shift;
+    }
+
+    template<typename operation>
+    __attribute__((target("avx2"))) inline __m256i apply_avx2(__m256i x, __m256i y) noexcept {
+        if constexpr (std::is_same_v<operation, limb_and>) {
+            return _mm256_and_si256(x, y);
+        } else if constexpr (std::is_same_v<operation, limb_or>) {
+            return _mm256_or_si256(x, y);
+        } else {
+            return _mm256_xor_si256(x, y);
+        }
+    }
+
+    template<typename operation>
+    __attribute__((target("avx2"))) void bitwise_n_avx2(unsigned int *r, const unsigned int *a, const unsigned int *b, size_t n) noexcept {
+        size_t i = 0;
+        for (; i + 8 <= n; i += 8) {
+            const __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(a + i));
+            const __m256i y = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(b + i));
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(r + i), apply_avx2<operation>(x, y));
+        }
+        for (; i < n; ++i) {
+            r[i] = operation::apply(a[i], b[i]);
+        }
+    }
+
+    __attribute__((target("avx2"))) void not_n_avx2(unsigned int *r, const unsigned int *a, size_t n) noexcept {
+        size_t i = 0;
+        for (; i + 8 <= n; i += 8) {
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(r + i), ~_mm256_loadu_si256(reinterpret_cast<const __m256i *>(a + i)));
+        }
+        for (; i < n; ++i) {
+            r[i] = ~a[i];
+        }
+    }
+
+    __attribute__((target("avx2"))) void lshift_n_avx2(unsigned int *r, const unsigned int *a, size_t n, unsigned int shift) noexcept {
+        constexpr unsigned int bits = std::numeric_limits<unsigned int>::digits;
+        const __m128i left = _mm_cvtsi32_si128(static_cast<int>(shift));
+        const __m128i right = _mm_cvtsi32_si128(static_cast<int>(bits - shift));
+        r[n] = a[n - 1] >> (bits - shift);
+        size_t i = n;
+        while (i >= 9) {
+            i -= 8;
+            const __m256i high = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(a + i));
+            const __m256i low = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(a + i - 1));
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(r + i), _mm256_or_si256(_mm256_sll_epi32(high, left), _mm256_srl_epi32(low, right)));
+        }
+        for (; i-- > 1;) {
+            r[i] = (a[i] << shift) | (a[i - 1] >> (bits - shift));
+        }
+        r[0] = a[0] << shift;
+    }
+
+    __attribute__((target("avx2"))) void rshift_n_avx2(unsigned int *r, const unsigned int *a, size_t n, unsigned int shift) noexcept {
+        constexpr unsigned int bits = std::numeric_limits<unsigned int>::digits;
+        const __m128i right = _mm_cvtsi32_si128(static_cast<int>(shift));
+        const __m128i left = _mm_cvtsi32_si128(static_cast<int>(bits - shift));
+        size_t i = 0;
+        for (; i + 9 <= n; i += 8) {
+            const __m256i low = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(a + i));
+            const __m256i high = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(a + i + 1));
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(r + i), _mm256_or_si256(_mm256_srl_epi32(low, right), _mm256_sll_epi32(high, left)));
+        }
+        for (; i + 1 < n; ++i) {
+            r[i] = (a[i] >> shift) | (a[i + 1] << (bits - shift));
+        }
+        r[n - 1] = a[n - 1] >> shift;
+    }
+
+    // Тот же цикл, что и в переносимом варианте, но std::popcount компилируется в инструкцию popcnt
+    __attribute__((target("popcnt"))) size_t popcount_n_popcnt(const unsigned int *a, size_t n) noexcept {
+        size_t count = 0;
+        size_t i = 0;
+        for (; i + 1 < n; i += 2) {
+            count += static_cast<size_t>(std::popcount(load_pair(a + i)));
+        }
+        if (i < n) {
+            count += static_cast<size_t>(std::popcount(a[i]));
+        }
+        return count;
+    }
+
+#else
+
+    // r[0..n) = a[0..n) op b[0..n), r может совпадать с a или b
+    template<typename operation>
+    void bitwise_n_scalar(unsigned int *r, const unsigned int *a, const unsigned int *b, size_t n) noexcept {
+        size_t i = 0;
+        for (; i + 1 < n; i += 2) {
+            store_pair(r + i, operation::apply(load_pair(a + i), load_pair(b + i)));
+        }
+        if (i < n) {
+            r[i] = operation::apply(a[i], b[i]);
+        }
+    }
+
+    // r[0..n) = ~a[0..n)
+    void not_n_scalar(unsigned int *r, const unsigned int *a, size_t n) noexcept {
+        size_t i = 0;
+        for (; i + 1 < n; i += 2) {
+            store_pair(r + i, ~load_pair(a + i));
+        }
+        if (i < n) {
+            r[i] = ~a[i];
+        }
+    }
+
+#endif
+
+    struct limb_kernels {
+        void (*and_n)(unsigned int *, const unsigned int *, const unsigned int *, size_t) noexcept;
+        void (*or_n)(unsigned int *, const unsigned int *, const unsigned int *, size_t) noexcept;
+        void (*xor_n)(unsigned int *, const unsigned int *, const unsigned int *, size_t) noexcept;
+        void (*not_n)(unsigned int *, const unsigned int *, size_t) noexcept;
+        void (*lshift_n)(unsigned int *, const unsigned int *, size_t, unsigned int) noexcept;
+        void (*rshift_n)(unsigned int *, const unsigned int *, size_t, unsigned int) noexcept;
+        size_t (*popcount_n)(const unsigned int *, size_t) noexcept;
+    };
+
+    const limb_kernels &select_limb_kernels() noexcept {
+        static const limb_kernels kernels = []() -> limb_kernels {
+#ifdef BIG_INT_LIMB_X86_SIMD
+            __builtin_cpu_init();
+            const auto popcount = __builtin_cpu_supports("popcnt") ? popcount_n_popcnt : popcount_n_scalar;
+            if (__builtin_cpu_supports("avx2")) {
+                return {bitwise_n_avx2<limb_and>, bitwise_n_avx2<limb_or>, bitwise_n_avx2<limb_xor>, not_n_avx2,
+                        lshift_n_avx2, rshift_n_avx2, popcount};
+            }
+            return {bitwise_n_sse2<limb_and>, bitwise_n_sse2<limb_or>, bitwise_n_sse2<limb_xor>, not_n_sse2,
+                    lshift_n_sse2, rshift_n_sse2, popcount};
+#else
+            return {bitwise_n_scalar<limb_and>, bitwise_n_scalar<limb_or>, bitwise_n_scalar<limb_xor>, not_n_scalar,
+                    lshift_n_scalar, rshift_n_scalar, popcount_n_scalar};
+#endif
+        }();
+        return kernels;
+    }
+
+    // Короткие сдвиги (нормализация в делении и т. п.) не стоят косвенного вызова
+    constexpr size_t LIMB_SIMD_THRESHOLD = 16;
+
+    void lshift_n(unsigned int *r, const unsigned int *a, size_t n, unsigned int shift) noexcept {
+        if (n < LIMB_SIMD_THRESHOLD) {
+            lshift_n_scalar(r, a, n, shift);
+        } else {
+            select_limb_kernels().lshift_n(r, a, n, shift);
+        }
+    }
+
+    void rshift_n(unsigned int *r, const unsigned int *a, size_t n, unsigned int shift) noexcept {
+        if (n < LIMB_SIMD_THRESHOLD) {
+            rshift_n_scalar(r, a, n, shift);
+        } else {
+            select_limb_kernels().rshift_n(r, a, n, shift);
+        }
+    }
+
+    // r[0..n) = a[0..n) + (b[0..n) << shift) mod B^n, 0 < shift < 32. Возвращает то, что надо прибавить к r[n]:
+    // выдвинутые биты b[n - 1] и перенос. Разряд b читается до записи r, поэтому r может совпадать с a и b
+    unsigned int add_lsh_n(unsigned int *r, const unsigned int *a, const unsigned int *b, size_t n, unsigned int shift) noexcept {
+        constexpr unsigned int bits = std::numeric_limits<unsigned int>::digits;
+        unsigned int previous = 0;
+        unsigned int carry = 0;
+        for (size_t i = 0; i < n; ++i) {
+            const unsigned int current = b[i];
+            const uint64_t sum = static_cast<uint64_t>(a[i]) + ((current << shift) | (previous >> (bits - shift))) + carry;
+            r[i] = static_cast<unsigned int>(sum);
+            carry = static_cast<unsigned int>(sum >> 32);
+            previous = current;
+        }
+        return (previous >> (bits - shift)) + carry;
+    }
+
+    // r[0..n) = a[0..n) - (b[0..n) << shift) mod B^n, 0 < shift < 32. Возвращает то, что надо вычесть из r[n]
+    unsigned int sub_lsh_n(unsigned int *r, const unsigned int *a, const unsigned int *b, size_t n, unsigned int shift) noexcept {
+        constexpr unsigned int bits = std::numeric_limits<unsigned int>::digits;
+        unsigned int previous = 0;
+        unsigned int borrow = 0;
+        for (size_t i = 0; i < n; ++i) {
+            const unsigned int current = b[i];
+            const uint64_t diff = static_cast<uint64_t>(a[i]) - ((current << shift) | (previous >> (bits - shift))) - borrow;
+            r[i] = static_cast<unsigned int>(diff);
+            borrow = static_cast<unsigned int>(diff >> 32) & 1u;
+            previous = current;
+        }
+        return (previous >> (bits - shift)) + borrow;
+    }
+
+    // Сравнение |a[0..na)| и |b[0..nb)| * 2^shift, старшие разряды ненулевые
+    std::strong_ordering compare_shifted(const unsigned int *a, size_t na, const unsigned int *b, size_t nb, size_t shift) noexcept {
+        constexpr size_t bits = std::numeric_limits<unsigned int>::digits;
+        const size_t a_bits = na == 0 ? 0 : (na - 1) * bits + std::bit_width(a[na - 1]);
+        const size_t b_bits = nb == 0 ? 0 : (nb - 1) * bits + std::bit_width(b[nb - 1]) + shift;
+        if (a_bits != b_bits || a_bits == 0) {
+            return a_bits <=> b_bits;
+        }
+
+        // Одинаковая длина: идём сверху по разрядам сдвинутого b, собирая каждый из двух соседних
+        const size_t limb_shift = shift / bits;
+        const auto bit_shift = static_cast<unsigned int>(shift % bits);
+        for (size_t i = na; i-- > limb_shift;) {
+            const size_t j = i - limb_shift;
+            unsigned int digit = j < nb ? b[j] << bit_shift : 0;
+            if (bit_shift != 0 && j > 0 && j - 1 < nb) {
+                digit |= b[j - 1] >> (bits - bit_shift);
+            }
+            if (a[i] != digit) {
+                return a[i] <=> digit;
+            }
+        }
+        for (size_t i = limb_shift; i-- > 0;) {
+            if (a[i] != 0) {
+                return std::strong_ordering::greater;
+            }
+        }
+        return std::strong_ordering::equal;
+    }
+
+    // q[0..n) = a[0..n) / d, возвращает остаток. q может совпадать с a
+    unsigned int divrem_1(unsigned int *q, const unsigned int *a, size_t n, unsigned int d) noexcept {
+        uint64_t remainder = 0;
+        for (size_t i = n; i-- > 0;) {
+            const uint64_t current = (remainder << 32) | a[i];
+            q[i] = static_cast<unsigned int>(current / d);
+            remainder = current % d;
+        }
+        return static_cast<unsigned int>(remainder);
+    }
+
+    // r[0..n) = r[0..n) * m + add, возвращает старший разряд
+    unsigned int mul_add_1(unsigned int *r, size_t n, unsigned int m, unsigned int add) noexcept {
+        uint64_t carry = add;
+        for (size_t i = 0; i < n; ++i) {
+            const uint64_t current = static_cast<uint64_t>(r[i]) * m + carry;
+            r[i] = static_cast<unsigned int>(current);
+            carry = current >> 32;
+        }
+        return static_cast<unsigned int>(carry);
+    }
+
+    /*
+     * Деление Кнута (алгоритм D): q[0..n - m] = a / b, r[0..m) = a % b.
+     * n >= m >= 2, старший разряд b ненулевой
+     */
+    void divrem_knuth(unsigned int *q, unsigned int *r, const unsigned int *a, size_t n, const unsigned int *b, size_t m) {
+        constexpr uint64_t base = uint64_t(1) << 32;
+        const auto shift = static_cast<unsigned int>(__detail::countl_zero_uint_impl(b[m - 1]));
+
+        // Нормализуем делитель, чтобы старший бит его старшего разряда был единицей
+        std::vector<unsigned int> bn(m + 1), an(n + 1);
+        if (shift != 0) {
+            lshift_n(bn.data(), b, m, shift);
+            lshift_n(an.data(), a, n, shift);
+        } else {
+            std::copy(b, b + m, bn.begin());
+            std::copy(a, a + n, an.begin());
+        }
+
+        const uint64_t top = bn[m - 1], second = bn[m - 2];
+        for (size_t j = n - m + 1; j-- > 0;) {
+            // Оценка цифры частного по двум старшим разрядам, ошибается не больше чем на 2
+            const uint64_t numerator = (static_cast<uint64_t>(an[j + m]) << 32) | an[j + m - 1];
+            uint64_t q_hat = numerator / top;
+            uint64_t r_hat = numerator % top;
+            while (q_hat >= base || q_hat * second > ((r_hat << 32) | an[j + m - 2])) {
+                --q_hat;
+                r_hat += top;
+                if (r_hat >= base) {
+                    break;
+                }
+            }
+
+            // an[j..j + m] -= q_hat * bn
+            int64_t k = 0, t;
+            for (size_t i = 0; i < m; ++i) {
+                const uint64_t p = q_hat * bn[i];
+                t = static_cast<int64_t>(an[i + j]) - k - static_cast<int64_t>(p & 0xFFFFFFFFu);
+                an[i + j] = static_cast<unsigned int>(t);
+                k = static_cast<int64_t>(p >> 32) - (t >> 32);
+            }
+            t = static_cast<int64_t>(an[j + m]) - k;
+            an[j + m] = static_cast<unsigned int>(t);
+
+            // Оценка оказалась на единицу больше - возвращаем делитель обратно
+            if (t < 0) {
+                --q_hat;
+                an[j + m] += add_n(an.data() + j, an.data() + j, bn.data(), m);
+            }
+            q[j] = static_cast<unsigned int>(q_hat);
+        }
+
+        if (shift != 0) {
+            rshift_n(r, an.data(), m, shift);
+        } else {
+            std::copy(an.begin(), an.begin() + m, r);
+        }
+    }
+
+    // Самая большая степень radix, помещающаяся в один разряд, и число цифр в ней
+    unsigned int radix_chunk(unsigned int radix, size_t &digits) noexcept {
+        uint64_t chunk = radix;
+        digits = 1;
+        while (chunk * radix <= std::numeric_limits<unsigned int>::max()) {
+            chunk *= radix;
+            ++digits;
+        }
+        return static_cast<unsigned int>(chunk);
+    }
+
+    /*
+     * Кэш степеней radix^(digits * 2^level), где radix^digits - radix_chunk.
+     * Заполняется возведением в квадрат один раз на поток и переиспользуется всеми переводами
+     */
+    const big_int &radix_power(unsigned int radix, size_t level) {
+        thread_local std::vector<big_int> cache[37];
+        std::vector<big_int> &powers = cache[radix];
+
+        if (powers.empty()) {
+            size_t digits;
+            powers.emplace_back(radix_chunk(radix, digits));
+        }
+        while (powers.size() <= level) {
+            powers.push_back(powers.back() * powers.back());
+        }
+        return powers[level];
+    }
 }
 
 
 std::strong_ordering big_int::modulo_comparison(const big_int &left, const big_int &right, size_t shift) noexcept {
 
-    size_t effective_right_size = right._digits.size() + shift;
-    size_t left_size = left._digits.size();
+    size_t effective_right_size = right._digits.size() + shift;
+    size_t left_size = left._digits.size();
+
+    // Сначала сравним длины чисел.
+    if (left_size < effective_right_size) {
+        return std::strong_ordering::less;
+    }
+    if (left_size > effective_right_size) {
+        return std::strong_ordering::greater;
+    }
+
+    // Если длины совпадают, сравниваем цифры по порядку, начиная с самого старшего разряда.
+    // Индекс i пробегает от left_size-1 до 0.
+    for (size_t i = left_size; i-- > 0;) {
+        unsigned int left_digit = left._digits[i];
+        // Для right, если i находится в области смещения, т.е. i < shift, то соответствующая цифра равна 0.
+        // Иначе индекс в right равен (i - shift).
+        unsigned int right_digit = (i < shift || (i - shift) >= right._digits.size()) ? 0 : right._digits[i - shift];
+        if (left_digit < right_digit) {
+            return std::strong_ordering::less;
+        }
+        if (left_digit > right_digit) {
+            return std::strong_ordering::greater;
+        }
+    }
+
+    // Если все разряды совпадают, числа равны.
+    return std::strong_ordering::equal;
+}
+
+std::strong_ordering big_int::compare_with_sign(const big_int &left, const big_int &right, size_t shift) noexcept {
+    if (left._sign != right._sign) {
+        // Если знаки разные, то положительное число больше отрицательного
+        return left._sign ? std::strong_ordering::greater : std::strong_ordering::less;
+    }
+    if (left._sign == 0 && right._sign == 0) {
+        auto result = modulo_comparison(left, right, shift);
+        if (result == std::strong_ordering::less) return std::strong_ordering::greater;
+        if (result == std::strong_ordering::greater) return std::strong_ordering::less;
+        return std::strong_ordering::equal;
+    }
+
+    return modulo_comparison(left, right, shift);
+}
+
+std::strong_ordering big_int::operator<=>(const big_int &other) const noexcept {
+    return compare_with_sign(*this, other, 0);
+}
+
+big_int::operator bool() const noexcept {
+    return !(_digits.empty());
+}
+
+big_int &big_int::operator++() & {
+    return *this += big_int({1});
+}
+
+big_int big_int::operator++(int) {
+    big_int copy = *this;
+    ++*this;
+    return copy;
+}
+
+big_int &big_int::operator--() & {
+    return *this -= big_int({1});
+}
+
+big_int big_int::operator--(int) {
+    big_int copy = *this;
+    --*this;
+    return copy;
+}
+
+big_int &big_int::operator+=(const big_int &other) & {
+    return plus_assign(other, 0);
+}
+
+big_int &big_int::operator-=(const big_int &other) & {
+    return add_signed(other, true);
+}
+
+void big_int::plus_operation_without_sign(big_int &left, const big_int &right, size_t shift) noexcept {
+    if (&left == &right && shift != 0) {
+        // при сдвиге ядро читало бы уже перезаписанные разряды
+        const big_int copy = right;
+        plus_operation_without_sign(left, copy, shift);
+        return;
+    }
+
+    const size_t right_size = right._digits.size();
+    // Убедимся, что в результате достаточно места для разрядов right со сдвигом
+    if (left._digits.size() < right_size + shift) {
+        left._digits.resize(right_size + shift, 0);
+    }
+
+    unsigned int *target = left._digits.data() + shift;
+    unsigned int carry = add_n(target, target, right._digits.data(), right_size);
+    // Продолжаем обработку остаточного переноса, если он ещё остался
+    carry = add_1(target + right_size, target + right_size, left._digits.size() - shift - right_size, carry);
+
+    if (carry != 0) {
+        left._digits.push_back(carry);
+    }
+}
+
+void big_int::minus_operation_without_sign(big_int &left, const big_int &right, size_t shift) {
+    // left >= right
+    if (modulo_comparison(left, right, shift) == std::strong_ordering::less) {
+        throw std::invalid_argument("Subtraction cannot be performed: left is smaller than right");
+    }
+
+    const size_t right_size = right._digits.size();
+    unsigned int *target = left._digits.data() + shift;
+    unsigned int borrow = sub_n(target, target, right._digits.data(), right_size);
+    // Продолжаем обработку остаточного заёма
+    sub_1(target + right_size, target + right_size, left._digits.size() - shift - right_size, borrow);
+
+    left.optimise();
+}
+
+big_int big_int::multiply_table(const big_int &left, const big_int &right) noexcept {
+    big_int result(left._digits.get_allocator());
+    multiply_table_into(result, left, right);
+    return result;
+}
+
+void big_int::multiply_table_into(big_int &destination, const big_int &left, const big_int &right) {
+    if (left.is_zero() || right.is_zero()) {
+        destination._digits.clear();
+        destination._sign = true;
+        return;
+    }
+
+    // Перемножаем 64-битные слова: в четыре раза меньше умножений, чем по 16-битным половинам
+    const size_t left_words = (left._digits.size() + 1) / 2;
+    const size_t right_words = (right._digits.size() + 1) / 2;
+    const size_t total_words = 2 * (left_words + right_words);
+
+    // Небольшие произведения считаются в буфере на стеке, без обращений к аллокатору
+    uint64_t local_buffer[4 * KARATSUBA_THRESHOLD];
+    std::vector<uint64_t> heap_buffer;
+    uint64_t *buffer = local_buffer;
+    if (total_words > std::size(local_buffer)) {
+        heap_buffer.resize(total_words);
+        buffer = heap_buffer.data();
+    }
+
+    uint64_t *left_data = buffer, *right_data = buffer + left_words, *product = right_data + right_words;
+    pack_words(left_data, left._digits.data(), left._digits.size());
+    pack_words(right_data, right._digits.data(), right._digits.size());
+    mul_words(product, left_data, left_words, right_data, right_words);
+
+    // destination может совпадать с одним из сомножителей: знак берём до записи
+    const bool sign = (left._sign == right._sign);
+    unpack_words(product, left_words + right_words, destination._digits);
+    destination._sign = sign;
+    destination.optimise();
+}
+
+big_int big_int::multiply(const big_int &left, const big_int &right) {
+    if (&left == &right) {
+        return left.square();
+    }
+    switch (left.decide_mult(right._digits.size())) {
+        case multiplication_rule::Karatsuba:
+            return multiply_karatsuba(left, right);
+        case multiplication_rule::SchonhageStrassen:
+            return multiply_schonhage_strassen(left, right);
+        default:
+            return multiply_table(left, right);
+    }
+}
+
+void big_int::multiply_into(big_int &destination, const big_int &left, const big_int &right) {
+    if (&left != &right && left.decide_mult(right._digits.size()) == multiplication_rule::trivial) {
+        // школьное произведение пишется прямо в буфер destination
+        multiply_table_into(destination, left, right);
+        return;
+    }
+    destination = multiply(left, right);
+}
+
+big_int &big_int::add_signed(const big_int &other, bool subtract, size_t shift) {
+    if (&other == this) {
+        if (shift == 0) {
+            if (subtract) {
+                _digits.clear();
+                _sign = true;
+            } else {
+                plus_operation_without_sign(*this, *this);
+            }
+            return *this;
+        }
+        const big_int copy = other;
+        return add_signed(copy, subtract, shift);
+    }
+    add_digits(other._digits.data(), other._digits.size(), other._sign != subtract, shift);
+    return *this;
+}
+
+void big_int::add_digits(const unsigned int *value, size_t size, bool sign, size_t shift) {
+    while (size > 0 && value[size - 1] == 0) {
+        --size;
+    }
+    if (size == 0) {
+        return;
+    }
+    if (is_zero()) {
+        _digits.resize(shift + size, 0);
+        std::copy(value, value + size, _digits.data() + shift);
+        _sign = sign;
+        return;
+    }
+
+    if (_sign == sign) {
+        if (_digits.size() < shift + size) {
+            _digits.resize(shift + size, 0);
+        }
+        unsigned int *target = _digits.data() + shift;
+        unsigned int carry = add_n(target, target, value, size);
+        carry = add_1(target + size, target + size, _digits.size() - shift - size, carry);
+        if (carry != 0) {
+            _digits.push_back(carry);
+        }
+        return;
+    }
+
+    if (compare_shifted(_digits.data(), _digits.size(), value, size, shift * 8 * sizeof(unsigned int)) != std::strong_ordering::less) {
+        // |*this| не меньше: вычитаем на месте, знак остаётся
+        unsigned int *target = _digits.data() + shift;
+        const unsigned int borrow = sub_n(target, target, value, size);
+        sub_1(target + size, target + size, _digits.size() - shift - size, borrow);
+        optimise();
+        return;
+    }
+
+    // |*this| меньше: на его же месте считаем value * B^shift - |*this|, знак берётся у value
+    _digits.resize(shift + size, 0);
+    unsigned int *data = _digits.data();
+    unsigned int borrow = 0;
+    for (size_t i = 0; i < shift; ++i) {
+        const uint64_t diff = uint64_t{0} - data[i] - borrow;
+        data[i] = static_cast<unsigned int>(diff);
+        borrow = static_cast<unsigned int>(diff >> 32) & 1u;
+    }
+    sub_n(data + shift, value, data + shift, size, borrow);
+    _sign = sign;
+    optimise();
+}
+
+void big_int::accumulate_product(const big_int &left, const big_int &right, bool subtract) {
+    if (left.is_zero() || right.is_zero()) {
+        return;
+    }
+    const bool sign = (left._sign == right._sign) != subtract;
+
+    const size_t left_words = (left._digits.size() + 1) / 2;
+    const size_t right_words = (right._digits.size() + 1) / 2;
+    if (left.decide_mult(right._digits.size()) == multiplication_rule::trivial
+        && 2 * (left_words + right_words) <= 4 * KARATSUBA_THRESHOLD) {
+        // Произведение школьного размера собирается на стеке и сразу прибавляется: *this может быть сомножителем
+        uint64_t buffer[4 * KARATSUBA_THRESHOLD];
+        unsigned int product_digits[4 * KARATSUBA_THRESHOLD];
+        uint64_t *left_data = buffer, *right_data = buffer + left_words, *product = right_data + right_words;
+        pack_words(left_data, left._digits.data(), left._digits.size());
+        pack_words(right_data, right._digits.data(), right._digits.size());
+        mul_words(product, left_data, left_words, right_data, right_words);
+        for (size_t i = 0; i < left_words + right_words; ++i) {
+            store_pair(product_digits + 2 * i, product[i]);
+        }
+        add_digits(product_digits, 2 * (left_words + right_words), sign);
+        return;
+    }
+
+    big_int product = multiply(left, right);
+    if (is_zero()) {
+        *this = std::move(product);
+        _sign = sign;
+        return;
+    }
+    add_digits(product._digits.data(), product._digits.size(), sign);
+}
+
+void big_int::accumulate_shifted(const big_int &value, size_t bits, bool subtract) {
+    constexpr size_t digit_bits = 8 * sizeof(unsigned int);
+    const size_t limb_shift = bits / digit_bits;
+    const auto bit_shift = static_cast<unsigned int>(bits % digit_bits);
 
-    // Сначала сравним длины чисел.
-    if (left_size < effective_right_size) {
-        return std::strong_ordering::less;
+    if (value.is_zero()) {
+        return;
     }
-    if (left_size > effective_right_size) {
-        return std::strong_ordering::greater;
+    if (bit_shift == 0) {
+        add_signed(value, subtract, limb_shift);
+        return;
+    }
+    if (&value == this) {
+        const big_int copy = value;
+        accumulate_shifted(copy, bits, subtract);
+        return;
     }
 
-    // Если длины совпадают, сравниваем цифры по порядку, начиная с самого старшего разряда.
-    // Индекс i пробегает от left_size-1 до 0.
-    for (size_t i = left_size; i-- > 0;) {
-        unsigned int left_digit = left._digits[i];
-        // Для right, если i находится в области смещения, т.е. i < shift, то соответствующая цифра равна 0.
-        // Иначе индекс в right равен (i - shift).
-        unsigned int right_digit = (i < shift || (i - shift) >= right._digits.size()) ? 0 : right._digits[i - shift];
-        if (left_digit < right_digit) {
-            return std::strong_ordering::less;
+    const bool sign = value._sign != subtract;
+    const unsigned int *source = value._digits.data();
+    const size_t size = value._digits.size();
+
+    if (is_zero() || _sign == sign) {
+        _sign = sign;
+        if (_digits.size() < limb_shift + size) {
+            _digits.resize(limb_shift + size, 0);
         }
-        if (left_digit > right_digit) {
-            return std::strong_ordering::greater;
+        unsigned int *target = _digits.data() + limb_shift;
+        unsigned int carry = add_lsh_n(target, target, source, size, bit_shift);
+        carry = add_1(target + size, target + size, _digits.size() - limb_shift - size, carry);
+        if (carry != 0) {
+            _digits.push_back(carry);
         }
+        return;
     }
 
-    // Если все разряды совпадают, числа равны.
-    return std::strong_ordering::equal;
+    if (compare_shifted(_digits.data(), _digits.size(), source, size, bits) != std::strong_ordering::less) {
+        // |*this| >= |value| * 2^bits, поэтому разрядов у *this не меньше limb_shift + size
+        unsigned int *target = _digits.data() + limb_shift;
+        const unsigned int borrow = sub_lsh_n(target, target, source, size, bit_shift);
+        sub_1(target + size, target + size, _digits.size() - limb_shift - size, borrow);
+        optimise();
+        return;
+    }
+
+    big_int shifted = value;
+    shifted <<= bits;
+    add_digits(shifted._digits.data(), shifted._digits.size(), sign);
 }
 
-std::strong_ordering big_int::compare_with_sign(const big_int &left, const big_int &right, size_t shift) noexcept {
-    if (left._sign != right._sign) {
-        // Если знаки разные, то положительное число больше отрицательного
-        return left._sign ? std::strong_ordering::greater : std::strong_ordering::less;
+big_int big_int::multiply_karatsuba(const big_int& left, const big_int& right) {
+    if (left.is_zero() || right.is_zero()) {
+        return big_int(0);
     }
-    if (left._sign == 0 && right._sign == 0) {
-        auto result = modulo_comparison(left, right, shift);
-        if (result == std::strong_ordering::less) return std::strong_ordering::greater;
-        if (result == std::strong_ordering::greater) return std::strong_ordering::less;
-        return std::strong_ordering::equal;
+    size_t m = std::max(left._digits.size(), right._digits.size());
+
+    // Базовый случай: на малых размерах школьное умножение быстрее
+    if (m <= KARATSUBA_THRESHOLD) {
+        return multiply_table(left, right);
     }
 
-    return modulo_comparison(left, right, shift);
-}
+    size_t half = (m + 1) / 2;  // Округляем вверх
 
-std::strong_ordering big_int::operator<=>(const big_int &other) const noexcept {
-    return compare_with_sign(*this, other, 0);
-}
+    // Лямбда для безопасного разбиения
+    auto split = [](const big_int& num, size_t pos) -> std::pair<big_int, big_int> {
+        pos = std::min(pos, num._digits.size());
+        return {
+            big_int(std::vector<unsigned int>(num._digits.begin(), num._digits.begin() + pos), num._sign),
+            big_int(std::vector<unsigned int>(num._digits.begin() + pos, num._digits.end()), num._sign)
+    };
+    };
 
-big_int::operator bool() const noexcept {
-    return !(_digits.empty());
-}
+    auto [left_low, left_high] = split(left, half);
+    auto [right_low, right_high] = split(right, half);
 
-big_int &big_int::operator++() & {
-    return *this += big_int({1});
-}
+    // Рекурсивные вызовы независимы: на больших размерах в параллельном режиме z0 и z2 уходят в пул
+    const std::shared_ptr<work_stealing_pool> pool = m >= PARALLEL_KARATSUBA_THRESHOLD ? current_parallel_pool() : nullptr;
+    big_int sum_left = left_low + left_high;
+    big_int sum_right = right_low + right_high;
+    big_int z0, z1, z2;
+    run_both(pool.get(),
+             [&]() { run_both(pool.get(),
+                              [&]() { z1 = multiply_karatsuba(sum_left, sum_right); },
+                              [&]() { z2 = multiply_karatsuba(left_high, right_high); }); },
+             [&]() { z0 = multiply_karatsuba(left_low, right_low); });
 
-big_int big_int::operator++(int) {
-    big_int copy = *this;
-    ++*this;
-    return copy;
-}
+    // z1 = (left_low + left_high) * (right_low + right_high) - z0 - z2
+    z1 -= z0;
+    z1 -= z2;
 
-big_int &big_int::operator--() & {
-    return *this -= big_int({1});
-}
+    // Сборка результата
+    big_int result = z0;
+    result += (z1 << (half * sizeof(unsigned int) * 8));
+    result += (z2 << (2 * half * sizeof(unsigned int) * 8));
 
-big_int big_int::operator--(int) {
-    big_int copy = *this;
-    --*this;
-    return copy;
+    result._sign = (left._sign == right._sign);
+    result.optimise();
+    return result;
 }
 
-big_int &big_int::operator+=(const big_int &other) & {
-    return plus_assign(other, 0);
-}
 
-big_int &big_int::operator-=(const big_int &other) & {
-    return *this += (-other);
-}
 
-void big_int::plus_operation_without_sign(big_int &left, const big_int &right, size_t shift) noexcept {
 
-    // Убедимся, что в результате достаточно места для разрядов right со сдвигом
-    if (left._digits.size() < right._digits.size() + shift) {
-        left._digits.resize(right._digits.size() + shift, 0);
+big_int big_int::square_table(const big_int &value) {
+    big_int result(value._digits.get_allocator());
+    if (value.is_zero()) {
+        return result;
     }
 
-    unsigned int carry = 0;
-    size_t i = 0;
-    // Проходим по цифрам числа right
-    constexpr unsigned int half_bits = sizeof(unsigned int) * 4;
-    const unsigned int low_mask = __detail::generate_half_mask();
-    unsigned int high_mask = low_mask << half_bits;
+    const size_t words = (value._digits.size() + 1) / 2;
+    uint64_t local_buffer[4 * KARATSUBA_THRESHOLD];
+    std::vector<uint64_t> heap_buffer;
+    uint64_t *buffer = local_buffer;
+    if (3 * words > std::size(local_buffer)) {
+        heap_buffer.resize(3 * words);
+        buffer = heap_buffer.data();
+    }
 
-    for (; i < right._digits.size(); ++i) {
-        size_t j = i + shift; // Смещаем индекс на shift
-        // Если нет переноса разряда
+    pack_words(buffer, value._digits.data(), value._digits.size());
+    sqr_words(buffer + words, buffer, words);
 
-        const unsigned int left_low = left._digits[j] & low_mask;
-        const unsigned int left_high = left._digits[j] >> half_bits;
-        const unsigned int right_low = right._digits[j] & low_mask;
-        const unsigned int right_high = right._digits[j] >> half_bits;
+    unpack_words(buffer + words, 2 * words, result._digits);
+    result.optimise();
+    return result;
+}
 
-        const unsigned int low_result = left_low + right_low + carry;
-        const unsigned int high_result = (low_result >> half_bits) + left_high + right_high;
+big_int big_int::square_karatsuba(const big_int &value) {
+    const size_t m = value._digits.size();
+    if (m <= KARATSUBA_THRESHOLD) {
+        return square_table(value);
+    }
 
-        left._digits[j] = (high_result << half_bits) | (low_result & low_mask);
-        carry = high_result >> half_bits;
+    // (low + high * B)^2 = low^2 + ((low + high)^2 - low^2 - high^2) * B + high^2 * B^2
+    const size_t half = (m + 1) / 2;
+    big_int low(value._digits.get_allocator()), high(value._digits.get_allocator());
+    low._digits.assign(value._digits.begin(), value._digits.begin() + half);
+    high._digits.assign(value._digits.begin() + half, value._digits.end());
+    low.optimise();
+
+    const std::shared_ptr<work_stealing_pool> pool = m >= PARALLEL_KARATSUBA_THRESHOLD ? current_parallel_pool() : nullptr;
+    const big_int sum = low + high;
+    big_int z0(value._digits.get_allocator()), z1(value._digits.get_allocator()), z2(value._digits.get_allocator());
+    run_both(pool.get(),
+             [&]() { run_both(pool.get(),
+                              [&]() { z1 = square_karatsuba(sum); },
+                              [&]() { z2 = square_karatsuba(high); }); },
+             [&]() { z0 = square_karatsuba(low); });
+    z1 -= z0;
+    z1 -= z2;
+
+    z0.plus_assign(z1, half);
+    z0.plus_assign(z2, 2 * half);
+    return z0;
+}
+
+big_int big_int::square_with_rule(const big_int &value, multiplication_rule rule) {
+    switch (rule) {
+        case multiplication_rule::Karatsuba:
+            return square_karatsuba(value);
+        case multiplication_rule::SchonhageStrassen:
+            return multiply_schonhage_strassen(value, value);
+        default:
+            return square_table(value);
     }
+}
 
-    // Продолжаем обработку остаточного переноса, если он ещё остался
-    size_t j = i + shift;
-    while (carry != 0 && j < left._digits.size()) {
-        const unsigned int left_low = left._digits[i] & low_mask;
-        const unsigned int left_high = left._digits[i] >> half_bits;
-        const unsigned int right_low = right._digits[i] & low_mask;
-        const unsigned int right_high = right._digits[i] >> half_bits;
+std::pair<big_int, big_int> big_int::divide_table_with_remainder(const big_int &numerator, const big_int &denominator) {
+    big_int quotient(numerator._digits.get_allocator());
+    big_int remainder(numerator._digits.get_allocator());
 
-        const unsigned int low_result = left_low + right_low + carry;
-        const unsigned int high_result = (low_result >> half_bits) + left_high + right_high;
+    if (modulo_comparison(numerator, denominator) == std::strong_ordering::less) {
+        remainder = numerator.abs();
+        return {std::move(quotient), std::move(remainder)};
+    }
 
-        left._digits[j] = (high_result << half_bits) | (low_result & low_mask);
-        carry = high_mask >> half_bits;
+    const size_t n = numerator._digits.size();
+    const size_t m = denominator._digits.size();
+    quotient._digits.resize(n - m + 1);
 
-        ++j;
-    }
-    if (carry != 0) {
-        left._digits.push_back(1);
+    if (m == 1) {
+        // Деление на один разряд: один проход 64/32-битного деления
+        const unsigned int rest = divrem_1(quotient._digits.data(), numerator._digits.data(), n, denominator._digits[0]);
+        remainder._digits.push_back(rest);
+    } else {
+        remainder._digits.resize(m);
+        divrem_knuth(quotient._digits.data(), remainder._digits.data(), numerator._digits.data(), n, denominator._digits.data(), m);
     }
+
+    quotient.optimise();
+    remainder.optimise();
+    return {std::move(quotient), std::move(remainder)};
 }
 
-void big_int::minus_operation_without_sign(big_int &left, const big_int &right, size_t shift) {
-    // left >= right
-    if (modulo_comparison(left, right) == std::strong_ordering::less) {
-        throw std::invalid_argument("Subtraction cannot be performed: left is smaller than right");
+std::pair<big_int, big_int> big_int::divide_burnikel_ziegler(const big_int &numerator, const big_int &denominator) {
+    const size_t m = denominator._digits.size();
+    if (m < BURNIKEL_ZIEGLER_THRESHOLD || modulo_comparison(numerator, denominator) == std::strong_ordering::less) {
+        return divide_table_with_remainder(numerator, denominator);
     }
 
-    uint32_t carry = 0;
-    size_t i = 0;
-    // Проходим по цифрам числа right
-    for (; i < right._digits.size(); ++i) {
-        size_t j = i + shift; // Смещаем индекс на shift
-        // Если результат вычитания без переноса положительный
-        if (left._digits[j] >= (right._digits[i] + carry)) {
-            left._digits[j] -= (right._digits[i] + carry);
-            carry = 0;
-        } else {
-            // Если перенос
-            left._digits[j] = (UINT_MAX - (right._digits[i] + carry) + left._digits[j] + 1);
-            carry = 1; // После переноса нужно вычесть 1 из следующего разряда
+    constexpr size_t bits = 8 * sizeof(unsigned int);
+    const pp_allocator<unsigned int> allocator = numerator._digits.get_allocator();
+
+    struct recursion
+    {
+        pp_allocator<unsigned int> allocator;
+
+        // count разрядов числа начиная с from
+        big_int slice(const big_int &value, size_t from, size_t count) const {
+            big_int result(allocator);
+            if (from < value._digits.size()) {
+                const size_t to = std::min(value._digits.size(), from + count);
+                result._digits.assign(value._digits.begin() + from, value._digits.begin() + to);
+                result.optimise();
+            }
+            return result;
+        }
+
+        // A < B * base^n, B нормализовано и занимает n разрядов
+        std::pair<big_int, big_int> divide_2n_1n(const big_int &a, const big_int &b, size_t n) {
+            if (n % 2 != 0 || n < BURNIKEL_ZIEGLER_THRESHOLD) {
+                return divide_table_with_remainder(a, b);
+            }
+            const size_t half = n / 2;
+
+            auto [q1, r] = divide_3n_2n(a >> (half * bits), b, half);
+            r <<= half * bits;
+            r += slice(a, 0, half);
+            auto [q2, s] = divide_3n_2n(r, b, half);
+
+            q1 <<= half * bits;
+            q1 += q2;
+            return {std::move(q1), std::move(s)};
+        }
+
+        // A < B * base^half, B нормализовано и занимает 2 * half разрядов
+        std::pair<big_int, big_int> divide_3n_2n(const big_int &a, const big_int &b, size_t half) {
+            const big_int b1 = b >> (half * bits);
+            const big_int b2 = slice(b, 0, half);
+            const big_int a12 = a >> (half * bits);
+
+            big_int q, r;
+            if (modulo_comparison(a, b1, 2 * half) == std::strong_ordering::less) {
+                std::tie(q, r) = divide_2n_1n(a12, b1, half);
+            } else {
+                // Частное заведомо не меньше base^half - 1
+                q = big_int(1) << (half * bits);
+                --q;
+                r = a12 - (b1 << (half * bits)) + b1;
+            }
+
+            r <<= half * bits;
+            r += slice(a, 0, half);
+            r -= q * b2;
+
+            while (r.is_negative()) {
+                --q;
+                r += b;
+            }
+            return {std::move(q), std::move(r)};
         }
+    } impl{allocator};
+
+    // n = j * 2^k >= m, где j не больше порога: тогда рекурсия делит пополам до деления Кнута
+    size_t k = 0;
+    while (((m + (size_t(1) << k) - 1) >> k) > BURNIKEL_ZIEGLER_THRESHOLD) {
+        ++k;
     }
+    const size_t n = ((m + (size_t(1) << k) - 1) >> k) << k;
 
-    // Продолжаем обработку остаточного переноса
-    size_t j = i + shift;
-    while (carry != 0 && j < left._digits.size()) {
-        if (left._digits[j] > 0) {
-            left._digits[j]--;
-            carry = 0;
+    // Нормализуем делитель до ровно n разрядов со старшим единичным битом
+    const size_t sigma = (n - m) * bits + __detail::countl_zero_uint_impl(denominator._digits.back());
+    const big_int b = denominator.abs() << sigma;
+    const big_int a = numerator.abs() << sigma;
+
+    // Делимое разбиваем на t блоков по n разрядов, старший блок меньше B
+    const size_t t = std::max<size_t>(2, (a._digits.size() + n) / n);
+
+    big_int quotient(allocator);
+    quotient._digits.assign((t - 1) * n, 0);
+
+    big_int z = a >> ((t - 2) * n * bits);
+    big_int remainder(allocator);
+    for (size_t i = t - 1; i-- > 0;) {
+        auto [q, r] = impl.divide_2n_1n(z, b, n);
+        std::copy(q._digits.begin(), q._digits.end(), quotient._digits.begin() + i * n);
+
+        if (i > 0) {
+            z = std::move(r);
+            z <<= n * bits;
+            z += impl.slice(a, (i - 1) * n, n);
         } else {
-            left._digits[j] = UINT_MAX;
-            carry = 1;
+            remainder = std::move(r);
         }
-        ++j;
     }
 
-    left.optimise();
+    quotient.optimise();
+    remainder >>= sigma;
+    return {std::move(quotient), std::move(remainder)};
 }
 
-big_int big_int::multiply_table(const big_int &left, const big_int &right) noexcept {
-    constexpr unsigned int HALF_BITS = (sizeof(unsigned int) * 8) / 2;  // 16
-    constexpr unsigned int HALF_MASK = (1u << HALF_BITS) - 1;          // 0xFFFF
+std::pair<big_int, big_int> big_int::divide_newton(const big_int &numerator, const big_int &denominator) {
+    if (modulo_comparison(numerator, denominator) == std::strong_ordering::less) {
+        return divide_table_with_remainder(numerator, denominator);
+    }
 
-    size_t n = left._digits.size();
-    size_t m = right._digits.size();
-    big_int result;
-    // Результат может занять n+m+1 разряд
-    result._digits.assign(n + m + 1, 0u);
+    // Запасные биты: на каждом уровне ошибка приближения остаётся в пределах нескольких единиц
+    constexpr size_t guard = 32;
+    const pp_allocator<unsigned int> allocator = numerator._digits.get_allocator();
+
+    // y ~ 2^(s + p) / b, где s - длина b в битах; ошибка - несколько единиц.
+    // От b нужны только старшие p + guard бит, точность удваивается шагом y += y * (2^(s + p) - b * y) / 2^(s + p).
+    // Погрешность e = 2^(s + p) - b * y в шаге занимает около s + p / 2 бит, но для поправки хватает её старших p / 2 + guard бит
+    struct reciprocal
+    {
+        pp_allocator<unsigned int> allocator;
+
+        big_int operator()(const big_int &b, size_t p) const {
+            const size_t s = b.bit_length();
+            if (s > p + guard) {
+                return (*this)(b >> (s - p - guard), p);
+            }
+
+            big_int power(allocator);
+            power.set_bit(s + p);
+            if (p <= NEWTON_THRESHOLD) {
+                return divide_with_remainder(power, b, b.decide_div(b._digits.size())).first;
+            }
+
+            const size_t half = p / 2 + guard;
+            const big_int y = (*this)(b, half);
+            power -= (b * y) << (p - half);
+
+            const size_t dropped = s > guard ? s - guard : 0;
+            big_int result = y << (p - half);
+            result += (y * (power >> dropped)) >> (s + half - dropped);
+            return result;
+        }
+    };
 
-    for (size_t i = 0; i < n; ++i) {
-        unsigned int a = left._digits[i];
-        unsigned int a_low  = a & HALF_MASK;
-        unsigned int a_high = a >> HALF_BITS;
+    const big_int a = numerator.abs();
+    const big_int b = denominator.abs();
+    const size_t s = b.bit_length();
+    const size_t p = a.bit_length() - s + 1;
 
-        for (size_t j = 0; j < m; ++j) {
-            unsigned int b = right._digits[j];
-            unsigned int b_low  = b & HALF_MASK;
-            unsigned int b_high = b >> HALF_BITS;
+    // a < 2^(s + p - 1), поэтому для частного хватает старших p + guard бит делимого
+    const size_t dropped = s > guard ? s - guard : 0;
+    big_int quotient = (reciprocal{allocator}(b, p) * (a >> dropped)) >> (s + p - dropped);
 
-            // четыре частичных произведения
-            unsigned int p_ll = a_low  * b_low;
-            unsigned int p_lh = a_low  * b_high;
-            unsigned int p_hl = a_high * b_low;
-            unsigned int p_hh = a_high * b_high;
+    big_int remainder = a - quotient * b;
+    while (remainder.is_negative()) {
+        --quotient;
+        remainder += b;
+    }
+    while (modulo_comparison(remainder, b) != std::strong_ordering::less) {
+        ++quotient;
+        remainder -= b;
+    }
+    return {std::move(quotient), std::move(remainder)};
+}
 
-            // сумма средних произведений с переносом
-            unsigned int mid_lo = (p_lh & HALF_MASK) + (p_hl & HALF_MASK);
-            unsigned int carry_mid_lo = mid_lo >> HALF_BITS;
-            mid_lo &= HALF_MASK;
-            unsigned int mid_hi = (p_lh >> HALF_BITS) + (p_hl >> HALF_BITS) + carry_mid_lo;
+std::pair<big_int, big_int> big_int::divide_with_remainder(const big_int &numerator, const big_int &denominator, division_rule rule) {
+    if (denominator.is_zero()) {
+        throw std::invalid_argument("Zero division");
+    }
 
-            // собираем low часть: lo_lo | ((lo_hi + mid_lo) << HALF_BITS)
-            unsigned int lo_lo = p_ll & HALF_MASK;
-            unsigned int lo_hi = p_ll >> HALF_BITS;
-            unsigned int res_lo_hi = lo_hi + mid_lo;
-            unsigned int carry_lo = res_lo_hi >> HALF_BITS;
-            res_lo_hi &= HALF_MASK;
-            unsigned int low = (res_lo_hi << HALF_BITS) | lo_lo;
+    std::pair<big_int, big_int> result;
+    switch (rule) {
+        case division_rule::trivial:
+            result = divide_table_with_remainder(numerator, denominator);
+            break;
+        case division_rule::Newton:
+            result = divide_newton(numerator, denominator);
+            break;
+        case division_rule::BurnikelZiegler:
+            result = divide_burnikel_ziegler(numerator, denominator);
+            break;
+    }
 
-            // общий перенос в high: carry_lo + mid_hi + (p_hh low part)
-            unsigned int carry_low = carry_lo + mid_hi;
-            unsigned int high = p_hh + carry_low;
+    // Частное положительно, если делимое и делитель имеют одинаковый знак, остаток берёт знак делимого
+    result.first._sign = (numerator._sign == denominator._sign);
+    result.second._sign = numerator._sign;
+    result.first.optimise();
+    result.second.optimise();
+    return result;
+}
 
+big_int big_int::divide_table(const big_int &numerator, const big_int &denominator) {
+    return divide_with_remainder(numerator, denominator, division_rule::trivial).first;
+}
 
-            // Добавляем low
-            unsigned int sum1   = result._digits[i + j] + low;
-            unsigned int carry1 = (sum1 < low) ? 1u : 0u;
-            result._digits[i + j] = sum1;
+big_int big_int::gcd(const big_int &left, const big_int &right) {
+    constexpr size_t bits = 8 * sizeof(unsigned int);
 
-            // Добавляем high + carry1
-            unsigned int to_add = high + carry1;
-            unsigned int sum2   = result._digits[i + j + 1] + to_add;
-            unsigned int carry2 = (sum2 < to_add) ? 1u : 0u;
-            result._digits[i + j + 1] = sum2;
+    // (x, y) -> (u0 * x + v0 * y, u1 * x + v1 * y)
+    struct cofactors
+    {
+        big_int u0, v0, u1, v1;
+    };
 
-            // Финальный перенос
-            result._digits[i + j + 2] += carry2;
+    struct recursion
+    {
+        // Шаг алгоритма Евклида с делением: (x, y) -> (y, x mod y)
+        static void euclid_step(big_int &x, big_int &y, cofactors *n) {
+            auto [q, r] = divide_with_remainder(x, y, x.decide_div(y._digits.size()));
+            x = std::move(y);
+            y = std::move(r);
+            if (n != nullptr) {
+                big_int u = n->u0 - q * n->u1;
+                big_int v = n->v0 - q * n->v1;
+                n->u0 = std::move(n->u1);
+                n->v0 = std::move(n->v1);
+                n->u1 = std::move(u);
+                n->v1 = std::move(v);
+            }
         }
-    }
 
-    // Убираем ведущие нули
-    while (result._digits.size() > 1 && result._digits.back() == 0u) {
-        result._digits.pop_back();
-    }
+        // Несколько шагов Евклида по ведущим 62 битам за один проход по разрядам
+        static void lehmer_step(big_int &x, big_int &y, cofactors *n) {
+            const size_t length = bit_length_of(x._digits.data(), x._digits.size());
+            if (length <= 62) {
+                euclid_step(x, y, n);
+                return;
+            }
 
-    result._sign = (left._sign == right._sign);
-    result.optimise();
-    return result;
+            const size_t shift = length - 62;
+            const lehmer_matrix m = lehmer_quotients(
+                static_cast<int64_t>(bits_at(x._digits.data(), x._digits.size(), shift)),
+                static_cast<int64_t>(bits_at(y._digits.data(), y._digits.size(), shift)));
+            if (m.b == 0) {
+                euclid_step(x, y, n);
+                return;
+            }
+
+            y._digits.resize(x._digits.size(), 0);
+            lehmer_update(x._digits.data(), y._digits.data(), x._digits.size(), m);
+            x.optimise();
+            y.optimise();
+            if (n != nullptr) {
+                big_int u0 = big_int(m.a) * n->u0 + big_int(m.b) * n->u1;
+                big_int v0 = big_int(m.a) * n->v0 + big_int(m.b) * n->v1;
+                n->u1 = big_int(m.c) * n->u0 + big_int(m.d) * n->u1;
+                n->v1 = big_int(m.c) * n->v0 + big_int(m.d) * n->v1;
+                n->u0 = std::move(u0);
+                n->v0 = std::move(v0);
+            }
+        }
+
+        // Применяет к (x, y) матрицу, найденную по старшим разрядам. Если частные старших разрядов разошлись
+        // с настоящими и результат отрицателен или не меньше исходного, матрица отбрасывается
+        static bool apply(big_int &x, big_int &y, cofactors &m) {
+            big_int new_x = m.u0 * x + m.v0 * y;
+            big_int new_y = m.u1 * x + m.v1 * y;
+            if (new_x.is_negative() || new_y.is_negative()) {
+                return false;
+            }
+            if (new_x < new_y) {
+                swap(new_x, new_y);
+                swap(m.u0, m.u1);
+                swap(m.v0, m.v1);
+            }
+            if (!(new_y < y)) {
+                return false;
+            }
+            x = std::move(new_x);
+            y = std::move(new_y);
+            return true;
+        }
+
+        // n = m * n
+        static void compose(cofactors &n, const cofactors &m) {
+            cofactors product{
+                m.u0 * n.u0 + m.v0 * n.u1,
+                m.u0 * n.v0 + m.v0 * n.v1,
+                m.u1 * n.u0 + m.v1 * n.u1,
+                m.u1 * n.v0 + m.v1 * n.v1
+            };
+            n = std::move(product);
+        }
+
+        // Сокращает x >= y >= 0, пока в y больше stop разрядов, накапливая преобразование в n (если n задано).
+        // Большие числа сокращаются по старшей части: матрица для p старших разрядов, найденная рекурсивно,
+        // применяется ко всему числу быстрым умножением
+        static void half_gcd(big_int &x, big_int &y, size_t stop, cofactors *n) {
+            while (y._digits.size() > stop) {
+                if (n == nullptr && x._digits.size() <= 2) {
+                    const uint64_t result = binary_gcd(bits_at(x._digits.data(), x._digits.size(), 0),
+                                                       bits_at(y._digits.data(), y._digits.size(), 0));
+                    x = big_int(result, x._digits.get_allocator());
+                    y = big_int(y._digits.get_allocator());
+                    return;
+                }
+                if (x._digits.size() <= HALF_GCD_THRESHOLD) {
+                    lehmer_step(x, y, n);
+                    continue;
+                }
+
+                const size_t p = std::min(2 * (y._digits.size() - stop), x._digits.size() / 2);
+                const size_t k = x._digits.size() - p;
+                big_int high_x = x >> (k * bits), high_y = y >> (k * bits);
+                cofactors m{big_int(1), big_int(0), big_int(0), big_int(1)};
+                half_gcd(high_x, high_y, p / 2 + 1, &m);
+
+                if (!apply(x, y, m)) {
+                    lehmer_step(x, y, n);
+                } else if (n != nullptr) {
+                    compose(*n, m);
+                }
+            }
+        }
+    };
+
+    big_int x = left.abs(), y = right.abs();
+    if (x < y) {
+        swap(x, y);
+    }
+    recursion::half_gcd(x, y, 0, nullptr);
+    return x;
 }
 
-big_int big_int::multiply_karatsuba(const big_int& left, const big_int& right) {
-    if (left.is_zero() || right.is_zero()) {
-        return big_int(0);
+void big_int::divide_exact(big_int &first, big_int &second, const big_int &divisor) {
+    if (divisor.is_zero()) {
+        throw std::invalid_argument("Zero division");
     }
-    size_t m = std::max(left._digits.size(), right._digits.size());
 
-    // Базовый случай: если числа состоят из одной цифры (32 бита)
-    if (m == 1) {
-        big_int result;
-        result = left * right;
-        result._sign = (left._sign == right._sign);
-        return result;
+    // Делитель делаем нечётным: общий множитель 2^shift снимается сдвигом
+    size_t shift = 0;
+    while (divisor._digits[shift / 32] == 0) {
+        shift += 32;
+    }
+    shift += std::countr_zero(divisor._digits[shift / 32]);
+    big_int odd_divisor = divisor.abs();
+    odd_divisor >>= shift;
+
+    // d[0]^(-1) mod 2^32 методом Ньютона: 3 -> 6 -> 12 -> 24 -> 48 верных бит
+    const unsigned int low = odd_divisor._digits[0];
+    unsigned int inverse = low;
+    for (int i = 0; i < 4; ++i) {
+        inverse *= 2 - low * inverse;
     }
 
-    size_t half = (m + 1) / 2;  // Округляем вверх
+    const size_t m = odd_divisor._digits.size();
+    auto divide = [&](big_int &value) {
+        const bool sign = value._sign == divisor._sign;
+        value._sign = true;
+        value >>= shift;
+        if (value._digits.size() < m) {
+            value = big_int(value._digits.get_allocator());
+            return;
+        }
 
-    // Лямбда для безопасного разбиения
-    auto split = [](const big_int& num, size_t pos) -> std::pair<big_int, big_int> {
-        pos = std::min(pos, num._digits.size());
-        return {
-            big_int(std::vector<unsigned int>(num._digits.begin(), num._digits.begin() + pos), num._sign),
-            big_int(std::vector<unsigned int>(num._digits.begin() + pos, num._digits.end()), num._sign)
-    };
+        const size_t qn = value._digits.size() - m + 1;
+        if (std::min(qn, m) >= BURNIKEL_ZIEGLER_THRESHOLD) {
+            value = divide_with_remainder(value, odd_divisor, value.decide_div(m)).first;
+        } else {
+            big_int quotient(value._digits.get_allocator());
+            quotient._digits.resize(qn);
+            divexact_n(quotient._digits.data(), value._digits.data(), qn, odd_divisor._digits.data(), m, inverse);
+            value = std::move(quotient);
+        }
+        value._sign = sign;
+        value.optimise();
     };
 
-    auto [left_low, left_high] = split(left, half);
-    auto [right_low, right_high] = split(right, half);
+    divide(first);
+    divide(second);
+}
 
-    // Рекурсивные вызовы
-    big_int z0 = multiply_karatsuba(left_low, right_low);
-    big_int z2 = multiply_karatsuba(left_high, right_high);
+big_int::multiplication_rule big_int::decide_mult(size_t rhs) const noexcept {
+    const size_t smaller = std::min(_digits.size(), rhs);
+    const size_t total_bits = (_digits.size() + rhs) * 8 * sizeof(unsigned int);
 
-    // Вычисляем z1 = (left_low + left_high) * (right_low + right_high) - z0 - z2
-    big_int sum_left = left_low + left_high;
-    big_int sum_right = right_low + right_high;
-    big_int z1 = multiply_karatsuba(sum_left, sum_right) - z0 - z2;
+    if (smaller < KARATSUBA_THRESHOLD) {
+        return multiplication_rule::trivial;
+    }
+    if (smaller < SCHONHAGE_STRASSEN_THRESHOLD || total_bits / 20 >= SS_MAX_COEFFICIENTS) {
+        return multiplication_rule::Karatsuba;
+    }
+    return multiplication_rule::SchonhageStrassen;
+}
 
-    // Сборка результата
-    big_int result = z0;
-    result += (z1 << (half * sizeof(unsigned int) * 8));
-    result += (z2 << (2 * half * sizeof(unsigned int) * 8));
+big_int::division_rule big_int::decide_div(size_t rhs) const noexcept {
+    if (rhs < BURNIKEL_ZIEGLER_THRESHOLD || _digits.size() < rhs + BURNIKEL_ZIEGLER_THRESHOLD) {
+        return division_rule::trivial;
+    }
+    return division_rule::BurnikelZiegler;
+}
 
-    result._sign = (left._sign == right._sign);
-    result.optimise();
+big_int big_int::operator+(const big_int &other) const & {
+    big_int result = *this;
+    result += other;
     return result;
 }
 
+big_int big_int::operator+(const big_int &other) && {
+    *this += other;
+    return std::move(*this);
+}
+
+big_int big_int::operator-(const big_int &other) const & {
+    big_int result = *this;
+    result -= other;
+    return result;
+}
 
+big_int big_int::operator-(const big_int &other) && {
+    *this -= other;
+    return std::move(*this);
+}
 
+big_int big_int::operator*(const big_int &other) const {
+    return multiply(*this, other);
+}
 
-big_int big_int::binary_search_quotient(const big_int &numerator, const big_int &denominator) {
-    // Бинарный двоичный поиск
-    big_int result;
-    result._digits.push_back(0);
-    unsigned int &closest = result._digits[0];
-    for (int i = sizeof(unsigned int) * 8 - 1; i >= 0; --i) {
-        const unsigned int temp = closest;
-        closest |= 1 << i;
-        big_int multiplied = result * denominator;
+big_int big_int::square() const {
+    return square_with_rule(*this, decide_mult(_digits.size()));
+}
 
-        auto comp = modulo_comparison(multiplied, numerator);
-        if (comp == std::strong_ordering::equal) {
-            return result;
-        } else if (comp == std::strong_ordering::less) {
-            continue;
-        } else {
-            result._digits[0] = temp;
-        }
+big_int big_int::pow(size_t exp) const {
+    if (exp == 0) {
+        return big_int(1, _digits.get_allocator());
+    }
+    if (is_zero()) {
+        return *this;
     }
+
+    big_int result = sliding_window_pow(abs(), std::bit_width(exp),
+        [exp](size_t i) { return ((exp >> i) & 1) != 0; },
+        [](big_int &x) { x = x.square(); },
+        [](big_int &x, const big_int &y) { x *= y; });
+    result._sign = _sign || exp % 2 == 0;
     return result;
 }
 
-big_int big_int::divide_table(const big_int &numerator, const big_int &denominator) {
-    if (denominator.is_zero()) {
+big_int big_int::modpow(const big_int &exp, const big_int &mod) const {
+    if (mod.is_zero()) {
         throw std::invalid_argument("Zero division");
     }
-    big_int abs_dividend = numerator;
-    big_int abs_divisor = denominator;
-    abs_dividend._sign = true;
-    abs_divisor._sign = true;
+    if (mod.is_negative()) {
+        throw std::invalid_argument("Modulus must be positive");
+    }
+    if (exp.is_negative()) {
+        throw std::invalid_argument("Negative exponent");
+    }
+    if (mod._digits[0] % 2 != 0) {
+        return montgomery_context(mod).pow(*this, exp);
+    }
+
+    // Чётный модуль: Монтгомери неприменим, остаток берётся после каждого умножения
+    big_int base = *this % mod;
+    if (base.is_negative()) {
+        base += mod;
+    }
+    if (exp.is_zero() || base.is_zero()) {
+        return exp.is_zero() ? big_int(1, mod._digits.get_allocator()) % mod : base;
+    }
+    return sliding_window_pow(base, bit_length_of(exp._digits.data(), exp._digits.size()),
+        [&exp](size_t i) { return ((exp._digits[i / 32] >> (i % 32)) & 1) != 0; },
+        [&mod](big_int &x) { x = x.square() % mod; },
+        [&mod](big_int &x, const big_int &y) { x = (x * y) % mod; });
+}
+
+big_int::montgomery_context::montgomery_context(const big_int &modulus) : _modulus(modulus), _inverse(0) {
+    if (modulus.is_zero() || modulus.is_negative() || modulus._digits[0] % 2 == 0) {
+        throw std::invalid_argument("Montgomery modulus must be odd and positive");
+    }
+
+    const size_t n = (modulus._digits.size() + 1) / 2;
+    _words.resize(n);
+    pack_words(_words.data(), modulus._digits.data(), modulus._digits.size());
+
+    // Обратный по модулю 2^64 методом Ньютона: каждая итерация удваивает число верных бит (3 -> 96)
+    uint64_t inverse = _words[0];
+    for (int i = 0; i < 5; ++i) {
+        inverse *= 2 - _words[0] * inverse;
+    }
+    _inverse = 0 - inverse;
 
-    big_int quotient; // частное
-    big_int remainder; // остаток
-    remainder._digits.push_back(0);
+    big_int r_squared = (big_int(1, modulus._digits.get_allocator()) << (128 * n)) % modulus;
+    _r_squared.assign(n, 0);
+    pack_words(_r_squared.data(), r_squared._digits.data(), r_squared._digits.size());
+}
 
-    for (long long pos = static_cast<long long>(abs_dividend._digits.size()) - 1; pos >= 0; --pos) {
-        // вставляем в остаток самую старшую цифру делимого
-        remainder._digits.insert(remainder._digits.begin(), abs_dividend._digits[pos]);
-        remainder.optimise();
+const big_int &big_int::montgomery_context::modulus() const noexcept {
+    return _modulus;
+}
 
-        // Находим цифру частного:
-        // такую что (digit * absDivisor) <= remainder.
-        big_int digit = binary_search_quotient(remainder, abs_divisor);
+big_int big_int::montgomery_context::pow(const big_int &base, const big_int &exp) const {
+    if (exp.is_negative()) {
+        throw std::invalid_argument("Negative exponent");
+    }
 
-        // Записываем найденную цифру в частное.
-        quotient._digits.insert(quotient._digits.begin(), digit._digits[0]);
+    big_int result(_modulus._digits.get_allocator());
+    if (_modulus == big_int(1)) {
+        return result;
+    }
+    if (exp.is_zero()) {
+        return big_int(1, _modulus._digits.get_allocator());
+    }
 
-        // Вычитаем произведение делителя на найденную цифру из остатка.
-        big_int prod = abs_divisor * digit;
-        remainder = remainder - prod;
-        remainder.optimise();
+    big_int reduced = base % _modulus;
+    if (reduced.is_negative()) {
+        reduced += _modulus;
+    }
+    if (reduced.is_zero()) {
+        return result;
     }
-    quotient.optimise();
-    // Определяем знак частного: оно положительно, если делимое и делитель имеют одинаковый знак.
-    quotient._sign = (numerator._sign == denominator._sign);
-    return quotient;
-}
 
-big_int big_int::operator+(const big_int &other) const {
-    big_int result = *this;
-    result += other;
+    const size_t n = _words.size();
+    const uint64_t *m = _words.data();
+    const uint64_t inverse = _inverse;
+    std::vector<uint64_t> scratch(2 * n + 1);
+    uint64_t *t = scratch.data();
+
+    // Перевод в форму Монтгомери: x * R = REDC(x * R^2)
+    std::vector<uint64_t> x(n, 0);
+    pack_words(x.data(), reduced._digits.data(), reduced._digits.size());
+    mul_words(t, x.data(), n, _r_squared.data(), n);
+    t[2 * n] = 0;
+    redc_words(x.data(), t, m, n, inverse);
+
+    x = sliding_window_pow(x, bit_length_of(exp._digits.data(), exp._digits.size()),
+        [&exp](size_t i) { return ((exp._digits[i / 32] >> (i % 32)) & 1) != 0; },
+        [=](std::vector<uint64_t> &value) {
+            sqr_words(t, value.data(), n);
+            t[2 * n] = 0;
+            redc_words(value.data(), t, m, n, inverse);
+        },
+        [=](std::vector<uint64_t> &value, const std::vector<uint64_t> &other) {
+            mul_words(t, value.data(), n, other.data(), n);
+            t[2 * n] = 0;
+            redc_words(value.data(), t, m, n, inverse);
+        });
+
+    // Обратный перевод: REDC(x * R) = x
+    std::fill(t, t + 2 * n + 1, 0);
+    std::copy(x.begin(), x.end(), t);
+    redc_words(x.data(), t, m, n, inverse);
+
+    unpack_words(x.data(), n, result._digits);
+    result.optimise();
     return result;
 }
 
-big_int big_int::operator-(const big_int &other) const {
-    return (*this + (-other));
-}
-
-big_int big_int::operator*(const big_int &other) const {
-    return multiply_table(*this, other);
-}
-
 big_int big_int::operator/(const big_int &other) const {
-    return divide_table(*this, other);
+    return divide_with_remainder(*this, other, decide_div(other._digits.size())).first;
 }
 
 big_int big_int::operator%(const big_int &other) const {
-    big_int copy = *this;
-    copy %= other;
-    return copy;
+    return divide_with_remainder(*this, other, decide_div(other._digits.size())).second;
 }
 
 big_int big_int::operator&(const big_int &other) const {
-    big_int copy = *this;
-    copy &= other;
-    return copy;
+    big_int result(_digits.get_allocator());
+    bitwise_into(result, *this, other, bitwise_operation::conjunction);
+    return result;
 }
 
 big_int big_int::operator|(const big_int &other) const {
-    big_int copy = *this;
-    copy |= other;
-    return copy;
+    big_int result(_digits.get_allocator());
+    bitwise_into(result, *this, other, bitwise_operation::disjunction);
+    return result;
 }
 
 big_int big_int::operator^(const big_int &other) const {
-    big_int copy = *this;
-    copy ^= other;
-    return copy;
+    big_int result(_digits.get_allocator());
+    bitwise_into(result, *this, other, bitwise_operation::exclusive_disjunction);
+    return result;
 }
 
-big_int big_int::operator<<(size_t shift) const {
+big_int big_int::operator<<(size_t shift) const & {
     big_int copy = *this;
     copy <<= shift;
     return copy;
 }
 
+big_int big_int::operator<<(size_t shift) && {
+    *this <<= shift;
+    return std::move(*this);
+}
+
 big_int big_int::operator>>(size_t shift) const {
-    big_int copy = *this;
-    copy >>= shift;
-    return copy;
+    big_int result(_digits.get_allocator());
+    shift_right_into(result, *this, shift);
+    return result;
 }
 
 big_int &big_int::operator%=(const big_int &other) & {
-    return ((*this) -= ((*this / other) * other));
+    return modulo_assign(other, decide_div(other._digits.size()));
 }
 
 big_int big_int::operator~() const {
-    auto res = *this;
-    res._sign = !res._sign;
-    for (auto &num: res._digits) {
-        num = ~num;
-    }
-    res.optimise();
-    return res;
+    big_int result(_digits.get_allocator());
+    result._digits.resize_for_overwrite(_digits.size());
+    select_limb_kernels().not_n(result._digits.data(), _digits.data(), _digits.size());
+    result._sign = !_sign;
+    result.optimise();
+    return result;
 }
 
 big_int &big_int::operator&=(const big_int &other) & {
-    if (!_sign && other._sign)
-        _sign = true;
-
-    for (size_t i = 0; i < _digits.size(); ++i)
-        _digits[i] &= i < other._digits.size() ? other._digits[i] : 0;
-
-    optimise();
+    bitwise_into(*this, *this, other, bitwise_operation::conjunction);
     return *this;
 }
 
 big_int &big_int::operator|=(const big_int &other) & {
-    if (_sign && !other._sign)
-        _sign = false;
-
-    if (_digits.size() < other._digits.size())
-        _digits.resize(other._digits.size(), 0);
-
-    for (size_t i = 0; i < _digits.size(); ++i)
-        _digits[i] |= other._digits[i];
-
-    optimise();
+    bitwise_into(*this, *this, other, bitwise_operation::disjunction);
     return *this;
 }
 
 big_int &big_int::operator^=(const big_int &other) & {
-    if (_sign != other._sign)
-        _sign = false;
-    else
-        _sign = true;
+    bitwise_into(*this, *this, other, bitwise_operation::exclusive_disjunction);
+    return *this;
+}
+
+void big_int::bitwise_into(big_int &destination, const big_int &left, const big_int &right, bitwise_operation operation) {
+    const size_t left_size = left._digits.size();
+    const size_t right_size = right._digits.size();
+    const size_t common = std::min(left_size, right_size);
+    const big_int &longer = left_size >= right_size ? left : right;
+    const limb_kernels &kernels = select_limb_kernels();
+
+    // Операции над модулями, знак - как у поразрядной операции над знаковыми битами
+    bool sign;
+    size_t size;
+    void (*kernel)(unsigned int *, const unsigned int *, const unsigned int *, size_t) noexcept;
+    switch (operation) {
+        case bitwise_operation::conjunction:
+            sign = left._sign || right._sign;
+            size = common;
+            kernel = kernels.and_n;
+            break;
+        case bitwise_operation::disjunction:
+            sign = left._sign && right._sign;
+            size = std::max(left_size, right_size);
+            kernel = kernels.or_n;
+            break;
+        default:
+            sign = left._sign == right._sign;
+            size = std::max(left_size, right_size);
+            kernel = kernels.xor_n;
+            break;
+    }
 
-    if (_digits.size() < other._digits.size())
-        _digits.resize(other._digits.size(), 0);
+    if (&destination != &left && &destination != &right) {
+        destination._digits.clear();
+    }
+    // если destination - один из операндов, его разряды сохраняются, а хвост перезаписывается ниже
+    destination._digits.resize_for_overwrite(size);
+    unsigned int *target = destination._digits.data();
+    kernel(target, left._digits.data(), right._digits.data(), common);
+    if (size > common && &destination != &longer) {
+        std::copy(longer._digits.data() + common, longer._digits.data() + size, target + common);
+    }
 
-    for (size_t i = 0; i < _digits.size(); ++i)
-        _digits[i] ^= other._digits[i];
+    destination._sign = sign;
+    destination.optimise();
+}
 
-    optimise();
+big_int &big_int::operator<<=(size_t shift) & {
+    shift_left_into(*this, *this, shift);
     return *this;
 }
 
-big_int &big_int::operator<<=(size_t shift) & {
-    if (shift / (8 * sizeof(unsigned int)) > 0) {
-        const size_t n = shift / (8 * sizeof(unsigned int));
+big_int &big_int::operator>>=(size_t shift) & {
+    shift_right_into(*this, *this, shift);
+    return *this;
+}
 
-        std::vector<unsigned int> vec(n, 0);
+void big_int::shift_left_into(big_int &destination, const big_int &value, size_t shift) {
+    constexpr size_t bits = 8 * sizeof(unsigned int);
+    const size_t limb_shift = shift / bits;
+    const auto bit_shift = static_cast<unsigned int>(shift % bits);
+    const size_t size = value._digits.size();
+    const bool sign = value._sign;
 
-        _digits.insert(_digits.begin(), vec.begin(), vec.end());
+    if (&destination != &value) {
+        destination._digits.clear();
+    } else if (size == 0 || shift == 0) {
+        return;
+    }
 
-        shift %= 8 * sizeof(unsigned int);
+    // Разряды сдвигаются в конечный буфер за один проход сверху вниз, младшие limb_shift заполняются нулями
+    destination._digits.resize_for_overwrite(size == 0 ? 0 : size + limb_shift + (bit_shift != 0 ? 1 : 0));
+    unsigned int *data = destination._digits.data();
+    const unsigned int *source = &destination == &value ? data : value._digits.data();
+    if (size != 0) {
+        if (bit_shift != 0) {
+            lshift_n(data + limb_shift, source, size, bit_shift);
+        } else {
+            std::copy_backward(source, source + size, data + size + limb_shift);
+        }
+        std::fill(data, data + limb_shift, 0u);
     }
 
-    if (shift == 0)
-        return *this;
+    destination._sign = sign;
+    destination.optimise();
+}
+
+void big_int::shift_right_into(big_int &destination, const big_int &value, size_t shift) {
+    constexpr size_t bits = 8 * sizeof(unsigned int);
+    const size_t limb_shift = shift / bits;
+    const auto bit_shift = static_cast<unsigned int>(shift % bits);
+    const size_t size = value._digits.size();
 
-    unsigned int c = 0;
+    if (limb_shift >= size) {
+        destination._digits.clear();
+        destination._sign = true;
+        return;
+    }
 
-    for (auto &num: _digits) {
-        const auto tmp = num;
-        // сдвиг влево + добавление перенесенных старших битов
-        num = (num << shift) | c;
-        // запоминаем верхние "непоместившиеся" биты
-        c = tmp >> (8 * sizeof(unsigned int) - shift);
+    const size_t new_size = size - limb_shift;
+    const bool sign = value._sign;
+    if (&destination != &value) {
+        destination._digits.clear();
+        destination._digits.resize_for_overwrite(new_size);
     }
+    unsigned int *data = destination._digits.data();
+    const unsigned int *source = value._digits.data() + limb_shift;
+    if (bit_shift != 0) {
+        rshift_n(data, source, new_size, bit_shift);
+    } else if (data != source) {
+        std::copy(source, source + new_size, data);
+    }
+    destination._digits.resize(new_size);
 
-    if (c != 0)
-        _digits.push_back(c);
+    destination._sign = sign;
+    destination.optimise();
+}
 
-    optimise();
-    return *this;
+size_t big_int::popcount() const noexcept {
+    return select_limb_kernels().popcount_n(_digits.data(), _digits.size());
 }
 
-big_int &big_int::operator>>=(size_t shift) & {
-    if (shift / (8 * sizeof(unsigned int)) > 0) {
-        const size_t n = shift / (8 * sizeof(unsigned int));
+size_t big_int::bit_length() const noexcept {
+    return bit_length_of(_digits.data(), _digits.size());
+}
 
-        if (n > _digits.size()) {
-            _digits.clear();
-            _sign = true;
-            return *this;
-        }
-        _digits.erase(_digits.begin(), _digits.begin() + n);
+bool big_int::test_bit(size_t index) const noexcept {
+    constexpr size_t bits = 8 * sizeof(unsigned int);
+    return index / bits < _digits.size() && ((_digits[index / bits] >> (index % bits)) & 1u) != 0;
+}
 
-        shift %= 8 * sizeof(unsigned int);
+big_int &big_int::set_bit(size_t index, bool value) & {
+    constexpr size_t bits = 8 * sizeof(unsigned int);
+    const size_t limb = index / bits;
+    const unsigned int mask = 1u << (index % bits);
+    if (value) {
+        if (limb >= _digits.size()) {
+            _digits.resize(limb + 1, 0);
+        }
+        _digits[limb] |= mask;
+    } else if (limb < _digits.size()) {
+        _digits[limb] &= ~mask;
+        optimise();
     }
+    return *this;
+}
 
-    if (shift == 0) {
-        return *this;
-    }
-    unsigned int c = 0;
+big_int &big_int::plus_assign(const big_int &other, size_t shift) & {
+    return add_signed(other, false, shift);
+}
 
-    for (auto &num: _digits) {
-        const auto tmp = num;
+big_int &big_int::minus_assign(const big_int &other, size_t shift) & {
+    return add_signed(other, true, shift);
+}
 
-        num = (num >> shift) | c;
-        c = tmp << (8 * sizeof(unsigned int) - shift);
-    }
-    optimise();
+big_int &big_int::add_product(const big_int &left, const big_int &right) & {
+    accumulate_product(left, right, false);
     return *this;
 }
 
-big_int &big_int::plus_assign(const big_int &other, size_t shift) & {
-    if (this->_sign == other._sign) {
-        plus_operation_without_sign(*this, other, shift);
-        return *this;
-    }
-    // знаки разные
-    // 1 случай this >= other
-    // Знак остается от this
-    auto result = modulo_comparison(*this, other);
-    if (result == std::strong_ordering::greater || result == std::strong_ordering::equal) {
-        minus_operation_without_sign(*this, other, shift);
-        return *this;
-    }
+big_int &big_int::subtract_product(const big_int &left, const big_int &right) & {
+    accumulate_product(left, right, true);
+    return *this;
+}
 
-    // 2 случай this < other
-    big_int copy = other;
-    minus_operation_without_sign(copy, *this, shift);
-    *this = copy;
+big_int &big_int::assign_product(const big_int &left, const big_int &right) & {
+    multiply_into(*this, left, right);
     return *this;
 }
 
-big_int &big_int::minus_assign(const big_int &other, size_t shift) & {
-    return plus_assign(-other, shift);
+big_int &big_int::add_shifted(const big_int &value, size_t bits) & {
+    accumulate_shifted(value, bits, false);
+    return *this;
 }
 
-big_int &big_int::operator*=(const big_int &other) & {
-    *this = std::move((*this) * other);
-    optimise();
+big_int &big_int::subtract_shifted(const big_int &value, size_t bits) & {
+    accumulate_shifted(value, bits, true);
     return *this;
 }
 
+big_int &big_int::operator*=(const big_int &other) & {
+    return multiply_assign(other, decide_mult(other._digits.size()));
+}
+
 big_int &big_int::operator/=(const big_int &other) & {
-    big_int res = *this / other;
-    *this = std::move(res);
-    optimise();
-    return *this;
+    return divide_assign(other, decide_div(other._digits.size()));
+}
+
+void big_int::append_decimal(const big_int &value, size_t width, std::string &out) {
+    constexpr unsigned int chunk_base = 1000000000u;
+    constexpr size_t chunk_digits = 9;
+    const size_t size = value._digits.size();
+
+    if (size < TO_STRING_THRESHOLD) {
+        // Снимаем по 9 десятичных цифр одним проходом деления на 10^9
+        std::vector<unsigned int> rest(value._digits.begin(), value._digits.end());
+        std::vector<unsigned int> chunks;
+        chunks.reserve(size * 32 / 29 + 1);
+        size_t n = rest.size();
+        while (n > 0) {
+            chunks.push_back(divrem_1(rest.data(), rest.data(), n, chunk_base));
+            while (n > 0 && rest[n - 1] == 0) {
+                --n;
+            }
+        }
+
+        const std::string head = chunks.empty() ? std::string() : std::to_string(chunks.back());
+        const size_t digits = chunks.empty() ? 0 : head.size() + (chunks.size() - 1) * chunk_digits;
+        if (width > digits) {
+            out.append(width - digits, '0');
+        }
+        out += head;
+
+        char buffer[chunk_digits];
+        for (size_t i = chunks.size() - (chunks.empty() ? 0 : 1); i-- > 0;) {
+            unsigned int chunk = chunks[i];
+            for (size_t j = chunk_digits; j-- > 0;) {
+                buffer[j] = static_cast<char>('0' + chunk % 10);
+                chunk /= 10;
+            }
+            out.append(buffer, chunk_digits);
+        }
+        return;
+    }
+
+    // Делим пополам по размеру: value = high * 10^(9 * 2^level) + low
+    size_t level = 0;
+    while (radix_power(10, level + 1)._digits.size() * 2 <= size + 1) {
+        ++level;
+    }
+    const big_int &power = radix_power(10, level);
+    const size_t low_digits = chunk_digits << level;
+
+    auto [high, low] = divide_with_remainder(value, power, value.decide_div(power._digits.size()));
+    if (!high.is_zero() || width > low_digits) {
+        append_decimal(high, width > low_digits ? width - low_digits : 0, out);
+        append_decimal(low, low_digits, out);
+    } else {
+        append_decimal(low, width, out);
+    }
 }
 
 std::string big_int::to_string() const {
@@ -593,24 +2696,12 @@ std::string big_int::to_string() const {
         return "0";
     }
 
-    big_int copy = *this;
     std::string result;
-
-    // делаем положительной копию
-    copy._sign = true;
-    const big_int ten{10};
-    while (!copy.is_zero()) {
-        big_int remain;
-        remain = copy % ten;
-        remain.optimise();
-        copy /= ten;
-        copy.optimise();
-        result += remain.is_zero() ? "0" : std::to_string(remain._digits[0]);
-    }
+    result.reserve(_digits.size() * 10 + 1);
     if (_sign == false) {
         result += '-';
     }
-    std::ranges::reverse(result);
+    append_decimal(*this, 0, result);
     return result;
 }
 
@@ -620,18 +2711,237 @@ std::ostream &operator<<(std::ostream &stream, const big_int &value) {
 }
 
 std::istream &operator>>(std::istream &stream, big_int &value) {
+    // Читаем знак и цифры прямо из потока, первый нецифровой символ остаётся в потоке
+    const std::istream::sentry sentry(stream);
+    if (!sentry) {
+        return stream;
+    }
+
     std::string string_number;
-    stream >> string_number;
+    auto is_digit = [](int c) {
+        return c != std::char_traits<char>::eof() && std::isdigit(static_cast<unsigned char>(c));
+    };
+
+    int c = stream.peek();
+    if (c == '-' || c == '+') {
+        string_number += static_cast<char>(stream.get());
+        c = stream.peek();
+    }
+    while (is_digit(c)) {
+        string_number += static_cast<char>(stream.get());
+        c = stream.peek();
+    }
+
+    if (string_number.empty() || !std::isdigit(static_cast<unsigned char>(string_number.back()))) {
+        stream.setstate(std::ios::failbit);
+        return stream;
+    }
+
     value.get_new_value_from_string(string_number, 10);
     return stream;
 }
 
+size_t big_int::byte_length() const noexcept {
+    return (bit_length() + 7) / 8;
+}
+
+size_t big_int::export_bits(std::span<std::byte> bytes, std::endian order) const {
+    const size_t length = byte_length();
+    if (bytes.size() < length) {
+        throw std::invalid_argument("export_bits: buffer is shorter than the number");
+    }
+
+    if constexpr (std::endian::native == std::endian::little) {
+        // разряды уже лежат в памяти младшими байтами вперёд
+        std::memcpy(bytes.data(), _digits.data(), length);
+    } else {
+        for (size_t i = 0; i < length; ++i) {
+            bytes[i] = static_cast<std::byte>(_digits[i / 4] >> (8 * (i % 4)));
+        }
+    }
+    std::fill(bytes.begin() + static_cast<std::ptrdiff_t>(length), bytes.end(), std::byte{0});
+
+    if (order == std::endian::big) {
+        std::reverse(bytes.begin(), bytes.end());
+    }
+    return length;
+}
+
+big_int big_int::import_bits(std::span<const std::byte> bytes, std::endian order, bool sign, pp_allocator<unsigned int> allocator) {
+    big_int result(allocator);
+    const size_t count = bytes.size();
+    result._digits.resize((count + 3) / 4, 0);
+
+    if (order == std::endian::little && std::endian::native == std::endian::little) {
+        std::memcpy(result._digits.data(), bytes.data(), count);
+    } else {
+        for (size_t i = 0; i < count; ++i) {
+            const std::byte byte = order == std::endian::little ? bytes[i] : bytes[count - 1 - i];
+            result._digits[i / 4] |= std::to_integer<unsigned int>(byte) << (8 * (i % 4));
+        }
+    }
+
+    result._sign = sign;
+    result.optimise();
+    return result;
+}
+
+namespace {
+    size_t varint_size(uint64_t value) noexcept {
+        return std::max<size_t>(1, (std::bit_width(value) + 6) / 7);
+    }
+}
+
+size_t big_int::serialized_size() const noexcept {
+    const size_t length = byte_length();
+    return varint_size(2 * static_cast<uint64_t>(length)) + length;
+}
+
+void big_int::serialize(std::ostream &stream) const {
+    const size_t length = byte_length();
+
+    // Заголовок - LEB128: по 7 бит, старший бит байта означает продолжение
+    uint64_t header = 2 * static_cast<uint64_t>(length) + (_sign ? 0 : 1);
+    char buffer[10];
+    size_t header_size = 0;
+    do {
+        const auto low = static_cast<unsigned char>(header & 0x7F);
+        header >>= 7;
+        buffer[header_size++] = static_cast<char>(header != 0 ? low | 0x80 : low);
+    } while (header != 0);
+    stream.write(buffer, static_cast<std::streamsize>(header_size));
+
+    if constexpr (std::endian::native == std::endian::little) {
+        stream.write(reinterpret_cast<const char *>(_digits.data()), static_cast<std::streamsize>(length));
+    } else {
+        std::vector<std::byte> bytes(length);
+        export_bits(bytes);
+        stream.write(reinterpret_cast<const char *>(bytes.data()), static_cast<std::streamsize>(length));
+    }
+}
+
+big_int big_int::deserialize(std::istream &stream, pp_allocator<unsigned int> allocator) {
+    uint64_t header = 0;
+    for (unsigned int shift = 0;; shift += 7) {
+        const int c = stream.get();
+        if (c == std::char_traits<char>::eof()) {
+            throw std::invalid_argument("deserialize: stream ends inside the header");
+        }
+        const auto byte = static_cast<uint64_t>(static_cast<unsigned char>(c));
+        if (shift == 63 && byte > 1) {
+            throw std::invalid_argument("deserialize: header is too long");
+        }
+        header |= (byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0) {
+            break;
+        }
+    }
+
+    const uint64_t length = header / 2;
+    big_int result(allocator);
+    if constexpr (std::endian::native == std::endian::little) {
+        // Читаем прямо в разряды. Буфер растёт по мере чтения, чтобы испорченный заголовок
+        // не заставил выделить гигабайты под несуществующие данные
+        constexpr uint64_t chunk = uint64_t(1) << 20;
+        uint64_t done = 0;
+        while (done < length) {
+            const uint64_t part = std::min(chunk, length - done);
+            result._digits.resize(static_cast<size_t>((done + part + 3) / 4), 0);
+            stream.read(reinterpret_cast<char *>(result._digits.data()) + done, static_cast<std::streamsize>(part));
+            if (static_cast<uint64_t>(stream.gcount()) != part) {
+                throw std::invalid_argument("deserialize: stream ends inside the number");
+            }
+            done += part;
+        }
+        result._sign = header % 2 == 0;
+        result.optimise();
+    } else {
+        std::vector<std::byte> bytes;
+        constexpr uint64_t chunk = uint64_t(1) << 20;
+        while (bytes.size() < length) {
+            const size_t done = bytes.size();
+            const auto part = static_cast<size_t>(std::min(chunk, length - done));
+            bytes.resize(done + part);
+            stream.read(reinterpret_cast<char *>(bytes.data() + done), static_cast<std::streamsize>(part));
+            if (static_cast<size_t>(stream.gcount()) != part) {
+                throw std::invalid_argument("deserialize: stream ends inside the number");
+            }
+        }
+        result = import_bits(bytes, std::endian::little, header % 2 == 0, allocator);
+    }
+    return result;
+}
+
+big_int_view::big_int_view() noexcept : _digits(nullptr), _size(0), _sign(true) {
+}
+
+big_int_view::big_int_view(std::span<const unsigned int> digits, bool sign) noexcept
+    : _digits(digits.data()), _size(digits.size()), _sign(sign) {
+    while (_size > 0 && _digits[_size - 1] == 0) {
+        --_size;
+    }
+    if (_size == 0) {
+        _sign = true;
+    }
+}
+
+big_int_view::big_int_view(const big_int &value) noexcept
+    : _digits(value._digits.data()), _size(value._digits.size()), _sign(value._sign) {
+}
+
+std::span<const unsigned int> big_int_view::digits() const noexcept {
+    return {_digits, _size};
+}
+
+bool big_int_view::is_negative() const noexcept {
+    return !_sign;
+}
+
+bool big_int_view::is_zero() const noexcept {
+    return _size == 0;
+}
+
+std::strong_ordering operator<=>(big_int_view left, big_int_view right) noexcept {
+    if (left._sign != right._sign) {
+        return left._sign ? std::strong_ordering::greater : std::strong_ordering::less;
+    }
+    const std::strong_ordering magnitude = compare_shifted(left._digits, left._size, right._digits, right._size, 0);
+    return left._sign ? magnitude : 0 <=> magnitude;
+}
+
+bool operator==(big_int_view left, big_int_view right) noexcept {
+    return left._size == right._size && left._sign == right._sign && std::equal(left._digits, left._digits + left._size, right._digits);
+}
+
+big_int::big_int(big_int_view view, pp_allocator<unsigned int> allocator)
+    : _sign(!view.is_negative()), _digits(view.digits().begin(), view.digits().end(), allocator) {
+}
+
+big_int &big_int::operator+=(big_int_view other) & {
+    const std::span<const unsigned int> digits = other.digits();
+    if (std::less_equal<>()(_digits.data(), digits.data()) && std::less<>()(digits.data(), _digits.data() + _digits.size())) {
+        // вид на собственные разряды: при росте буфер переедет
+        return *this += big_int(other);
+    }
+    add_digits(digits.data(), digits.size(), !other.is_negative());
+    return *this;
+}
+
+big_int &big_int::operator-=(big_int_view other) & {
+    const std::span<const unsigned int> digits = other.digits();
+    if (std::less_equal<>()(_digits.data(), digits.data()) && std::less<>()(digits.data(), _digits.data() + _digits.size())) {
+        return *this -= big_int(other);
+    }
+    add_digits(digits.data(), digits.size(), other.is_negative());
+    return *this;
+}
+
 bool big_int::operator==(const big_int &other) const noexcept {
     return ((*this <=> other) == std::strong_ordering::equal);
 }
 
 big_int::big_int(const std::vector<unsigned int, pp_allocator<unsigned int> > &digits, bool sign) : _sign(sign),
-    _digits(digits) {
+    _digits(digits.begin(), digits.end(), digits.get_allocator()) {
     optimise();
 }
 
@@ -643,15 +2953,44 @@ big_int::big_int(const std::initializer_list<unsigned int> init, const bool sign
     optimise();
 }
 
-big_int::big_int(std::vector<unsigned int, pp_allocator<unsigned int> > &&digits, bool sign) noexcept : _sign(sign), _digits(std::move(digits)) {
+big_int::big_int(std::vector<unsigned int, pp_allocator<unsigned int> > &&digits, bool sign) : _sign(sign), _digits(digits.begin(), digits.end(), digits.get_allocator()) {
     optimise();
 }
 
+big_int big_int::from_radix_chunks(const std::vector<unsigned int> &chunks, size_t from, size_t to, unsigned int radix, pp_allocator<unsigned int> allocator) {
+    const size_t count = to - from;
+
+    if (count <= FROM_STRING_THRESHOLD) {
+        // Схема Горнера: result = result * radix^k + chunk, без промежуточных big_int
+        size_t digits;
+        const unsigned int chunk_base = radix_chunk(radix, digits);
+        big_int result(allocator);
+        result._digits.reserve(count);
+        for (size_t i = from; i < to; ++i) {
+            const unsigned int carry = mul_add_1(result._digits.data(), result._digits.size(), chunk_base, chunks[i]);
+            if (carry != 0) {
+                result._digits.push_back(carry);
+            }
+        }
+        return result;
+    }
+
+    // Младшая часть - ровно 2^level кусков, чтобы множитель брался из кэша степеней
+    size_t level = 0;
+    while ((size_t(2) << level) < count) {
+        ++level;
+    }
+    const size_t middle = to - (size_t(1) << level);
+
+    big_int result = from_radix_chunks(chunks, from, middle, radix, allocator);
+    result *= radix_power(radix, level);
+    result += from_radix_chunks(chunks, middle, to, radix, allocator);
+    return result;
+}
+
 void big_int::get_new_value_from_string(const std::string &num, unsigned int radix) {
     if (radix > 36 || radix < 2)
         throw std::invalid_argument("Radix must be in [2, 36], but is " + std::to_string(radix));
-    // Сохраняем все в копию, чтобы избежать потери изначального значения при ошибках
-    big_int result;
     auto it = num.begin();
     // пустая строчка
     if (it == num.end()) {
@@ -665,6 +3004,9 @@ void big_int::get_new_value_from_string(const std::string &num, unsigned int rad
         ++it;
     }
 
+    // Сначала переводим символы в цифры, чтобы при ошибке не потерять изначальное значение
+    std::vector<unsigned int> digits;
+    digits.reserve(num.end() - it);
     for (; it != num.end(); ++it) {
         const char c = *it;
         unsigned int digit;
@@ -681,17 +3023,53 @@ void big_int::get_new_value_from_string(const std::string &num, unsigned int rad
             throw std::invalid_argument(
                 "Symbol " + std::to_string(c) + " is not a valid character in radix " + std::to_string(radix));
         }
+        digits.push_back(digit);
+    }
+
+    big_int result(_digits.get_allocator());
+
+    if ((radix & (radix - 1)) == 0) {
+        // Степень двойки: биты цифр укладываются в разряды напрямую
+        const auto digit_bits = static_cast<unsigned int>(std::countr_zero(radix));
+        uint64_t buffer = 0;
+        unsigned int buffered = 0;
+        result._digits.reserve(digits.size() * digit_bits / 32 + 1);
+        for (auto digit = digits.rbegin(); digit != digits.rend(); ++digit) {
+            buffer |= static_cast<uint64_t>(*digit) << buffered;
+            buffered += digit_bits;
+            if (buffered >= 32) {
+                result._digits.push_back(static_cast<unsigned int>(buffer));
+                buffer >>= 32;
+                buffered -= 32;
+            }
+        }
+        if (buffered != 0) {
+            result._digits.push_back(static_cast<unsigned int>(buffer));
+        }
+    } else {
+        // Группируем по k цифр в один разряд по основанию radix^k, старший кусок может быть короче
+        size_t chunk_digits;
+        radix_chunk(radix, chunk_digits);
+        const size_t chunk_count = (digits.size() + chunk_digits - 1) / chunk_digits;
+        std::vector<unsigned int> chunks(chunk_count, 0);
+
+        size_t position = 0;
+        for (size_t i = 0; i < chunk_count; ++i) {
+            const size_t length = i == 0 ? digits.size() - (chunk_count - 1) * chunk_digits : chunk_digits;
+            for (size_t j = 0; j < length; ++j) {
+                chunks[i] = chunks[i] * radix + digits[position++];
+            }
+        }
 
-        big_int radix_big_int({radix}, true);
-        result *= radix_big_int;
-        result += big_int({digit});
+        result = from_radix_chunks(chunks, 0, chunk_count, radix, _digits.get_allocator());
     }
+
     result._sign = sign;
-    optimise();
+    result.optimise();
     *this = std::move(result);
 }
 
-big_int::big_int(const std::string &num, unsigned int radix, pp_allocator<unsigned int>) : _sign(true), _digits() {
+big_int::big_int(const std::string &num, unsigned int radix, pp_allocator<unsigned int> allocator) : _sign(true), _digits(allocator) {
     get_new_value_from_string(num, radix);
 }
 
@@ -734,13 +3112,18 @@ big_int &big_int::operator=(const big_int &other) {
 }
 
 
-big_int::big_int(pp_allocator<unsigned int>) : _sign(true) {
-    _digits = std::vector<unsigned int, pp_allocator<unsigned int> >();
-    optimise();
+big_int::big_int(pp_allocator<unsigned int> allocator) : _sign(true), _digits(allocator) {
+}
+
+void swap(big_int &left, big_int &right) noexcept {
+    std::swap(left._sign, right._sign);
+    left._digits.swap(right._digits);
 }
 
 big_int &big_int::multiply_assign(const big_int &other, big_int::multiplication_rule rule) & {
-    if (rule == multiplication_rule::trivial) {
+    if (this == &other) {
+        *this = square_with_rule(*this, rule);
+    } else if (rule == multiplication_rule::trivial) {
         *this = std::move(multiply_table(*this, other));
     } else if (rule == multiplication_rule::Karatsuba) {
         *this = std::move(multiply_karatsuba(*this, other));
@@ -751,18 +3134,12 @@ big_int &big_int::multiply_assign(const big_int &other, big_int::multiplication_
 }
 
 big_int &big_int::divide_assign(const big_int &other, big_int::division_rule rule) & {
-    if (rule == division_rule::trivial) {
-        *this = std::move(divide_table(*this, other));
-    }
+    *this = std::move(divide_with_remainder(*this, other, rule).first);
     return *this;
 }
 
 big_int &big_int::modulo_assign(const big_int &other, big_int::division_rule rule) & {
-    // return ((*this) -= ((*this / other) * other));
-    if (rule == division_rule::trivial) {
-        *this -= (divide_table(*this, other) * other);
-    }
-
+    *this = std::move(divide_with_remainder(*this, other, rule).second);
     return *this;
 }
 
@@ -801,6 +3178,18 @@ bool big_int::is_zero() const noexcept {
     return _digits.empty();
 }
 
+void big_int::set_parallel_threads(size_t threads) {
+    // Пул создаётся вне мьютекса; идущие умножения держат свою копию указателя на старый пул
+    std::shared_ptr<work_stealing_pool> pool = threads > 1 ? std::make_shared<work_stealing_pool>(threads - 1) : nullptr;
+    std::lock_guard<std::mutex> lock(parallel_mutex);
+    parallel_pool.swap(pool);
+}
+
+size_t big_int::parallel_threads() noexcept {
+    std::lock_guard<std::mutex> lock(parallel_mutex);
+    return parallel_pool ? parallel_pool->thread_count() + 1 : 1;
+}
+
 big_int big_int::abs() const {
     big_int result = *this;
     result._sign = true;
@@ -832,6 +3221,9 @@ void big_int::ss_ntt_transform(std::vector<uint64_t>& data, uint64_t mod, uint64
     size_t n = data.size();
     if (n == 0) return;
 
+    // Бабочки одного этапа независимы: на длинных преобразованиях они делятся между потоками пула
+    const std::shared_ptr<work_stealing_pool> pool = n >= PARALLEL_NTT_THRESHOLD ? current_parallel_pool() : nullptr;
+
     // Битовая инверсия
     for (size_t i = 1, j = 0; i < n; i++) {
         size_t bit = n >> 1;
@@ -842,31 +3234,47 @@ void big_int::ss_ntt_transform(std::vector<uint64_t>& data, uint64_t mod, uint64
             std::swap(data[i], data[j]);
     }
 
-    for (size_t len = 2; len <= n; len <<= 1) {
-        uint64_t wlen = root_val_for_L;
-        // wlen = g * (N / len) mod
-        for (size_t temp_n = n; temp_n > len; temp_n >>= 1) {
-            wlen = (wlen * wlen) % mod;
-        }
-        // Идем блоками len
-        for (size_t i = 0; i < n; i += len) {
-            uint64_t w = 1;
-            for (size_t j = 0; j < len / 2; j++) {
-                uint64_t u = data[i + j];
-                uint64_t v = (data[i + j + len / 2] * w) % mod;
-                data[i + j] = u + v;
-                if (data[i + j] >= mod) data[i + j] -= mod;
-                data[i + j + len / 2] = u - v + mod;
-                if (data[i + j + len / 2] >= mod) data[i + j + len / 2] -= mod;
-                w = (w * wlen) % mod;
+    if (mod < NTT_FAST_MODULUS_LIMIT) {
+        // умножение по Шупу требует приведённых вычетов
+        for (auto &value : data) {
+            if (value >= mod) value %= mod;
+        }
+        ntt_fast_stages(data, mod, root_val_for_L, select_ntt_kernels(), pool.get());
+    } else {
+        for (size_t len = 2; len <= n; len <<= 1) {
+            uint64_t wlen = root_val_for_L;
+            // wlen = g * (N / len) mod
+            for (size_t temp_n = n; temp_n > len; temp_n >>= 1) {
+                wlen = (wlen * wlen) % mod;
+            }
+            auto butterflies = [&data, mod, wlen, len](size_t first, size_t last) {
+                ntt_butterflies(data.data(), len, wlen, first, last, mod);
+            };
+
+            if (pool != nullptr) {
+                pool->parallel_for(n / 2, PARALLEL_NTT_GRAIN, butterflies);
+            } else {
+                butterflies(0, n / 2);
             }
         }
     }
 
     if (inverse) {
         uint64_t n_inv = ss_modInverse(n, mod);
-        for (size_t i = 0; i < n; i++) {
-            data[i] = (data[i] * n_inv) % mod;
+        auto scale = [&data, mod, n_inv](size_t first, size_t last) {
+            if (mod < NTT_FAST_MODULUS_LIMIT) {
+                select_ntt_kernels().scale(data.data(), n_inv, shoup_companion(n_inv, mod), mod, first, last);
+                return;
+            }
+            for (size_t i = first; i < last; i++) {
+                data[i] = (data[i] * n_inv) % mod;
+            }
+        };
+
+        if (pool != nullptr) {
+            pool->parallel_for(n, 2 * PARALLEL_NTT_GRAIN, scale);
+        } else {
+            scale(0, n);
         }
     }
 }
@@ -965,47 +3373,71 @@ big_int big_int::ss_multiply_core_crt(const big_int& a, const big_int& b, pp_all
     };
 
 
+    const bool squaring = &a == &b;
     std::vector<uint64_t> poly_a_coeffs = get_coeffs_lambda(a, num_chunks_a, "a");
-    std::vector<uint64_t> poly_b_coeffs = get_coeffs_lambda(b, num_chunks_b, "b");
-
-    // NTT для MOD1
-    std::vector<uint64_t> p_a_ntt1 = poly_a_coeffs;
-    std::vector<uint64_t> p_b_ntt1 = poly_b_coeffs;
-    uint64_t omega_L_mod1 = ss_power(SS_ROOT1, (SS_MOD1 - 1) / L, SS_MOD1);
-    ss_ntt_transform(p_a_ntt1, SS_MOD1, omega_L_mod1, false);
-    ss_ntt_transform(p_b_ntt1, SS_MOD1, omega_L_mod1, false);
-    std::vector<uint64_t> p_c_ntt1(L);
-    for (size_t i = 0; i < L; ++i) p_c_ntt1[i] = (p_a_ntt1[i] * p_b_ntt1[i]) % SS_MOD1;
-    uint64_t inv_omega_L_mod1 = ss_modInverse(omega_L_mod1, SS_MOD1);
-    ss_ntt_transform(p_c_ntt1, SS_MOD1, inv_omega_L_mod1, true);
-
-    // NTT для MOD2
-    std::vector<uint64_t> p_a_ntt2 = poly_a_coeffs;
-    std::vector<uint64_t> p_b_ntt2 = poly_b_coeffs;
-    uint64_t omega_L_mod2 = ss_power(SS_ROOT2, (SS_MOD2 - 1) / L, SS_MOD2);
-    ss_ntt_transform(p_a_ntt2, SS_MOD2, omega_L_mod2, false);
-    ss_ntt_transform(p_b_ntt2, SS_MOD2, omega_L_mod2, false);
-    std::vector<uint64_t> p_c_ntt2(L);
-    for (size_t i = 0; i < L; ++i) p_c_ntt2[i] = (p_a_ntt2[i] * p_b_ntt2[i]) % SS_MOD2;
-    uint64_t inv_omega_L_mod2 = ss_modInverse(omega_L_mod2, SS_MOD2);
-    ss_ntt_transform(p_c_ntt2, SS_MOD2, inv_omega_L_mod2, true);
+    std::vector<uint64_t> poly_b_coeffs = squaring ? std::vector<uint64_t>() : get_coeffs_lambda(b, num_chunks_b, "b");
+
+    // Свёртка по одному модулю; свёртки по двум модулям и прямые преобразования a и b независимы
+    const std::shared_ptr<work_stealing_pool> pool = L >= PARALLEL_NTT_THRESHOLD ? current_parallel_pool() : nullptr;
+    auto convolve = [&](uint64_t mod, uint64_t root, std::vector<uint64_t> &p_c_ntt) {
+        std::vector<uint64_t> p_a_ntt, p_b_ntt;
+        uint64_t omega_L = ss_power(root, (mod - 1) / L, mod);
+        run_both(pool.get(),
+                 [&]() {
+                     p_a_ntt = poly_a_coeffs;
+                     ss_ntt_transform(p_a_ntt, mod, omega_L, false);
+                 },
+                 [&]() {
+                     if (!squaring) {
+                         p_b_ntt = poly_b_coeffs;
+                         ss_ntt_transform(p_b_ntt, mod, omega_L, false);
+                     }
+                 });
+        const std::vector<uint64_t> &p_b_image = squaring ? p_a_ntt : p_b_ntt;
+        p_c_ntt.resize(L);
+        const ntt_modulus modulus(mod);
+        auto pointwise = [&](size_t first, size_t last) {
+            select_ntt_kernels().pointwise(p_c_ntt.data(), p_a_ntt.data(), p_b_image.data(), modulus, first, last);
+        };
+        if (pool != nullptr) {
+            pool->parallel_for(L, 2 * PARALLEL_NTT_GRAIN, pointwise);
+        } else {
+            pointwise(0, L);
+        }
+        uint64_t inv_omega_L = ss_modInverse(omega_L, mod);
+        ss_ntt_transform(p_c_ntt, mod, inv_omega_L, true);
+    };
+
+    std::vector<uint64_t> p_c_ntt1, p_c_ntt2;
+    run_both(pool.get(),
+             [&]() { convolve(SS_MOD1, SS_ROOT1, p_c_ntt1); },
+             [&]() { convolve(SS_MOD2, SS_ROOT2, p_c_ntt2); });
 
+    // Собираем коэффициенты (до 60 бит каждый) со сдвигом i * 20 бит прямо в разряды результата
     big_int final_result(alloc);
-    std::vector<uint64_t> final_result_coeffs_vec(L);
-    for (size_t i = 0; i < L; ++i) {
-        final_result_coeffs_vec[i] = ss_solve_crt_two_moduli(p_c_ntt1[i], p_c_ntt2[i]);
-    }
+    final_result._digits.assign((L * m_bits_per_chunk + 64) / std::numeric_limits<unsigned int>::digits + 3, 0);
+    unsigned int *result_data = final_result._digits.data();
+    const size_t result_size = final_result._digits.size();
 
-    for(size_t i = 0; i < L; ++i) {
-        if (final_result_coeffs_vec[i] == 0 && i >= (num_chunks_a + num_chunks_b -1) ) {
+    for (size_t i = 0; i < L; ++i) {
+        const uint64_t coefficient = ss_solve_crt_two_moduli(p_c_ntt1[i], p_c_ntt2[i]);
+        if (coefficient == 0) {
             continue;
         }
 
-        if (final_result_coeffs_vec[i] > 0) {
-            big_int term(final_result_coeffs_vec[i], alloc);
-            term <<= (i * m_bits_per_chunk);
-            final_result += term;
-        }
+        const size_t bit = i * m_bits_per_chunk;
+        const size_t position = bit / std::numeric_limits<unsigned int>::digits;
+        const auto offset = static_cast<unsigned int>(bit % std::numeric_limits<unsigned int>::digits);
+        const uint64_t low = coefficient << offset;
+        const unsigned int addend[3] = {
+            static_cast<unsigned int>(low),
+            static_cast<unsigned int>(low >> 32),
+            static_cast<unsigned int>(offset != 0 ? coefficient >> (64 - offset) : 0)
+        };
+
+        unsigned int *target = result_data + position;
+        const unsigned int carry = add_n(target, target, addend, 3);
+        add_1(target + 3, target + 3, result_size - position - 3, carry);
     }
     final_result.optimise();
     return final_result;
@@ -1024,9 +3456,10 @@ big_int big_int::multiply_schonhage_strassen(const big_int& left, const big_int&
 
     big_int abs_left_arg = left.abs();
 
-    big_int abs_right_arg = right.abs();
+    // При возведении в квадрат оба аргумента - один объект, и ядро делает одно прямое преобразование вместо двух
+    big_int abs_right_arg = &left == &right ? big_int(common_alloc) : right.abs();
 
-    big_int result_val = ss_multiply_core_crt(abs_left_arg, abs_right_arg, common_alloc);
+    big_int result_val = ss_multiply_core_crt(abs_left_arg, &left == &right ? abs_left_arg : abs_right_arg, common_alloc);
 
     if (!result_val.is_zero()) {
         result_val._sign = result_sign_is_positive;
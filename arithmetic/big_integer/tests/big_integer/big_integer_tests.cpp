@@ -1,4 +1,5 @@
 #include <gtest/gtest.h>
+#include <sstream>
 
 #include <big_int.h>
 #include <client_logger.h>
@@ -231,6 +232,465 @@ TEST(positive_tests, test9)
     delete logger;
 }
 
+TEST(positive_tests, test10)
+{
+    logger *logger = create_logger(std::vector<std::pair<std::string, logger::severity>>
+        {
+            {
+                "bigint_logs.txt",
+                logger::severity::information
+            },
+        });
+
+    std::string digits = "-9";
+    for (size_t i = 0; i < 3000; ++i)
+    {
+        digits += static_cast<char>('0' + (i * 7 + i / 13) % 10);
+    }
+
+    big_int bigint_1(digits);
+    big_int bigint_2 = bigint_1 * bigint_1;
+
+    EXPECT_TRUE(bigint_1.to_string() == digits);
+    EXPECT_TRUE(big_int(bigint_2.to_string()) == bigint_2);
+    EXPECT_TRUE(bigint_2 / bigint_1 == bigint_1);
+
+    delete logger;
+}
+
+TEST(positive_tests, test11)
+{
+    logger *logger = create_logger(std::vector<std::pair<std::string, logger::severity>>
+        {
+            {
+                "bigint_logs.txt",
+                logger::severity::information
+            },
+        });
+
+    big_int bigint_1("-1fFfFfFfF00000001", 16);
+    big_int bigint_2("zz", 36);
+    big_int bigint_3("0");
+    std::stringstream ss("  +18446744073709551616/2");
+    ss >> bigint_3;
+
+    EXPECT_TRUE(bigint_1.to_string() == "-36893488143124135937");
+    EXPECT_TRUE(bigint_2.to_string() == "1295");
+    EXPECT_TRUE(bigint_3.to_string() == "18446744073709551616");
+    EXPECT_TRUE(ss.peek() == '/');
+
+    delete logger;
+}
+
+TEST(positive_tests, test12)
+{
+    logger *logger = create_logger(std::vector<std::pair<std::string, logger::severity>>
+        {
+            {
+                "bigint_logs.txt",
+                logger::severity::information
+            },
+        });
+
+    big_int bigint_1("-123456789012345678901234567");
+    big_int bigint_2 = (big_int(1) << 521) - big_int(1);
+    big_int bigint_3 = (big_int(1) << 200) + big_int(12345);
+    big_int::montgomery_context context(bigint_2);
+
+    EXPECT_TRUE(bigint_1.pow(7).to_string() == "-437124189926872542867019500185174072717053649502737543675691925255764337806801566013527292274219275329801640628998996437998672739448996708448770447028932891841110485397807310641768823");
+    EXPECT_TRUE(bigint_1.pow(0) == big_int(1));
+    EXPECT_TRUE(context.pow(big_int(3), big_int("10000000000000000000000000000000000000007")).to_string() == "2940799015610611506619277061529328418569870105144398694739791495664842484290507612852066053775931476354973592556921247408606086867423052216755357871500368621");
+    EXPECT_TRUE(big_int("-98765432123456789").modpow(big_int(65537), big_int("1000000000000000000000000000000")).to_string() == "784222652106597559952580379371");
+    EXPECT_TRUE(bigint_3.square().to_string() == "2582249878086908589655919172003011874329705792829223512870334656853402091919972238689548657936411023352400327076490865841");
+    EXPECT_TRUE(bigint_3 * bigint_3 == bigint_3 * big_int(bigint_3));
+
+    delete logger;
+}
+
+TEST(positive_tests, test13)
+{
+    logger *logger = create_logger(std::vector<std::pair<std::string, logger::severity>>
+        {
+            {
+                "bigint_logs.txt",
+                logger::severity::information
+            },
+        });
+
+    big_int bigint_1 = (big_int(1) << 300) * big_int(3).pow(50) * big_int(7);
+    big_int bigint_2 = -((big_int(1) << 200) * big_int(3).pow(80) * big_int(11));
+    big_int bigint_3 = big_int::gcd(bigint_1, bigint_2);
+
+    EXPECT_TRUE(bigint_3.to_string() == "1153617588319010271378133306175011326520419737189530113840977835459429144159137562624");
+    EXPECT_TRUE(big_int::gcd(big_int(10).pow(200) + big_int(1), big_int(10).pow(100) + big_int(1)) == big_int(1));
+    EXPECT_TRUE(big_int::gcd(big_int(0), bigint_2) == bigint_2.abs());
+
+    big_int::divide_exact(bigint_1, bigint_2, bigint_3);
+
+    EXPECT_TRUE(bigint_1.to_string() == "8873554201597605810476922437632");
+    EXPECT_TRUE(bigint_2.to_string() == "-2264802453041139");
+
+    delete logger;
+}
+
+TEST(positive_tests, test14)
+{
+    logger *logger = create_logger(std::vector<std::pair<std::string, logger::severity>>
+        {
+            {
+                "bigint_logs.txt",
+                logger::severity::information
+            },
+        });
+
+    // 5000 разрядов идут через параллельную Карацубу, 40000 - через NTT длины 2^17 с параллельными бабочками
+    big_int bigint_1 = big_int(3).pow(150000) - big_int(1);
+    big_int bigint_2 = -(big_int(7).pow(60000) + big_int(5));
+    big_int bigint_3 = big_int(3).pow(800000) + big_int(1);
+    big_int bigint_4 = big_int(5).pow(550000) - big_int(3);
+
+    big_int product_1 = bigint_1 * bigint_2;
+    big_int square_1 = bigint_1.square();
+    big_int product_2 = bigint_3 * bigint_4;
+    big_int square_2 = bigint_3.square();
+
+    big_int::set_parallel_threads(4);
+    EXPECT_TRUE(big_int::parallel_threads() == 4);
+    EXPECT_TRUE(bigint_1 * bigint_2 == product_1);
+    EXPECT_TRUE(bigint_1.square() == square_1);
+    EXPECT_TRUE(bigint_3 * bigint_4 == product_2);
+    EXPECT_TRUE(bigint_3.square() == square_2);
+    EXPECT_TRUE(bigint_3 * bigint_4 / bigint_4 == bigint_3);
+
+    big_int::set_parallel_threads(1);
+    EXPECT_TRUE(big_int::parallel_threads() == 1);
+
+    delete logger;
+}
+
+TEST(positive_tests, test15)
+{
+    logger *logger = create_logger(std::vector<std::pair<std::string, logger::severity>>
+        {
+            {
+                "bigint_logs.txt",
+                logger::severity::information
+            },
+        });
+
+    // Векторные ядра NTT должны давать в точности X_k = sum x_i * root^(i * k) по модулю, как прямое вычисление
+    for (uint64_t mod : {uint64_t(998244353), uint64_t(1004535809)})
+    {
+        for (size_t n = 1; n <= 128; n *= 2)
+        {
+            const uint64_t root = big_int::ss_power(3, (mod - 1) / n, mod);
+            std::vector<uint64_t> data(n);
+            for (size_t i = 0; i < n; ++i)
+            {
+                data[i] = i % 3 == 0 ? mod - 1 - i : (i * 2654435761u) % mod;
+            }
+
+            std::vector<uint64_t> expected(n, 0);
+            for (size_t k = 0; k < n; ++k)
+            {
+                for (size_t i = 0; i < n; ++i)
+                {
+                    expected[k] = (expected[k] + data[i] * big_int::ss_power(root, i * k % n, mod)) % mod;
+                }
+            }
+
+            std::vector<uint64_t> image = data;
+            big_int::ss_ntt_transform(image, mod, root, false);
+            EXPECT_TRUE(image == expected);
+
+            big_int::ss_ntt_transform(image, mod, big_int::ss_modInverse(root, mod), true);
+            EXPECT_TRUE(image == data);
+        }
+    }
+
+    big_int bigint_1 = big_int(3).pow(130000) - big_int(1);
+    big_int bigint_2 = big_int(7).pow(75000) + big_int(5);
+    big_int bigint_3 = bigint_1;
+    bigint_1.multiply_assign(bigint_2, big_int::multiplication_rule::SchonhageStrassen);
+    bigint_3.multiply_assign(bigint_2, big_int::multiplication_rule::Karatsuba);
+    EXPECT_TRUE(bigint_1 == bigint_3);
+
+    delete logger;
+}
+
+TEST(positive_tests, test16)
+{
+    logger *logger = create_logger(std::vector<std::pair<std::string, logger::severity>>
+        {
+            {
+                "bigint_logs.txt",
+                logger::severity::information
+            },
+        });
+
+    // Совмещённые операции сравниваются с тем же вычислением через составные присваивания
+    auto product = [](big_int left, const big_int &right) { left *= right; return left; };
+    auto shifted = [](big_int value, size_t bits) { value <<= bits; return value; };
+
+    for (size_t size : {size_t(3), size_t(400), size_t(9000)})
+    {
+        const big_int a = big_int(3).pow(size * 20);
+        const big_int b = -big_int(7).pow(size * 11);
+        const big_int c = big_int(5).pow(size * 14) + big_int(1);
+        const big_int d = big_int(-12345);
+
+        big_int expected = product(a, b);
+        expected += product(c, d);
+        big_int x;
+        x.assign_product(a, b).add_product(c, d);
+        EXPECT_TRUE(x == expected);
+        EXPECT_TRUE(a * b + c * d == expected);
+
+        expected = product(c, d);
+        expected -= product(a, b);
+        x.assign_product(c, d).subtract_product(a, b);
+        EXPECT_TRUE(x == expected);
+        EXPECT_TRUE(c * d - a * b == expected);
+        EXPECT_TRUE(a * b == b * a);
+
+        for (size_t bits : {size_t(0), size_t(5), size_t(64), size_t(77)})
+        {
+            expected = a;
+            expected -= shifted(b, bits);
+            x = a;
+            x.subtract_shifted(b, bits);
+            EXPECT_TRUE(x == expected);
+
+            // |x| меньше вычитаемого: знак результата меняется
+            expected = d;
+            expected -= shifted(a, bits);
+            x = d;
+            x.subtract_shifted(a, bits);
+            EXPECT_TRUE(x == expected);
+
+            expected = c;
+            expected += shifted(c, bits);
+            x = c;
+            x.add_shifted(x, bits);
+            EXPECT_TRUE(x == expected);
+            EXPECT_TRUE(c + (c << bits) == expected);
+        }
+
+        // сомножители совпадают с результатом
+        expected = product(c, c);
+        expected += c;
+        x = c;
+        x.assign_product(x, x);
+        x += c;
+        EXPECT_TRUE(x == expected);
+
+        expected = a;
+        expected += product(a, b);
+        x = a;
+        x.add_product(x, b);
+        EXPECT_TRUE(x == expected);
+
+        x.subtract_product(x, big_int(1));
+        EXPECT_TRUE(x.is_zero());
+    }
+
+    // Операторы возвращают значения: результат не зависит от дальнейших изменений операндов
+    big_int a(5);
+    const big_int b(7);
+    auto sum = a + b;
+    auto t = a * b;
+    a = big_int(100);
+    t += a;
+    EXPECT_TRUE(sum == big_int(12));
+    EXPECT_TRUE(t == big_int(135));
+    EXPECT_EQ((a * b).to_string(), "700");
+    EXPECT_TRUE((b - a).is_negative());
+    EXPECT_TRUE(std::max(a, a + b) == big_int(107));
+
+    delete logger;
+}
+
+TEST(positive_tests, test17)
+{
+    logger *logger = create_logger(std::vector<std::pair<std::string, logger::severity>>
+        {
+            {
+                "bigint_logs.txt",
+                logger::severity::information
+            },
+        });
+
+    // 0x0102...: в little-endian младший байт идёт первым, в big-endian - последним
+    const big_int small("0102030405060708090a", 16);
+    std::vector<std::byte> bytes(12);
+    EXPECT_EQ(small.export_bits(bytes), 10);
+    EXPECT_EQ(std::to_integer<int>(bytes[0]), 0x0a);
+    EXPECT_EQ(std::to_integer<int>(bytes[9]), 0x01);
+    EXPECT_EQ(std::to_integer<int>(bytes[11]), 0);
+    EXPECT_TRUE(big_int::import_bits(bytes) == small);
+
+    EXPECT_EQ(small.export_bits(bytes, std::endian::big), 10);
+    EXPECT_EQ(std::to_integer<int>(bytes[0]), 0);
+    EXPECT_EQ(std::to_integer<int>(bytes[2]), 0x01);
+    EXPECT_EQ(std::to_integer<int>(bytes[11]), 0x0a);
+    EXPECT_TRUE(big_int::import_bits(bytes, std::endian::big, false) == -small);
+    EXPECT_THROW(small.export_bits(std::span(bytes).first(9)), std::invalid_argument);
+
+    std::stringstream stream;
+    const big_int values[] = {0_bi, 1_bi, big_int(-255), small, -big_int(3).pow(5000), big_int(2).pow(4095)};
+    size_t expected_size = 0;
+    for (const big_int &value : values)
+    {
+        value.serialize(stream);
+        expected_size += value.serialized_size();
+    }
+    EXPECT_EQ(stream.str().size(), expected_size);
+    EXPECT_EQ(big_int().serialized_size(), 1);
+    EXPECT_EQ(big_int(-255).serialized_size(), 2);
+    for (const big_int &value : values)
+    {
+        EXPECT_TRUE(big_int::deserialize(stream) == value);
+    }
+
+    std::stringstream truncated;
+    (-small).serialize(truncated);
+    std::stringstream cut(truncated.str().substr(0, truncated.str().size() - 1));
+    EXPECT_THROW(big_int::deserialize(cut), std::invalid_argument);
+    std::stringstream overlong(std::string(10, '\xff'));
+    EXPECT_THROW(big_int::deserialize(overlong), std::invalid_argument);
+
+    // вид на чужую память: ведущие нули не учитываются, сравнение и сложение без копирования
+    const std::vector<unsigned int> memory = {7, 0, 1, 0, 0};
+    const big_int_view view(memory);
+    const big_int same({7, 0, 1});
+    EXPECT_TRUE(view == same);
+    EXPECT_TRUE(same == view);
+    EXPECT_TRUE(big_int_view(memory, false) < view);
+    EXPECT_TRUE(view < big_int_view(small));
+    EXPECT_TRUE(big_int_view(std::span(memory).first(0), false) == big_int_view());
+    EXPECT_EQ(view.digits().size(), 3);
+
+    big_int sum = small;
+    sum += view;
+    sum -= view;
+    EXPECT_TRUE(sum == small);
+    sum = 5_bi;
+    sum -= view;
+    EXPECT_TRUE(sum == 5_bi - same);
+    sum += big_int_view(sum);
+    EXPECT_TRUE(sum == (5_bi - same) * 2_bi);
+    EXPECT_TRUE(big_int(view) == same);
+
+    delete logger;
+}
+
+TEST(positive_tests, test18)
+{
+    logger *logger = create_logger(std::vector<std::pair<std::string, logger::severity>>
+        {
+            {
+                "bigint_logs.txt",
+                logger::severity::information
+            },
+        });
+
+    // Поразрядные операции и сдвиги сверяются с поразрядным вычислением по модулям, длины - по обе стороны векторных блоков
+    unsigned int seed = 12345;
+    auto digits = [&seed](size_t size) {
+        std::vector<unsigned int> value(size);
+        for (auto &digit : value)
+        {
+            seed = seed * 1664525u + 1013904223u;
+            digit = seed;
+        }
+        return value;
+    };
+    auto combine = [](const std::vector<unsigned int> &left, const std::vector<unsigned int> &right, auto operation, bool shortest) {
+        const size_t size = shortest ? std::min(left.size(), right.size()) : std::max(left.size(), right.size());
+        std::vector<unsigned int> result(size);
+        for (size_t i = 0; i < size; ++i)
+        {
+            result[i] = operation(i < left.size() ? left[i] : 0u, i < right.size() ? right[i] : 0u);
+        }
+        return result;
+    };
+
+    const size_t sizes[] = {0, 1, 3, 4, 5, 8, 9, 17, 33, 100};
+    for (size_t left_size : sizes)
+    {
+        for (size_t right_size : sizes)
+        {
+            const std::vector<unsigned int> x = digits(left_size), y = digits(right_size);
+            const big_int a(x, left_size % 2 == 0), b(y, right_size % 3 != 0);
+
+            const big_int conjunction(combine(x, y, std::bit_and<>(), true), a.is_positive() || b.is_positive() || a.is_zero() || b.is_zero());
+            const big_int disjunction(combine(x, y, std::bit_or<>(), false), !a.is_negative() && !b.is_negative());
+            const big_int exclusive(combine(x, y, std::bit_xor<>(), false), a.is_negative() == b.is_negative());
+            EXPECT_TRUE((a & b) == conjunction);
+            EXPECT_TRUE((a | b) == disjunction);
+            EXPECT_TRUE((a ^ b) == exclusive);
+
+            big_int value = a;
+            value &= b;
+            EXPECT_TRUE(value == conjunction);
+            value = b;
+            value |= a;
+            EXPECT_TRUE(value == disjunction);
+            value = a;
+            value ^= b;
+            EXPECT_TRUE(value == exclusive);
+        }
+
+        const std::vector<unsigned int> x = digits(left_size);
+        const big_int a(x, left_size % 2 == 0);
+        big_int value = a;
+        value |= value;
+        EXPECT_TRUE(value == a);
+        value ^= value;
+        EXPECT_TRUE(value.is_zero());
+
+        std::vector<unsigned int> inverted = x;
+        for (auto &digit : inverted)
+        {
+            digit = ~digit;
+        }
+        EXPECT_TRUE(~a == big_int(inverted, a.is_negative() || a.is_zero()));
+
+        for (size_t shift : {size_t(0), size_t(1), size_t(31), size_t(32), size_t(33), size_t(100), size_t(1000)})
+        {
+            const big_int power = big_int(2).pow(shift);
+            big_int shifted = a << shift;
+            EXPECT_TRUE(shifted == a * power);
+            EXPECT_TRUE((shifted >> shift) == a);
+            EXPECT_TRUE((a >> shift) == a / power);
+            shifted >>= shift + 7;
+            EXPECT_TRUE(shifted == a / big_int(128));
+        }
+
+        EXPECT_EQ(a.bit_length(), a.is_zero() ? 0 : 32 * (left_size - 1) + std::bit_width(x.back()));
+        size_t ones = 0;
+        for (unsigned int digit : x)
+        {
+            ones += std::popcount(digit);
+        }
+        EXPECT_EQ(a.popcount(), ones);
+    }
+
+    big_int bits;
+    bits.set_bit(100).set_bit(3);
+    EXPECT_TRUE(bits == big_int(2).pow(100) + 8_bi);
+    EXPECT_TRUE(bits.test_bit(100) && bits.test_bit(3) && !bits.test_bit(4) && !bits.test_bit(5000));
+    bits.set_bit(100, false);
+    EXPECT_TRUE(bits == 8_bi);
+    EXPECT_EQ(bits.bit_length(), 4);
+    bits = -(big_int(2).pow(64) - 1_bi);
+    EXPECT_EQ(bits.popcount(), 64);
+    bits.set_bit(0, false);
+    EXPECT_TRUE(bits == -(big_int(2).pow(64) - 2_bi));
+
+    delete logger;
+}
+
 int main(
     int argc,
     char **argv)
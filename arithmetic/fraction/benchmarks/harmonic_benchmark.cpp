@@ -0,0 +1,54 @@
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+#include <fraction.h>
+
+// Сумма 1 + 1/2 + ... + 1/n в обоих режимах нормализации дроби.
+// Запуск: mp_os_arthmtc_frctn_bnchmrk [n], по умолчанию n = 100000
+
+namespace
+{
+    fraction harmonic(size_t n, fraction::normalisation_mode mode)
+    {
+        fraction sum(0_bi, 1_bi);
+        sum.set_normalisation(mode);
+        for (size_t i = 1; i <= n; ++i)
+        {
+            sum += fraction(1_bi, big_int(i));
+        }
+        return sum.set_normalisation(fraction::normalisation_mode::eager);
+    }
+
+    double measure(size_t n, fraction::normalisation_mode mode, std::string &result)
+    {
+        auto start = std::chrono::steady_clock::now();
+        fraction sum = harmonic(n, mode);
+        auto finish = std::chrono::steady_clock::now();
+        result = sum.to_string();
+        return std::chrono::duration<double, std::milli>(finish - start).count();
+    }
+}
+
+int main(
+    int argc,
+    char **argv)
+{
+    const size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 100000;
+
+    std::string eager_result, lazy_result;
+    const double eager_ms = measure(n, fraction::normalisation_mode::eager, eager_result);
+    const double lazy_ms = measure(n, fraction::normalisation_mode::lazy, lazy_result);
+
+    std::cout << "H(" << n << "): " << eager_result.size() << " characters" << std::endl;
+    std::cout << "eager: " << eager_ms << " ms" << std::endl;
+    std::cout << "lazy:  " << lazy_ms << " ms" << std::endl;
+
+    if (eager_result != lazy_result)
+    {
+        std::cerr << "results differ" << std::endl;
+        return 1;
+    }
+    return 0;
+}
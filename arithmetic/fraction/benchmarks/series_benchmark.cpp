@@ -0,0 +1,55 @@
+#include <chrono>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <string>
+
+#include <fraction.h>
+
+// Трансцендентные функции с точностью 10^(-digits).
+// Запуск: mp_os_arthmtc_frctn_srs_bnchmrk [digits], по умолчанию digits = 10000
+
+namespace
+{
+    void measure(char const *name, std::function<fraction()> const &function)
+    {
+        auto start = std::chrono::steady_clock::now();
+        fraction result = function();
+        auto finish = std::chrono::steady_clock::now();
+        std::cout << name << ": " << std::chrono::duration<double, std::milli>(finish - start).count() << " ms, "
+                  << result.to_string().size() << " characters" << std::endl;
+    }
+}
+
+int main(
+    int argc,
+    char **argv)
+{
+    const size_t digits = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10000;
+    const fraction epsilon(1_bi, big_int("1" + std::string(digits, '0')));
+
+    // аргумент той же длины, что и точность: считается по кускам
+    std::string numerator = "3", denominator = "7";
+    for (size_t i = 0; i < digits; ++i)
+    {
+        numerator += static_cast<char>('0' + (i * 7 + 3) % 10);
+        denominator += static_cast<char>('0' + (i * 3 + 1) % 10);
+    }
+    const fraction half(1_bi, 2_bi);
+    const fraction two(2_bi, 1_bi);
+    const fraction full{big_int(numerator), big_int(denominator)};
+
+    measure("pi", [&] { return fraction::pi(epsilon); });
+    measure("pi (cached)", [&] { return fraction::pi(epsilon); });
+    measure("sin(1/2)", [&] { return half.sin(epsilon); });
+    measure("cos(1/2)", [&] { return half.cos(epsilon); });
+    measure("exp(1/2)", [&] { return half.exp(epsilon); });
+    measure("ln(2)", [&] { return two.ln(epsilon); });
+    measure("arctg(1/2)", [&] { return half.arctg(epsilon); });
+    measure("arcsin(1/2)", [&] { return half.arcsin(epsilon); });
+    measure("sin(x)", [&] { return full.sin(epsilon); });
+    measure("exp(x)", [&] { return full.exp(epsilon); });
+    measure("ln(x)", [&] { return full.ln(epsilon); });
+    measure("arctg(x)", [&] { return full.arctg(epsilon); });
+    return 0;
+}
@@ -2,6 +2,7 @@
 #define MP_OS_FRACTION_H
 
 #include <big_int.h>
+#include <big_float.h>
 #include <not_implemented.h>
 #include <concepts>
 #include <cstdlib>
@@ -12,14 +13,60 @@
 class fraction final
 {
 
+public:
+
+    /** eager - every arithmetic result is reduced by the gcd right away.
+     *  lazy - results are kept as (ad + bc) / bd and reduced only for output or equality
+     *  checks, or once they grow past twice their size after the last reduction
+     */
+    enum class normalisation_mode
+    {
+        eager,
+        lazy
+    };
+
 private:
 
     big_int _numerator;
     big_int _denominator;
 
+    normalisation_mode _mode;
+    bool _reduced;
+    size_t _reduced_digits; // digits of numerator and denominator after the last reduction
+
     void optimise();
 
+    /** Moves the sign to the denominator without reducing
+     */
+    void normalise_sign() noexcept;
+
+    /** Called after a lazy operation: reduces the fraction if it has grown too much since the last reduction
+     */
+    void finish_lazy_operation();
+
+    size_t digits_count() const noexcept;
+
+    big_int signed_numerator() const;
+
+    /** Copy of *this reduced by the gcd
+     */
+    fraction reduced() const;
+
+    void add(fraction const &other, bool subtract);
+
+    void multiply(big_int numerator, big_int denominator, bool other_reduced);
+
+    /** Approximate log2 |value| from the leading digits, -inf for zero
+     */
+    static double log2_abs(big_int const &value) noexcept;
+
+    /** Number of fraction bits that keeps a rounding error below epsilon / 8
+     */
+    static size_t precision_bits(fraction const &epsilon);
 
+    /** *this as big_float with an absolute error below 2^(-bits)
+     */
+    big_float argument(size_t bits) const;
 
 public:
 
@@ -30,10 +77,26 @@ public:
 
     fraction(pp_allocator<big_int::value_type> = pp_allocator<big_int::value_type>());
 
+    /** Exact: mantissa * 2^exponent
+     */
+    explicit fraction(big_float const &value);
+
     fraction abs() const;
 
+    /** Results of operations take the mode of the left operand. Switching to eager reduces the fraction
+     */
+    fraction &set_normalisation(normalisation_mode mode) &;
+
+    normalisation_mode normalisation() const noexcept;
+
+    /** Correctly rounded
+     */
     double to_double() const;
 
+    /** Correctly rounded to precision bits
+     */
+    big_float to_big_float(size_t precision = big_float::default_precision) const;
+
 public:
 
     fraction &operator+=(fraction const &other) &;
@@ -68,11 +131,15 @@ public:
 
     std::string to_string() const;
 
-    fraction modulo_2pi() const;
+    /** *this - 2 * pi * k in [-pi, pi]
+     */
+    fraction modulo_2pi(fraction const &epsilon = fraction(1_bi, 1000000_bi)) const;
 
 public:
 
-    fraction pi();
+    /** The transcendental functions and root evaluate on big_float with the precision that epsilon requires
+     */
+    static fraction pi(fraction const &epsilon = fraction(1_bi, 1000000_bi));
 
     fraction sin(fraction const &epsilon = fraction(1_bi, 1000000_bi)) const;
 
@@ -102,12 +169,18 @@ public:
 
     fraction pow(size_t degree) const;
 
+    /** Approximate power through big_float, cheaper than the exact one when only epsilon is needed
+     */
+    fraction pow(size_t degree, fraction const &epsilon) const;
+
 public:
 
     fraction root(size_t degree, fraction const &epsilon = fraction(1_bi, 1000000_bi)) const;
 
 public:
 
+    fraction exp(fraction const &epsilon = fraction(1_bi, 1000000_bi)) const;
+
     fraction log2(fraction const &epsilon = fraction(1_bi, 1000000_bi)) const;
 
     fraction ln(fraction const &epsilon = fraction(1_bi, 1000000_bi)) const;
@@ -1,78 +1,308 @@
 #include "../include/fraction.h"
 #include "../../big_integer/include/big_int.h"
 #include <math.h>
-
-static const fraction PI(245850922_bi, 78256779_bi);
-static const fraction HALF_PI = PI / fraction(2_bi, 1_bi);
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <limits>
+#include <numbers>
 
 
 big_int gcd(big_int a, big_int b) {
-    a = a.abs();
-    b = b.abs();
-    while (!b.is_zero() && !a.is_zero()) {
-        if ((a <=> b) == std::strong_ordering::greater) {
-            a %= b;
-        } else {
-            b %= a;
-        }
-    }
-    return a + b;
+    return big_int::gcd(a, b);
 }
 
 
+namespace
+{
+    // Относительная точность, при которой значение порядка 2^magnitude получает абсолютную ошибку
+    // меньше 2^(-bits - 1): big_float ошибается меньше чем на единицу последнего разряда
+    size_t relative_precision(double magnitude, size_t bits)
+    {
+        return static_cast<size_t>(std::max(16.0, std::ceil(magnitude) + 2 + static_cast<double>(bits)));
+    }
+}
+
 
 void fraction::optimise() {
     if (_denominator.is_zero())
         throw std::invalid_argument("Denominator cannot be zero");
 
     // Eсли дробь отрицательная, знак должен быть у знаменателя
-    bool is_negative_fraction = _numerator.is_negative() != _denominator.is_negative();
+    normalise_sign();
+
+    big_int g = big_int::gcd(_numerator, _denominator);
+    if (g != 1_bi) {
+        big_int::divide_exact(_numerator, _denominator, g);
+    }
+    _reduced = true;
+    _reduced_digits = digits_count();
+}
 
-    _numerator = _numerator.abs();
-    _denominator = _denominator.abs();
+void fraction::normalise_sign() noexcept {
+    if (_numerator.is_negative()) {
+        _numerator._sign = true;
+        _denominator._sign = !_denominator._sign;
+    }
+    if (_numerator.is_zero()) {
+        _denominator._sign = true;
+    }
+}
 
-    if (is_negative_fraction)
-        _denominator = -_denominator;
+void fraction::finish_lazy_operation() {
+    normalise_sign();
+    _reduced = false;
+
+    // Сокращаем, когда дробь выросла вдвое с последнего сокращения: НОД считается редко,
+    // а размер промежуточных чисел остаётся под контролем
+    constexpr size_t min_digits = 16;
+    if (digits_count() > std::max(min_digits, 2 * _reduced_digits)) {
+        optimise();
+    }
+}
+
+size_t fraction::digits_count() const noexcept {
+    return _numerator._digits.size() + _denominator._digits.size();
+}
 
-    big_int g = gcd(_numerator, _denominator);
-    _numerator /= g;
-    _denominator /= g;
+big_int fraction::signed_numerator() const {
+    return _denominator.is_negative() ? -_numerator : _numerator;
+}
+
+double fraction::log2_abs(big_int const &value) noexcept {
+    const size_t size = value._digits.size();
+    if (size == 0) {
+        return -std::numeric_limits<double>::infinity();
+    }
+    // Два старших разряда дают 32 значащих бита
+    double top = value._digits[size - 1];
+    if (size > 1) {
+        top += std::ldexp(static_cast<double>(value._digits[size - 2]), -32);
+    }
+    return std::log2(top) + 32.0 * static_cast<double>(size - 1);
+}
+
+size_t fraction::precision_bits(fraction const &epsilon) {
+    if (epsilon._numerator.is_zero() || epsilon._denominator.is_negative()) {
+        throw std::invalid_argument("Epsilon must be greater than 0");
+    }
+    // 2^(-bits) <= epsilon / 8
+    const double bits = std::ceil(log2_abs(epsilon._denominator) - log2_abs(epsilon._numerator)) + 3;
+    return std::max<size_t>(static_cast<size_t>(std::max(bits, 0.0)), 16);
+}
+
+big_float fraction::argument(size_t bits) const {
+    // 2^(top - 1) <= |x| < 2^top, top оценивается по старшим разрядам с запасом в единицу
+    const double magnitude = log2_abs(_numerator) - log2_abs(_denominator);
+    const size_t top = magnitude > 0 ? static_cast<size_t>(std::ceil(magnitude)) + 1 : 0;
+    return to_big_float(top + bits + 2);
+}
+
+fraction fraction::reduced() const {
+    fraction result = *this;
+    if (!result._reduced) {
+        result.optimise();
+    }
+    return result;
 }
 
 
 fraction fraction::abs() const {
-    return fraction(_numerator, _denominator < 0_bi ? -_denominator : _denominator);
+    fraction result = *this;
+    result._denominator._sign = true;
+    return result;
+}
+
+fraction &fraction::set_normalisation(normalisation_mode mode) & {
+    _mode = mode;
+    if (mode == normalisation_mode::eager && !_reduced) {
+        optimise();
+    }
+    return *this;
+}
+
+fraction::normalisation_mode fraction::normalisation() const noexcept {
+    return _mode;
+}
+
+big_float fraction::to_big_float(size_t precision) const {
+    return big_float(signed_numerator(), _denominator.abs(), precision);
+}
+
+double fraction::to_double() const {
+    if (_numerator.is_zero()) {
+        return 0.0;
+    }
+
+    // 2^(top - 1) <= |x| < 2^top: одно округление сразу до числа бит, которое double хранит на этом порядке
+    long long top = static_cast<long long>(std::floor(log2_abs(_numerator) - log2_abs(_denominator))) + 1;
+    // оценка по старшим разрядам может ошибиться на единицу
+    const auto at_least = [this](long long power) {
+        // |x| >= 2^power
+        return power >= 0 ? _numerator >= (_denominator.abs() << static_cast<size_t>(power))
+                          : (_numerator << static_cast<size_t>(-power)) >= _denominator.abs();
+    };
+    while (!at_least(top - 1)) {
+        --top;
+    }
+    while (at_least(top)) {
+        ++top;
+    }
+
+    const long long allowed = std::min(53LL, top + 1074);
+    if (allowed <= 0) {
+        // |x| < 2^(-1074): к нулю, кроме значений больше половины наименьшего субнормального
+        const bool above_half = allowed == 0 && (_numerator << 1075) != _denominator.abs();
+        const double result = above_half ? std::numeric_limits<double>::denorm_min() : 0.0;
+        return _denominator.is_negative() ? -result : result;
+    }
+    return to_big_float(static_cast<size_t>(allowed)).to_double();
 }
 
 
 template<std::convertible_to<big_int> f, std::convertible_to<big_int> s>
 fraction::fraction(f &&numerator, s &&denominator)
         : _numerator(std::forward<f>(numerator)),
-          _denominator(std::forward<s>(denominator))
+          _denominator(std::forward<s>(denominator)),
+          _mode(normalisation_mode::eager),
+          _reduced(true),
+          _reduced_digits(0)
 {
     optimise();
 }
 
+// Конструктор определён здесь: инстанцируем его для пар big_int, с которыми дроби создаются снаружи
+template fraction::fraction(big_int &&, big_int &&);
+template fraction::fraction(big_int &, big_int &);
+template fraction::fraction(big_int const &, big_int const &);
+
 fraction::fraction(pp_allocator<big_int::value_type> alloc)
         : _numerator(big_int(alloc)),
-          _denominator(big_int(alloc))
+          _denominator(big_int(alloc)),
+          _mode(normalisation_mode::eager),
+          _reduced(true),
+          _reduced_digits(0)
 {}
 
+fraction::fraction(big_float const &value)
+        : fraction()
+{
+    // Мантисса нечётна, знаменатель - степень двойки: дробь уже несократима
+    const big_float::exponent_type exponent = value.exponent();
+    _numerator = value.mantissa().abs();
+    _denominator = 1_bi;
+    if (exponent > 0) {
+        _numerator <<= static_cast<size_t>(exponent);
+    } else {
+        _denominator <<= static_cast<size_t>(-exponent);
+    }
+    if (value.is_negative()) {
+        _denominator = -_denominator;
+    }
+    _reduced_digits = digits_count();
+}
 
-fraction &fraction::operator+=(fraction const &other) & {
-     // Ищем наибольшее общее кратное
-     big_int g = gcd(_denominator, other._denominator);
-     big_int lcm = (_denominator * other._denominator) / g;
 
-     // Минимальные множители, на которые надо домножить числители
-     big_int mul_this = lcm / _denominator;
-     big_int mul_other = lcm / other._denominator;
+void fraction::add(fraction const &other, bool subtract) {
+    if (_mode == normalisation_mode::eager && !other._reduced) {
+        add(other.reduced(), subtract);
+        return;
+    }
+
+    // Знак переносим в числители, знаменатели положительны
+    const big_int a = signed_numerator();
+    const big_int c = other.signed_numerator();
+    const big_int b = _denominator.abs();
+    const big_int d = other._denominator.abs();
+
+    // Числитель a * d' +- c * b' собирается прямо в _numerator: произведения школьного размера
+    // пишутся в его буфер и прибавляются со стека, без временных big_int
+    auto cross_sum = [&](big_int const &d_factor, big_int const &b_factor) {
+        _numerator.assign_product(a, d_factor);
+        if (subtract) {
+            _numerator.subtract_product(c, b_factor);
+        } else {
+            _numerator.add_product(c, b_factor);
+        }
+    };
+
+    if (_mode == normalisation_mode::lazy) {
+        cross_sum(d, b);
+        _denominator.assign_product(b, d);
+        finish_lazy_operation();
+        return;
+    }
+
+    // Обе дроби несократимы, поэтому вместо НОД(числитель, знаменатель) полного размера достаточно
+    // g = НОД(b, d) и НОД(t, g) (Кнут, 4.5.1): a/b + c/d = (t / g2) / ((b / g) * (d / g2)), t = a(d/g) + c(b/g)
+    const big_int g = big_int::gcd(b, d);
+    if (g == 1_bi) {
+        cross_sum(d, b);
+        _denominator.assign_product(b, d);
+    } else {
+        big_int b_part = b, d_part = d;
+        big_int::divide_exact(b_part, d_part, g);
+        cross_sum(d_part, b_part);
+
+        const big_int g2 = big_int::gcd(_numerator, g);
+        big_int d_rest = d;
+        if (g2 != 1_bi) {
+            big_int::divide_exact(_numerator, d_rest, g2);
+        }
+        _denominator.assign_product(b_part, d_rest);
+    }
+
+    if (_numerator.is_zero()) {
+        _denominator = 1_bi;
+    }
+    normalise_sign();
+    _reduced = true;
+    _reduced_digits = digits_count();
+}
+
+void fraction::multiply(big_int numerator, big_int denominator, bool other_reduced) {
+    big_int a = signed_numerator();
+    big_int b = _denominator.abs();
+
+    if (_mode == normalisation_mode::lazy) {
+        _numerator = a * numerator;
+        _denominator = b * denominator;
+        finish_lazy_operation();
+        return;
+    }
+
+    if (!other_reduced) {
+        fraction other(std::move(numerator), std::move(denominator));
+        numerator = std::move(other._numerator);
+        denominator = std::move(other._denominator);
+    }
+
+    // Для несократимых a/b и c/d сокращаются только перекрёстные пары a, d и c, b
+    if (a.is_zero() || numerator.is_zero()) {
+        _numerator = 0_bi;
+        _denominator = 1_bi;
+    } else {
+        const big_int g1 = big_int::gcd(a, denominator);
+        if (g1 != 1_bi) {
+            big_int::divide_exact(a, denominator, g1);
+        }
+        const big_int g2 = big_int::gcd(numerator, b);
+        if (g2 != 1_bi) {
+            big_int::divide_exact(numerator, b, g2);
+        }
+        _numerator = a * numerator;
+        _denominator = b * denominator;
+    }
+
+    normalise_sign();
+    _reduced = true;
+    _reduced_digits = digits_count();
+}
 
-     _numerator = _numerator * mul_this + other._numerator * mul_other;
-     _denominator = lcm;
 
-     optimise();
-     return *this;
+fraction &fraction::operator+=(fraction const &other) & {
+    add(other, false);
+    return *this;
 }
 
 
@@ -85,18 +315,7 @@ fraction fraction::operator+(fraction const &other) const {
 
 
 fraction &fraction::operator-=(fraction const &other) & {
-    // Ищем наибольшее общее кратное
-    big_int g = gcd(_denominator, other._denominator);
-    big_int lcm = (_denominator * other._denominator) / g;
-
-    // Минимальные множители, на которые надо домножить числители
-    big_int mul_this = lcm / _denominator;
-    big_int mul_other = lcm / other._denominator;
-
-    _numerator = _numerator * mul_this - other._numerator * mul_other;
-    _denominator = lcm;
-
-    optimise();
+    add(other, true);
     return *this;
 }
 
@@ -108,9 +327,7 @@ fraction fraction::operator-(fraction const &other) const {
 
 
 fraction &fraction::operator*=(fraction const &other) & {
-    _numerator *= other._numerator;
-    _denominator *= other._denominator;
-    optimise();
+    multiply(other.signed_numerator(), other._denominator.abs(), other._reduced);
     return *this;
 }
 
@@ -124,9 +341,10 @@ fraction &fraction::operator/=(fraction const &other) & {
     if (other._numerator == 0_bi) {
         throw std::invalid_argument("Division by zero");
     }
-    _numerator *= other._denominator;
-    _denominator *= other._numerator;
-    optimise();
+    // Умножаем на обратную дробь d / c, знак переносим в числитель
+    big_int numerator = other._denominator;
+    big_int denominator = other._numerator;
+    multiply(std::move(numerator), std::move(denominator), other._reduced);
     return *this;
 }
 
@@ -137,12 +355,21 @@ fraction fraction::operator/(fraction const &other) const {
 }
 
 fraction fraction::operator-() const {
-    return fraction(_numerator, -_denominator);
+    fraction result = *this;
+    if (!result._numerator.is_zero()) {
+        result._denominator._sign = !result._denominator._sign;
+    }
+    return result;
 }
 
 
 bool fraction::operator==(fraction const &other) const noexcept {
-    return _numerator == other._numerator && _denominator == other._denominator;
+    if (_reduced && other._reduced) {
+        return _numerator == other._numerator && _denominator == other._denominator;
+    }
+    // Хотя бы одна дробь не сокращена: сравниваем перекрёстные произведения
+    return _denominator.is_negative() == other._denominator.is_negative()
+           && _numerator * other._denominator == other._numerator * _denominator;
 }
 
 std::partial_ordering fraction::operator<=>(fraction const &other) const noexcept {
@@ -160,7 +387,8 @@ std::partial_ordering fraction::operator<=>(fraction const &other) const noexcep
 
 
 
-std::ostream &operator<<(std::ostream &stream, fraction const &obj) {
+std::ostream &operator<<(std::ostream &stream, fraction const &value) {
+    const fraction obj = value.reduced();
     if (obj._numerator == 0_bi) {
         stream << "0";
     } else {
@@ -205,6 +433,10 @@ std::istream &operator>>(std::istream &stream, fraction &obj) {
     return stream;
 }
 std::string fraction::to_string() const {
+    if (!_reduced) {
+        return reduced().to_string();
+    }
+
     std::string result;
 
     if (_numerator.is_zero()) {
@@ -224,67 +456,24 @@ std::string fraction::to_string() const {
 
 
 fraction fraction::sin(fraction const &epsilon) const {
-
-    // sin(x) = x - x^3 / 3! + x^5 / 5! - ...
-    fraction zero(0_bi, 1_bi);
-    fraction one(1_bi, 1_bi);
-    fraction two(2_bi, 1_bi);
-
-
-
-    if (epsilon <= zero)
-    {
-         throw std::invalid_argument("Epsilon must be greater than 0");
-    }
-
-    fraction x(*this);
-
-    while (x > PI)
-        x -= fraction(2_bi, 1_bi) * PI;
-    while (x < -PI)
-        x += fraction(2_bi, 1_bi) * PI;
-
-    fraction current = x;
-    fraction sum = current;
-    fraction n = one;
-
-    do
-    {
-         fraction tmp = two * n;
-         current *= -(x * x) / (tmp * (tmp + one));;
-         sum += current;
-         n += one;
-    }
-    while(current.abs() >= epsilon);
-    return sum;
- }
+    // |sin'| <= 1: достаточно аргумента с абсолютной ошибкой 2^(-bits - 4)
+    return fraction(argument(precision_bits(epsilon) + 4).sin());
+}
 
 fraction fraction::cos(fraction const &epsilon) const {
-    fraction zero(0_bi, 1_bi);
-    fraction one(1_bi, 1_bi);
-    fraction two(2_bi, 1_bi);
-
-    if (epsilon <= zero) {
-        throw std::invalid_argument("Epsilon must be greater than 0");
-    }
+    return fraction(argument(precision_bits(epsilon) + 4).cos());
+}
 
-    fraction x(*this);
 
-    while (x > PI)
-        x -= fraction(2_bi, 1_bi) * PI;
-    while (x < -PI)
-        x += fraction(2_bi, 1_bi) * PI;
-    fraction current = one;
-    fraction sum = current;
-    fraction n = one;
-    do {
-        fraction tmp = two * n;
-        current *= -(x * x) / (tmp * (tmp - one));
-        sum += current;
-        n += one;
-    } while (current.abs() >= epsilon);
+fraction fraction::modulo_2pi(fraction const &epsilon) const {
+    // Остаток от деления на 2pi точный, ошибка pi умножается на |x| / 2pi: pi берётся с точностью аргумента
+    const big_float x = argument(precision_bits(epsilon) + 4);
+    const big_float two_pi = big_float::pi(x.precision() + 4).ldexp(1);
+    return fraction(x.remainder(two_pi));
+}
 
-    return sum;
+fraction fraction::pi(fraction const &epsilon) {
+    return fraction(big_float::pi(precision_bits(epsilon) + 4));
 }
 
 
@@ -348,77 +537,44 @@ fraction fraction::pow(size_t degree) const {
         return one;
     }
 
-    fraction value = *this;
-    fraction tmp_res = one;
-
-    while (degree > 0) {
-        if (degree & 1) {
-            tmp_res *= value;
-        }
+    // Числитель и знаменатель взаимно просты, поэтому их степени тоже: сокращать не нужно
+    fraction result = *this;
+    result._numerator = _numerator.pow(degree);
+    result._denominator = _denominator.pow(degree);
+    return result;
+}
 
-        value *= value;
-        degree /= 2;
+fraction fraction::pow(size_t degree, fraction const &epsilon) const {
+    if (degree == 0) {
+        return pow(degree);
     }
 
-    return tmp_res;
+    // Результат порядка 2^(degree * log2|x|), относительная ошибка аргумента умножается на degree
+    const size_t bits = precision_bits(epsilon);
+    const double magnitude = (log2_abs(_numerator) - log2_abs(_denominator)) * static_cast<double>(degree);
+    if (_numerator.is_zero() || magnitude < -static_cast<double>(bits)) {
+        // |x|^degree < 2^(-bits) < epsilon
+        return fraction(0_bi, 1_bi);
+    }
+    const size_t precision = relative_precision(magnitude, bits);
+    return fraction(to_big_float(precision + std::bit_width(degree) + 2).pow(degree));
 }
 
-fraction fraction::root(size_t degree,fraction const &epsilon) const {
-    // Метод Ньютона: x_{k+1}  = (1 / n) * ((n - 1) * x_k + a / x_k ^ n - 1
-    // a - число, из которого извлекаем корень, x_k - текущее приближение
-     if (degree == 0)
-     {
-         throw std::invalid_argument("Root degree cannot be zero");
-     }
-     if (degree == 1)
-     {
-         return *this;
-     }
-
-     fraction zero(0_bi, 1_bi);
-     fraction one(1_bi, 1_bi);
-     fraction two(2_bi, 1_bi);
-     fraction fraction_degree(big_int(std::to_string(degree)), 1_bi);
-     fraction tmp_fraction = *this;
-
-
-     int sign = 1;
-     int l = 0;
-
-     if (tmp_fraction < zero)
-     {
-         if (degree & 1)
-         {
-             sign = -1;
-             tmp_fraction *= -one;
-         }
-         else
-         {
-             throw std::invalid_argument("Cannot take odd degree root of negative number");
-         }
-     }
-
-    // Начальное приближение - среднее арифметическое между 1 и a
-     fraction current = (one + tmp_fraction) / two;
-     fraction next = current;
-
-     fraction one_by_n(1_bi, big_int(std::to_string(degree)));
-
-     fraction prev_degree = fraction_degree - one;
-
-     do
-     {
-         current = next;
-         // Формула Ньютона
-         next = one_by_n * (prev_degree * current + tmp_fraction / current.pow(degree - 1));
-     }
-     while ((next - current).abs() >= epsilon);
+fraction fraction::root(size_t degree, fraction const &epsilon) const {
+    if (degree == 0) {
+        throw std::invalid_argument("Root degree cannot be zero");
+    }
+    if (degree == 1 || _numerator.is_zero()) {
+        return *this;
+    }
+    if (degree % 2 == 0 && _denominator.is_negative()) {
+        throw std::invalid_argument("Cannot take even degree root of negative number");
+    }
 
-     if (sign == -1)
-     {
-         return -next;
-     }
-     return next;
+    // Корень порядка 2^(log2|x| / degree), относительная ошибка аргумента делится на degree
+    const size_t bits = precision_bits(epsilon);
+    const double magnitude = (log2_abs(_numerator) - log2_abs(_denominator)) / static_cast<double>(degree);
+    return fraction(to_big_float(relative_precision(magnitude, bits) + 2).root(degree));
 }
 
 fraction fraction::log2(const fraction &epsilon) const {
@@ -427,52 +583,28 @@ fraction fraction::log2(const fraction &epsilon) const {
     return this->ln(epsilon) / ln2;
 }
 
-fraction fraction::ln(const fraction &epsilon) const {
-     // для ln(1 + x) = x - x^2 / 2 + ...
-     // если вызываем ln(5) и считаем ln(1 + 4) - очень медленно и неэффективно
-     // ln(x) = kln(2) * ln(a), a э (0,5; 1,5]
-     // y = (a-1)/(a+1)
-     // ln(a) = 2 * (y + y^3/3 + y^5/5 + ...)
-
-     static const fraction zero(0_bi, 1_bi);
-     static const fraction one(1_bi, 1_bi);
-     static const fraction two(2_bi, 1_bi);
-
-     if (*this <= zero)
-         throw std::invalid_argument("Cannot take logarithm of non-positive number");
-
-     if (*this < one) {
-         return (-one) * (one / *this).ln(epsilon); // логарифм обратного: ln(a) = -ln(1/a)
-     }
-
-     if (*this > two) {
-         fraction m = one;
-         fraction dividend = *this;
-
-         while ((dividend /= two) > one)
-             m += one;
-
-         return dividend.ln(epsilon) + m * two.ln(epsilon);
-     }
-
-     if (epsilon <= zero)
-         throw std::invalid_argument("Epsilon must be greater than 0");
-
-     fraction x = (*this - one) / (*this + one);
-     fraction current = x;
-     fraction sum = x;
-     fraction x_squared = x * x;
-     fraction n = one;
+fraction fraction::exp(fraction const &epsilon) const {
+    // Результат порядка 2^(x * log2(e)): абсолютная ошибка аргумента должна быть в exp(x) раз меньше epsilon
+    const size_t bits = precision_bits(epsilon);
+    const double magnitude = _numerator.is_zero() ? 0.0
+            : std::exp2(log2_abs(_numerator) - log2_abs(_denominator)) * std::numbers::log2e;
+    if (!_denominator.is_negative() && magnitude > 0x1p62) {
+        throw std::overflow_error("Exponent overflow");
+    }
+    const size_t extra = _denominator.is_negative() ? 0 : static_cast<size_t>(std::ceil(magnitude));
+    return fraction(argument(bits + extra + 4).exp());
+}
 
-     while (current.abs() >= epsilon) {
-         n += two;
-         current = current * x_squared;
-         fraction term = current / n;
-         sum += term;
-     }
+fraction fraction::ln(const fraction &epsilon) const {
+    // Абсолютная ошибка логарифма равна относительной ошибке аргумента
+    if (_numerator.is_zero() || _denominator.is_negative()) {
+        throw std::invalid_argument("Cannot take logarithm of non-positive number");
+    }
 
-     return sum * two;
- }
+    const size_t bits = precision_bits(epsilon);
+    const double magnitude = std::log2(std::abs(log2_abs(_numerator) - log2_abs(_denominator)) + 1);
+    return fraction(to_big_float(std::max(relative_precision(magnitude, bits), bits + 4)).ln());
+}
 
 
 
@@ -484,58 +616,41 @@ fraction fraction::lg(fraction const &epsilon) const
 
 fraction fraction::arctg(fraction const &epsilon) const
 {
-    // arctg(x) == arcsin( x / root(1 + x ^ 2)
-    return (*this / ((fraction(1_bi, 1_bi)) + pow(2)).root(2, epsilon)).arcsin(epsilon);
+    return fraction(argument(precision_bits(epsilon) + 4).atan());
 }
 
 fraction fraction::arcctg(fraction const &epsilon) const {
-    // arctg(x) == arccos( x / root(1 + x ^ 2)
-    return (*this / ((fraction(1_bi, 1_bi)) + pow(2)).root(2, epsilon)).arccos(epsilon);
+    // arcctg(x) == pi/2 - arctg(x)
+    return pi(epsilon) / fraction(2_bi, 1_bi) - arctg(epsilon);
 }
 
 fraction fraction::arcsin(fraction const &epsilon) const
 {
-    // Рекуррентная формула: a_{n+1} == a_n *  ((2 * n - 1) ^ 2 / ((2 * n) * (2 * n + 1))) * x ^ 2
-    fraction zero(0_bi, 1_bi);
-    fraction one(1_bi, 1_bi);
-    fraction two(2_bi, 1_bi);
-
-    if (epsilon <= zero)
-    {
-        throw std::invalid_argument("Epsilon must greater than 0");
-    }
+    // arcsin(x) = arctg(x / root(1 - x ^ 2)), см. big_float::asin
+    const fraction one(1_bi, 1_bi);
 
     if (abs() > one)
     {
         throw std::invalid_argument("Module of number must be not greater than 1");
     }
 
-    if (abs() > fraction(4_bi, 5_bi))
-    {
-        // if x > 0,8 : arcsin(x) = pi/2 − arcsin(root(1 − x ^ 2))
-        return PI / two - (one - pow(2)).root(2,epsilon).arcsin(epsilon);
-    }
-
-    fraction const &x = *this;
-    fraction current = x;
-    fraction sum = current;
-    fraction n = one;
+    const bool negative = _denominator.is_negative() && !_numerator.is_zero();
 
-    do
+    if (abs() == one)
     {
-        fraction tmp = two * n;
-        current *= (tmp - one).pow(2) * x * x / (tmp * (tmp + one));
-        sum += current;
-        n += one;
+        const fraction half_pi = pi(epsilon) / fraction(2_bi, 1_bi);
+        return negative ? -half_pi : half_pi;
     }
-    while(current.abs() >= epsilon);
 
-    return sum;
+    // производная 1 / root(1 - x ^ 2) растёт у единицы: ошибка аргумента усиливается
+    const fraction gap = one - abs();
+    const size_t extra = static_cast<size_t>(std::max(0.0, std::ceil(-(log2_abs(gap._numerator) - log2_abs(gap._denominator)) / 2))) + 1;
+    return fraction(argument(precision_bits(epsilon) + extra + 4).asin());
 }
 
 
 fraction fraction::arccos(const fraction &epsilon) const {
-    return HALF_PI - this->arcsin(epsilon);
+    return pi(epsilon) / fraction(2_bi, 1_bi) - this->arcsin(epsilon);
 }
 
 
@@ -599,6 +599,168 @@ TEST(logariphmTests, log10)
     logger->debug(a.to_string() + "  " + " = " + c.to_string());
 }
 
+TEST(seriesTests, exp)
+{
+    logger *logger = create_logger(std::vector<std::pair<std::string, logger::severity>>{
+            {"bigint_logs.txt", logger::severity::information},
+    });
+
+    const fraction a{big_int("1"), big_int("1")};
+    const auto epsilon = fraction(1_bi, big_int("1" + std::string(60, '0')));
+    const auto c = a.exp(epsilon);
+    const auto expected = fraction(big_int("27182818284590452353602874713526624977572470936999595749669676277"),
+                                   big_int("1" + std::string(64, '0')));
+    const auto diff = abs(c - expected);
+
+    EXPECT_TRUE(diff <= epsilon) << "Ожидалось: " << expected << "\nПолучено: " << c << "\nРазница: " << diff
+                                 << "\nДопустимая ошибка: " << epsilon;
+    EXPECT_TRUE(fraction(-1_bi, 1_bi).exp(epsilon) * c - fraction(1_bi, 1_bi) <= epsilon * fraction(4_bi, 1_bi));
+    logger->debug(a.to_string() + "  " + " = " + c.to_string());
+}
+
+TEST(seriesTests, machin)
+{
+    logger *logger = create_logger(std::vector<std::pair<std::string, logger::severity>>{
+            {"bigint_logs.txt", logger::severity::information},
+    });
+
+    // pi = 16 arctg(1/5) - 4 arctg(1/239)
+    const auto epsilon = fraction(1_bi, big_int("1" + std::string(100, '0')));
+    const auto c = fraction(16_bi, 1_bi) * fraction(1_bi, 5_bi).arctg(epsilon)
+                   - fraction(4_bi, 1_bi) * fraction(1_bi, 239_bi).arctg(epsilon);
+    const auto expected = fraction(big_int("314159265358979323846264338327950288419716939937510582097494459230781640628620899862803482534211706798214"),
+                                   big_int("1" + std::string(104, '0')));
+    const auto diff = abs(c - expected);
+
+    EXPECT_TRUE(diff <= epsilon * fraction(20_bi, 1_bi)) << "Ожидалось: " << expected << "\nПолучено: " << c
+                                                         << "\nРазница: " << diff;
+    logger->debug(c.to_string());
+}
+
+TEST(seriesTests, identities)
+{
+    logger *logger = create_logger(std::vector<std::pair<std::string, logger::severity>>{
+            {"bigint_logs.txt", logger::severity::information},
+    });
+
+    const fraction a{big_int("7"), big_int("3")};
+    const fraction b{big_int("3"), big_int("2")};
+    const auto epsilon = fraction(1_bi, big_int("1" + std::string(200, '0')));
+    const auto s = a.sin(epsilon);
+    const auto c = a.cos(epsilon);
+    const auto one = fraction(1_bi, 1_bi);
+
+    EXPECT_TRUE(abs(s * s + c * c - one) <= epsilon * fraction(10_bi, 1_bi));
+    EXPECT_TRUE(abs(b.exp(epsilon).ln(epsilon) - b) <= epsilon * fraction(10_bi, 1_bi));
+    EXPECT_TRUE(abs(fraction(1_bi, 2_bi).arcsin(epsilon) * fraction(3_bi, 1_bi)
+                    - fraction(1_bi, 1_bi).arctg(epsilon) * fraction(2_bi, 1_bi)) <= epsilon * fraction(10_bi, 1_bi));
+    logger->debug(s.to_string());
+}
+
+TEST(seriesTests, pi)
+{
+    logger *logger = create_logger(std::vector<std::pair<std::string, logger::severity>>{
+            {"bigint_logs.txt", logger::severity::information},
+    });
+
+    const auto epsilon = fraction(1_bi, big_int("1" + std::string(100, '0')));
+    const auto expected = fraction(big_int("31415926535897932384626433832795028841971693993751058209749445923078164062862089986280348253421170679821"),
+                                   big_int("1" + std::string(103, '0')));
+    // второй запрос обслуживается из кэша, посчитанного для большей точности
+    const auto precise = fraction::pi(fraction(1_bi, big_int("1" + std::string(300, '0'))));
+    const auto c = fraction::pi(epsilon);
+
+    EXPECT_TRUE(abs(c - expected) <= epsilon) << "Ожидалось: " << expected << "\nПолучено: " << c;
+    EXPECT_TRUE(abs(precise - c) <= epsilon);
+    logger->debug(c.to_string());
+}
+
+TEST(seriesTests, reduction)
+{
+    logger *logger = create_logger(std::vector<std::pair<std::string, logger::severity>>{
+            {"bigint_logs.txt", logger::severity::information},
+    });
+
+    // sin(10^22): аргумент сокращается на 2pi * 1591549430918953357689
+    const fraction a{big_int("10000000000000000000000"), big_int("1")};
+    const auto epsilon = fraction(1_bi, big_int("1" + std::string(40, '0')));
+    const auto c = a.sin(epsilon);
+    const auto expected = fraction(big_int("-852200849767188801772705893753029368261762150410"),
+                                   big_int("1" + std::string(48, '0')));
+    const auto diff = abs(c - expected);
+
+    EXPECT_TRUE(diff <= epsilon) << "Ожидалось: " << expected << "\nПолучено: " << c << "\nРазница: " << diff;
+    EXPECT_TRUE(abs(a.modulo_2pi(epsilon).sin(epsilon) - c) <= epsilon * fraction(2_bi, 1_bi));
+    EXPECT_TRUE(abs(a.modulo_2pi(epsilon)) <= fraction::pi(epsilon));
+    logger->debug(c.to_string());
+}
+
+TEST(bigFloatTests, conversions)
+{
+    logger *logger = create_logger(std::vector<std::pair<std::string, logger::severity>>{
+            {"bigint_logs.txt", logger::severity::information},
+    });
+
+    const fraction a{big_int("-22"), big_int("7")};
+    const big_float b = a.to_big_float(100);
+    const auto epsilon = fraction(1_bi, big_int("1" + std::string(50, '0')));
+
+    // дробь из big_float точна, обратное преобразование округляет к ближайшему
+    EXPECT_TRUE(fraction(b).to_big_float(100) == b);
+    EXPECT_TRUE(abs(fraction(b) - a) <= abs(a) * fraction(1_bi, 1_bi << 100));
+    EXPECT_TRUE(fraction(big_float(0.375)) == fraction(3_bi, 8_bi));
+    EXPECT_EQ(a.to_double(), -22.0 / 7);
+    EXPECT_EQ(fraction(1_bi, 10_bi).to_double(), 0.1);
+    EXPECT_EQ(fraction(1_bi, 1_bi << 1074).to_double(), 4.9406564584124654e-324);
+
+    const auto root = fraction(2_bi, 1_bi).root(2, epsilon);
+    EXPECT_TRUE(abs(root * root - fraction(2_bi, 1_bi)) <= epsilon * fraction(4_bi, 1_bi));
+    EXPECT_TRUE(fraction(big_int(-27), 8_bi).root(3, epsilon) == fraction(big_int(-3), 2_bi));
+    EXPECT_TRUE(abs(fraction(3_bi, 2_bi).pow(200, epsilon) - fraction(3_bi, 2_bi).pow(200)) <= epsilon);
+    logger->debug(root.to_string());
+}
+
+TEST(lazyTests, harmonic)
+{
+    logger *logger = create_logger(std::vector<std::pair<std::string, logger::severity>>{
+            {"bigint_logs.txt", logger::severity::information},
+    });
+
+    fraction eager(0_bi, 1_bi);
+    fraction lazy(0_bi, 1_bi);
+    lazy.set_normalisation(fraction::normalisation_mode::lazy);
+    for (int i = 1; i <= 20; ++i)
+    {
+        eager += fraction(1_bi, big_int(i));
+        lazy += fraction(1_bi, big_int(i));
+    }
+
+    EXPECT_TRUE(lazy.normalisation() == fraction::normalisation_mode::lazy);
+    EXPECT_TRUE(lazy == eager);
+    EXPECT_TRUE(lazy.to_string() == "55835135/15519504");
+    EXPECT_TRUE(eager.to_string() == "55835135/15519504");
+    logger->debug(lazy.to_string());
+}
+
+TEST(lazyTests, chain)
+{
+    logger *logger = create_logger(std::vector<std::pair<std::string, logger::severity>>{
+            {"bigint_logs.txt", logger::severity::information},
+    });
+
+    fraction x(2_bi, 3_bi);
+    x.set_normalisation(fraction::normalisation_mode::lazy);
+    for (int i = 0; i < 10; ++i)
+    {
+        x = x * fraction(3_bi, 4_bi) - fraction(1_bi, 7_bi);
+    }
+
+    EXPECT_TRUE(x < fraction(0_bi, 1_bi));
+    EXPECT_TRUE(x.to_string() == "-263039/524288");
+    EXPECT_TRUE(x.set_normalisation(fraction::normalisation_mode::eager).to_string() == "-263039/524288");
+    logger->debug(x.to_string());
+}
+
 auto main(int argc, char **argv) -> int
 {
     testing::InitGoogleTest(&argc, argv);
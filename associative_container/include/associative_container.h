@@ -13,6 +13,14 @@ concept compator = requires(const compare c, const tkey& lhs, const tkey& rhs) /
 // объект compare является копируемым и дефолтно инициализируемым
 // (можно ли создать объект типа compare без параметров, т.е. констурктором по умолчанию)
 
+// прозрачный компаратор (std::less<> и т.п.) объявляет is_transparent и сравнивает ключ с любым совместимым типом,
+// поэтому поиск по, например, std::string_view не создаёт временный std::string
+template<typename compare>
+concept transparent_compare = requires
+                              {
+                                  typename compare::is_transparent;
+                              };
+
 template<typename f_iter, typename tkey, typename tval>
 concept input_iterator_for_pair = std::input_iterator<f_iter> // требование для итератора быть входным
         && std::same_as<typename std::iterator_traits<f_iter>::value_type, std::pair<tkey, tval>>;  // тип значений на которые указывает итератор f_iter является парой std::pair<tkey, tval>
@@ -21,6 +29,15 @@ concept input_iterator_for_pair = std::input_iterator<f_iter> // требова
         // поэтому мы явно указываем, что это тип,
         // с помощью typename.
 
+// метка для конструкторов и insert_range: диапазон уже упорядочен по compare и не содержит повторяющихся ключей,
+// поэтому дерево можно построить сразу сбалансированным, без поиска места для каждого элемента (как std::sorted_unique)
+struct sorted_unique_t
+{
+    explicit sorted_unique_t() = default;
+};
+
+inline constexpr sorted_unique_t sorted_unique{};
+
 
 /**
  * You will strongly need this while doing your cursal work
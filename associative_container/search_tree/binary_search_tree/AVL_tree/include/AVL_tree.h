@@ -5,40 +5,82 @@
 
 namespace __detail
 {
+    template<bool order_statistics>
     class AVL_TAG;
 
-    template<typename tkey, typename tvalue, typename compare>
-    class bst_impl<tkey, tvalue, compare, AVL_TAG>
+    template<typename tkey, typename tvalue, typename compare, bool order_statistics>
+    class bst_impl<tkey, tvalue, compare, AVL_TAG<order_statistics>>
     {
-        friend class binary_search_tree<tkey, tvalue, compare, AVL_TAG>;
+        friend class binary_search_tree<tkey, tvalue, compare, AVL_TAG<order_statistics>>;
         template<class ...Args>
-        static binary_search_tree<tkey, tvalue, compare, AVL_TAG>::node* create_node(binary_search_tree<tkey, tvalue, compare, AVL_TAG>& cont, Args&& ...args);
+        static binary_search_tree<tkey, tvalue, compare, AVL_TAG<order_statistics>>::node* create_node(binary_search_tree<tkey, tvalue, compare, AVL_TAG<order_statistics>>& cont, Args&& ...args);
 
-        static void delete_node(binary_search_tree<tkey, tvalue, compare, AVL_TAG>& cont, binary_search_tree<tkey, tvalue, compare, AVL_TAG>::node**);
+        static void delete_node(binary_search_tree<tkey, tvalue, compare, AVL_TAG<order_statistics>>& cont, binary_search_tree<tkey, tvalue, compare, AVL_TAG<order_statistics>>::node**);
+
+        // New unlinked node with the value and metadata of source, child of parent
+        static binary_search_tree<tkey, tvalue, compare, AVL_TAG<order_statistics>>::node* clone_node(binary_search_tree<tkey, tvalue, compare, AVL_TAG<order_statistics>>& cont, const binary_search_tree<tkey, tvalue, compare, AVL_TAG<order_statistics>>::node* source, binary_search_tree<tkey, tvalue, compare, AVL_TAG<order_statistics>>::node* parent);
 
         //Does not invalidate node*, needed for splay tree
-        static void post_search(binary_search_tree<tkey, tvalue, compare, AVL_TAG>::node**){}
+        static void post_search(binary_search_tree<tkey, tvalue, compare, AVL_TAG<order_statistics>>::node**){}
 
         //Does not invalidate node*
-        static void post_insert(binary_search_tree<tkey, tvalue, compare, AVL_TAG>& cont, binary_search_tree<tkey, tvalue, compare, AVL_TAG>::node**);
+        static void post_insert(binary_search_tree<tkey, tvalue, compare, AVL_TAG<order_statistics>>& cont, binary_search_tree<tkey, tvalue, compare, AVL_TAG<order_statistics>>::node**);
+
+        // Metadata of a node of a tree built from sorted data, called once both subtrees are linked
+        static void post_build(binary_search_tree<tkey, tvalue, compare, AVL_TAG<order_statistics>>::node*, size_t, size_t);
+
+        static void erase(binary_search_tree<tkey, tvalue, compare, AVL_TAG<order_statistics>>& cont, binary_search_tree<tkey, tvalue, compare, AVL_TAG<order_statistics>>::node**);
+
+        static void swap(binary_search_tree<tkey, tvalue, compare, AVL_TAG<order_statistics>>& lhs, binary_search_tree<tkey, tvalue, compare, AVL_TAG<order_statistics>>& rhs) noexcept;
+
+        using tree = binary_search_tree<tkey, tvalue, compare, AVL_TAG<order_statistics>>;
+        using base_node = typename tree::node;
+
+        // Detached subtree for join and split: the root has no parent, nullptr for an empty one
+        struct subtree
+        {
+            base_node* root = nullptr;
+        };
+
+        static subtree make_subtree(tree& cont, base_node* root) noexcept;
 
-        static void erase(binary_search_tree<tkey, tvalue, compare, AVL_TAG>& cont, binary_search_tree<tkey, tvalue, compare, AVL_TAG>::node**);
+        // Both subtrees of the root and the root itself left without children
+        static std::tuple<subtree, base_node*, subtree> expose(tree& cont, subtree source) noexcept;
 
-        static void swap(binary_search_tree<tkey, tvalue, compare, AVL_TAG>& lhs, binary_search_tree<tkey, tvalue, compare, AVL_TAG>& rhs) noexcept;
+        // Keys of left < key of middle < keys of right. O(|height(left) - height(right)| + 1)
+        static subtree join(tree& cont, subtree left, base_node* middle, subtree right) noexcept;
+
+        // Middle goes down the spine of the higher tree to a subtree of about the height of the other one
+        static subtree join_right(tree& cont, subtree left, base_node* middle, subtree right) noexcept;
+        static subtree join_left(tree& cont, subtree left, base_node* middle, subtree right) noexcept;
+
+        static size_t height(const base_node* node) noexcept;
+
+        static void link(base_node* node, base_node* left, base_node* right) noexcept;
+
+        // Height and size of node from its children
+        static void update(tree& cont, base_node* node) noexcept;
+
+        // These rotations return the new root of the subtree and leave relinking it to the caller, never touching cont._root
+        static base_node* rotate_left(tree& cont, base_node* node) noexcept;
+        static base_node* rotate_right(tree& cont, base_node* node) noexcept;
+
+        static base_node* rebalance(tree& cont, base_node* node) noexcept;
     };
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare = std::less<tkey>>
+template<typename tkey, typename tvalue, compator<tkey> compare = std::less<tkey>, bool order_statistics = false>
 class AVL_tree final:
-        public binary_search_tree<tkey, tvalue, compare, __detail::AVL_TAG>
+        public binary_search_tree<tkey, tvalue, compare, __detail::AVL_TAG<order_statistics>>
 {
-    using parent = binary_search_tree<tkey, tvalue, compare, __detail::AVL_TAG>;
-    friend class __detail::bst_impl<tkey, tvalue, compare, __detail::AVL_TAG>;
+    using parent = binary_search_tree<tkey, tvalue, compare, __detail::AVL_TAG<order_statistics>>;
+    friend class __detail::bst_impl<tkey, tvalue, compare, __detail::AVL_TAG<order_statistics>>;
 private:
 
     struct node final: public parent::node
     {
-        size_t height;
+        // Height of the subtree; an AVL tree of 2^64 nodes is below 93 levels high
+        unsigned char height;
 
         void recalculate_height() noexcept;
 
@@ -50,7 +92,6 @@ private:
         template<class ...Args>
         node(parent::node* par, Args&&... args);
 
-        ~node() noexcept override =default;
     };
 
 public:
@@ -171,8 +212,8 @@ public:
 
     class infix_iterator : public parent::infix_iterator
     {
-        friend binary_search_tree<tkey, tvalue, compare, __detail::AVL_TAG>;
-        friend class __detail::bst_impl<tkey, tvalue, compare, __detail::AVL_TAG>;
+        friend binary_search_tree<tkey, tvalue, compare, __detail::AVL_TAG<order_statistics>>;
+        friend class __detail::bst_impl<tkey, tvalue, compare, __detail::AVL_TAG<order_statistics>>;
     public:
 
         using value_type = parent::infix_iterator::value_type;
@@ -522,6 +563,16 @@ public:
              pp_allocator<value_type> alloc = pp_allocator<value_type>(),
              logger* logger = nullptr);
 
+    template<input_iterator_for_pair<tkey, tvalue> iterator>
+    AVL_tree(sorted_unique_t, iterator begin, iterator end, const compare& cmp = compare(),
+             pp_allocator<value_type> alloc = pp_allocator<value_type>(),
+             logger* logger = nullptr);
+
+    template<std::ranges::input_range Range>
+    AVL_tree(sorted_unique_t, Range&& range, const compare& cmp = compare(),
+             pp_allocator<value_type> alloc = pp_allocator<value_type>(),
+             logger* logger = nullptr);
+
 public:
 
     ~AVL_tree() noexcept final =default;
@@ -551,6 +602,17 @@ public:
     template<class ...Args>
     infix_iterator emplace_or_assign(Args&&...args);
 
+    template<class ...Args>
+    std::pair<infix_iterator, bool> try_emplace(const tkey& key, Args&&...args);
+    template<class ...Args>
+    std::pair<infix_iterator, bool> try_emplace(tkey&& key, Args&&...args);
+
+    infix_iterator insert(typename parent::infix_const_iterator hint, const value_type&);
+    infix_iterator insert(typename parent::infix_const_iterator hint, value_type&&);
+
+    template<class ...Args>
+    infix_iterator emplace_hint(typename parent::infix_const_iterator hint, Args&&...args);
+
     infix_iterator find(const tkey&);
     infix_const_iterator find(const tkey&) const;
 
@@ -560,15 +622,69 @@ public:
     infix_iterator upper_bound(const tkey&);
     infix_const_iterator upper_bound(const tkey&) const;
 
+    infix_iterator lower_bound(typename parent::infix_const_iterator hint, const tkey&);
+    infix_const_iterator lower_bound(typename parent::infix_const_iterator hint, const tkey&) const;
+
+    infix_iterator select(size_t k);
+    infix_const_iterator select(size_t k) const;
+
+    infix_iterator advance(typename parent::infix_const_iterator it, ptrdiff_t n);
+    infix_const_iterator advance(typename parent::infix_const_iterator it, ptrdiff_t n) const;
+
+    template<typename K> requires transparent_compare<compare>
+    infix_iterator find(const K&);
+    template<typename K> requires transparent_compare<compare>
+    infix_const_iterator find(const K&) const;
+
+    template<typename K> requires transparent_compare<compare>
+    infix_iterator lower_bound(const K&);
+    template<typename K> requires transparent_compare<compare>
+    infix_const_iterator lower_bound(const K&) const;
+
+    template<typename K> requires transparent_compare<compare>
+    infix_iterator upper_bound(const K&);
+    template<typename K> requires transparent_compare<compare>
+    infix_const_iterator upper_bound(const K&) const;
+
     infix_iterator erase(infix_iterator pos);
     infix_iterator erase(infix_const_iterator pos);
 
     infix_iterator erase(infix_iterator first, infix_iterator last);
     infix_iterator erase(infix_const_iterator first, infix_const_iterator last);
 
+    /** Tree of left, middle and right made of their nodes in O(|height(left) - height(right)| + 1).
+     *  Every key of left must be less than middle.first and every key of right greater; this is trusted, not checked.
+     *  The nodes of right are copied if its allocator differs from the one of left
+     */
+    static AVL_tree join(AVL_tree&& left, value_type middle, AVL_tree&& right);
+
+    /** Splits tree into the keys less than key and the rest in O(log n) relinking. Without order statistics
+     *  the size of the first part is counted by walking it
+     */
+    static std::pair<AVL_tree, AVL_tree> split(AVL_tree&& tree, const tkey& key);
+
+    /** Set operations by split and join: O(m log(n / m + 1)) for trees of m <= n elements, against O(m log n)
+     *  of inserting or erasing one by one. With a pool the halves of the upper levels of the recursion run in parallel.
+     *  On equal keys *this keeps its value. The nodes of an rvalue other are reused when it shares the allocator
+     */
+    void union_with(AVL_tree&& other, work_stealing_pool* pool = nullptr);
+    void union_with(const AVL_tree& other, work_stealing_pool* pool = nullptr);
+
+    void intersect_with(const AVL_tree& other, work_stealing_pool* pool = nullptr);
+
+    void difference(const AVL_tree& other, work_stealing_pool* pool = nullptr);
+
+    /** Sorts the range, builds a balanced tree of it and unions it in; of repeated keys the first one is inserted
+     */
+    template<std::ranges::input_range R>
+    void insert_range(R&& rg);
+    template<std::ranges::input_range R>
+    void insert_range(R&& rg, work_stealing_pool* pool);
+
     using parent::erase;
     using parent::insert;
     using parent::insert_or_assign;
+    using parent::insert_range;
 };
 
 
@@ -590,43 +706,71 @@ AVL_tree(std::initializer_list<std::pair<tkey, tvalue>> data, const compare& cmp
          pp_allocator<U> alloc = pp_allocator<U>(),
          logger* logger = nullptr) -> AVL_tree<tkey, tvalue, compare>;
 
+template<typename compare, typename U, typename iterator>
+AVL_tree(sorted_unique_t, iterator begin, iterator end, const compare& cmp = compare(),
+         pp_allocator<U> alloc = pp_allocator<U>(),
+         logger* logger = nullptr) -> AVL_tree<const typename std::iterator_traits<iterator>::value_type::first_type, typename std::iterator_traits<iterator>::value_type::second_type, compare>;
+
+template<typename compare, typename U, std::ranges::forward_range Range>
+AVL_tree(sorted_unique_t, Range&& range, const compare& cmp = compare(),
+         pp_allocator<U> alloc = pp_allocator<U>(),
+         logger* logger = nullptr) -> AVL_tree<const typename std::iterator_traits<typename std::ranges::iterator_t<Range>>::value_type::first_type, typename std::iterator_traits<typename std::ranges::iterator_t<Range>>::value_type::second_type, compare>;
+
 namespace __detail
 {
-    template<typename tkey, typename tvalue, typename compare>
+    template<typename tkey, typename tvalue, typename compare, bool order_statistics>
     template<class ...Args>
-    binary_search_tree<tkey, tvalue, compare, AVL_TAG>::node *bst_impl<tkey, tvalue, compare, AVL_TAG>::create_node(
-            binary_search_tree <tkey, tvalue, compare, AVL_TAG> &cont, Args &&...args)
+    binary_search_tree<tkey, tvalue, compare, AVL_TAG<order_statistics>>::node *bst_impl<tkey, tvalue, compare, AVL_TAG<order_statistics>>::create_node(
+            binary_search_tree <tkey, tvalue, compare, AVL_TAG<order_statistics>> &cont, Args &&...args)
     {
-        using node_type = typename AVL_tree<tkey, tvalue, compare>::node;
+        using node_type = typename AVL_tree<tkey, tvalue, compare, order_statistics>::node;
         auto *new_node = cont._allocator.template new_object<node_type>(std::forward<Args>(args)...);
         return new_node;
     }
 
-    template<typename tkey, typename tvalue, typename compare>
-    void bst_impl<tkey, tvalue, compare, AVL_TAG>::delete_node(
-            binary_search_tree <tkey, tvalue, compare, AVL_TAG> &cont, binary_search_tree<tkey, tvalue, compare, AVL_TAG>::node** node)
+    template<typename tkey, typename tvalue, typename compare, bool order_statistics>
+    typename binary_search_tree<tkey, tvalue, compare, AVL_TAG<order_statistics>>::node* bst_impl<tkey, tvalue, compare, AVL_TAG<order_statistics>>::clone_node(
+            binary_search_tree<tkey, tvalue, compare, AVL_TAG<order_statistics>>& cont, const binary_search_tree<tkey, tvalue, compare, AVL_TAG<order_statistics>>::node* source, binary_search_tree<tkey, tvalue, compare, AVL_TAG<order_statistics>>::node* parent)
+    {
+        using node_type = typename AVL_tree<tkey, tvalue, compare, order_statistics>::node;
+        auto *copy = static_cast<node_type*>(create_node(cont, parent, source->data));
+        copy->height = static_cast<const node_type*>(source)->height;
+        return copy;
+    }
+
+    template<typename tkey, typename tvalue, typename compare, bool order_statistics>
+    void bst_impl<tkey, tvalue, compare, AVL_TAG<order_statistics>>::post_build(
+            binary_search_tree<tkey, tvalue, compare, AVL_TAG<order_statistics>>::node* node, size_t, size_t)
+    {
+        static_cast<typename AVL_tree<tkey, tvalue, compare, order_statistics>::node*>(node)->recalculate_height();
+    }
+
+    template<typename tkey, typename tvalue, typename compare, bool order_statistics>
+    void bst_impl<tkey, tvalue, compare, AVL_TAG<order_statistics>>::delete_node(
+            binary_search_tree <tkey, tvalue, compare, AVL_TAG<order_statistics>> &cont, binary_search_tree<tkey, tvalue, compare, AVL_TAG<order_statistics>>::node** node)
     {
-        using node_type = typename binary_search_tree<tkey, tvalue, compare, AVL_TAG>::node;
+        using node_type = typename AVL_tree<tkey, tvalue, compare, order_statistics>::node;
         if (node && *node)
         {
-            cont._allocator.template delete_object<node_type>(*node);
+            cont._allocator.template delete_object<node_type>(static_cast<node_type*>(*node));
             *node = nullptr;
         }
     }
 
-    template<typename tkey, typename tvalue, typename compare>
-    void bst_impl<tkey, tvalue, compare, AVL_TAG>::post_insert(
-            binary_search_tree<tkey, tvalue, compare, AVL_TAG>& cont,
-            typename binary_search_tree<tkey, tvalue, compare, AVL_TAG>::node** node) {
+    template<typename tkey, typename tvalue, typename compare, bool order_statistics>
+    void bst_impl<tkey, tvalue, compare, AVL_TAG<order_statistics>>::post_insert(
+            binary_search_tree<tkey, tvalue, compare, AVL_TAG<order_statistics>>& cont,
+            typename binary_search_tree<tkey, tvalue, compare, AVL_TAG<order_statistics>>::node** node) {
         if (node == nullptr || *node == nullptr)
             return;
 
-        using avl_node = typename AVL_tree<tkey, tvalue, compare>::node;
-        using node_type = typename binary_search_tree<tkey, tvalue, compare, AVL_TAG>::node;
+        using avl_node = typename AVL_tree<tkey, tvalue, compare, order_statistics>::node;
+        using node_type = typename binary_search_tree<tkey, tvalue, compare, AVL_TAG<order_statistics>>::node;
 
         auto* current = static_cast<avl_node*>((*node)->parent);
 
         while (current != nullptr) {
+            const auto previous_height = current->height;
             current->recalculate_height();
             short balance = current->get_balance();
 
@@ -670,6 +814,14 @@ namespace __detail
                 }
 
                 current = static_cast<avl_node *>(subtree_ref);
+            } else if (current->height == previous_height) {
+                // Высота поддерева не изменилась - выше балансы те же, подъём до корня не нужен
+                break;
+            }
+
+            if (balance > 1 || balance < -1) {
+                // После поворота при вставке поддерево возвращается к высоте, которая была до неё
+                break;
             }
 
             current = static_cast<avl_node *>(current->parent);
@@ -677,14 +829,14 @@ namespace __detail
     }
 
 
-    template<typename tkey, typename tvalue, typename compare>
-    void bst_impl<tkey, tvalue, compare, AVL_TAG>::erase(
-            binary_search_tree<tkey, tvalue, compare, AVL_TAG> &cont,
-            typename binary_search_tree<tkey, tvalue, compare, AVL_TAG>::node **node_ptr)
+    template<typename tkey, typename tvalue, typename compare, bool order_statistics>
+    void bst_impl<tkey, tvalue, compare, AVL_TAG<order_statistics>>::erase(
+            binary_search_tree<tkey, tvalue, compare, AVL_TAG<order_statistics>> &cont,
+            typename binary_search_tree<tkey, tvalue, compare, AVL_TAG<order_statistics>>::node **node_ptr)
     {
 
-        using node_type = typename binary_search_tree<tkey, tvalue, compare, AVL_TAG>::node;
-        using avl_node = typename AVL_tree<tkey, tvalue, compare>::node;
+        using node_type = typename binary_search_tree<tkey, tvalue, compare, AVL_TAG<order_statistics>>::node;
+        using avl_node = typename AVL_tree<tkey, tvalue, compare, order_statistics>::node;
 
         if (node_ptr == nullptr || *node_ptr == nullptr) return;
 
@@ -693,6 +845,7 @@ namespace __detail
         node_type *balance_start = parent;
         //нет детей
         if (node->left_subtree == nullptr && node->right_subtree == nullptr) {
+            cont.count_erase(node, nullptr);
             if (parent) {
                 if (parent->left_subtree == node) parent->left_subtree = nullptr;
                 else parent->right_subtree = nullptr;
@@ -704,6 +857,7 @@ namespace __detail
         // 1 ребенок
         else if (node->left_subtree == nullptr || node->right_subtree == nullptr) {
             node_type *child = node->left_subtree ? node->left_subtree : node->right_subtree;
+            cont.count_erase(node, nullptr);
             child->parent = parent;
 
             if (parent) {
@@ -723,6 +877,7 @@ namespace __detail
             }
 
             balance_start = predecessor;
+            cont.count_erase(node, predecessor);
 
             if (predecessor->parent != node) {
                 predecessor->parent->right_subtree = predecessor->left_subtree;
@@ -816,38 +971,237 @@ namespace __detail
 
 }
 
-template<typename tkey, typename tvalue, typename compare>
-void __detail::bst_impl<tkey, tvalue, compare, __detail::AVL_TAG>::swap(binary_search_tree<tkey, tvalue, compare, AVL_TAG> &lhs,
-                                                                        binary_search_tree<tkey, tvalue, compare, AVL_TAG> &rhs) noexcept
+template<typename tkey, typename tvalue, typename compare, bool order_statistics>
+void __detail::bst_impl<tkey, tvalue, compare, __detail::AVL_TAG<order_statistics>>::swap(binary_search_tree<tkey, tvalue, compare, AVL_TAG<order_statistics>> &lhs,
+                                                                        binary_search_tree<tkey, tvalue, compare, AVL_TAG<order_statistics>> &rhs) noexcept
 {
     using std::swap;
-    swap(lhs.root, rhs.root);
+    swap(lhs._root, rhs._root);
     swap(lhs._logger, rhs._logger);
     swap(lhs._size, rhs._size);
     swap(lhs._allocator, rhs._allocator);
 }
 
+namespace __detail
+{
+    template<typename tkey, typename tvalue, typename compare, bool order_statistics>
+    typename bst_impl<tkey, tvalue, compare, AVL_TAG<order_statistics>>::subtree bst_impl<tkey, tvalue, compare, AVL_TAG<order_statistics>>::make_subtree(
+            tree&, base_node* root) noexcept
+    {
+        if (root != nullptr)
+        {
+            root->parent = nullptr;
+        }
+        return {root};
+    }
+
+    template<typename tkey, typename tvalue, typename compare, bool order_statistics>
+    std::tuple<typename bst_impl<tkey, tvalue, compare, AVL_TAG<order_statistics>>::subtree, typename bst_impl<tkey, tvalue, compare, AVL_TAG<order_statistics>>::base_node*, typename bst_impl<tkey, tvalue, compare, AVL_TAG<order_statistics>>::subtree>
+    bst_impl<tkey, tvalue, compare, AVL_TAG<order_statistics>>::expose(tree& cont, subtree source) noexcept
+    {
+        base_node* root = source.root;
+        subtree left = make_subtree(cont, root->left_subtree);
+        subtree right = make_subtree(cont, root->right_subtree);
+        root->left_subtree = root->right_subtree = nullptr;
+        return {left, root, right};
+    }
+
+    template<typename tkey, typename tvalue, typename compare, bool order_statistics>
+    typename bst_impl<tkey, tvalue, compare, AVL_TAG<order_statistics>>::subtree bst_impl<tkey, tvalue, compare, AVL_TAG<order_statistics>>::join(
+            tree& cont, subtree left, base_node* middle, subtree right) noexcept
+    {
+        const size_t left_height = height(left.root);
+        const size_t right_height = height(right.root);
+        if (left_height > right_height + 1)
+        {
+            return join_right(cont, left, middle, right);
+        }
+        if (right_height > left_height + 1)
+        {
+            return join_left(cont, left, middle, right);
+        }
+
+        link(middle, left.root, right.root);
+        middle->parent = nullptr;
+        update(cont, middle);
+        return {middle};
+    }
+
+    template<typename tkey, typename tvalue, typename compare, bool order_statistics>
+    typename bst_impl<tkey, tvalue, compare, AVL_TAG<order_statistics>>::subtree bst_impl<tkey, tvalue, compare, AVL_TAG<order_statistics>>::join_right(
+            tree& cont, subtree left, base_node* middle, subtree right) noexcept
+    {
+        // Спуск по правому краю left до первого поддерева не выше right + 1: middle станет их общим корнем
+        const size_t right_height = height(right.root);
+        base_node* parent = nullptr;
+        base_node* current = left.root;
+        while (height(current) > right_height + 1)
+        {
+            parent = current;
+            current = current->right_subtree;
+        }
+
+        link(middle, current, right.root);
+        update(cont, middle);
+        middle->parent = parent;
+        parent->right_subtree = middle;
+
+        // Высоты и размеры меняются до самого корня; каждый узел края остаётся правым ребёнком своего родителя
+        base_node* top = middle;
+        for (base_node* climbing = parent; climbing != nullptr; climbing = top->parent)
+        {
+            top = rebalance(cont, climbing);
+            if (top->parent != nullptr)
+            {
+                top->parent->right_subtree = top;
+            }
+        }
+        return {top};
+    }
+
+    template<typename tkey, typename tvalue, typename compare, bool order_statistics>
+    typename bst_impl<tkey, tvalue, compare, AVL_TAG<order_statistics>>::subtree bst_impl<tkey, tvalue, compare, AVL_TAG<order_statistics>>::join_left(
+            tree& cont, subtree left, base_node* middle, subtree right) noexcept
+    {
+        const size_t left_height = height(left.root);
+        base_node* parent = nullptr;
+        base_node* current = right.root;
+        while (height(current) > left_height + 1)
+        {
+            parent = current;
+            current = current->left_subtree;
+        }
+
+        link(middle, left.root, current);
+        update(cont, middle);
+        middle->parent = parent;
+        parent->left_subtree = middle;
+
+        base_node* top = middle;
+        for (base_node* climbing = parent; climbing != nullptr; climbing = top->parent)
+        {
+            top = rebalance(cont, climbing);
+            if (top->parent != nullptr)
+            {
+                top->parent->left_subtree = top;
+            }
+        }
+        return {top};
+    }
+
+    template<typename tkey, typename tvalue, typename compare, bool order_statistics>
+    size_t bst_impl<tkey, tvalue, compare, AVL_TAG<order_statistics>>::height(const base_node* node) noexcept
+    {
+        return node == nullptr ? 0 : static_cast<const typename AVL_tree<tkey, tvalue, compare, order_statistics>::node*>(node)->height;
+    }
+
+    template<typename tkey, typename tvalue, typename compare, bool order_statistics>
+    void bst_impl<tkey, tvalue, compare, AVL_TAG<order_statistics>>::link(base_node* node, base_node* left, base_node* right) noexcept
+    {
+        node->left_subtree = left;
+        node->right_subtree = right;
+        if (left != nullptr)
+        {
+            left->parent = node;
+        }
+        if (right != nullptr)
+        {
+            right->parent = node;
+        }
+    }
+
+    template<typename tkey, typename tvalue, typename compare, bool order_statistics>
+    void bst_impl<tkey, tvalue, compare, AVL_TAG<order_statistics>>::update(tree& cont, base_node* node) noexcept
+    {
+        static_cast<typename AVL_tree<tkey, tvalue, compare, order_statistics>::node*>(node)->recalculate_height();
+        cont.recalculate_size(node);
+    }
+
+    template<typename tkey, typename tvalue, typename compare, bool order_statistics>
+    typename bst_impl<tkey, tvalue, compare, AVL_TAG<order_statistics>>::base_node* bst_impl<tkey, tvalue, compare, AVL_TAG<order_statistics>>::rotate_left(
+            tree& cont, base_node* node) noexcept
+    {
+        base_node* pivot = node->right_subtree;
+        node->right_subtree = pivot->left_subtree;
+        if (node->right_subtree != nullptr)
+        {
+            node->right_subtree->parent = node;
+        }
+        pivot->left_subtree = node;
+        pivot->parent = node->parent;
+        node->parent = pivot;
+        update(cont, node);
+        update(cont, pivot);
+        return pivot;
+    }
+
+    template<typename tkey, typename tvalue, typename compare, bool order_statistics>
+    typename bst_impl<tkey, tvalue, compare, AVL_TAG<order_statistics>>::base_node* bst_impl<tkey, tvalue, compare, AVL_TAG<order_statistics>>::rotate_right(
+            tree& cont, base_node* node) noexcept
+    {
+        base_node* pivot = node->left_subtree;
+        node->left_subtree = pivot->right_subtree;
+        if (node->left_subtree != nullptr)
+        {
+            node->left_subtree->parent = node;
+        }
+        pivot->right_subtree = node;
+        pivot->parent = node->parent;
+        node->parent = pivot;
+        update(cont, node);
+        update(cont, pivot);
+        return pivot;
+    }
+
+    template<typename tkey, typename tvalue, typename compare, bool order_statistics>
+    typename bst_impl<tkey, tvalue, compare, AVL_TAG<order_statistics>>::base_node* bst_impl<tkey, tvalue, compare, AVL_TAG<order_statistics>>::rebalance(
+            tree& cont, base_node* node) noexcept
+    {
+        using avl_node = typename AVL_tree<tkey, tvalue, compare, order_statistics>::node;
+
+        update(cont, node);
+        const short balance = static_cast<avl_node*>(node)->get_balance();
+        if (balance > 1)
+        {
+            if (static_cast<avl_node*>(node->right_subtree)->get_balance() < 0)
+            {
+                node->right_subtree = rotate_right(cont, node->right_subtree);
+            }
+            return rotate_left(cont, node);
+        }
+        if (balance < -1)
+        {
+            if (static_cast<avl_node*>(node->left_subtree)->get_balance() > 0)
+            {
+                node->left_subtree = rotate_left(cont, node->left_subtree);
+            }
+            return rotate_right(cont, node);
+        }
+        return node;
+    }
+}
+
 // region node implementation
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-void AVL_tree<tkey, tvalue, compare>::node::recalculate_height() noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+void AVL_tree<tkey, tvalue, compare, order_statistics>::node::recalculate_height() noexcept
 {
     const size_t left_height = this->left_subtree ? static_cast<node*>(this->left_subtree)->height : 0;
     const size_t right_height = this->right_subtree ? static_cast<node*>(this->right_subtree)->height : 0;
-    this->height = 1 + std::max(left_height, right_height);
+    this->height = static_cast<unsigned char>(1 + std::max(left_height, right_height));
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-short AVL_tree<tkey, tvalue, compare>::node::get_balance() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+short AVL_tree<tkey, tvalue, compare, order_statistics>::node::get_balance() const noexcept
 {
     const size_t left_height = this->left_subtree ? static_cast<node *>(this->left_subtree)->height : 0;
     const size_t right_height = this->right_subtree ? static_cast<node *>(this->right_subtree)->height : 0;
     return static_cast<short>(right_height - left_height);
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
 template<class ...Args>
-AVL_tree<tkey, tvalue, compare>::node::node(parent::node* par, Args&&... args)
+AVL_tree<tkey, tvalue, compare, order_statistics>::node::node(parent::node* par, Args&&... args)
         : parent::node(par, std::forward<Args>(args)...), height(1)
 {
 }
@@ -856,24 +1210,24 @@ AVL_tree<tkey, tvalue, compare>::node::node(parent::node* par, Args&&... args)
 
 // region prefix_iterator implementation
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-AVL_tree<tkey, tvalue, compare>::prefix_iterator::prefix_iterator(parent::node* n) noexcept : parent::prefix_iterator(n)
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+AVL_tree<tkey, tvalue, compare, order_statistics>::prefix_iterator::prefix_iterator(parent::node* n) noexcept : parent::prefix_iterator(n)
 {
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-AVL_tree<tkey, tvalue, compare>::prefix_iterator::prefix_iterator(parent::prefix_iterator it) noexcept : parent::prefix_iterator(it)
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+AVL_tree<tkey, tvalue, compare, order_statistics>::prefix_iterator::prefix_iterator(parent::prefix_iterator it) noexcept : parent::prefix_iterator(it)
 {
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-size_t AVL_tree<tkey, tvalue, compare>::prefix_iterator::get_height() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+size_t AVL_tree<tkey, tvalue, compare, order_statistics>::prefix_iterator::get_height() const noexcept
 {
     return static_cast<node*>(this->_data)->height;
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-size_t AVL_tree<tkey, tvalue, compare>::prefix_iterator::get_balance() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+size_t AVL_tree<tkey, tvalue, compare, order_statistics>::prefix_iterator::get_balance() const noexcept
 {
     return static_cast<node*>(this->_data)->get_balance();
 }
@@ -882,29 +1236,29 @@ size_t AVL_tree<tkey, tvalue, compare>::prefix_iterator::get_balance() const noe
 
 // region prefix_const_iterator implementation
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-AVL_tree<tkey, tvalue, compare>::prefix_const_iterator::prefix_const_iterator(parent::node* n) noexcept : parent::prefix_const_iterator(n)
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+AVL_tree<tkey, tvalue, compare, order_statistics>::prefix_const_iterator::prefix_const_iterator(parent::node* n) noexcept : parent::prefix_const_iterator(n)
 {
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-AVL_tree<tkey, tvalue, compare>::prefix_const_iterator::prefix_const_iterator(parent::prefix_const_iterator it) noexcept : parent::prefix_const_iterator(it)
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+AVL_tree<tkey, tvalue, compare, order_statistics>::prefix_const_iterator::prefix_const_iterator(parent::prefix_const_iterator it) noexcept : parent::prefix_const_iterator(it)
 {
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-AVL_tree<tkey, tvalue, compare>::prefix_const_iterator::prefix_const_iterator(prefix_iterator it) noexcept : parent::prefix_const_iterator(it)
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+AVL_tree<tkey, tvalue, compare, order_statistics>::prefix_const_iterator::prefix_const_iterator(prefix_iterator it) noexcept : parent::prefix_const_iterator(it)
 {
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-size_t AVL_tree<tkey, tvalue, compare>::prefix_const_iterator::get_height() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+size_t AVL_tree<tkey, tvalue, compare, order_statistics>::prefix_const_iterator::get_height() const noexcept
 {
     return prefix_iterator(this->_base).get_height();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-size_t AVL_tree<tkey, tvalue, compare>::prefix_const_iterator::get_balance() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+size_t AVL_tree<tkey, tvalue, compare, order_statistics>::prefix_const_iterator::get_balance() const noexcept
 {
     return prefix_iterator(this->_base)->get_balance();
 }
@@ -913,42 +1267,42 @@ size_t AVL_tree<tkey, tvalue, compare>::prefix_const_iterator::get_balance() con
 
 // region prefix_reverse_iterator implementation
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-AVL_tree<tkey, tvalue, compare>::prefix_reverse_iterator::prefix_reverse_iterator(parent::node* n) noexcept : parent::prefix_reverse_iterator(n)
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+AVL_tree<tkey, tvalue, compare, order_statistics>::prefix_reverse_iterator::prefix_reverse_iterator(parent::node* n) noexcept : parent::prefix_reverse_iterator(n)
 {
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-AVL_tree<tkey, tvalue, compare>::prefix_reverse_iterator::prefix_reverse_iterator(parent::prefix_reverse_iterator it) noexcept : parent::prefix_reverse_iterator(it)
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+AVL_tree<tkey, tvalue, compare, order_statistics>::prefix_reverse_iterator::prefix_reverse_iterator(parent::prefix_reverse_iterator it) noexcept : parent::prefix_reverse_iterator(it)
 {
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-size_t AVL_tree<tkey, tvalue, compare>::prefix_reverse_iterator::get_height() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+size_t AVL_tree<tkey, tvalue, compare, order_statistics>::prefix_reverse_iterator::get_height() const noexcept
 {
     return prefix_iterator(this->_base)->height;
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-size_t AVL_tree<tkey, tvalue, compare>::prefix_reverse_iterator::get_balance() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+size_t AVL_tree<tkey, tvalue, compare, order_statistics>::prefix_reverse_iterator::get_balance() const noexcept
 {
     return prefix_iterator(this->_base)->get_balance();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-AVL_tree<tkey, tvalue, compare>::prefix_reverse_iterator::prefix_reverse_iterator(prefix_iterator it) noexcept : parent::prefix_reverse_iterator(it)
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+AVL_tree<tkey, tvalue, compare, order_statistics>::prefix_reverse_iterator::prefix_reverse_iterator(prefix_iterator it) noexcept : parent::prefix_reverse_iterator(it)
 {
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-AVL_tree<tkey, tvalue, compare>::prefix_reverse_iterator::operator AVL_tree<tkey, tvalue, compare>::prefix_iterator() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+AVL_tree<tkey, tvalue, compare, order_statistics>::prefix_reverse_iterator::operator AVL_tree<tkey, tvalue, compare, order_statistics>::prefix_iterator() const noexcept
 {
     return parent::prefix_reverse_iterator::operator prefix_iterator();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename AVL_tree<tkey, tvalue, compare>::prefix_iterator
-AVL_tree<tkey, tvalue, compare>::prefix_reverse_iterator::base() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+typename AVL_tree<tkey, tvalue, compare, order_statistics>::prefix_iterator
+AVL_tree<tkey, tvalue, compare, order_statistics>::prefix_reverse_iterator::base() const noexcept
 {
     return parent::prefix_reverse_iterator::base();
 }
@@ -957,42 +1311,42 @@ AVL_tree<tkey, tvalue, compare>::prefix_reverse_iterator::base() const noexcept
 
 // region prefix_const_reverse_iterator implementation
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-AVL_tree<tkey, tvalue, compare>::prefix_const_reverse_iterator::prefix_const_reverse_iterator(parent::node* n) noexcept : parent::prefix_const_reverse_iterator(n)
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+AVL_tree<tkey, tvalue, compare, order_statistics>::prefix_const_reverse_iterator::prefix_const_reverse_iterator(parent::node* n) noexcept : parent::prefix_const_reverse_iterator(n)
 {
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-AVL_tree<tkey, tvalue, compare>::prefix_const_reverse_iterator::prefix_const_reverse_iterator(parent::prefix_const_reverse_iterator it) noexcept : parent::prefix_const_reverse_iterator(it)
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+AVL_tree<tkey, tvalue, compare, order_statistics>::prefix_const_reverse_iterator::prefix_const_reverse_iterator(parent::prefix_const_reverse_iterator it) noexcept : parent::prefix_const_reverse_iterator(it)
 {
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-size_t AVL_tree<tkey, tvalue, compare>::prefix_const_reverse_iterator::get_height() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+size_t AVL_tree<tkey, tvalue, compare, order_statistics>::prefix_const_reverse_iterator::get_height() const noexcept
 {
     return prefix_iterator(this->_base)->height;
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-size_t AVL_tree<tkey, tvalue, compare>::prefix_const_reverse_iterator::get_balance() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+size_t AVL_tree<tkey, tvalue, compare, order_statistics>::prefix_const_reverse_iterator::get_balance() const noexcept
 {
     return prefix_iterator(this->_base)->get_balance();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-AVL_tree<tkey, tvalue, compare>::prefix_const_reverse_iterator::prefix_const_reverse_iterator(prefix_const_iterator it) noexcept : parent::prefix_const_reverse_iterator(it)
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+AVL_tree<tkey, tvalue, compare, order_statistics>::prefix_const_reverse_iterator::prefix_const_reverse_iterator(prefix_const_iterator it) noexcept : parent::prefix_const_reverse_iterator(it)
 {
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-AVL_tree<tkey, tvalue, compare>::prefix_const_reverse_iterator::operator AVL_tree<tkey, tvalue, compare>::prefix_const_iterator() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+AVL_tree<tkey, tvalue, compare, order_statistics>::prefix_const_reverse_iterator::operator AVL_tree<tkey, tvalue, compare, order_statistics>::prefix_const_iterator() const noexcept
 {
     return parent::prefix_const_reverse_iterator::operator prefix_const_iterator();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename AVL_tree<tkey, tvalue, compare>::prefix_const_iterator
-AVL_tree<tkey, tvalue, compare>::prefix_const_reverse_iterator::base() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+typename AVL_tree<tkey, tvalue, compare, order_statistics>::prefix_const_iterator
+AVL_tree<tkey, tvalue, compare, order_statistics>::prefix_const_reverse_iterator::base() const noexcept
 {
     return parent::prefix_const_reverse_iterator::base();
 }
@@ -1001,24 +1355,24 @@ AVL_tree<tkey, tvalue, compare>::prefix_const_reverse_iterator::base() const noe
 
 // region infix_iterator implementation
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-AVL_tree<tkey, tvalue, compare>::infix_iterator::infix_iterator(parent::node* n) noexcept : parent::infix_iterator(n)
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+AVL_tree<tkey, tvalue, compare, order_statistics>::infix_iterator::infix_iterator(parent::node* n) noexcept : parent::infix_iterator(n)
 {
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-AVL_tree<tkey, tvalue, compare>::infix_iterator::infix_iterator(parent::infix_iterator it) noexcept : parent::infix_iterator(it)
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+AVL_tree<tkey, tvalue, compare, order_statistics>::infix_iterator::infix_iterator(parent::infix_iterator it) noexcept : parent::infix_iterator(it)
 {
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-size_t AVL_tree<tkey, tvalue, compare>::infix_iterator::get_height() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+size_t AVL_tree<tkey, tvalue, compare, order_statistics>::infix_iterator::get_height() const noexcept
 {
     return static_cast<node*>(this->_data)->height;
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-size_t AVL_tree<tkey, tvalue, compare>::infix_iterator::get_balance() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+size_t AVL_tree<tkey, tvalue, compare, order_statistics>::infix_iterator::get_balance() const noexcept
 {
     return static_cast<node*>(this->_data)->get_balance();
 }
@@ -1027,30 +1381,30 @@ size_t AVL_tree<tkey, tvalue, compare>::infix_iterator::get_balance() const noex
 
 // region infix_const_iterator implementation
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-AVL_tree<tkey, tvalue, compare>::infix_const_iterator::infix_const_iterator(parent::node* n) noexcept : parent::infix_const_iterator(n)
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+AVL_tree<tkey, tvalue, compare, order_statistics>::infix_const_iterator::infix_const_iterator(parent::node* n) noexcept : parent::infix_const_iterator(n)
 {
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-AVL_tree<tkey, tvalue, compare>::infix_const_iterator::infix_const_iterator(parent::infix_const_iterator it) noexcept : parent::infix_const_iterator(it)
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+AVL_tree<tkey, tvalue, compare, order_statistics>::infix_const_iterator::infix_const_iterator(parent::infix_const_iterator it) noexcept : parent::infix_const_iterator(it)
 {
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-size_t AVL_tree<tkey, tvalue, compare>::infix_const_iterator::get_height() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+size_t AVL_tree<tkey, tvalue, compare, order_statistics>::infix_const_iterator::get_height() const noexcept
 {
     return infix_iterator(this->_base).get_height();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-size_t AVL_tree<tkey, tvalue, compare>::infix_const_iterator::get_balance() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+size_t AVL_tree<tkey, tvalue, compare, order_statistics>::infix_const_iterator::get_balance() const noexcept
 {
     return infix_iterator(this->_base)->get_balance();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-AVL_tree<tkey, tvalue, compare>::infix_const_iterator::infix_const_iterator(infix_iterator it) noexcept : parent::infix_const_iterator(it)
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+AVL_tree<tkey, tvalue, compare, order_statistics>::infix_const_iterator::infix_const_iterator(infix_iterator it) noexcept : parent::infix_const_iterator(it)
 {
 }
 
@@ -1058,41 +1412,41 @@ AVL_tree<tkey, tvalue, compare>::infix_const_iterator::infix_const_iterator(infi
 
 // region infix_reverse_iterator implementation
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-AVL_tree<tkey, tvalue, compare>::infix_reverse_iterator::infix_reverse_iterator(parent::node* n) noexcept : parent::infix_reverse_iterator(n)
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+AVL_tree<tkey, tvalue, compare, order_statistics>::infix_reverse_iterator::infix_reverse_iterator(parent::node* n) noexcept : parent::infix_reverse_iterator(n)
 {
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-AVL_tree<tkey, tvalue, compare>::infix_reverse_iterator::infix_reverse_iterator(parent::infix_reverse_iterator it) noexcept : parent::infix_reverse_iterator(it)
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+AVL_tree<tkey, tvalue, compare, order_statistics>::infix_reverse_iterator::infix_reverse_iterator(parent::infix_reverse_iterator it) noexcept : parent::infix_reverse_iterator(it)
 {
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-size_t AVL_tree<tkey, tvalue, compare>::infix_reverse_iterator::get_height() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+size_t AVL_tree<tkey, tvalue, compare, order_statistics>::infix_reverse_iterator::get_height() const noexcept
 {
     return infix_iterator(this->_base)->get_height();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-size_t AVL_tree<tkey, tvalue, compare>::infix_reverse_iterator::get_balance() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+size_t AVL_tree<tkey, tvalue, compare, order_statistics>::infix_reverse_iterator::get_balance() const noexcept
 {
     return infix_iterator(this->_base)->get_balance();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-AVL_tree<tkey, tvalue, compare>::infix_reverse_iterator::infix_reverse_iterator(infix_iterator it) noexcept : parent::infix_reverse_iterator(it)
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+AVL_tree<tkey, tvalue, compare, order_statistics>::infix_reverse_iterator::infix_reverse_iterator(infix_iterator it) noexcept : parent::infix_reverse_iterator(it)
 {
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-AVL_tree<tkey, tvalue, compare>::infix_reverse_iterator::operator AVL_tree<tkey, tvalue, compare>::infix_iterator() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+AVL_tree<tkey, tvalue, compare, order_statistics>::infix_reverse_iterator::operator AVL_tree<tkey, tvalue, compare, order_statistics>::infix_iterator() const noexcept
 {
     return parent::infix_reverse_iterator::operator infix_iterator();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename AVL_tree<tkey, tvalue, compare>::infix_iterator AVL_tree<tkey, tvalue, compare>::infix_reverse_iterator::base() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+typename AVL_tree<tkey, tvalue, compare, order_statistics>::infix_iterator AVL_tree<tkey, tvalue, compare, order_statistics>::infix_reverse_iterator::base() const noexcept
 {
     return parent::infix_reverse_iterator::base();
 }
@@ -1101,41 +1455,41 @@ typename AVL_tree<tkey, tvalue, compare>::infix_iterator AVL_tree<tkey, tvalue,
 
 // region infix_const_reverse_iterator implementation
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-AVL_tree<tkey, tvalue, compare>::infix_const_reverse_iterator::infix_const_reverse_iterator(parent::node* n) noexcept : parent::infix_const_reverse_iterator(n)
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+AVL_tree<tkey, tvalue, compare, order_statistics>::infix_const_reverse_iterator::infix_const_reverse_iterator(parent::node* n) noexcept : parent::infix_const_reverse_iterator(n)
 {
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-AVL_tree<tkey, tvalue, compare>::infix_const_reverse_iterator::infix_const_reverse_iterator(parent::infix_const_reverse_iterator it) noexcept : parent::infix_const_reverse_iterator(it)
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+AVL_tree<tkey, tvalue, compare, order_statistics>::infix_const_reverse_iterator::infix_const_reverse_iterator(parent::infix_const_reverse_iterator it) noexcept : parent::infix_const_reverse_iterator(it)
 {
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-size_t AVL_tree<tkey, tvalue, compare>::infix_const_reverse_iterator::get_height() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+size_t AVL_tree<tkey, tvalue, compare, order_statistics>::infix_const_reverse_iterator::get_height() const noexcept
 {
     return infix_iterator(this->_base)->get_height();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-size_t AVL_tree<tkey, tvalue, compare>::infix_const_reverse_iterator::get_balance() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+size_t AVL_tree<tkey, tvalue, compare, order_statistics>::infix_const_reverse_iterator::get_balance() const noexcept
 {
     return infix_iterator(this->_base)->get_balance();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-AVL_tree<tkey, tvalue, compare>::infix_const_reverse_iterator::infix_const_reverse_iterator(infix_const_iterator it) noexcept : parent::infix_const_reverse_iterator(it)
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+AVL_tree<tkey, tvalue, compare, order_statistics>::infix_const_reverse_iterator::infix_const_reverse_iterator(infix_const_iterator it) noexcept : parent::infix_const_reverse_iterator(it)
 {
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-AVL_tree<tkey, tvalue, compare>::infix_const_reverse_iterator::operator AVL_tree<tkey, tvalue, compare>::infix_const_iterator() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+AVL_tree<tkey, tvalue, compare, order_statistics>::infix_const_reverse_iterator::operator AVL_tree<tkey, tvalue, compare, order_statistics>::infix_const_iterator() const noexcept
 {
     return parent::infix_const_reverse_iterator::operator infix_const_iterator();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename AVL_tree<tkey, tvalue, compare>::infix_const_iterator AVL_tree<tkey, tvalue, compare>::infix_const_reverse_iterator::base() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+typename AVL_tree<tkey, tvalue, compare, order_statistics>::infix_const_iterator AVL_tree<tkey, tvalue, compare, order_statistics>::infix_const_reverse_iterator::base() const noexcept
 {
     return parent::infix_const_reverse_iterator::base();
 }
@@ -1144,24 +1498,24 @@ typename AVL_tree<tkey, tvalue, compare>::infix_const_iterator AVL_tree<tkey, tv
 
 // region postfix_iterator implementation
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-AVL_tree<tkey, tvalue, compare>::postfix_iterator::postfix_iterator(parent::node* n) noexcept : parent::postfix_iterator(n)
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+AVL_tree<tkey, tvalue, compare, order_statistics>::postfix_iterator::postfix_iterator(parent::node* n) noexcept : parent::postfix_iterator(n)
 {
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-AVL_tree<tkey, tvalue, compare>::postfix_iterator::postfix_iterator(parent::postfix_iterator it) noexcept : parent::postfix_iterator(it)
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+AVL_tree<tkey, tvalue, compare, order_statistics>::postfix_iterator::postfix_iterator(parent::postfix_iterator it) noexcept : parent::postfix_iterator(it)
 {
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-size_t AVL_tree<tkey, tvalue, compare>::postfix_iterator::get_height() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+size_t AVL_tree<tkey, tvalue, compare, order_statistics>::postfix_iterator::get_height() const noexcept
 {
     return static_cast<node*>(this->_data)->height;
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-size_t AVL_tree<tkey, tvalue, compare>::postfix_iterator::get_balance() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+size_t AVL_tree<tkey, tvalue, compare, order_statistics>::postfix_iterator::get_balance() const noexcept
 {
     return static_cast<node*>(this->_data)->get_balance();
 }
@@ -1170,30 +1524,30 @@ size_t AVL_tree<tkey, tvalue, compare>::postfix_iterator::get_balance() const no
 
 // region postfix_const_iterator implementation
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-AVL_tree<tkey, tvalue, compare>::postfix_const_iterator::postfix_const_iterator(parent::node* n) noexcept : parent::postfix_const_iterator(n)
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+AVL_tree<tkey, tvalue, compare, order_statistics>::postfix_const_iterator::postfix_const_iterator(parent::node* n) noexcept : parent::postfix_const_iterator(n)
 {
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-AVL_tree<tkey, tvalue, compare>::postfix_const_iterator::postfix_const_iterator(parent::postfix_const_iterator it) noexcept : parent::postfix_const_iterator(it)
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+AVL_tree<tkey, tvalue, compare, order_statistics>::postfix_const_iterator::postfix_const_iterator(parent::postfix_const_iterator it) noexcept : parent::postfix_const_iterator(it)
 {
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-size_t AVL_tree<tkey, tvalue, compare>::postfix_const_iterator::get_height() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+size_t AVL_tree<tkey, tvalue, compare, order_statistics>::postfix_const_iterator::get_height() const noexcept
 {
     return postfix_iterator(this->_base).get_height();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-size_t AVL_tree<tkey, tvalue, compare>::postfix_const_iterator::get_balance() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+size_t AVL_tree<tkey, tvalue, compare, order_statistics>::postfix_const_iterator::get_balance() const noexcept
 {
     return postfix_iterator(this->_base)->get_balance();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-AVL_tree<tkey, tvalue, compare>::postfix_const_iterator::postfix_const_iterator(postfix_iterator it) noexcept : parent::postfix_const_iterator(it)
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+AVL_tree<tkey, tvalue, compare, order_statistics>::postfix_const_iterator::postfix_const_iterator(postfix_iterator it) noexcept : parent::postfix_const_iterator(it)
 {
 }
 
@@ -1201,41 +1555,41 @@ AVL_tree<tkey, tvalue, compare>::postfix_const_iterator::postfix_const_iterator(
 
 // region postfix_reverse_iterator implementation
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-AVL_tree<tkey, tvalue, compare>::postfix_reverse_iterator::postfix_reverse_iterator(parent::node* n) noexcept : parent::postfix_reverse_iterator(n)
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+AVL_tree<tkey, tvalue, compare, order_statistics>::postfix_reverse_iterator::postfix_reverse_iterator(parent::node* n) noexcept : parent::postfix_reverse_iterator(n)
 {
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-AVL_tree<tkey, tvalue, compare>::postfix_reverse_iterator::postfix_reverse_iterator(parent::postfix_reverse_iterator it) noexcept : parent::postfix_reverse_iterator(it)
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+AVL_tree<tkey, tvalue, compare, order_statistics>::postfix_reverse_iterator::postfix_reverse_iterator(parent::postfix_reverse_iterator it) noexcept : parent::postfix_reverse_iterator(it)
 {
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-size_t AVL_tree<tkey, tvalue, compare>::postfix_reverse_iterator::get_height() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+size_t AVL_tree<tkey, tvalue, compare, order_statistics>::postfix_reverse_iterator::get_height() const noexcept
 {
     return postfix_iterator(this->_base).get_height();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-size_t AVL_tree<tkey, tvalue, compare>::postfix_reverse_iterator::get_balance() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+size_t AVL_tree<tkey, tvalue, compare, order_statistics>::postfix_reverse_iterator::get_balance() const noexcept
 {
     return postfix_iterator(this->_base).get_balance();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-AVL_tree<tkey, tvalue, compare>::postfix_reverse_iterator::postfix_reverse_iterator(postfix_iterator it) noexcept : parent::postfix_reverse_iterator(it)
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+AVL_tree<tkey, tvalue, compare, order_statistics>::postfix_reverse_iterator::postfix_reverse_iterator(postfix_iterator it) noexcept : parent::postfix_reverse_iterator(it)
 {
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-AVL_tree<tkey, tvalue, compare>::postfix_reverse_iterator::operator AVL_tree<tkey, tvalue, compare>::postfix_iterator() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+AVL_tree<tkey, tvalue, compare, order_statistics>::postfix_reverse_iterator::operator AVL_tree<tkey, tvalue, compare, order_statistics>::postfix_iterator() const noexcept
 {
     return parent::postfix_reverse_iterator::operator postfix_iterator();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename AVL_tree<tkey, tvalue, compare>::postfix_iterator AVL_tree<tkey, tvalue, compare>::postfix_reverse_iterator::base() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+typename AVL_tree<tkey, tvalue, compare, order_statistics>::postfix_iterator AVL_tree<tkey, tvalue, compare, order_statistics>::postfix_reverse_iterator::base() const noexcept
 {
     return parent::postfix_reverse_iterator::base();
 }
@@ -1244,41 +1598,41 @@ typename AVL_tree<tkey, tvalue, compare>::postfix_iterator AVL_tree<tkey, tvalue
 
 // region postfix_const_reverse_iterator implementation
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-AVL_tree<tkey, tvalue, compare>::postfix_const_reverse_iterator::postfix_const_reverse_iterator(parent::node* n) noexcept : parent::postfix_reverse_iterator(n)
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+AVL_tree<tkey, tvalue, compare, order_statistics>::postfix_const_reverse_iterator::postfix_const_reverse_iterator(parent::node* n) noexcept : parent::postfix_reverse_iterator(n)
 {
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-AVL_tree<tkey, tvalue, compare>::postfix_const_reverse_iterator::postfix_const_reverse_iterator(parent::postfix_const_reverse_iterator it) noexcept : parent::postfix_reverse_iterator(it)
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+AVL_tree<tkey, tvalue, compare, order_statistics>::postfix_const_reverse_iterator::postfix_const_reverse_iterator(parent::postfix_const_reverse_iterator it) noexcept : parent::postfix_reverse_iterator(it)
 {
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-size_t AVL_tree<tkey, tvalue, compare>::postfix_const_reverse_iterator::get_height() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+size_t AVL_tree<tkey, tvalue, compare, order_statistics>::postfix_const_reverse_iterator::get_height() const noexcept
 {
     return postfix_iterator(this->_base).get_height();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-size_t AVL_tree<tkey, tvalue, compare>::postfix_const_reverse_iterator::get_balance() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+size_t AVL_tree<tkey, tvalue, compare, order_statistics>::postfix_const_reverse_iterator::get_balance() const noexcept
 {
     return postfix_iterator(this->_base).get_balance();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-AVL_tree<tkey, tvalue, compare>::postfix_const_reverse_iterator::postfix_const_reverse_iterator(postfix_const_iterator it) noexcept : parent::postfix_const_reverse_iterator(it)
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+AVL_tree<tkey, tvalue, compare, order_statistics>::postfix_const_reverse_iterator::postfix_const_reverse_iterator(postfix_const_iterator it) noexcept : parent::postfix_const_reverse_iterator(it)
 {
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-AVL_tree<tkey, tvalue, compare>::postfix_const_reverse_iterator::operator AVL_tree<tkey, tvalue, compare>::postfix_const_iterator() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+AVL_tree<tkey, tvalue, compare, order_statistics>::postfix_const_reverse_iterator::operator AVL_tree<tkey, tvalue, compare, order_statistics>::postfix_const_iterator() const noexcept
 {
     return parent::postfix_const_reverse_iterator::operator postfix_const_iterator();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename AVL_tree<tkey, tvalue, compare>::postfix_const_iterator AVL_tree<tkey, tvalue, compare>::postfix_const_reverse_iterator::base() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+typename AVL_tree<tkey, tvalue, compare, order_statistics>::postfix_const_iterator AVL_tree<tkey, tvalue, compare, order_statistics>::postfix_const_reverse_iterator::base() const noexcept
 {
     return parent::postfix_const_reverse_iterator::base();
 }
@@ -1288,294 +1642,294 @@ typename AVL_tree<tkey, tvalue, compare>::postfix_const_iterator AVL_tree<tkey,
 // region iterator requests implementation
 
 // Infix iterators
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename AVL_tree<tkey, tvalue, compare>::infix_iterator AVL_tree<tkey, tvalue, compare>::begin() noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+typename AVL_tree<tkey, tvalue, compare, order_statistics>::infix_iterator AVL_tree<tkey, tvalue, compare, order_statistics>::begin() noexcept
 {
     return parent::begin();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename AVL_tree<tkey, tvalue, compare>::infix_iterator AVL_tree<tkey, tvalue, compare>::end() noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+typename AVL_tree<tkey, tvalue, compare, order_statistics>::infix_iterator AVL_tree<tkey, tvalue, compare, order_statistics>::end() noexcept
 {
     return parent::end();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename AVL_tree<tkey, tvalue, compare>::infix_const_iterator AVL_tree<tkey, tvalue, compare>::begin() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+typename AVL_tree<tkey, tvalue, compare, order_statistics>::infix_const_iterator AVL_tree<tkey, tvalue, compare, order_statistics>::begin() const noexcept
 {
     return parent::begin();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename AVL_tree<tkey, tvalue, compare>::infix_const_iterator AVL_tree<tkey, tvalue, compare>::end() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+typename AVL_tree<tkey, tvalue, compare, order_statistics>::infix_const_iterator AVL_tree<tkey, tvalue, compare, order_statistics>::end() const noexcept
 {
     return parent::end();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename AVL_tree<tkey, tvalue, compare>::infix_const_iterator AVL_tree<tkey, tvalue, compare>::cbegin() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+typename AVL_tree<tkey, tvalue, compare, order_statistics>::infix_const_iterator AVL_tree<tkey, tvalue, compare, order_statistics>::cbegin() const noexcept
 {
     return parent::cbegin();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename AVL_tree<tkey, tvalue, compare>::infix_const_iterator AVL_tree<tkey, tvalue, compare>::cend() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+typename AVL_tree<tkey, tvalue, compare, order_statistics>::infix_const_iterator AVL_tree<tkey, tvalue, compare, order_statistics>::cend() const noexcept
 {
     return parent::cend();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename AVL_tree<tkey, tvalue, compare>::infix_reverse_iterator AVL_tree<tkey, tvalue, compare>::rbegin() noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+typename AVL_tree<tkey, tvalue, compare, order_statistics>::infix_reverse_iterator AVL_tree<tkey, tvalue, compare, order_statistics>::rbegin() noexcept
 {
     return parent::rbegin();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename AVL_tree<tkey, tvalue, compare>::infix_reverse_iterator AVL_tree<tkey, tvalue, compare>::rend() noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+typename AVL_tree<tkey, tvalue, compare, order_statistics>::infix_reverse_iterator AVL_tree<tkey, tvalue, compare, order_statistics>::rend() noexcept
 {
     return parent::rend();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename AVL_tree<tkey, tvalue, compare>::infix_const_reverse_iterator AVL_tree<tkey, tvalue, compare>::rbegin() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+typename AVL_tree<tkey, tvalue, compare, order_statistics>::infix_const_reverse_iterator AVL_tree<tkey, tvalue, compare, order_statistics>::rbegin() const noexcept
 {
     return parent::rbegin();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename AVL_tree<tkey, tvalue, compare>::infix_const_reverse_iterator AVL_tree<tkey, tvalue, compare>::rend() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+typename AVL_tree<tkey, tvalue, compare, order_statistics>::infix_const_reverse_iterator AVL_tree<tkey, tvalue, compare, order_statistics>::rend() const noexcept
 {
     return parent::rend();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename AVL_tree<tkey, tvalue, compare>::infix_const_reverse_iterator AVL_tree<tkey, tvalue, compare>::crbegin() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+typename AVL_tree<tkey, tvalue, compare, order_statistics>::infix_const_reverse_iterator AVL_tree<tkey, tvalue, compare, order_statistics>::crbegin() const noexcept
 {
     return parent::crbegin();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename AVL_tree<tkey, tvalue, compare>::infix_const_reverse_iterator AVL_tree<tkey, tvalue, compare>::crend() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+typename AVL_tree<tkey, tvalue, compare, order_statistics>::infix_const_reverse_iterator AVL_tree<tkey, tvalue, compare, order_statistics>::crend() const noexcept
 {
     return parent::crend();
 }
 
 // region prefix iterators
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename AVL_tree<tkey, tvalue, compare>::prefix_iterator AVL_tree<tkey, tvalue, compare>::begin_prefix() noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+typename AVL_tree<tkey, tvalue, compare, order_statistics>::prefix_iterator AVL_tree<tkey, tvalue, compare, order_statistics>::begin_prefix() noexcept
 {
     return parent::begin_prefix();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename AVL_tree<tkey, tvalue, compare>::prefix_iterator AVL_tree<tkey, tvalue, compare>::end_prefix() noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+typename AVL_tree<tkey, tvalue, compare, order_statistics>::prefix_iterator AVL_tree<tkey, tvalue, compare, order_statistics>::end_prefix() noexcept
 {
     return parent::end_prefix();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename AVL_tree<tkey, tvalue, compare>::prefix_const_iterator AVL_tree<tkey, tvalue, compare>::begin_prefix() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+typename AVL_tree<tkey, tvalue, compare, order_statistics>::prefix_const_iterator AVL_tree<tkey, tvalue, compare, order_statistics>::begin_prefix() const noexcept
 {
     return parent::begin_prefix();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename AVL_tree<tkey, tvalue, compare>::prefix_const_iterator AVL_tree<tkey, tvalue, compare>::end_prefix() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+typename AVL_tree<tkey, tvalue, compare, order_statistics>::prefix_const_iterator AVL_tree<tkey, tvalue, compare, order_statistics>::end_prefix() const noexcept
 {
     return parent::end_prefix();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename AVL_tree<tkey, tvalue, compare>::prefix_const_iterator AVL_tree<tkey, tvalue, compare>::cbegin_prefix() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+typename AVL_tree<tkey, tvalue, compare, order_statistics>::prefix_const_iterator AVL_tree<tkey, tvalue, compare, order_statistics>::cbegin_prefix() const noexcept
 {
     return parent::cbegin_prefix();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename AVL_tree<tkey, tvalue, compare>::prefix_const_iterator AVL_tree<tkey, tvalue, compare>::cend_prefix() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+typename AVL_tree<tkey, tvalue, compare, order_statistics>::prefix_const_iterator AVL_tree<tkey, tvalue, compare, order_statistics>::cend_prefix() const noexcept
 {
     return parent::cend_prefix();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename AVL_tree<tkey, tvalue, compare>::prefix_reverse_iterator AVL_tree<tkey, tvalue, compare>::rbegin_prefix() noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+typename AVL_tree<tkey, tvalue, compare, order_statistics>::prefix_reverse_iterator AVL_tree<tkey, tvalue, compare, order_statistics>::rbegin_prefix() noexcept
 {
     return parent::rbegin_prefix();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename AVL_tree<tkey, tvalue, compare>::prefix_reverse_iterator AVL_tree<tkey, tvalue, compare>::rend_prefix() noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+typename AVL_tree<tkey, tvalue, compare, order_statistics>::prefix_reverse_iterator AVL_tree<tkey, tvalue, compare, order_statistics>::rend_prefix() noexcept
 {
     return parent::rend_prefix();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename AVL_tree<tkey, tvalue, compare>::prefix_const_reverse_iterator AVL_tree<tkey, tvalue, compare>::rbegin_prefix() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+typename AVL_tree<tkey, tvalue, compare, order_statistics>::prefix_const_reverse_iterator AVL_tree<tkey, tvalue, compare, order_statistics>::rbegin_prefix() const noexcept
 {
     return parent::rbegin_prefix();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename AVL_tree<tkey, tvalue, compare>::prefix_const_reverse_iterator AVL_tree<tkey, tvalue, compare>::rend_prefix() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+typename AVL_tree<tkey, tvalue, compare, order_statistics>::prefix_const_reverse_iterator AVL_tree<tkey, tvalue, compare, order_statistics>::rend_prefix() const noexcept
 {
     return parent::rend_prefix();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename AVL_tree<tkey, tvalue, compare>::prefix_const_reverse_iterator AVL_tree<tkey, tvalue, compare>::crbegin_prefix() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+typename AVL_tree<tkey, tvalue, compare, order_statistics>::prefix_const_reverse_iterator AVL_tree<tkey, tvalue, compare, order_statistics>::crbegin_prefix() const noexcept
 {
     return parent::crbegin_prefix();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename AVL_tree<tkey, tvalue, compare>::prefix_const_reverse_iterator AVL_tree<tkey, tvalue, compare>::crend_prefix() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+typename AVL_tree<tkey, tvalue, compare, order_statistics>::prefix_const_reverse_iterator AVL_tree<tkey, tvalue, compare, order_statistics>::crend_prefix() const noexcept
 {
     return parent::crend_prefix();
 }
 
 // region infix iterators
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename AVL_tree<tkey, tvalue, compare>::infix_iterator AVL_tree<tkey, tvalue, compare>::begin_infix() noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+typename AVL_tree<tkey, tvalue, compare, order_statistics>::infix_iterator AVL_tree<tkey, tvalue, compare, order_statistics>::begin_infix() noexcept
 {
     return parent::begin_infix();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename AVL_tree<tkey, tvalue, compare>::infix_iterator AVL_tree<tkey, tvalue, compare>::end_infix() noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+typename AVL_tree<tkey, tvalue, compare, order_statistics>::infix_iterator AVL_tree<tkey, tvalue, compare, order_statistics>::end_infix() noexcept
 {
     return parent::end_infix();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename AVL_tree<tkey, tvalue, compare>::infix_const_iterator AVL_tree<tkey, tvalue, compare>::begin_infix() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+typename AVL_tree<tkey, tvalue, compare, order_statistics>::infix_const_iterator AVL_tree<tkey, tvalue, compare, order_statistics>::begin_infix() const noexcept
 {
     return parent::begin_infix();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename AVL_tree<tkey, tvalue, compare>::infix_const_iterator AVL_tree<tkey, tvalue, compare>::end_infix() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+typename AVL_tree<tkey, tvalue, compare, order_statistics>::infix_const_iterator AVL_tree<tkey, tvalue, compare, order_statistics>::end_infix() const noexcept
 {
     return parent::end_infix();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename AVL_tree<tkey, tvalue, compare>::infix_const_iterator AVL_tree<tkey, tvalue, compare>::cbegin_infix() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+typename AVL_tree<tkey, tvalue, compare, order_statistics>::infix_const_iterator AVL_tree<tkey, tvalue, compare, order_statistics>::cbegin_infix() const noexcept
 {
     return parent::cbegin_infix();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename AVL_tree<tkey, tvalue, compare>::infix_const_iterator AVL_tree<tkey, tvalue, compare>::cend_infix() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+typename AVL_tree<tkey, tvalue, compare, order_statistics>::infix_const_iterator AVL_tree<tkey, tvalue, compare, order_statistics>::cend_infix() const noexcept
 {
     return parent::cend_infix();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename AVL_tree<tkey, tvalue, compare>::infix_reverse_iterator AVL_tree<tkey, tvalue, compare>::rbegin_infix() noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+typename AVL_tree<tkey, tvalue, compare, order_statistics>::infix_reverse_iterator AVL_tree<tkey, tvalue, compare, order_statistics>::rbegin_infix() noexcept
 {
     return parent::rbegin_infix();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename AVL_tree<tkey, tvalue, compare>::infix_reverse_iterator AVL_tree<tkey, tvalue, compare>::rend_infix() noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+typename AVL_tree<tkey, tvalue, compare, order_statistics>::infix_reverse_iterator AVL_tree<tkey, tvalue, compare, order_statistics>::rend_infix() noexcept
 {
     return parent::rend_infix();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename AVL_tree<tkey, tvalue, compare>::infix_const_reverse_iterator AVL_tree<tkey, tvalue, compare>::rbegin_infix() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+typename AVL_tree<tkey, tvalue, compare, order_statistics>::infix_const_reverse_iterator AVL_tree<tkey, tvalue, compare, order_statistics>::rbegin_infix() const noexcept
 {
     return parent::rbegin_infix();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename AVL_tree<tkey, tvalue, compare>::infix_const_reverse_iterator AVL_tree<tkey, tvalue, compare>::rend_infix() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+typename AVL_tree<tkey, tvalue, compare, order_statistics>::infix_const_reverse_iterator AVL_tree<tkey, tvalue, compare, order_statistics>::rend_infix() const noexcept
 {
     return parent::rend_infix();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename AVL_tree<tkey, tvalue, compare>::infix_const_reverse_iterator AVL_tree<tkey, tvalue, compare>::crbegin_infix() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+typename AVL_tree<tkey, tvalue, compare, order_statistics>::infix_const_reverse_iterator AVL_tree<tkey, tvalue, compare, order_statistics>::crbegin_infix() const noexcept
 {
     return parent::crbegin_infix();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename AVL_tree<tkey, tvalue, compare>::infix_const_reverse_iterator AVL_tree<tkey, tvalue, compare>::crend_infix() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+typename AVL_tree<tkey, tvalue, compare, order_statistics>::infix_const_reverse_iterator AVL_tree<tkey, tvalue, compare, order_statistics>::crend_infix() const noexcept
 {
     return parent::crend_infix();
 }
 
 // region postfix iterators
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename AVL_tree<tkey, tvalue, compare>::postfix_iterator AVL_tree<tkey, tvalue, compare>::begin_postfix() noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+typename AVL_tree<tkey, tvalue, compare, order_statistics>::postfix_iterator AVL_tree<tkey, tvalue, compare, order_statistics>::begin_postfix() noexcept
 {
     return parent::begin_postfix();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename AVL_tree<tkey, tvalue, compare>::postfix_iterator AVL_tree<tkey, tvalue, compare>::end_postfix() noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+typename AVL_tree<tkey, tvalue, compare, order_statistics>::postfix_iterator AVL_tree<tkey, tvalue, compare, order_statistics>::end_postfix() noexcept
 {
     return parent::end_postfix();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename AVL_tree<tkey, tvalue, compare>::postfix_const_iterator AVL_tree<tkey, tvalue, compare>::begin_postfix() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+typename AVL_tree<tkey, tvalue, compare, order_statistics>::postfix_const_iterator AVL_tree<tkey, tvalue, compare, order_statistics>::begin_postfix() const noexcept
 {
     return parent::begin_postfix();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename AVL_tree<tkey, tvalue, compare>::postfix_const_iterator AVL_tree<tkey, tvalue, compare>::end_postfix() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+typename AVL_tree<tkey, tvalue, compare, order_statistics>::postfix_const_iterator AVL_tree<tkey, tvalue, compare, order_statistics>::end_postfix() const noexcept
 {
     return parent::end_postfix();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename AVL_tree<tkey, tvalue, compare>::postfix_const_iterator AVL_tree<tkey, tvalue, compare>::cbegin_postfix() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+typename AVL_tree<tkey, tvalue, compare, order_statistics>::postfix_const_iterator AVL_tree<tkey, tvalue, compare, order_statistics>::cbegin_postfix() const noexcept
 {
     return parent::cbegin_postfix();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename AVL_tree<tkey, tvalue, compare>::postfix_const_iterator AVL_tree<tkey, tvalue, compare>::cend_postfix() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+typename AVL_tree<tkey, tvalue, compare, order_statistics>::postfix_const_iterator AVL_tree<tkey, tvalue, compare, order_statistics>::cend_postfix() const noexcept
 {
     return parent::cend_postfix();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename AVL_tree<tkey, tvalue, compare>::postfix_reverse_iterator AVL_tree<tkey, tvalue, compare>::rbegin_postfix() noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+typename AVL_tree<tkey, tvalue, compare, order_statistics>::postfix_reverse_iterator AVL_tree<tkey, tvalue, compare, order_statistics>::rbegin_postfix() noexcept
 {
     return parent::rbegin_postfix();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename AVL_tree<tkey, tvalue, compare>::postfix_reverse_iterator AVL_tree<tkey, tvalue, compare>::rend_postfix() noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+typename AVL_tree<tkey, tvalue, compare, order_statistics>::postfix_reverse_iterator AVL_tree<tkey, tvalue, compare, order_statistics>::rend_postfix() noexcept
 {
     return parent::rend_postfix();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename AVL_tree<tkey, tvalue, compare>::postfix_const_reverse_iterator AVL_tree<tkey, tvalue, compare>::rbegin_postfix() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+typename AVL_tree<tkey, tvalue, compare, order_statistics>::postfix_const_reverse_iterator AVL_tree<tkey, tvalue, compare, order_statistics>::rbegin_postfix() const noexcept
 {
     return parent::rbegin_postfix();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename AVL_tree<tkey, tvalue, compare>::postfix_const_reverse_iterator AVL_tree<tkey, tvalue, compare>::rend_postfix() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+typename AVL_tree<tkey, tvalue, compare, order_statistics>::postfix_const_reverse_iterator AVL_tree<tkey, tvalue, compare, order_statistics>::rend_postfix() const noexcept
 {
     return parent::rend_postfix();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename AVL_tree<tkey, tvalue, compare>::postfix_const_reverse_iterator AVL_tree<tkey, tvalue, compare>::crbegin_postfix() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+typename AVL_tree<tkey, tvalue, compare, order_statistics>::postfix_const_reverse_iterator AVL_tree<tkey, tvalue, compare, order_statistics>::crbegin_postfix() const noexcept
 {
     return parent::crbegin_postfix();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename AVL_tree<tkey, tvalue, compare>::postfix_const_reverse_iterator AVL_tree<tkey, tvalue, compare>::crend_postfix() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+typename AVL_tree<tkey, tvalue, compare, order_statistics>::postfix_const_reverse_iterator AVL_tree<tkey, tvalue, compare, order_statistics>::crend_postfix() const noexcept
 {
     return parent::crend_postfix();
 }
@@ -1585,68 +1939,78 @@ typename AVL_tree<tkey, tvalue, compare>::postfix_const_reverse_iterator AVL_tre
 // region AVL_tree constructors
 
 // Constructors
-template<typename tkey, typename tvalue, compator<tkey> compare>
-AVL_tree<tkey, tvalue, compare>::AVL_tree(
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+AVL_tree<tkey, tvalue, compare, order_statistics>::AVL_tree(
         const compare& comp,
         pp_allocator<value_type> alloc,
         logger* logger) : parent(comp, alloc, logger)
 {
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-AVL_tree<tkey, tvalue, compare>::AVL_tree(
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+AVL_tree<tkey, tvalue, compare, order_statistics>::AVL_tree(
         pp_allocator<value_type> alloc,
         const compare& comp,
         logger* logger) : parent(comp, alloc, logger)
 {
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
 template<input_iterator_for_pair<tkey, tvalue> iterator>
-AVL_tree<tkey, tvalue, compare>::AVL_tree(
+AVL_tree<tkey, tvalue, compare, order_statistics>::AVL_tree(
         iterator begin, iterator end,
         const compare& cmp,
         pp_allocator<value_type> alloc,
-        logger* logger) : parent(cmp, alloc, logger)
+        logger* logger) : parent(begin, end, cmp, alloc, logger)
 {
-    for (auto it = begin; it != end; ++it)
-    {
-        this->emplace(*it);
-    }
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
 template<std::ranges::input_range Range>
-AVL_tree<tkey, tvalue, compare>::AVL_tree(
+AVL_tree<tkey, tvalue, compare, order_statistics>::AVL_tree(
         Range&& range,
         const compare& cmp,
         pp_allocator<value_type> alloc,
-        logger* logger) : parent(range, cmp, alloc, logger)
+        logger* logger) : parent(std::forward<Range>(range), cmp, alloc, logger)
 {
-    for (auto &&element : range)
-    {
-        emplace(std::forward<decltype(element)>(element));
-    }
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-AVL_tree<tkey, tvalue, compare>::AVL_tree(std::initializer_list<std::pair<tkey, tvalue>> data,
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+AVL_tree<tkey, tvalue, compare, order_statistics>::AVL_tree(std::initializer_list<std::pair<tkey, tvalue>> data,
                                           const compare& cmp, pp_allocator<value_type> alloc,
-                                          logger* logger) : parent(cmp, alloc, logger)
+                                          logger* logger) : parent(data, cmp, alloc, logger)
 {
-    for (const auto &element : data)
-    {
-        emplace(element.first, element.second);
-    }
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-AVL_tree<tkey, tvalue, compare>::AVL_tree(const AVL_tree& other) : parent(other)
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+template<input_iterator_for_pair<tkey, tvalue> iterator>
+AVL_tree<tkey, tvalue, compare, order_statistics>::AVL_tree(
+        sorted_unique_t tag,
+        iterator begin, iterator end,
+        const compare& cmp,
+        pp_allocator<value_type> alloc,
+        logger* logger) : parent(tag, begin, end, cmp, alloc, logger)
+{
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+template<std::ranges::input_range Range>
+AVL_tree<tkey, tvalue, compare, order_statistics>::AVL_tree(
+        sorted_unique_t tag,
+        Range&& range,
+        const compare& cmp,
+        pp_allocator<value_type> alloc,
+        logger* logger) : parent(tag, std::forward<Range>(range), cmp, alloc, logger)
 {
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-AVL_tree<tkey, tvalue, compare>& AVL_tree<tkey, tvalue, compare>::operator=(const AVL_tree& other)
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+AVL_tree<tkey, tvalue, compare, order_statistics>::AVL_tree(const AVL_tree& other) : parent(other)
+{
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+AVL_tree<tkey, tvalue, compare, order_statistics>& AVL_tree<tkey, tvalue, compare, order_statistics>::operator=(const AVL_tree& other)
 {
     if (this != &other) {
         parent::operator=(other);
@@ -1654,8 +2018,8 @@ AVL_tree<tkey, tvalue, compare>& AVL_tree<tkey, tvalue, compare>::operator=(cons
     return *this;
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-void AVL_tree<tkey, tvalue, compare>::swap(parent& other) noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+void AVL_tree<tkey, tvalue, compare, order_statistics>::swap(parent& other) noexcept
 {
     if (this != &other)
     {
@@ -1667,125 +2031,308 @@ void AVL_tree<tkey, tvalue, compare>::swap(parent& other) noexcept
 
 // region AVL_tree methods
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-std::pair<typename AVL_tree<tkey, tvalue, compare>::infix_iterator, bool>
-AVL_tree<tkey, tvalue, compare>::insert(const value_type& value)
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+std::pair<typename AVL_tree<tkey, tvalue, compare, order_statistics>::infix_iterator, bool>
+AVL_tree<tkey, tvalue, compare, order_statistics>::insert(const value_type& value)
 {
     auto result = parent::insert(value);
     return result;
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-std::pair<typename AVL_tree<tkey, tvalue, compare>::infix_iterator, bool>
-AVL_tree<tkey, tvalue, compare>::insert(value_type&& value)
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+std::pair<typename AVL_tree<tkey, tvalue, compare, order_statistics>::infix_iterator, bool>
+AVL_tree<tkey, tvalue, compare, order_statistics>::insert(value_type&& value)
 {
     auto result = parent::insert(std::move(value));
     return result;
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
 template<class ...Args>
-std::pair<typename AVL_tree<tkey, tvalue, compare>::infix_iterator, bool>
-AVL_tree<tkey, tvalue, compare>::emplace(Args&&... args)
+std::pair<typename AVL_tree<tkey, tvalue, compare, order_statistics>::infix_iterator, bool>
+AVL_tree<tkey, tvalue, compare, order_statistics>::emplace(Args&&... args)
 {
     return parent::emplace(std::forward<Args>(args)...);
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename AVL_tree<tkey, tvalue, compare>::infix_iterator
-AVL_tree<tkey, tvalue, compare>::insert_or_assign(const value_type& value)
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+typename AVL_tree<tkey, tvalue, compare, order_statistics>::infix_iterator
+AVL_tree<tkey, tvalue, compare, order_statistics>::insert_or_assign(const value_type& value)
 {
     auto result = parent::insert_or_assign(value);
     return result;
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename AVL_tree<tkey, tvalue, compare>::infix_iterator
-AVL_tree<tkey, tvalue, compare>::insert_or_assign(value_type&& value)
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+typename AVL_tree<tkey, tvalue, compare, order_statistics>::infix_iterator
+AVL_tree<tkey, tvalue, compare, order_statistics>::insert_or_assign(value_type&& value)
 {
     auto result = parent::insert_or_assign(std::move(value));
     return result;
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
 template<class ...Args>
-typename AVL_tree<tkey, tvalue, compare>::infix_iterator
-AVL_tree<tkey, tvalue, compare>::emplace_or_assign(Args&&... args)
+typename AVL_tree<tkey, tvalue, compare, order_statistics>::infix_iterator
+AVL_tree<tkey, tvalue, compare, order_statistics>::emplace_or_assign(Args&&... args)
 {
-    auto it = binary_search_tree<tkey, tvalue, compare, __detail::AVL_TAG>::emplace_or_assign(std::forward<Args>(args)...);
+    auto it = binary_search_tree<tkey, tvalue, compare, __detail::AVL_TAG<order_statistics>>::emplace_or_assign(std::forward<Args>(args)...);
     return it;
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename AVL_tree<tkey, tvalue, compare>::infix_iterator
-AVL_tree<tkey, tvalue, compare>::find(const tkey& key)
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+typename AVL_tree<tkey, tvalue, compare, order_statistics>::infix_iterator
+AVL_tree<tkey, tvalue, compare, order_statistics>::find(const tkey& key)
 {
     return parent::find(key);
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename AVL_tree<tkey, tvalue, compare>::infix_const_iterator
-AVL_tree<tkey, tvalue, compare>::find(const tkey& key) const
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+typename AVL_tree<tkey, tvalue, compare, order_statistics>::infix_const_iterator
+AVL_tree<tkey, tvalue, compare, order_statistics>::find(const tkey& key) const
 {
     return parent::find(key);
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename AVL_tree<tkey, tvalue, compare>::infix_iterator
-AVL_tree<tkey, tvalue, compare>::lower_bound(const tkey& key)
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+typename AVL_tree<tkey, tvalue, compare, order_statistics>::infix_iterator
+AVL_tree<tkey, tvalue, compare, order_statistics>::lower_bound(const tkey& key)
 {
     return parent::lower_bound(key);
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename AVL_tree<tkey, tvalue, compare>::infix_const_iterator
-AVL_tree<tkey, tvalue, compare>::lower_bound(const tkey& key) const
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+typename AVL_tree<tkey, tvalue, compare, order_statistics>::infix_const_iterator
+AVL_tree<tkey, tvalue, compare, order_statistics>::lower_bound(const tkey& key) const
 {
     return parent::lower_bound(key);
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename AVL_tree<tkey, tvalue, compare>::infix_iterator
-AVL_tree<tkey, tvalue, compare>::upper_bound(const tkey& key)
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+typename AVL_tree<tkey, tvalue, compare, order_statistics>::infix_iterator
+AVL_tree<tkey, tvalue, compare, order_statistics>::upper_bound(const tkey& key)
 {
     return parent::upper_bound(key);
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename AVL_tree<tkey, tvalue, compare>::infix_const_iterator
-AVL_tree<tkey, tvalue, compare>::upper_bound(const tkey& key) const
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+typename AVL_tree<tkey, tvalue, compare, order_statistics>::infix_const_iterator
+AVL_tree<tkey, tvalue, compare, order_statistics>::upper_bound(const tkey& key) const
 {
     return parent::upper_bound(key);
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename AVL_tree<tkey, tvalue, compare>::infix_iterator
-AVL_tree<tkey, tvalue, compare>::erase(infix_iterator pos)
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+template<class ...Args>
+std::pair<typename AVL_tree<tkey, tvalue, compare, order_statistics>::infix_iterator, bool>
+AVL_tree<tkey, tvalue, compare, order_statistics>::try_emplace(const tkey& key, Args&&... args)
+{
+    return parent::try_emplace(key, std::forward<Args>(args)...);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+template<class ...Args>
+std::pair<typename AVL_tree<tkey, tvalue, compare, order_statistics>::infix_iterator, bool>
+AVL_tree<tkey, tvalue, compare, order_statistics>::try_emplace(tkey&& key, Args&&... args)
+{
+    return parent::try_emplace(std::move(key), std::forward<Args>(args)...);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+typename AVL_tree<tkey, tvalue, compare, order_statistics>::infix_iterator
+AVL_tree<tkey, tvalue, compare, order_statistics>::insert(typename parent::infix_const_iterator hint, const value_type& value)
+{
+    return parent::insert(hint, value);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+typename AVL_tree<tkey, tvalue, compare, order_statistics>::infix_iterator
+AVL_tree<tkey, tvalue, compare, order_statistics>::insert(typename parent::infix_const_iterator hint, value_type&& value)
+{
+    return parent::insert(hint, std::move(value));
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+template<class ...Args>
+typename AVL_tree<tkey, tvalue, compare, order_statistics>::infix_iterator
+AVL_tree<tkey, tvalue, compare, order_statistics>::emplace_hint(typename parent::infix_const_iterator hint, Args&&... args)
+{
+    return parent::emplace_hint(hint, std::forward<Args>(args)...);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+typename AVL_tree<tkey, tvalue, compare, order_statistics>::infix_iterator
+AVL_tree<tkey, tvalue, compare, order_statistics>::lower_bound(typename parent::infix_const_iterator hint, const tkey& key)
+{
+    return parent::lower_bound(hint, key);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+typename AVL_tree<tkey, tvalue, compare, order_statistics>::infix_const_iterator
+AVL_tree<tkey, tvalue, compare, order_statistics>::lower_bound(typename parent::infix_const_iterator hint, const tkey& key) const
+{
+    return parent::lower_bound(hint, key);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+typename AVL_tree<tkey, tvalue, compare, order_statistics>::infix_iterator
+AVL_tree<tkey, tvalue, compare, order_statistics>::select(size_t k)
+{
+    return parent::select(k);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+typename AVL_tree<tkey, tvalue, compare, order_statistics>::infix_const_iterator
+AVL_tree<tkey, tvalue, compare, order_statistics>::select(size_t k) const
+{
+    return parent::select(k);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+typename AVL_tree<tkey, tvalue, compare, order_statistics>::infix_iterator
+AVL_tree<tkey, tvalue, compare, order_statistics>::advance(typename parent::infix_const_iterator it, ptrdiff_t n)
+{
+    return parent::advance(it, n);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+typename AVL_tree<tkey, tvalue, compare, order_statistics>::infix_const_iterator
+AVL_tree<tkey, tvalue, compare, order_statistics>::advance(typename parent::infix_const_iterator it, ptrdiff_t n) const
+{
+    return parent::advance(it, n);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+template<typename K> requires transparent_compare<compare>
+typename AVL_tree<tkey, tvalue, compare, order_statistics>::infix_iterator
+AVL_tree<tkey, tvalue, compare, order_statistics>::find(const K& key)
+{
+    return parent::find(key);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+template<typename K> requires transparent_compare<compare>
+typename AVL_tree<tkey, tvalue, compare, order_statistics>::infix_const_iterator
+AVL_tree<tkey, tvalue, compare, order_statistics>::find(const K& key) const
+{
+    return parent::find(key);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+template<typename K> requires transparent_compare<compare>
+typename AVL_tree<tkey, tvalue, compare, order_statistics>::infix_iterator
+AVL_tree<tkey, tvalue, compare, order_statistics>::lower_bound(const K& key)
+{
+    return parent::lower_bound(key);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+template<typename K> requires transparent_compare<compare>
+typename AVL_tree<tkey, tvalue, compare, order_statistics>::infix_const_iterator
+AVL_tree<tkey, tvalue, compare, order_statistics>::lower_bound(const K& key) const
+{
+    return parent::lower_bound(key);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+template<typename K> requires transparent_compare<compare>
+typename AVL_tree<tkey, tvalue, compare, order_statistics>::infix_iterator
+AVL_tree<tkey, tvalue, compare, order_statistics>::upper_bound(const K& key)
+{
+    return parent::upper_bound(key);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+template<typename K> requires transparent_compare<compare>
+typename AVL_tree<tkey, tvalue, compare, order_statistics>::infix_const_iterator
+AVL_tree<tkey, tvalue, compare, order_statistics>::upper_bound(const K& key) const
+{
+    return parent::upper_bound(key);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+typename AVL_tree<tkey, tvalue, compare, order_statistics>::infix_iterator
+AVL_tree<tkey, tvalue, compare, order_statistics>::erase(infix_iterator pos)
 {
     return parent::erase(pos);
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename AVL_tree<tkey, tvalue, compare>::infix_iterator
-AVL_tree<tkey, tvalue, compare>::erase(infix_const_iterator pos)
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+typename AVL_tree<tkey, tvalue, compare, order_statistics>::infix_iterator
+AVL_tree<tkey, tvalue, compare, order_statistics>::erase(infix_const_iterator pos)
 {
     return parent::erase(pos);
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename AVL_tree<tkey, tvalue, compare>::infix_iterator
-AVL_tree<tkey, tvalue, compare>::erase(infix_iterator first, infix_iterator last)
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+typename AVL_tree<tkey, tvalue, compare, order_statistics>::infix_iterator
+AVL_tree<tkey, tvalue, compare, order_statistics>::erase(infix_iterator first, infix_iterator last)
 {
     return parent::erase(first, last);
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename AVL_tree<tkey, tvalue, compare>::infix_iterator
-AVL_tree<tkey, tvalue, compare>::erase(infix_const_iterator first, infix_const_iterator last)
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+typename AVL_tree<tkey, tvalue, compare, order_statistics>::infix_iterator
+AVL_tree<tkey, tvalue, compare, order_statistics>::erase(infix_const_iterator first, infix_const_iterator last)
 {
     return parent::erase(first, last);
 }
 
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+AVL_tree<tkey, tvalue, compare, order_statistics> AVL_tree<tkey, tvalue, compare, order_statistics>::join(AVL_tree&& left, value_type middle, AVL_tree&& right)
+{
+    left.join_trees(std::move(middle), right);
+    return std::move(left);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+std::pair<AVL_tree<tkey, tvalue, compare, order_statistics>, AVL_tree<tkey, tvalue, compare, order_statistics>> AVL_tree<tkey, tvalue, compare, order_statistics>::split(AVL_tree&& tree, const tkey& key)
+{
+    // Опустевший tree получает большую часть
+    AVL_tree less(std::move(tree));
+    less.split_trees(key, tree);
+    return {std::move(less), std::move(tree)};
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+void AVL_tree<tkey, tvalue, compare, order_statistics>::union_with(AVL_tree&& other, work_stealing_pool* pool)
+{
+    this->merge_union(other, pool);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+void AVL_tree<tkey, tvalue, compare, order_statistics>::union_with(const AVL_tree& other, work_stealing_pool* pool)
+{
+    auto copy = this->clone_foreign(other);
+    this->merge_union(copy, pool);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+void AVL_tree<tkey, tvalue, compare, order_statistics>::intersect_with(const AVL_tree& other, work_stealing_pool* pool)
+{
+    this->merge_intersection(other, pool);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+void AVL_tree<tkey, tvalue, compare, order_statistics>::difference(const AVL_tree& other, work_stealing_pool* pool)
+{
+    this->merge_difference(other, pool);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+template<std::ranges::input_range R>
+void AVL_tree<tkey, tvalue, compare, order_statistics>::insert_range(R&& rg)
+{
+    this->bulk_insert(std::forward<R>(rg), nullptr);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+template<std::ranges::input_range R>
+void AVL_tree<tkey, tvalue, compare, order_statistics>::insert_range(R&& rg, work_stealing_pool* pool)
+{
+    this->bulk_insert(std::forward<R>(rg), pool);
+}
+
 // endregion AVL_tree methods
 
 #endif //MATH_PRACTICE_AND_OPERATING_SYSTEMS_AVL_TREE_H
\ No newline at end of file
@@ -3,6 +3,7 @@
 #include <logger_builder.h>
 #include <client_logger_builder.h>
 #include <iostream>
+#include <string_view>
 
 logger *create_logger(
         std::vector<std::pair<std::string, logger::severity>> const &output_file_streams_setup,
@@ -562,6 +563,298 @@ TEST(AVLTreePositiveTests, test11)
     logger->trace("AVLTreePositiveTests.test11 finished");
 }
 
+TEST(AVLTreePositiveTests, test12)
+{
+    std::unique_ptr<logger> logger(create_logger(std::vector<std::pair<std::string, logger::severity>>
+                                                         {
+                                                                 {
+                                                                         "AVL_tree_tests_logs.txt",
+                                                                         logger::severity::trace
+                                                                 },
+                                                         }));
+    
+    logger->trace("AVLTreePositiveTests.test12 started");
+
+    auto avl1 = std::make_unique<AVL_tree<int, std::string>>(std::less<int>(), nullptr, logger.get());
+    
+    avl1->emplace(6, "l");
+    avl1->emplace(8, "c");
+    avl1->emplace(15, "l");
+    avl1->emplace(11, "o");
+    avl1->emplace(9, "h");
+    avl1->emplace(2, "e");
+    avl1->emplace(4, "b");
+    avl1->emplace(18, "e");
+    
+    std::vector<test_data<int, std::string>> expected_result =
+        {
+                test_data<int, std::string>(0, 8, "c", 4),
+                test_data<int, std::string>(1, 4, "b", 2),
+                test_data<int, std::string>(2, 2, "e", 1),
+                test_data<int, std::string>(2, 6, "l", 1),
+                test_data<int, std::string>(1, 11, "o", 3),
+                test_data<int, std::string>(2, 9, "h", 1),
+                test_data<int, std::string>(2, 15, "l", 2),
+                test_data<int, std::string>(3, 18, "e", 1)
+        };
+    
+    AVL_tree<int, std::string> avl2(*avl1);
+    
+    EXPECT_TRUE(prefix_iterator_test(avl2, expected_result));
+    EXPECT_EQ(avl2.size(), 8);
+    
+    avl2.erase(15);
+    avl2.at(8) = "x";
+    
+    EXPECT_TRUE(prefix_iterator_test(*avl1, expected_result));
+    
+    AVL_tree<int, std::string> avl3(std::less<int>(), nullptr, logger.get());
+    avl3.emplace(1, "a");
+    avl3 = *avl1;
+    avl1.reset();
+    
+    EXPECT_TRUE(prefix_iterator_test(avl3, expected_result));
+    EXPECT_EQ(avl3.size(), 8);
+    
+    logger->trace("AVLTreePositiveTests.test12 finished");
+}
+
+TEST(AVLTreePositiveTests, test13)
+{
+    std::unique_ptr<logger> logger(create_logger(std::vector<std::pair<std::string, logger::severity>>
+                                                         {
+                                                                 {
+                                                                         "AVL_tree_tests_logs.txt",
+                                                                         logger::severity::trace
+                                                                 },
+                                                         }));
+    
+    logger->trace("AVLTreePositiveTests.test13 started");
+
+    std::vector<std::pair<int, std::string>> sorted =
+        {
+            { 1, "a" },
+            { 2, "b" },
+            { 3, "c" },
+            { 4, "d" },
+            { 5, "e" },
+            { 6, "f" }
+        };
+
+    AVL_tree<int, std::string> avl(sorted_unique, sorted.begin(), sorted.end(), std::less<int>(), nullptr, logger.get());
+    
+    std::vector<test_data<int, std::string>> expected_result =
+        {
+                test_data<int, std::string>(0, 4, "d", 3),
+                test_data<int, std::string>(1, 2, "b", 2),
+                test_data<int, std::string>(2, 1, "a", 1),
+                test_data<int, std::string>(2, 3, "c", 1),
+                test_data<int, std::string>(1, 6, "f", 2),
+                test_data<int, std::string>(2, 5, "e", 1)
+        };
+    
+    EXPECT_TRUE(prefix_iterator_test(avl, expected_result));
+    EXPECT_EQ(avl.size(), 6);
+    
+    avl.emplace(7, "g");
+    
+    std::vector<test_data<int, std::string>> expected_after_insert =
+        {
+                test_data<int, std::string>(0, 4, "d", 3),
+                test_data<int, std::string>(1, 2, "b", 2),
+                test_data<int, std::string>(2, 1, "a", 1),
+                test_data<int, std::string>(2, 3, "c", 1),
+                test_data<int, std::string>(1, 6, "f", 2),
+                test_data<int, std::string>(2, 5, "e", 1),
+                test_data<int, std::string>(2, 7, "g", 1)
+        };
+    
+    EXPECT_TRUE(prefix_iterator_test(avl, expected_after_insert));
+    
+    logger->trace("AVLTreePositiveTests.test13 finished");
+}
+
+TEST(AVLTreePositiveTests, test14)
+{
+    std::unique_ptr<logger> logger(create_logger(std::vector<std::pair<std::string, logger::severity>>
+                                                         {
+                                                                 {
+                                                                         "AVL_tree_tests_logs.txt",
+                                                                         logger::severity::trace
+                                                                 },
+                                                         }));
+    
+    logger->trace("AVLTreePositiveTests.test14 started");
+
+    AVL_tree<std::string, int, std::less<>> avl(std::less<>(), nullptr, logger.get());
+    
+    EXPECT_TRUE(avl.try_emplace("a", 1).second);
+    EXPECT_TRUE(avl.try_emplace("b", 2).second);
+    EXPECT_TRUE(avl.try_emplace("c", 3).second);
+    EXPECT_FALSE(avl.try_emplace("b", 20).second);
+    EXPECT_EQ(avl.size(), 3);
+    
+    std::string_view a = "a", b = "b", c = "c";
+    EXPECT_EQ(avl.find(b)->second, 2);
+    EXPECT_EQ(avl.find(b).get_height(), 2);
+    EXPECT_EQ(avl.find(a).get_height(), 1);
+    EXPECT_EQ(avl.find(c).get_height(), 1);
+    EXPECT_TRUE(avl.contains(c));
+    EXPECT_FALSE(avl.contains(std::string_view("d")));
+    EXPECT_EQ(avl.at(a), 1);
+    EXPECT_EQ(avl.lower_bound(std::string_view("bb"))->first, "c");
+    EXPECT_EQ(avl.upper_bound(a)->first, "b");
+    
+    logger->trace("AVLTreePositiveTests.test14 finished");
+}
+
+TEST(AVLTreePositiveTests, test15)
+{
+    std::unique_ptr<logger> logger(create_logger(std::vector<std::pair<std::string, logger::severity>>
+                                                         {
+                                                                 {
+                                                                         "AVL_tree_tests_logs.txt",
+                                                                         logger::severity::trace
+                                                                 },
+                                                         }));
+    
+    logger->trace("AVLTreePositiveTests.test15 started");
+
+    AVL_tree<int, std::string> avl(std::less<int>(), nullptr, logger.get());
+    
+    auto hint = avl.end();
+    for (int key = 1; key <= 7; ++key)
+    {
+        hint = avl.emplace_hint(hint, key, std::string(1, static_cast<char>('a' + key - 1)));
+        EXPECT_EQ(hint->first, key);
+    }
+    
+    std::vector<test_data<int, std::string>> expected_result =
+        {
+                test_data<int, std::string>(0, 4, "d", 3),
+                test_data<int, std::string>(1, 2, "b", 2),
+                test_data<int, std::string>(2, 1, "a", 1),
+                test_data<int, std::string>(2, 3, "c", 1),
+                test_data<int, std::string>(1, 6, "f", 2),
+                test_data<int, std::string>(2, 5, "e", 1),
+                test_data<int, std::string>(2, 7, "g", 1)
+        };
+    
+    EXPECT_TRUE(prefix_iterator_test(avl, expected_result));
+    EXPECT_EQ(avl.size(), 7);
+    
+    EXPECT_EQ(avl.lower_bound(avl.find(7), 2).get_height(), 2);
+    EXPECT_EQ(avl.lower_bound(avl.find(1), 5)->second, "e");
+    EXPECT_TRUE(avl.lower_bound(avl.find(4), 8) == avl.end());
+    
+    logger->trace("AVLTreePositiveTests.test15 finished");
+}
+
+TEST(AVLTreePositiveTests, test16)
+{
+    std::unique_ptr<logger> logger(create_logger(std::vector<std::pair<std::string, logger::severity>>
+                                                         {
+                                                                 {
+                                                                         "AVL_tree_tests_logs.txt",
+                                                                         logger::severity::trace
+                                                                 },
+                                                         }));
+    
+    logger->trace("AVLTreePositiveTests.test16 started");
+
+    AVL_tree<int, int, std::less<int>, true> avl(std::less<int>(), nullptr, logger.get());
+    
+    for (int key = 1; key <= 100; ++key)
+    {
+        avl.emplace(key, key * 10);
+    }
+    for (int key = 2; key <= 100; key += 2)
+    {
+        avl.erase(key);
+    }
+    
+    EXPECT_EQ(avl.size(), 50);
+    for (size_t k = 0; k < avl.size(); ++k)
+    {
+        EXPECT_EQ(avl.select(k)->first, static_cast<int>(2 * k + 1));
+    }
+    EXPECT_EQ(avl.rank(50), 25);
+    EXPECT_EQ(avl.rank(51), 25);
+    EXPECT_EQ(avl.advance(avl.find(21), 10)->second, 410);
+    EXPECT_EQ(avl.advance(avl.find(21), -10).get_height(), avl.find(1).get_height());
+    EXPECT_EQ(avl.distance(avl.find(99), avl.find(1)), -49);
+    
+    AVL_tree<int, int, std::less<int>, true> copy(avl);
+    EXPECT_TRUE(copy.order_statistics());
+    EXPECT_FALSE((AVL_tree<int, int>::order_statistics()));
+    EXPECT_EQ(copy.select(49)->first, 99);
+    
+    logger->trace("AVLTreePositiveTests.test16 finished");
+}
+
+TEST(AVLTreePositiveTests, test17)
+{
+    std::unique_ptr<logger> logger(create_logger(std::vector<std::pair<std::string, logger::severity>>
+                                                         {
+                                                                 {
+                                                                         "AVL_tree_tests_logs.txt",
+                                                                         logger::severity::trace
+                                                                 },
+                                                         }));
+    
+    logger->trace("AVLTreePositiveTests.test17 started");
+
+    AVL_tree<int, int> evens(std::less<int>(), nullptr, logger.get());
+    AVL_tree<int, int> threes(std::less<int>(), nullptr, logger.get());
+    for (int key = 0; key < 30000; key += 2)
+    {
+        evens.emplace(key, 2);
+    }
+    for (int key = 0; key < 30000; key += 3)
+    {
+        threes.emplace(key, 3);
+    }
+    work_stealing_pool pool(2);
+    
+    AVL_tree<int, int> both(evens);
+    both.intersect_with(threes, &pool);
+    EXPECT_EQ(both.size(), 5000);
+    for (auto const &[key, value] : both)
+    {
+        EXPECT_EQ(key % 6, 0);
+    }
+    
+    AVL_tree<int, int> only(evens);
+    only.difference(threes, &pool);
+    EXPECT_EQ(only.size(), 10000);
+    EXPECT_EQ(only.find(6), only.end());
+    EXPECT_EQ(only.at(4), 2);
+    
+    evens.union_with(std::move(threes), &pool);
+    EXPECT_EQ(evens.size(), 20000);
+    EXPECT_EQ(evens.at(6), 2);
+    EXPECT_EQ(evens.at(9), 3);
+    EXPECT_TRUE(threes.empty());
+    
+    auto [less, greater] = AVL_tree<int, int>::split(std::move(evens), 15000);
+    EXPECT_EQ(less.size() + greater.size(), 20000);
+    EXPECT_EQ(less.rbegin()->first, 14998);
+    EXPECT_EQ(greater.begin()->first, 15000);
+    
+    greater.erase(15000);
+    AVL_tree<int, int> joined = AVL_tree<int, int>::join(std::move(less), {15000, 7}, std::move(greater));
+    EXPECT_EQ(joined.size(), 20000);
+    EXPECT_EQ(joined.at(15000), 7);
+    
+    joined.insert_range(std::vector<std::pair<int, int>>{{1, 100}, {30001, 1}, {30001, 2}, {6, 100}}, &pool);
+    EXPECT_EQ(joined.size(), 20002);
+    EXPECT_EQ(joined.at(1), 100);
+    EXPECT_EQ(joined.at(30001), 1);
+    EXPECT_EQ(joined.at(6), 2);
+    
+    logger->trace("AVLTreePositiveTests.test17 finished");
+}
+
 int main(
     int argc,
     char **argv)
@@ -0,0 +1,100 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <binary_search_tree.h>
+#include <AVL_tree.h>
+#include <red_black_tree.h>
+#include <splay_tree.h>
+
+// Копирование деревьев из n элементов со случайным порядком вставки: время построения вставками,
+// построения из упорядоченного диапазона, конструктора копирования, копирующего присваивания
+// и уничтожения копии в миллисекундах.
+// Дерево-козёл отпущения не участвует, пока у него нет вставки.
+// Запуск: mp_os_assctv_cntnr_srch_tr_bnr_srch_tr_cp_bnchmrk [n], по умолчанию n = 10000000
+
+namespace
+{
+    double elapsed_ms(std::chrono::steady_clock::time_point start)
+    {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    template<typename tree_type>
+    void run(std::string const &name, std::vector<int> const &keys, std::vector<std::pair<int, int>> const &sorted)
+    {
+        using clock = std::chrono::steady_clock;
+
+        tree_type source;
+        auto start = clock::now();
+        for (int key : keys)
+        {
+            source.emplace(key, key);
+        }
+        const double build = elapsed_ms(start);
+
+        double sorted_build;
+        {
+            start = clock::now();
+            tree_type built(sorted_unique, sorted);
+            sorted_build = elapsed_ms(start);
+        }
+
+        double copy, assign, destroy;
+        {
+            start = clock::now();
+            tree_type copied(source);
+            copy = elapsed_ms(start);
+
+            tree_type assigned;
+            assigned.emplace(0, 0);
+            start = clock::now();
+            assigned = copied;
+            assign = elapsed_ms(start);
+
+            if (copied.size() != source.size() || assigned.size() != source.size())
+            {
+                std::cerr << name << ": copy has " << copied.size() << " elements instead of " << source.size() << std::endl;
+            }
+            start = clock::now();
+        }
+        destroy = elapsed_ms(start) / 2;
+
+        std::cout << std::setw(16) << name << std::fixed << std::setprecision(1) << std::setw(12) << build
+                  << std::setw(12) << sorted_build << std::setw(12) << copy << std::setw(12) << assign << std::setw(12) << destroy << std::endl;
+    }
+}
+
+int main(
+    int argc,
+    char **argv)
+{
+    const size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10'000'000;
+
+    std::vector<int> keys(n);
+    std::iota(keys.begin(), keys.end(), 0);
+    std::shuffle(keys.begin(), keys.end(), std::mt19937(42));
+
+    std::vector<std::pair<int, int>> sorted;
+    sorted.reserve(n);
+    for (size_t i = 0; i < n; ++i)
+    {
+        sorted.emplace_back(static_cast<int>(i), static_cast<int>(i));
+    }
+
+    std::cout << n << " elements, ms" << std::endl;
+    std::cout << std::setw(16) << "tree" << std::setw(12) << "build" << std::setw(12) << "sorted" << std::setw(12) << "copy"
+              << std::setw(12) << "assign" << std::setw(12) << "destroy" << std::endl;
+
+    run<binary_search_tree<int, int>>("binary_search", keys, sorted);
+    run<AVL_tree<int, int>>("AVL", keys, sorted);
+    run<red_black_tree<int, int>>("red_black", keys, sorted);
+    run<splay_tree<int, int>>("splay", keys, sorted);
+    return 0;
+}
@@ -0,0 +1,156 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <AVL_tree.h>
+#include <red_black_tree.h>
+
+// Вставка и поиск с подсказкой на потоках из n ключей: упорядоченном, почти упорядоченном
+// (каждый сотый ключ переставлен с соседом на расстоянии до 16) и случайном.
+// Для каждого дерева: emplace от корня, insert с подсказкой-предыдущим результатом, insert с подсказкой end(),
+// затем lower_bound по тем же ключам от корня и от предыдущего найденного. В каждой ячейке миллисекунды
+// и сравнения ключей на элемент. Несбалансированное дерево не участвует: на упорядоченном потоке оно вырождается в список;
+// расширяющееся тоже - его lower_bound не расширяет, и поиск по такому списку квадратичен.
+// Запуск: mp_os_assctv_cntnr_srch_tr_bnr_srch_tr_hnt_bnchmrk [n], по умолчанию n = 1000000
+
+namespace
+{
+    struct counting_less
+    {
+        static inline size_t count = 0;
+
+        bool operator()(int lhs, int rhs) const
+        {
+            ++count;
+            return lhs < rhs;
+        }
+    };
+
+    struct measurement
+    {
+        double ms;
+        double comparisons;
+    };
+
+    template<typename F>
+    measurement measure(size_t n, F const &function)
+    {
+        counting_less::count = 0;
+        auto start = std::chrono::steady_clock::now();
+        function();
+        const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        return {ms, static_cast<double>(counting_less::count) / static_cast<double>(n)};
+    }
+
+    std::ostream &operator<<(std::ostream &out, measurement const &m)
+    {
+        return out << std::setw(10) << std::fixed << std::setprecision(1) << m.ms << std::setw(7) << std::setprecision(1)
+                   << m.comparisons;
+    }
+
+    template<typename tree_type>
+    void run(std::string const &name, std::string const &stream, std::vector<int> const &keys)
+    {
+        const size_t n = keys.size();
+        size_t checksum = 0;
+
+        tree_type plain;
+        const measurement emplace = measure(n, [&]() {
+            for (int key : keys)
+            {
+                plain.emplace(key, key);
+            }
+        });
+
+        tree_type hinted;
+        const measurement previous = measure(n, [&]() {
+            auto hint = hinted.end();
+            for (int key : keys)
+            {
+                hint = hinted.insert(hint, {key, key});
+            }
+        });
+
+        tree_type at_end;
+        const measurement end = measure(n, [&]() {
+            for (int key : keys)
+            {
+                at_end.insert(at_end.end(), {key, key});
+            }
+        });
+
+        const measurement lower_bound = measure(n, [&]() {
+            for (int key : keys)
+            {
+                checksum += plain.lower_bound(key)->second;
+            }
+        });
+
+        const measurement finger = measure(n, [&]() {
+            auto hint = hinted.end();
+            for (int key : keys)
+            {
+                hint = hinted.lower_bound(hint, key);
+                checksum += hint->second;
+            }
+        });
+
+        if (plain.size() != n || hinted.size() != n || at_end.size() != n)
+        {
+            std::cerr << name << ": " << hinted.size() << " elements instead of " << n << std::endl;
+        }
+
+        std::cout << std::setw(10) << name << std::setw(8) << stream << emplace << previous << end << lower_bound << finger
+                  << std::setw(16) << checksum << std::endl;
+    }
+
+    template<typename tree_type>
+    void run_streams(std::string const &name, std::vector<std::pair<std::string, std::vector<int>>> const &streams)
+    {
+        for (auto const &[stream, keys] : streams)
+        {
+            run<tree_type>(name, stream, keys);
+        }
+    }
+}
+
+int main(
+    int argc,
+    char **argv)
+{
+    const size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1'000'000;
+
+    std::vector<int> sorted(n);
+    std::iota(sorted.begin(), sorted.end(), 0);
+
+    std::mt19937 generator(42);
+    std::vector<int> nearly = sorted;
+    for (size_t i = 0; i + 1 < n; i += 100)
+    {
+        std::swap(nearly[i], nearly[std::min(n - 1, i + 1 + generator() % 16)]);
+    }
+
+    std::vector<int> random = sorted;
+    std::shuffle(random.begin(), random.end(), generator);
+
+    const std::vector<std::pair<std::string, std::vector<int>>> streams = {
+        {"sorted", sorted},
+        {"nearly", nearly},
+        {"random", random}
+    };
+
+    std::cout << n << " keys, ms and key comparisons per element" << std::endl;
+    std::cout << std::setw(10) << "tree" << std::setw(8) << "stream" << std::setw(17) << "emplace" << std::setw(17) << "hint=prev"
+              << std::setw(17) << "hint=end" << std::setw(17) << "lower_bound" << std::setw(17) << "finger" << std::setw(16)
+              << "checksum" << std::endl;
+
+    run_streams<AVL_tree<int, int, counting_less>>("AVL", streams);
+    run_streams<red_black_tree<int, int, counting_less>>("red_black", streams);
+    return 0;
+}
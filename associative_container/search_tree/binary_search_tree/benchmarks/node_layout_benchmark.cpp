@@ -0,0 +1,104 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory_resource>
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <AVL_tree.h>
+#include <red_black_tree.h>
+#include <splay_tree.h>
+
+// Память на элемент и скорость поиска для ключей int: n случайных ключей вставляются в дерево, чьи узлы
+// берутся у считающего ресурса, затем каждый ключ ищется find в перемешанном порядке.
+// Байты на элемент - всё запрошенное у ресурса, делённое на n; время поиска - наносекунды на find.
+// Расширяющееся дерево ищется по тем же ключам, но каждый find у него ещё и перестраивает дерево.
+// Запуск: mp_os_assctv_cntnr_srch_tr_bnr_srch_tr_nd_lt_bnchmrk [n], по умолчанию n = 1000000
+
+namespace
+{
+    class counting_resource final : public std::pmr::memory_resource
+    {
+        size_t _allocated = 0;
+
+        void *do_allocate(size_t bytes, size_t alignment) override
+        {
+            _allocated += bytes;
+            return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+        }
+
+        void do_deallocate(void *p, size_t bytes, size_t alignment) override
+        {
+            _allocated -= bytes;
+            std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+        }
+
+        bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override
+        {
+            return this == &other;
+        }
+
+    public:
+
+        size_t allocated() const noexcept
+        {
+            return _allocated;
+        }
+    };
+
+    template<typename tree_type>
+    void run(std::string const &name, std::vector<int> const &keys, std::vector<int> const &lookups)
+    {
+        counting_resource resource;
+        size_t checksum = 0;
+        double ns;
+        double bytes;
+        {
+            tree_type tree(std::less<int>{}, pp_allocator<typename tree_type::value_type>(&resource));
+            for (int key : keys)
+            {
+                tree.emplace(key, key);
+            }
+            bytes = static_cast<double>(resource.allocated()) / static_cast<double>(keys.size());
+
+            auto start = std::chrono::steady_clock::now();
+            for (int key : lookups)
+            {
+                checksum += tree.find(key)->second;
+            }
+            ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count()
+                    / static_cast<double>(lookups.size());
+        }
+
+        std::cout << std::setw(10) << name << std::fixed << std::setprecision(1) << std::setw(16) << bytes << std::setw(16) << ns
+                  << std::setw(20) << checksum << std::endl;
+    }
+}
+
+int main(
+    int argc,
+    char **argv)
+{
+    const size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1'000'000;
+
+    std::vector<int> keys(n);
+    std::iota(keys.begin(), keys.end(), 0);
+    std::mt19937 generator(42);
+    std::shuffle(keys.begin(), keys.end(), generator);
+    std::vector<int> lookups = keys;
+    std::shuffle(lookups.begin(), lookups.end(), generator);
+
+    std::cout << n << " int keys" << std::endl;
+    std::cout << std::setw(10) << "tree" << std::setw(16) << "bytes/element" << std::setw(16) << "ns/find" << std::setw(20)
+              << "checksum" << std::endl;
+
+    run<binary_search_tree<int, int>>("bst", keys, lookups);
+    run<AVL_tree<int, int>>("AVL", keys, lookups);
+    run<red_black_tree<int, int>>("red_black", keys, lookups);
+    run<splay_tree<int, int>>("splay", keys, lookups);
+    return 0;
+}
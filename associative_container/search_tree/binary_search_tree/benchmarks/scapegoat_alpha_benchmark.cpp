@@ -0,0 +1,113 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <red_black_tree.h>
+#include <scapegoat_tree.h>
+
+// Вставки в дерево козла отпущения при разных alpha: n перемешанных и n возрастающих ключей int вставляются
+// в пустое дерево, затем замеряется n find по перемешанным ключам. Высота - наибольшая глубина после случайных вставок.
+// Красно-чёрное дерево - точка отсчёта. В ячейках наносекунды на операцию.
+// Запуск: mp_os_assctv_cntnr_srch_tr_bnr_srch_tr_scpgt_alph_bnchmrk [n], по умолчанию n = 1000000
+
+namespace
+{
+    template<typename F>
+    double measure(size_t count, F const &function)
+    {
+        auto start = std::chrono::steady_clock::now();
+        function();
+        return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count()
+               / static_cast<double>(count);
+    }
+
+    template<typename tree_type>
+    size_t height(tree_type &tree)
+    {
+        size_t result = 0;
+        for (auto it = tree.begin_infix(); it != tree.end_infix(); ++it)
+        {
+            result = std::max(result, it.depth());
+        }
+        return result;
+    }
+
+    template<typename tree_type, typename F>
+    void row(std::string const &name, std::vector<int> const &keys, std::vector<int> const &ascending, F const &make)
+    {
+        size_t checksum = 0;
+        double random_ns;
+        double find_ns;
+        size_t random_height;
+        {
+            tree_type tree = make();
+            random_ns = measure(keys.size(), [&]() {
+                for (int key : keys)
+                {
+                    tree.emplace(key, key);
+                }
+            });
+            random_height = height(tree);
+            find_ns = measure(keys.size(), [&]() {
+                for (int key : ascending)
+                {
+                    checksum += tree.find(keys[key])->second;
+                }
+            });
+        }
+
+        double ascending_ns;
+        {
+            tree_type tree = make();
+            ascending_ns = measure(ascending.size(), [&]() {
+                for (int key : ascending)
+                {
+                    tree.emplace(key, key);
+                }
+            });
+            checksum += tree.size();
+        }
+
+        std::cout << std::setw(14) << name << std::fixed << std::setprecision(1) << std::setw(12) << random_ns
+                  << std::setw(12) << ascending_ns << std::setw(12) << find_ns << std::setw(10) << random_height << std::endl;
+        if (checksum == 0)
+        {
+            std::cerr << name << ": empty results" << std::endl;
+        }
+    }
+}
+
+int main(
+    int argc,
+    char **argv)
+{
+    const size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1'000'000;
+
+    std::vector<int> ascending(n);
+    std::iota(ascending.begin(), ascending.end(), 0);
+    std::vector<int> keys = ascending;
+    std::mt19937 generator(42);
+    std::shuffle(keys.begin(), keys.end(), generator);
+
+    std::cout << n << " keys, ns per operation" << std::endl;
+    std::cout << std::setw(14) << "tree" << std::setw(12) << "random" << std::setw(12) << "ascending" << std::setw(12)
+              << "find" << std::setw(10) << "height" << std::endl;
+
+    row<red_black_tree<int, int>>("red_black", keys, ascending, []() { return red_black_tree<int, int>(); });
+    for (double alpha : {0.55, 0.6, 0.65, 0.7, 0.75, 0.8, 0.85, 0.9})
+    {
+        std::ostringstream name;
+        name << "alpha " << alpha;
+        row<scapegoat_tree<int, int>>(name.str(), keys, ascending, [alpha]() {
+            return scapegoat_tree<int, int>(std::less<int>{}, pp_allocator<std::pair<const int, int>>(), nullptr, alpha);
+        });
+    }
+    return 0;
+}
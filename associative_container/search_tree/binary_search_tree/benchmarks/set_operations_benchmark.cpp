@@ -0,0 +1,186 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <AVL_tree.h>
+#include <red_black_tree.h>
+
+// Операции над множествами через split и join против поэлементных emplace, erase и contains
+// (поэлементное пересечение собирает новое дерево из общих ключей).
+// Дерево из n случайных ключей объединяется, пересекается и вычитается с деревом из m ключей при m = n / 1000, n / 10 и n;
+// insert_range вставляет m пар в произвольном порядке. Каждая операция - без пула, затем на пуле из threads потоков.
+// В ячейках миллисекунды; копии деревьев и подготовка входа в замер не входят.
+// Запуск: mp_os_assctv_cntnr_srch_tr_bnr_srch_tr_st_prtns_bnchmrk [n] [threads],
+// по умолчанию n = 1000000 и threads = std::thread::hardware_concurrency()
+
+namespace
+{
+    template<typename F>
+    double measure(F const &function)
+    {
+        auto start = std::chrono::steady_clock::now();
+        function();
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    std::vector<int> random_keys(size_t count, std::mt19937 &generator)
+    {
+        std::vector<int> keys(count);
+        for (int &key : keys)
+        {
+            key = static_cast<int>(generator() >> 1);
+        }
+        return keys;
+    }
+
+    template<typename tree_type>
+    tree_type make_tree(std::vector<int> const &keys)
+    {
+        tree_type tree;
+        for (int key : keys)
+        {
+            tree.emplace(key, key);
+        }
+        return tree;
+    }
+
+    void print(std::string const &name, size_t m, std::string const &operation, double one_by_one, double sequential, double parallel)
+    {
+        std::cout << std::setw(10) << name << std::setw(10) << m << std::setw(14) << operation << std::fixed << std::setprecision(1)
+                  << std::setw(12) << one_by_one << std::setw(12) << sequential << std::setw(12) << parallel << std::endl;
+    }
+
+    template<typename tree_type>
+    void run(std::string const &name, size_t n, size_t m, work_stealing_pool &pool)
+    {
+        std::mt19937 generator(static_cast<unsigned>(n + m));
+        const std::vector<int> big_keys = random_keys(n, generator);
+        const std::vector<int> small_keys = random_keys(m, generator);
+        const tree_type big = make_tree<tree_type>(big_keys);
+        const tree_type small = make_tree<tree_type>(small_keys);
+        size_t checksum = 0;
+
+        {
+            tree_type target(big);
+            const double one_by_one = measure([&]() {
+                for (int key : small_keys)
+                {
+                    target.emplace(key, key);
+                }
+            });
+            checksum += target.size();
+
+            double times[2];
+            for (int parallel = 0; parallel < 2; ++parallel)
+            {
+                tree_type lhs(big);
+                tree_type rhs(small);
+                times[parallel] = measure([&]() { lhs.union_with(std::move(rhs), parallel ? &pool : nullptr); });
+                checksum += lhs.size();
+            }
+            print(name, m, "union", one_by_one, times[0], times[1]);
+        }
+
+        {
+            tree_type target;
+            const double one_by_one = measure([&]() {
+                for (int key : small_keys)
+                {
+                    if (big.contains(key))
+                    {
+                        target.emplace(key, key);
+                    }
+                }
+            });
+            checksum += target.size();
+
+            double times[2];
+            for (int parallel = 0; parallel < 2; ++parallel)
+            {
+                tree_type lhs(big);
+                times[parallel] = measure([&]() { lhs.intersect_with(small, parallel ? &pool : nullptr); });
+                checksum += lhs.size();
+            }
+            print(name, m, "intersection", one_by_one, times[0], times[1]);
+        }
+
+        {
+            tree_type target(big);
+            const double one_by_one = measure([&]() {
+                for (int key : small_keys)
+                {
+                    target.erase(key);
+                }
+            });
+            checksum += target.size();
+
+            double times[2];
+            for (int parallel = 0; parallel < 2; ++parallel)
+            {
+                tree_type lhs(big);
+                times[parallel] = measure([&]() { lhs.difference(small, parallel ? &pool : nullptr); });
+                checksum += lhs.size();
+            }
+            print(name, m, "difference", one_by_one, times[0], times[1]);
+        }
+
+        {
+            std::vector<std::pair<int, int>> items;
+            items.reserve(m);
+            for (int key : small_keys)
+            {
+                items.emplace_back(key, key);
+            }
+
+            tree_type target(big);
+            const double one_by_one = measure([&]() {
+                for (auto const &item : items)
+                {
+                    target.emplace(item.first, item.second);
+                }
+            });
+            checksum += target.size();
+
+            double times[2];
+            for (int parallel = 0; parallel < 2; ++parallel)
+            {
+                tree_type lhs(big);
+                times[parallel] = measure([&]() { lhs.insert_range(items, parallel ? &pool : nullptr); });
+                checksum += lhs.size();
+            }
+            print(name, m, "insert_range", one_by_one, times[0], times[1]);
+        }
+
+        if (checksum == 0)
+        {
+            std::cerr << name << ": empty results" << std::endl;
+        }
+    }
+}
+
+int main(
+    int argc,
+    char **argv)
+{
+    const size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1'000'000;
+    const size_t threads = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : std::max(1u, std::thread::hardware_concurrency());
+    work_stealing_pool pool(threads);
+
+    std::cout << n << " keys against m keys, ms; the pool has " << threads << " threads" << std::endl;
+    std::cout << std::setw(10) << "tree" << std::setw(10) << "m" << std::setw(14) << "operation" << std::setw(12) << "one by one"
+              << std::setw(12) << "join" << std::setw(12) << "join+pool" << std::endl;
+
+    for (size_t m : {n / 1000, n / 10, n})
+    {
+        run<AVL_tree<int, int>>("AVL", n, m, pool);
+        run<red_black_tree<int, int>>("red_black", n, m, pool);
+    }
+    return 0;
+}
@@ -0,0 +1,123 @@
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <red_black_tree.h>
+#include <splay_tree.h>
+
+// Политики поиска в расширяющемся дереве на равномерных и зипфовских (s = 0.99) запросах.
+// Дерево из n перемешанных ключей int строится заново для каждой политики, затем замеряется lookups вызовов find;
+// в зипфовском потоке частоты ключей убывают по рангу, а ранги розданы ключам случайно.
+// Порог глубины - log2(n), вероятность - 1/32; красно-чёрное дерево - точка отсчёта без перестроек.
+// В ячейках наносекунды на find.
+// Запуск: mp_os_assctv_cntnr_srch_tr_bnr_srch_tr_spl_plc_bnchmrk [n] [lookups], по умолчанию n = 1000000 и lookups = 2n
+
+namespace
+{
+    using splay_type = splay_tree<int, int>;
+
+    std::vector<int> zipf_lookups(std::vector<int> const &keys, size_t count, std::mt19937 &generator)
+    {
+        std::vector<double> cumulative(keys.size());
+        double total = 0;
+        for (size_t rank = 0; rank < keys.size(); ++rank)
+        {
+            total += 1.0 / std::pow(static_cast<double>(rank + 1), 0.99);
+            cumulative[rank] = total;
+        }
+
+        std::uniform_real_distribution<double> distribution(0, total);
+        std::vector<int> lookups(count);
+        for (int &key : lookups)
+        {
+            size_t rank = std::upper_bound(cumulative.begin(), cumulative.end(), distribution(generator)) - cumulative.begin();
+            key = keys[std::min(rank, keys.size() - 1)];
+        }
+        return lookups;
+    }
+
+    template<typename tree_type, typename F>
+    double measure(std::vector<int> const &keys, std::vector<int> const &lookups, F const &setup)
+    {
+        tree_type tree;
+        setup(tree);
+        for (int key : keys)
+        {
+            tree.emplace(key, key);
+        }
+
+        size_t checksum = 0;
+        auto start = std::chrono::steady_clock::now();
+        for (int key : lookups)
+        {
+            checksum += tree.find(key)->second;
+        }
+        double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count()
+                    / static_cast<double>(lookups.size());
+        if (checksum == 0)
+        {
+            std::cerr << "empty lookups" << std::endl;
+        }
+        return ns;
+    }
+
+    template<typename tree_type, typename F>
+    void row(std::string const &name, std::vector<int> const &keys, std::vector<int> const &uniform,
+             std::vector<int> const &zipf, F const &setup)
+    {
+        const double uniform_ns = measure<tree_type>(keys, uniform, setup);
+        const double zipf_ns = measure<tree_type>(keys, zipf, setup);
+        std::cout << std::setw(22) << name << std::fixed << std::setprecision(1) << std::setw(12) << uniform_ns
+                  << std::setw(12) << zipf_ns << std::endl;
+    }
+}
+
+int main(
+    int argc,
+    char **argv)
+{
+    const size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1'000'000;
+    const size_t count = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 2 * n;
+    const size_t threshold = std::bit_width(n);
+
+    std::mt19937 generator(42);
+    std::vector<int> keys(n);
+    std::iota(keys.begin(), keys.end(), 0);
+    std::shuffle(keys.begin(), keys.end(), generator);
+
+    std::vector<int> uniform(count);
+    std::uniform_int_distribution<size_t> position(0, n - 1);
+    for (int &key : uniform)
+    {
+        key = keys[position(generator)];
+    }
+
+    std::vector<int> by_rank = keys;
+    std::shuffle(by_rank.begin(), by_rank.end(), generator);
+    const std::vector<int> zipf = zipf_lookups(by_rank, count, generator);
+
+    std::cout << n << " keys, " << count << " lookups, ns/find" << std::endl;
+    std::cout << std::setw(22) << "policy" << std::setw(12) << "uniform" << std::setw(12) << "zipf" << std::endl;
+
+    row<red_black_tree<int, int>>("red_black", keys, uniform, zipf, [](auto &) {});
+    row<splay_type>("splay none", keys, uniform, zipf,
+                    [](splay_type &tree) { tree.setup_splay(splay_type::splay_mode::none); });
+    row<splay_type>("splay full top-down", keys, uniform, zipf, [](splay_type &) {});
+    row<splay_type>("splay semi", keys, uniform, zipf,
+                    [](splay_type &tree) { tree.setup_splay(splay_type::splay_mode::semi); });
+    row<splay_type>("full, depth > log2 n", keys, uniform, zipf,
+                    [threshold](splay_type &tree) { tree.setup_splay(splay_type::splay_mode::full, threshold); });
+    row<splay_type>("semi, depth > log2 n", keys, uniform, zipf,
+                    [threshold](splay_type &tree) { tree.setup_splay(splay_type::splay_mode::semi, threshold); });
+    row<splay_type>("full, p = 1/32", keys, uniform, zipf,
+                    [](splay_type &tree) { tree.setup_splay(splay_type::splay_mode::full, 0, 1.0 / 32); });
+    return 0;
+}
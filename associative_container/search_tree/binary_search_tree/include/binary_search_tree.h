@@ -2,6 +2,7 @@
 #define MATH_PRACTICE_AND_OPERATING_SYSTEMS_BINARY_SEARCH_TREE_H
 
 #include <list>
+#include <memory_resource>
 #include <stack>
 #include <vector>
 #include <memory>
@@ -13,17 +14,140 @@
 #include <ranges>
 #include <pp_allocator.h>
 #include <concepts>
+#include <cstdint>
+#include <bit>
+#include <iterator>
+#include <tuple>
+#include <atomic>
+#include <algorithm>
+#include <work_stealing_pool.h>
 
 namespace __detail
 {
     template<typename tkey, typename tvalue, typename compare, typename tag>
     class bst_impl;
 
+    /** Tag of a plain binary search tree; with order_statistics its nodes keep the sizes of their subtrees
+     */
+    template<bool order_statistics = false>
     class BST_TAG;
+
+    /** Pointer to T with one spare flag in its low bit, which is always zero because T is aligned to at least 2.
+     *  Reads and assignments behave as for T*; assignment replaces only the pointer and keeps the flag,
+     *  so the flag belongs to the object holding the pointer, not to the pointee
+     */
+    template<typename T>
+    class flagged_pointer
+    {
+        std::uintptr_t _bits;
+
+    public:
+
+        flagged_pointer(T* pointer = nullptr) noexcept;
+
+        flagged_pointer(const flagged_pointer& other) noexcept =default;
+
+        flagged_pointer& operator=(const flagged_pointer& other) noexcept;
+
+        flagged_pointer& operator=(T* pointer) noexcept;
+
+        operator T*() const noexcept;
+
+        template<std::derived_from<T> U>
+        explicit operator U*() const noexcept;
+
+        T* operator->() const noexcept;
+
+        bool flag() const noexcept;
+
+        void set_flag(bool value) noexcept;
+    };
+
+    template<typename T>
+    flagged_pointer<T>::flagged_pointer(T* pointer) noexcept : _bits(reinterpret_cast<std::uintptr_t>(pointer))
+    {
+    }
+
+    template<typename T>
+    flagged_pointer<T>& flagged_pointer<T>::operator=(const flagged_pointer& other) noexcept
+    {
+        return *this = static_cast<T*>(other);
+    }
+
+    template<typename T>
+    flagged_pointer<T>& flagged_pointer<T>::operator=(T* pointer) noexcept
+    {
+        static_assert(alignof(T) >= 2, "the low bit of the pointer must be free");
+        _bits = reinterpret_cast<std::uintptr_t>(pointer) | (_bits & 1);
+        return *this;
+    }
+
+    template<typename T>
+    flagged_pointer<T>::operator T*() const noexcept
+    {
+        return reinterpret_cast<T*>(_bits & ~std::uintptr_t(1));
+    }
+
+    template<typename T>
+    template<std::derived_from<T> U>
+    flagged_pointer<T>::operator U*() const noexcept
+    {
+        return static_cast<U*>(static_cast<T*>(*this));
+    }
+
+    template<typename T>
+    T* flagged_pointer<T>::operator->() const noexcept
+    {
+        return static_cast<T*>(*this);
+    }
+
+    /** Whether nodes of a tree with this tag keep subtree sizes: the bool argument of a tag template,
+     *  a tree kind that always needs them specialises it for its own tag
+     */
+    template<typename tag>
+    constexpr bool keeps_subtree_sizes = false;
+
+    template<template<bool> typename tag_template, bool order_statistics>
+    constexpr bool keeps_subtree_sizes<tag_template<order_statistics>> = order_statistics;
+
+    /** Part of a node that exists only for order statistics, empty without them
+     */
+    template<bool enabled>
+    struct subtree_size_field
+    {
+        // Number of nodes in the subtree rooted here
+        size_t subtree_size = 1;
+    };
+
+    template<>
+    struct subtree_size_field<false>
+    {
+    };
+
+    /** A value and three links: a node of a tree without order statistics is no larger than this
+     */
+    template<typename value_type>
+    struct bare_node_layout
+    {
+        value_type data;
+        void* links[3];
+    };
+
+    template<typename T>
+    bool flagged_pointer<T>::flag() const noexcept
+    {
+        return (_bits & 1) != 0;
+    }
+
+    template<typename T>
+    void flagged_pointer<T>::set_flag(bool value) noexcept
+    {
+        _bits = (_bits & ~std::uintptr_t(1)) | static_cast<std::uintptr_t>(value);
+    }
 }
 
 
-template<typename tkey, typename tvalue, compator<tkey> compare = std::less<tkey>, typename tag = __detail::BST_TAG>
+template<typename tkey, typename tvalue, compator<tkey> compare = std::less<tkey>, typename tag = __detail::BST_TAG<>>
 class binary_search_tree : private compare
 {
 public:
@@ -34,23 +158,27 @@ public:
 
 protected:
 
-    struct node
+    struct node : __detail::subtree_size_field<__detail::keeps_subtree_sizes<tag>>
     {
 
     public:
 
         value_type data;
 
-        node* parent;
+        // The low bit is free for per-node flags of derived trees (the colour of a red-black node)
+        __detail::flagged_pointer<node> parent;
         node* left_subtree;
         node* right_subtree;
 
         template<class ...Args>
         explicit node(node* parent, Args&& ...args);
 
-
-        virtual ~node() =default;
+        // No virtual destructor: nodes are freed by bst_impl::delete_node as the node type of the tree
     };
+
+    // Order statistics are the only per-node cost a tree may add to its value and links
+    static_assert(__detail::keeps_subtree_sizes<tag> || sizeof(node) == sizeof(__detail::bare_node_layout<value_type>),
+                  "a node without order statistics must hold only its value and links");
     friend class __detail::bst_impl<tkey, tvalue, compare, tag>;
     friend class binary_search_tree<tkey, tvalue, compare, tag>::node;
     inline bool compare_keys(const tkey& lhs, const tkey& rhs) const;
@@ -337,6 +465,8 @@ public:
 
     class infix_const_iterator
     {
+        friend class binary_search_tree;
+        friend class __detail::bst_impl<tkey, tvalue, compare, tag>;
     protected:
 
         infix_iterator _base;
@@ -698,6 +828,9 @@ protected:
     logger* _logger;
     size_t _size;
 
+    // Fixed by the tag: whether nodes keep subtree sizes
+    static constexpr bool _order_statistics = __detail::keeps_subtree_sizes<tag>;
+
     /** You should use coercion ctor or template methods of allocator
      */
     pp_allocator<value_type> _allocator;
@@ -729,6 +862,19 @@ public:
                        pp_allocator<value_type> alloc = pp_allocator<value_type>(),
                        logger* logger = nullptr);
 
+    /** Builds a perfectly balanced tree in O(n) from a range already ordered by cmp without repeated keys.
+     *  The order is trusted, not checked. Untagged ranges take the same path when they turn out to be sorted
+     */
+    template<input_iterator_for_pair<tkey, tvalue> iterator>
+    binary_search_tree(sorted_unique_t, iterator begin, iterator end, const compare& cmp = compare(),
+                       pp_allocator<value_type> alloc = pp_allocator<value_type>(),
+                       logger* logger = nullptr);
+
+    template<std::ranges::input_range Range>
+    binary_search_tree(sorted_unique_t, Range&& range, const compare& cmp = compare(),
+                       pp_allocator<value_type> alloc = pp_allocator<value_type>(),
+                       logger* logger = nullptr);
+
 public:
 
     binary_search_tree(const binary_search_tree &other);
@@ -746,6 +892,14 @@ public:
     tvalue& at(const tkey& key);
     const tvalue& at(const tkey& key) const;
 
+    /** Heterogeneous lookup: with a transparent compare (std::less<> etc.) key may be any type comparable with tkey,
+     *  e.g. std::string_view for std::string keys, and no tkey is built for the search
+     */
+    template<typename K> requires transparent_compare<compare>
+    tvalue& at(const K& key);
+    template<typename K> requires transparent_compare<compare>
+    const tvalue& at(const K& key) const;
+
     tvalue& operator[](const tkey& key);
     tvalue& operator[](tkey&& key);
 
@@ -753,10 +907,20 @@ public:
 
     size_t size() const noexcept;
 
+    /** Empties the tree without recursion and in O(1) extra memory, so even a degenerate tree of millions of nodes is safe
+     */
     void clear() noexcept;
 
+    /** Frees the subtree rooted at n, which must already be detached from the tree
+     */
     void clear(node *n);
 
+    /** Empties the tree by releasing its memory resource in one call instead of freeing nodes one by one.
+     *  Applies to std::pmr::monotonic_buffer_resource and the std::pmr pool resources, which must hold nothing
+     *  but this tree: the release returns all of their memory. Other resources are emptied by clear() and false is returned
+     */
+    bool clear_and_release() noexcept;
+
     std::pair<infix_iterator, bool> insert(const value_type&);
     std::pair<infix_iterator, bool> insert(value_type&&);
 
@@ -766,9 +930,32 @@ public:
     template<std::ranges::input_range R>
     void insert_range( R&& rg );
 
+    /** Into an empty tree builds it balanced in O(n), otherwise inserts one by one
+     */
+    template<std::ranges::input_range R>
+    void insert_range(sorted_unique_t, R&& rg);
+
     template<class ...Args>
     std::pair<infix_iterator, bool> emplace(Args&&...args);
 
+    /** Constructs the value from args in place inside the new node, and only if key is absent;
+     *  on a hit neither key nor args are touched (args are not moved from)
+     */
+    template<class ...Args>
+    std::pair<infix_iterator, bool> try_emplace(const tkey& key, Args&&...args);
+    template<class ...Args>
+    std::pair<infix_iterator, bool> try_emplace(tkey&& key, Args&&...args);
+
+    /** Insertion with a finger: the search starts at hint and climbs through parent links only while the key lies
+     *  outside the climbed subtree. With a hint next to the insertion point (the previous result for monotone input,
+     *  end() for ascending input) it takes O(1) key comparisons; any valid iterator of this tree is a correct hint
+     */
+    infix_iterator insert(infix_const_iterator hint, const value_type&);
+    infix_iterator insert(infix_const_iterator hint, value_type&&);
+
+    template<class ...Args>
+    infix_iterator emplace_hint(infix_const_iterator hint, Args&&...args);
+
     infix_iterator insert_or_assign(const value_type&);
     infix_iterator insert_or_assign(value_type&&);
 
@@ -793,6 +980,29 @@ public:
     infix_iterator upper_bound(const tkey&);
     infix_const_iterator upper_bound(const tkey&) const;
 
+    /** Finger search: the same result as lower_bound(key), found by climbing from hint instead of descending from the root
+     */
+    infix_iterator lower_bound(infix_const_iterator hint, const tkey&);
+    infix_const_iterator lower_bound(infix_const_iterator hint, const tkey&) const;
+
+    template<typename K> requires transparent_compare<compare>
+    bool contains(const K& key) const;
+
+    template<typename K> requires transparent_compare<compare>
+    infix_iterator find(const K&);
+    template<typename K> requires transparent_compare<compare>
+    infix_const_iterator find(const K&) const;
+
+    template<typename K> requires transparent_compare<compare>
+    infix_iterator lower_bound(const K&);
+    template<typename K> requires transparent_compare<compare>
+    infix_const_iterator lower_bound(const K&) const;
+
+    template<typename K> requires transparent_compare<compare>
+    infix_iterator upper_bound(const K&);
+    template<typename K> requires transparent_compare<compare>
+    infix_const_iterator upper_bound(const K&) const;
+
     infix_iterator erase(infix_iterator pos);
     infix_iterator erase(infix_const_iterator pos);
 
@@ -801,6 +1011,31 @@ public:
 
     size_t erase(const tkey& key);
 
+    /** Order statistics are chosen by the type: a tree tagged BST_TAG<true> (order_statistics = true for the derived
+     *  trees) keeps the size of every subtree through insertion, erasure and rotations, and select, rank, distance
+     *  and advance take O(log n). Without them nodes carry no counter, insertion does not climb to the root,
+     *  and the same requests walk the tree in order, O(n)
+     */
+    static constexpr bool order_statistics() noexcept;
+
+    /** Element with exactly k elements before it in key order, end() if k >= size()
+     */
+    infix_iterator select(size_t k);
+    infix_const_iterator select(size_t k) const;
+
+    /** Number of elements with keys less than key
+     */
+    size_t rank(const tkey& key) const;
+
+    /** Number of increments from first to last, negative if last comes first; end() counts as position size()
+     */
+    ptrdiff_t distance(infix_const_iterator first, infix_const_iterator last) const;
+
+    /** Iterator n positions after it (before it for negative n); end() if that falls outside the tree
+     */
+    infix_iterator advance(infix_const_iterator it, ptrdiff_t n);
+    infix_const_iterator advance(infix_const_iterator it, ptrdiff_t n) const;
+
 public:
 
     // region iterators requests definition
@@ -908,7 +1143,180 @@ public:
 
 protected:
 
+    /** Copies the subtree of source in one preorder walk: shape, values and per-node metadata (via bst_impl::clone_node),
+     *  without comparing keys or rebalancing. Iterative, so degenerate trees do not exhaust the stack.
+     *  Frees the nodes already made if a copy throws
+     */
+    node* clone(const node* source);
+
+    /** Builds a perfectly balanced subtree of count nodes taken in order from it, in one in-order pass.
+     *  Levels above height are full; metadata is set by bst_impl::post_build. Frees the nodes already made if one throws
+     */
+    template<typename iterator>
+    node* build_sorted(iterator& it, size_t count, size_t depth, size_t height);
+
+    /** Fills an empty tree with count elements taken in order from first
+     */
+    template<typename iterator>
+    void assign_sorted(iterator first, size_t count);
+
+    /** Fills an empty tree from a sorted range without repeated keys; input-only ranges are buffered first
+     */
+    template<std::ranges::input_range Range>
+    void assign_sorted(Range&& range);
+
+    /** Same for an empty tree and a multipass range whose keys strictly increase; false leaves the tree untouched
+     */
+    template<std::ranges::input_range Range>
+    bool try_assign_sorted(Range&& range);
+
+    /** Node with a key equivalent to key, the first not less than key and the first greater than key;
+     *  nullptr if there is none. K is tkey or, with a transparent compare, any type comparable with it
+     */
+    template<typename K>
+    node* find_node(const K& key) const;
+
+    template<typename K>
+    node* lower_bound_node(const K& key) const;
+
+    template<typename K>
+    node* upper_bound_node(const K& key) const;
+
+    /** Common part of both try_emplace overloads, key is const tkey& or tkey&&
+     */
+    template<typename K, class ...Args>
+    std::pair<infix_iterator, bool> try_emplace_node(K&& key, Args&&...args);
+
+    /** Links a new leaf under parent (as the root if parent is nullptr), counts it and lets the tree rebalance
+     */
+    infix_iterator attach(node* parent, bool to_left, node* new_node);
+
+    /** Node a hinted search starts from: the hinted one, the greatest for end(), nullptr for an empty tree
+     */
+    node* hint_node(infix_const_iterator hint) const;
+
+    /** Climbs from finger only while key lies outside the key range of the climbed subtree and returns the root
+     *  of the smallest such subtree that contains it; next is the first node after that subtree, nullptr if none
+     *  or if the subtree itself holds a node not less than key. Comparisons are made only at the turns of the path
+     */
+    node* finger_subtree(node* finger, const tkey& key, node*& next) const;
+
+    template<typename V>
+    infix_iterator insert_hint(infix_const_iterator hint, V&& value);
+
+    static size_t subtree_size(const node* n) noexcept;
 
+    /** Copies the subtree size of from into to; does nothing without order statistics
+     */
+    static void copy_size(node* to, const node* from) noexcept;
+
+    /** Recounts the size of n from its children; does nothing without order statistics
+     */
+    void recalculate_size(node* n) noexcept;
+
+    /** Counts a leaf just linked under parent in every subtree on the way to the root
+     */
+    void count_insert(node* parent) noexcept;
+
+    /** Called before target is unlinked. replacement is the node that takes its place when target has two children,
+     *  otherwise nullptr: every subtree that loses a node is decremented, and replacement takes over the size of target
+     */
+    void count_erase(node* target, node* replacement) noexcept;
+
+    /** Position of n in key order, size() for nullptr
+     */
+    size_t position(const node* n) const;
+
+    /** Node at position k, nullptr if k >= size()
+     */
+    node* select_node(size_t k) const;
+
+    /** Calls free_node for every node of the subtree rooted at n without recursion and in O(1) extra memory.
+     *  Rotations straighten the subtree into a right spine on the way, so child links are not valid inside free_node
+     */
+    template<typename F>
+    static void dismantle(node* n, F&& free_node) noexcept;
+
+    /** Whether resource gives back all of its memory in one call: a std::pmr monotonic or pool resource
+     */
+    static bool releasable(std::pmr::memory_resource* resource) noexcept;
+
+    static void release_resource(std::pmr::memory_resource* resource) noexcept;
+
+    // region join-based set operations definition
+
+    /** State shared by the tasks of one set operation. Tasks only relink nodes: everything left out of the result
+     *  is chained here (through parent) and freed by the calling thread once all tasks have finished
+     */
+    struct set_operation
+    {
+        // Меньше узлов в задаче параллелить невыгодно
+        static constexpr size_t grain = 4096;
+
+        work_stealing_pool* pool;
+        size_t parallel_depth;
+        std::atomic<node*> discarded;
+
+        set_operation(work_stealing_pool* pool, size_t smaller) noexcept;
+
+        void discard(node* subtree_root) noexcept;
+    };
+
+    /** Runs both functions, on the pool while depth is below the parallel depth of operation
+     */
+    template<typename F1, typename F2>
+    static void run_both(set_operation& operation, size_t depth, F1&& first, F2&& second);
+
+    /** The recursions below work on detached subtrees through bst_impl::make_subtree, expose and join,
+     *  so they never touch _root and may run concurrently on disjoint subtrees. O(m log(n / m + 1)) work
+     */
+    template<typename subtree>
+    std::tuple<subtree, node*, subtree> split_subtree(subtree tree, const tkey& key);
+
+    template<typename subtree>
+    std::pair<subtree, node*> split_last(subtree tree);
+
+    /** Join of two subtrees without a middle node, every key of left is less than every key of right
+     */
+    template<typename subtree>
+    subtree join_subtrees(subtree left, subtree right);
+
+    template<typename subtree>
+    subtree union_subtrees(subtree lhs, subtree rhs, set_operation& operation, size_t depth);
+
+    template<typename subtree>
+    subtree intersect_subtrees(subtree lhs, const node* rhs, set_operation& operation, size_t depth);
+
+    template<typename subtree>
+    subtree difference_subtrees(subtree lhs, const node* rhs, set_operation& operation, size_t depth);
+
+    /** Copy of other with the allocator, compare and logger of *this
+     */
+    binary_search_tree clone_foreign(const binary_search_tree& other);
+
+    /** Frees the chain of discarded subtrees, returns the number of freed nodes
+     */
+    size_t release(set_operation& operation) noexcept;
+
+    /** Entry points of the set operations of balanced trees: other is consumed by merge_union and join_trees,
+     *  split_trees moves keys not less than key into greater
+     */
+    void merge_union(binary_search_tree& other, work_stealing_pool* pool);
+
+    void merge_intersection(const binary_search_tree& other, work_stealing_pool* pool);
+
+    void merge_difference(const binary_search_tree& other, work_stealing_pool* pool);
+
+    void join_trees(value_type&& middle, binary_search_tree& right);
+
+    void split_trees(const tkey& key, binary_search_tree& greater);
+
+    /** Sorts and deduplicates rg (the first of equal keys wins), builds a balanced tree of it and merges it in
+     */
+    template<std::ranges::input_range R>
+    void bulk_insert(R&& rg, work_stealing_pool* pool);
+
+    // endregion join-based set operations definition
 
     // region subtree rotations definition
 
@@ -945,12 +1353,19 @@ namespace __detail
         // Only calls destructor and frees memory
         static void delete_node(binary_search_tree<tkey, tvalue, compare, tag>& cont, binary_search_tree<tkey, tvalue, compare, tag>::node** node);
 
+        // New unlinked node with the value and metadata of source, child of parent
+        static binary_search_tree<tkey, tvalue, compare, tag>::node* clone_node(binary_search_tree<tkey, tvalue, compare, tag>& cont, const binary_search_tree<tkey, tvalue, compare, tag>::node* source, binary_search_tree<tkey, tvalue, compare, tag>::node* parent);
+
         //Does not invalidate node*, needed for splay tree
         static void post_search(binary_search_tree<tkey, tvalue, compare, tag>::node**){}
 
         //Does not invalidate node*
         static void post_insert(binary_search_tree<tkey, tvalue, compare, tag>& cont, binary_search_tree<tkey, tvalue, compare, tag>::node**){}
 
+        // Metadata of a node of a tree built from sorted data, called once both subtrees are linked,
+        // with the depth of the node and the depth of the lowest level of the whole tree
+        static void post_build(binary_search_tree<tkey, tvalue, compare, tag>::node*, size_t, size_t){}
+
         // Removes this node from tree and deletes it
         static void erase(binary_search_tree<tkey, tvalue, compare, tag>& cont, binary_search_tree<tkey, tvalue, compare, tag>::node**);
 
@@ -963,7 +1378,7 @@ void __detail::bst_impl<tkey, tvalue, compare, tag>::swap(binary_search_tree<tke
                                                           binary_search_tree<tkey, tvalue, compare, tag> &rhs) noexcept
 {
     using std::swap;
-    swap(lhs.root, rhs.root);
+    swap(lhs._root, rhs._root);
     swap(lhs._logger, rhs._logger);
     swap(lhs._size, rhs._size);
     swap(lhs._allocator, rhs._allocator);
@@ -974,6 +1389,10 @@ template<input_iterator_for_pair<tkey, tvalue> iterator>
 binary_search_tree<tkey, tvalue, compare, tag>::binary_search_tree(iterator begin, iterator end, const compare &cmp,
                                                                    pp_allocator<typename binary_search_tree<tkey, tvalue, compare, tag>::value_type> alloc, logger *logger) : compare(cmp), _root(nullptr), _logger(logger), _size(0), _allocator(alloc)
 {
+    if (try_assign_sorted(std::ranges::subrange(begin, end)))
+    {
+        return;
+    }
     for (auto it = begin; it != end; ++it)
     {
         emplace(it->first, it->second);
@@ -1009,6 +1428,16 @@ binary_search_tree(std::initializer_list<std::pair<tkey, tvalue>> data, const co
                    pp_allocator<U> alloc = pp_allocator<U>(),
                    logger* logger = nullptr) -> binary_search_tree<tkey, tvalue, compare>;
 
+template<typename compare, typename U, typename iterator>
+binary_search_tree(sorted_unique_t, iterator begin, iterator end, const compare& cmp = compare(),
+                   pp_allocator<U> alloc = pp_allocator<U>(),
+                   logger* logger = nullptr) -> binary_search_tree<const typename std::iterator_traits<iterator>::value_type::first_type, typename std::iterator_traits<iterator>::value_type::second_type, compare>;
+
+template<typename compare, typename U, std::ranges::forward_range Range>
+binary_search_tree(sorted_unique_t, Range&& range, const compare& cmp = compare(),
+                   pp_allocator<U> alloc = pp_allocator<U>(),
+                   logger* logger = nullptr) -> binary_search_tree<const typename std::iterator_traits<typename std::ranges::iterator_t<Range>>::value_type::first_type, typename std::iterator_traits<typename std::ranges::iterator_t<Range>>::value_type::second_type, compare>;
+
 
 // region node implementation
 
@@ -2264,14 +2693,14 @@ size_t binary_search_tree<tkey, tvalue, compare, tag>::postfix_const_reverse_ite
 template <typename tkey, typename tvalue, compator<tkey> compare, typename tag>
 binary_search_tree<tkey, tvalue, compare, tag>::binary_search_tree(const compare &comp, pp_allocator<value_type> alloc,
                                                                    logger *logger)
-        : compare(comp), _allocator(alloc), _logger(logger), _root(nullptr)
+        : compare(comp), _allocator(alloc), _logger(logger), _root(nullptr), _size(0)
 {
 }
 
 template <typename tkey, typename tvalue, compator<tkey> compare, typename tag>
 binary_search_tree<tkey, tvalue, compare, tag>::binary_search_tree(pp_allocator<value_type> alloc, const compare &comp,
                                                                    logger *logger)
-        : compare(comp), _allocator(alloc), _logger(logger), _root(nullptr)
+        : compare(comp), _allocator(alloc), _logger(logger), _root(nullptr), _size(0)
 {
 }
 
@@ -2279,8 +2708,12 @@ template <typename tkey, typename tvalue, compator<tkey> compare, typename tag>
 template <std::ranges::input_range Range>
 binary_search_tree<tkey, tvalue, compare, tag>::binary_search_tree(Range &&range, const compare &cmp,
                                                                    pp_allocator<value_type> alloc, logger *logger)
-        : compare(cmp), _allocator(alloc), _logger(logger), _root(nullptr)
+        : compare(cmp), _allocator(alloc), _logger(logger), _root(nullptr), _size(0)
 {
+    if (try_assign_sorted(range))
+    {
+        return;
+    }
     for (auto &&element : range)
     {
         emplace(std::forward<decltype(element)>(element));
@@ -2291,81 +2724,253 @@ template <typename tkey, typename tvalue, compator<tkey> compare, typename tag>
 binary_search_tree<tkey, tvalue, compare, tag>::binary_search_tree(std::initializer_list<std::pair<tkey, tvalue>> data,
                                                                    const compare &cmp, pp_allocator<value_type> alloc,
                                                                    logger *logger)
-        : compare(cmp), _allocator(alloc), _logger(logger), _root(nullptr)
+        : compare(cmp), _allocator(alloc), _logger(logger), _root(nullptr), _size(0)
 {
+    if (try_assign_sorted(data))
+    {
+        return;
+    }
     for (const auto &element : data)
     {
         emplace(element.first, element.second);
     }
 }
 
+template <typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+template <input_iterator_for_pair<tkey, tvalue> iterator>
+binary_search_tree<tkey, tvalue, compare, tag>::binary_search_tree(sorted_unique_t, iterator begin, iterator end,
+                                                                   const compare &cmp, pp_allocator<value_type> alloc,
+                                                                   logger *logger)
+        : compare(cmp), _root(nullptr), _logger(logger), _size(0), _allocator(alloc)
+{
+    assign_sorted(std::ranges::subrange(begin, end));
+}
+
+template <typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+template <std::ranges::input_range Range>
+binary_search_tree<tkey, tvalue, compare, tag>::binary_search_tree(sorted_unique_t, Range &&range, const compare &cmp,
+                                                                   pp_allocator<value_type> alloc, logger *logger)
+        : compare(cmp), _root(nullptr), _logger(logger), _size(0), _allocator(alloc)
+{
+    assign_sorted(std::forward<Range>(range));
+}
+
 // endregion binary_search_tree implementation
 
 
 // region binary_search_tree 5_rules implementation
 
 template <typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-binary_search_tree<tkey, tvalue, compare, tag>::binary_search_tree(const binary_search_tree &other)
-        : compare(other.compare), _logger(other._logger), _allocator(other._allocator)
+typename binary_search_tree<tkey, tvalue, compare, tag>::node *
+binary_search_tree<tkey, tvalue, compare, tag>::clone(const node *source)
 {
-    if (other._root)
+    if (source == nullptr)
+    {
+        return nullptr;
+    }
+
+    node *root = __detail::bst_impl<tkey, tvalue, compare, tag>::clone_node(*this, source, nullptr);
+    copy_size(root, source);
+    try
     {
-        _root = _allocator.template new_object<node>(nullptr, other._root->data);
-        for (auto it = other.begin(); it != other.end(); ++it)
+        // Обе вершины идут синхронно: вниз в ещё не скопированного ребёнка, иначе вверх по parent
+        const node *from = source;
+        node *to = root;
+        while (true)
         {
-            if (it != other.begin())
+            if (from->left_subtree != nullptr && to->left_subtree == nullptr)
+            {
+                to->left_subtree = __detail::bst_impl<tkey, tvalue, compare, tag>::clone_node(*this, from->left_subtree, to);
+                from = from->left_subtree;
+                to = to->left_subtree;
+                copy_size(to, from);
+            }
+            else if (from->right_subtree != nullptr && to->right_subtree == nullptr)
+            {
+                to->right_subtree = __detail::bst_impl<tkey, tvalue, compare, tag>::clone_node(*this, from->right_subtree, to);
+                from = from->right_subtree;
+                to = to->right_subtree;
+                copy_size(to, from);
+            }
+            else if (from == source)
+            {
+                break;
+            }
+            else
             {
-                emplace(it->first, it->second);
+                from = from->parent;
+                to = to->parent;
             }
         }
     }
-    else
+    catch (...)
     {
-        _root = nullptr;
+        clear(root);
+        throw;
     }
+    return root;
 }
 
 template <typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-binary_search_tree<tkey, tvalue, compare, tag>::binary_search_tree(binary_search_tree &&other) noexcept
-        : compare(std::move(other)), _root(other._root), _logger(other._logger), _allocator(std::move(other._allocator)),
-          _size(other._size)
+template <typename iterator>
+typename binary_search_tree<tkey, tvalue, compare, tag>::node *
+binary_search_tree<tkey, tvalue, compare, tag>::build_sorted(iterator &it, size_t count, size_t depth, size_t height)
 {
-    other._root = nullptr;
-    other._logger = nullptr;
-    other._size = 0;
-}
+    if (count == 0)
+    {
+        return nullptr;
+    }
 
-template <typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-binary_search_tree<tkey, tvalue, compare, tag> &binary_search_tree<tkey, tvalue, compare, tag>::operator=(
-        const binary_search_tree &other)
-{
-    if (this != &other)
+    // Левое поддерево не меньше правого, поэтому неполным может быть только последний уровень
+    node *left = build_sorted(it, count / 2, depth + 1, height);
+    node *subtree_root;
+    try
     {
-        binary_search_tree temp(other);
-        __detail::bst_impl<tkey, tvalue, compare, tag>::swap(*this, temp);
+        subtree_root = __detail::bst_impl<tkey, tvalue, compare, tag>::create_node(*this, nullptr, *it);
     }
-    return *this;
-}
+    catch (...)
+    {
+        clear(left);
+        throw;
+    }
+    ++it;
 
-template <typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-binary_search_tree<tkey, tvalue, compare, tag> &binary_search_tree<tkey, tvalue, compare, tag>::operator=(
-        binary_search_tree &&other) noexcept
-{
-    if (this != &other)
+    subtree_root->left_subtree = left;
+    if (left != nullptr)
     {
-        __detail::bst_impl<tkey, tvalue, compare, tag>::swap(*this, other);
+        left->parent = subtree_root;
     }
-    return *this;
+    try
+    {
+        subtree_root->right_subtree = build_sorted(it, count - count / 2 - 1, depth + 1, height);
+    }
+    catch (...)
+    {
+        clear(subtree_root);
+        throw;
+    }
+    if (subtree_root->right_subtree != nullptr)
+    {
+        subtree_root->right_subtree->parent = subtree_root;
+    }
+
+    // Размер известен заранее и ничего не стоит
+    if constexpr (_order_statistics)
+    {
+        subtree_root->subtree_size = count;
+    }
+    __detail::bst_impl<tkey, tvalue, compare, tag>::post_build(subtree_root, depth, height);
+    return subtree_root;
 }
 
 template <typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-binary_search_tree<tkey, tvalue, compare, tag>::~binary_search_tree()
+template <typename iterator>
+void binary_search_tree<tkey, tvalue, compare, tag>::assign_sorted(iterator first, size_t count)
 {
-    clear(_root);
+    _root = build_sorted(first, count, 0, count == 0 ? 0 : std::bit_width(count) - 1);
+    _size = count;
 }
 
-// endregion binary_search_tree 5_rules implementation
-
+template <typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+template <std::ranges::input_range Range>
+void binary_search_tree<tkey, tvalue, compare, tag>::assign_sorted(Range &&range)
+{
+    if constexpr (std::ranges::forward_range<Range>)
+    {
+        assign_sorted(std::ranges::begin(range), static_cast<size_t>(std::ranges::distance(range)));
+    }
+    else
+    {
+        // Размер однопроходного диапазона заранее неизвестен
+        std::vector<value_type> buffer;
+        for (auto &&element : range)
+        {
+            buffer.emplace_back(std::forward<decltype(element)>(element));
+        }
+        assign_sorted(std::make_move_iterator(buffer.begin()), buffer.size());
+    }
+}
+
+template <typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+template <std::ranges::input_range Range>
+bool binary_search_tree<tkey, tvalue, compare, tag>::try_assign_sorted(Range &&range)
+{
+    if constexpr (!std::ranges::forward_range<Range>)
+    {
+        return false;
+    }
+    else
+    {
+        if (_root != nullptr)
+        {
+            return false;
+        }
+
+        auto previous = std::ranges::begin(range);
+        size_t count = 0;
+        for (auto it = previous, end = std::ranges::end(range); it != end; ++it)
+        {
+            if (count++ != 0 && !compare_keys((*previous).first, (*it).first))
+            {
+                return false;
+            }
+            previous = it;
+        }
+
+        assign_sorted(std::ranges::begin(range), count);
+        return true;
+    }
+}
+
+template <typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+binary_search_tree<tkey, tvalue, compare, tag>::binary_search_tree(const binary_search_tree &other)
+        : compare(static_cast<const compare &>(other)), _root(nullptr), _logger(other._logger), _size(other._size),
+          _allocator(other._allocator)
+{
+    _root = clone(other._root);
+}
+
+template <typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+binary_search_tree<tkey, tvalue, compare, tag>::binary_search_tree(binary_search_tree &&other) noexcept
+        : compare(std::move(other)), _root(other._root), _logger(other._logger), _size(other._size),
+          _allocator(std::move(other._allocator))
+{
+    other._root = nullptr;
+    other._logger = nullptr;
+    other._size = 0;
+}
+
+template <typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+binary_search_tree<tkey, tvalue, compare, tag> &binary_search_tree<tkey, tvalue, compare, tag>::operator=(
+        const binary_search_tree &other)
+{
+    if (this != &other)
+    {
+        binary_search_tree temp(other);
+        __detail::bst_impl<tkey, tvalue, compare, tag>::swap(*this, temp);
+    }
+    return *this;
+}
+
+template <typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+binary_search_tree<tkey, tvalue, compare, tag> &binary_search_tree<tkey, tvalue, compare, tag>::operator=(
+        binary_search_tree &&other) noexcept
+{
+    if (this != &other)
+    {
+        __detail::bst_impl<tkey, tvalue, compare, tag>::swap(*this, other);
+    }
+    return *this;
+}
+
+template <typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+binary_search_tree<tkey, tvalue, compare, tag>::~binary_search_tree()
+{
+    clear(_root);
+}
+
+// endregion binary_search_tree 5_rules implementation
+
 
 // region binary_search_tree methods_access implementation
 
@@ -2485,16 +3090,93 @@ template <typename tkey, typename tvalue, compator<tkey> compare, typename tag>
 void binary_search_tree<tkey, tvalue, compare, tag>::clear() noexcept
 {
     clear(_root);
+    _root = nullptr;
+    _size = 0;
 }
 
 template <typename tkey, typename tvalue, compator<tkey> compare, typename tag>
 void binary_search_tree<tkey, tvalue, compare, tag>::clear(node *n)
 {
-    if (n != nullptr)
+    // Монотонный ресурс ничего не освобождает поштучно, и при тривиальных деструкторах обходить узлы незачем
+    if constexpr (std::is_trivially_destructible_v<node>)
+    {
+        if (dynamic_cast<std::pmr::monotonic_buffer_resource *>(_allocator.resource()) != nullptr)
+        {
+            return;
+        }
+    }
+    dismantle(n, [this](node *current) noexcept {
+        __detail::bst_impl<tkey, tvalue, compare, tag>::delete_node(*this, &current);
+    });
+}
+
+template <typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+bool binary_search_tree<tkey, tvalue, compare, tag>::clear_and_release() noexcept
+{
+    std::pmr::memory_resource *resource = _allocator.resource();
+    if (!releasable(resource))
+    {
+        clear();
+        return false;
+    }
+
+    // Память вернёт ресурс, но деструкторы элементов вызвать нужно
+    if constexpr (!std::is_trivially_destructible_v<value_type>)
+    {
+        dismantle(_root, [](node *current) noexcept { std::destroy_at(&current->data); });
+    }
+    _root = nullptr;
+    _size = 0;
+    release_resource(resource);
+    return true;
+}
+
+template <typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+template <typename F>
+void binary_search_tree<tkey, tvalue, compare, tag>::dismantle(node *n, F &&free_node) noexcept
+{
+    // Пока у узла есть левый ребёнок, правый поворот поднимает его наверх; узел без левого ребёнка освобождается,
+    // и разбор идёт дальше по правому. Каждый поворот навсегда убирает одно левое ребро, так что работа линейна
+    while (n != nullptr)
+    {
+        node *left = n->left_subtree;
+        if (left != nullptr)
+        {
+            n->left_subtree = left->right_subtree;
+            left->right_subtree = n;
+            n = left;
+        }
+        else
+        {
+            node *right = n->right_subtree;
+            free_node(n);
+            n = right;
+        }
+    }
+}
+
+template <typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+bool binary_search_tree<tkey, tvalue, compare, tag>::releasable(std::pmr::memory_resource *resource) noexcept
+{
+    return dynamic_cast<std::pmr::monotonic_buffer_resource *>(resource) != nullptr
+           || dynamic_cast<std::pmr::unsynchronized_pool_resource *>(resource) != nullptr
+           || dynamic_cast<std::pmr::synchronized_pool_resource *>(resource) != nullptr;
+}
+
+template <typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+void binary_search_tree<tkey, tvalue, compare, tag>::release_resource(std::pmr::memory_resource *resource) noexcept
+{
+    if (auto *monotonic = dynamic_cast<std::pmr::monotonic_buffer_resource *>(resource))
+    {
+        monotonic->release();
+    }
+    else if (auto *pool = dynamic_cast<std::pmr::unsynchronized_pool_resource *>(resource))
     {
-        clear(n->left_subtree);
-        clear(n->right_subtree);
-        _allocator.delete_object(n);
+        pool->release();
+    }
+    else if (auto *pool = dynamic_cast<std::pmr::synchronized_pool_resource *>(resource))
+    {
+        pool->release();
     }
 }
 
@@ -2547,6 +3229,7 @@ binary_search_tree<tkey, tvalue, compare, tag>::insert(const value_type& value)
     }
 
     ++_size; // Увеличение размера дерева
+    count_insert(parent);
 
     if (_logger)
     {
@@ -2601,6 +3284,7 @@ binary_search_tree<tkey, tvalue, compare, tag>::insert(value_type&& value)
     }
 
     ++_size; // Увеличение размера дерева
+    count_insert(parent);
 
     if (_logger)
     {
@@ -2614,6 +3298,10 @@ template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
 template<std::input_iterator InputIt>
 void binary_search_tree<tkey, tvalue, compare, tag>::insert(InputIt first, InputIt last)
 {
+    if (try_assign_sorted(std::ranges::subrange(first, last)))
+    {
+        return;
+    }
     for (auto it = first; it != last; ++it)
     {
         insert(*it); // Вставляем каждый элемент из диапазона
@@ -2624,57 +3312,99 @@ template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
 template<std::ranges::input_range R>
 void binary_search_tree<tkey, tvalue, compare, tag>::insert_range(R&& rg)
 {
+    if (try_assign_sorted(rg))
+    {
+        return;
+    }
     for (auto&& element : rg)
     {
         insert(std::forward<decltype(element)>(element)); // Вставляем каждый элемент из диапазона
     }
 }
 
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+template<std::ranges::input_range R>
+void binary_search_tree<tkey, tvalue, compare, tag>::insert_range(sorted_unique_t, R&& rg)
+{
+    if (_root == nullptr)
+    {
+        assign_sorted(std::forward<R>(rg));
+        return;
+    }
+    insert_range(std::forward<R>(rg));
+}
+
 template <typename tkey, typename tvalue, compator<tkey> compare, typename tag>
 template <class... Args>
 std::pair<typename binary_search_tree<tkey, tvalue, compare, tag>::infix_iterator, bool> binary_search_tree<
         tkey, tvalue, compare, tag>::emplace(Args &&...args)
 {
     value_type value(std::forward<Args>(args)...);
-    return insert(value);
+    return insert(std::move(value));
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-typename binary_search_tree<tkey, tvalue, compare, tag>::infix_iterator
-binary_search_tree<tkey, tvalue, compare, tag>::insert_or_assign(const value_type& value)
+template <typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+template <class... Args>
+std::pair<typename binary_search_tree<tkey, tvalue, compare, tag>::infix_iterator, bool> binary_search_tree<
+        tkey, tvalue, compare, tag>::try_emplace(const tkey& key, Args &&...args)
+{
+    return try_emplace_node(key, std::forward<Args>(args)...);
+}
+
+template <typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+template <class... Args>
+std::pair<typename binary_search_tree<tkey, tvalue, compare, tag>::infix_iterator, bool> binary_search_tree<
+        tkey, tvalue, compare, tag>::try_emplace(tkey&& key, Args &&...args)
+{
+    return try_emplace_node(std::move(key), std::forward<Args>(args)...);
+}
+
+template <typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+template <typename K, class... Args>
+std::pair<typename binary_search_tree<tkey, tvalue, compare, tag>::infix_iterator, bool> binary_search_tree<
+        tkey, tvalue, compare, tag>::try_emplace_node(K&& key, Args &&...args)
 {
     node* current = _root;
     node* parent = nullptr;
+    bool to_left = false;
 
-    // Поиск узла с таким же ключом или подходящего места для вставки
+    // Сначала ищем место по одному ключу, значение ещё не построено
     while (current != nullptr)
     {
         parent = current;
-        if (compare_keys(value.first, current->data.first))
+        if (compare_keys(key, current->data.first))
         {
+            to_left = true;
             current = current->left_subtree;
         }
-        else if (compare_keys(current->data.first, value.first))
+        else if (compare_keys(current->data.first, key))
         {
+            to_left = false;
             current = current->right_subtree;
         }
         else
         {
-            // Ключ найден, обновляем значение
-            current->data.second = value.second;
-            return infix_iterator(current);
+            // Ключ уже существует, аргументы остаются нетронутыми
+            return std::make_pair(infix_iterator(current), false);
         }
     }
 
-    // Создание нового узла
-    node* new_node = __detail::bst_impl<tkey, tvalue, compare, tag>::create_node(*this, parent, value);
+    // Пара собирается прямо в узле, без промежуточного value_type
+    node* new_node = __detail::bst_impl<tkey, tvalue, compare, tag>::create_node(*this, parent, std::piecewise_construct,
+            std::forward_as_tuple(std::forward<K>(key)), std::forward_as_tuple(std::forward<Args>(args)...));
 
-    // Установка нового узла в дерево
+    return std::make_pair(attach(parent, to_left, new_node), true);
+}
+
+template <typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+typename binary_search_tree<tkey, tvalue, compare, tag>::infix_iterator
+binary_search_tree<tkey, tvalue, compare, tag>::attach(node* parent, bool to_left, node* new_node)
+{
     if (parent == nullptr)
     {
-        _root = new_node; // Дерево было пустым
+        _root = new_node;
     }
-    else if (compare_keys(new_node->data.first, parent->data.first))
+    else if (to_left)
     {
         parent->left_subtree = new_node;
     }
@@ -2683,19 +3413,157 @@ binary_search_tree<tkey, tvalue, compare, tag>::insert_or_assign(const value_typ
         parent->right_subtree = new_node;
     }
 
-    ++_size; // Увеличение размера дерева
+    ++_size;
+    count_insert(parent);
 
     if (_logger)
     {
-        _logger->log("Inserted or assigned new node", logger::severity::debug);
+        _logger->log("Successfully inserted new node", logger::severity::debug);
     }
+
     __detail::bst_impl<tkey, tvalue, compare, tag>::post_insert(*this, &new_node);
     return infix_iterator(new_node);
 }
 
+template <typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+typename binary_search_tree<tkey, tvalue, compare, tag>::node*
+binary_search_tree<tkey, tvalue, compare, tag>::hint_node(infix_const_iterator hint) const
+{
+    node* finger = hint._base._data;
+    if (finger == nullptr)
+    {
+        // end() сам по себе не указывает на узел, начинаем с наибольшего
+        finger = _root;
+        while (finger != nullptr && finger->right_subtree != nullptr)
+        {
+            finger = finger->right_subtree;
+        }
+    }
+    return finger;
+}
+
+template <typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+typename binary_search_tree<tkey, tvalue, compare, tag>::node*
+binary_search_tree<tkey, tvalue, compare, tag>::finger_subtree(node* finger, const tkey& key, node*& next) const
+{
+    next = nullptr;
+    node* current = finger;
+    node* last = finger;
+
+    if (compare_keys(finger->data.first, key))
+    {
+        // Ключ правее finger: нижние границы поддеревьев на пути вверх уже меньше ключа,
+        // проверяем только верхние - предков, в левом поддереве которых мы поднимались
+        while (current->parent != nullptr)
+        {
+            node* parent = current->parent;
+            if (current == parent->left_subtree)
+            {
+                if (compare_keys(key, parent->data.first))
+                {
+                    next = parent;
+                    break;
+                }
+                if (!compare_keys(parent->data.first, key))
+                {
+                    // Ключ равен parent, выше подниматься незачем
+                    return parent;
+                }
+                last = parent;
+            }
+            current = parent;
+        }
+    }
+    else if (compare_keys(key, finger->data.first))
+    {
+        // Симметрично: ключ левее finger, проверяем нижние границы
+        while (current->parent != nullptr)
+        {
+            node* parent = current->parent;
+            if (current == parent->right_subtree)
+            {
+                if (compare_keys(parent->data.first, key))
+                {
+                    break;
+                }
+                if (!compare_keys(key, parent->data.first))
+                {
+                    return parent;
+                }
+                last = parent;
+            }
+            current = parent;
+        }
+    }
+    return last;
+}
+
+template <typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+template <typename V>
+typename binary_search_tree<tkey, tvalue, compare, tag>::infix_iterator
+binary_search_tree<tkey, tvalue, compare, tag>::insert_hint(infix_const_iterator hint, V&& value)
+{
+    node* finger = hint_node(hint);
+    if (finger == nullptr)
+    {
+        return insert(std::forward<V>(value)).first;
+    }
+
+    node* next;
+    node* current = finger_subtree(finger, value.first, next);
+    node* parent = nullptr;
+    bool to_left = false;
+
+    // Обычный спуск, но от корня найденного поддерева, а не от корня дерева
+    while (current != nullptr)
+    {
+        parent = current;
+        if (compare_keys(value.first, current->data.first))
+        {
+            to_left = true;
+            current = current->left_subtree;
+        }
+        else if (compare_keys(current->data.first, value.first))
+        {
+            to_left = false;
+            current = current->right_subtree;
+        }
+        else
+        {
+            return infix_iterator(current);
+        }
+    }
+
+    node* new_node = __detail::bst_impl<tkey, tvalue, compare, tag>::create_node(*this, parent, std::forward<V>(value));
+    return attach(parent, to_left, new_node);
+}
+
+template <typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+typename binary_search_tree<tkey, tvalue, compare, tag>::infix_iterator
+binary_search_tree<tkey, tvalue, compare, tag>::insert(infix_const_iterator hint, const value_type& value)
+{
+    return insert_hint(hint, value);
+}
+
+template <typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+typename binary_search_tree<tkey, tvalue, compare, tag>::infix_iterator
+binary_search_tree<tkey, tvalue, compare, tag>::insert(infix_const_iterator hint, value_type&& value)
+{
+    return insert_hint(hint, std::move(value));
+}
+
+template <typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+template <class... Args>
+typename binary_search_tree<tkey, tvalue, compare, tag>::infix_iterator
+binary_search_tree<tkey, tvalue, compare, tag>::emplace_hint(infix_const_iterator hint, Args &&...args)
+{
+    value_type value(std::forward<Args>(args)...);
+    return insert_hint(hint, std::move(value));
+}
+
 template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
 typename binary_search_tree<tkey, tvalue, compare, tag>::infix_iterator
-binary_search_tree<tkey, tvalue, compare, tag>::insert_or_assign(value_type&& value)
+binary_search_tree<tkey, tvalue, compare, tag>::insert_or_assign(const value_type& value)
 {
     node* current = _root;
     node* parent = nullptr;
@@ -2715,13 +3583,13 @@ binary_search_tree<tkey, tvalue, compare, tag>::insert_or_assign(value_type&& va
         else
         {
             // Ключ найден, обновляем значение
-            current->data.second = std::move(value.second);
+            current->data.second = value.second;
             return infix_iterator(current);
         }
     }
 
-    // Создание нового узла с использованием перемещающего конструктора
-    node* new_node = __detail::bst_impl<tkey, tvalue, compare, tag>::create_node(*this, parent, std::move(value));
+    // Создание нового узла
+    node* new_node = __detail::bst_impl<tkey, tvalue, compare, tag>::create_node(*this, parent, value);
 
     // Установка нового узла в дерево
     if (parent == nullptr)
@@ -2738,18 +3606,74 @@ binary_search_tree<tkey, tvalue, compare, tag>::insert_or_assign(value_type&& va
     }
 
     ++_size; // Увеличение размера дерева
+    count_insert(parent);
 
     if (_logger)
     {
-        _logger->log("Inserted or assigned new node with move semantics", logger::severity::debug);
+        _logger->log("Inserted or assigned new node", logger::severity::debug);
     }
     __detail::bst_impl<tkey, tvalue, compare, tag>::post_insert(*this, &new_node);
     return infix_iterator(new_node);
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-template<std::input_iterator InputIt>
-void binary_search_tree<tkey, tvalue, compare, tag>::insert_or_assign(InputIt first, InputIt last)
+typename binary_search_tree<tkey, tvalue, compare, tag>::infix_iterator
+binary_search_tree<tkey, tvalue, compare, tag>::insert_or_assign(value_type&& value)
+{
+    node* current = _root;
+    node* parent = nullptr;
+
+    // Поиск узла с таким же ключом или подходящего места для вставки
+    while (current != nullptr)
+    {
+        parent = current;
+        if (compare_keys(value.first, current->data.first))
+        {
+            current = current->left_subtree;
+        }
+        else if (compare_keys(current->data.first, value.first))
+        {
+            current = current->right_subtree;
+        }
+        else
+        {
+            // Ключ найден, обновляем значение
+            current->data.second = std::move(value.second);
+            return infix_iterator(current);
+        }
+    }
+
+    // Создание нового узла с использованием перемещающего конструктора
+    node* new_node = __detail::bst_impl<tkey, tvalue, compare, tag>::create_node(*this, parent, std::move(value));
+
+    // Установка нового узла в дерево
+    if (parent == nullptr)
+    {
+        _root = new_node; // Дерево было пустым
+    }
+    else if (compare_keys(new_node->data.first, parent->data.first))
+    {
+        parent->left_subtree = new_node;
+    }
+    else
+    {
+        parent->right_subtree = new_node;
+    }
+
+    ++_size; // Увеличение размера дерева
+    count_insert(parent);
+
+    if (_logger)
+    {
+        _logger->log("Inserted or assigned new node with move semantics", logger::severity::debug);
+    }
+    __detail::bst_impl<tkey, tvalue, compare, tag>::post_insert(*this, &new_node);
+    return infix_iterator(new_node);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+template<std::input_iterator InputIt>
+void binary_search_tree<tkey, tvalue, compare, tag>::insert_or_assign(InputIt first, InputIt last)
 {
     if (_logger)
     {
@@ -2823,6 +3747,7 @@ typename binary_search_tree<tkey, tvalue, compare, tag>::infix_iterator binary_s
     }
 
     ++_size; // Увеличение размера дерева
+    count_insert(parent);
 
     if (_logger)
     {
@@ -2848,6 +3773,9 @@ void binary_search_tree<tkey, tvalue, compare, tag>::swap(binary_search_tree& ot
     pp_allocator<value_type> this_alloc = _allocator;
     logger* this_logger = _logger;
 
+    // Размер принадлежит дереву и переезжает вместе с корнем
+    std::swap(_size, other._size);
+
     try {
         _root = other._root;
         _allocator = other._allocator;
@@ -2866,265 +3794,993 @@ void binary_search_tree<tkey, tvalue, compare, tag>::swap(binary_search_tree& ot
             other._logger->log("Swapped trees (other)", logger::severity::debug);
         }
     }
-    catch (...) {
-        _root = this_root;
-        _allocator = this_alloc;
-        _logger = this_logger;
+    catch (...) {
+        _root = this_root;
+        _allocator = this_alloc;
+        _logger = this_logger;
+
+        std::terminate();
+    }
+}
+
+// endregion binary_search_tree swap_method implementation
+
+// region binary_search_tree methods_search and methods_erase implementation
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+bool binary_search_tree<tkey, tvalue, compare, tag>::contains(const tkey& key) const
+{
+    node* current = _root;
+    while (current != nullptr)
+    {
+        if (compare::operator()(key, current->data.first))
+        {
+            current = current->left_subtree;
+        }
+        else if (compare::operator()(current->data.first, key))
+        {
+            current = current->right_subtree;
+        }
+        else
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+typename binary_search_tree<tkey, tvalue, compare, tag>::infix_iterator
+binary_search_tree<tkey, tvalue, compare, tag>::find(const tkey& key)
+{
+    node* current = _root;
+    while (current != nullptr)
+    {
+        if (compare::operator()(key, current->data.first))
+        {
+            current = current->left_subtree;
+        }
+        else if (compare::operator()(current->data.first, key))
+        {
+            current = current->right_subtree;
+        }
+        else
+        {
+            return infix_iterator(current);
+        }
+    }
+    return end();
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+typename binary_search_tree<tkey, tvalue, compare, tag>::infix_const_iterator
+binary_search_tree<tkey, tvalue, compare, tag>::find(const tkey& key) const
+{
+    const node* current = _root;
+    while (current != nullptr)
+    {
+        if (compare::operator()(key, current->data.first))
+        {
+            current = current->left_subtree;
+        }
+        else if (compare::operator()(current->data.first, key))
+        {
+            current = current->right_subtree;
+        }
+        else
+        {
+            return infix_const_iterator(current);
+        }
+    }
+    return cend();
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+typename binary_search_tree<tkey, tvalue, compare, tag>::infix_iterator
+binary_search_tree<tkey, tvalue, compare, tag>::lower_bound(const tkey& key)
+{
+    node* current = _root;
+    node* result = nullptr;
+
+    while (current != nullptr)
+    {
+        if (!compare::operator()(current->data.first, key))
+        {
+            result = current;
+            current = current->left_subtree;
+        }
+        else
+        {
+            current = current->right_subtree;
+        }
+    }
+    return infix_iterator(result);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+typename binary_search_tree<tkey, tvalue, compare, tag>::infix_const_iterator
+binary_search_tree<tkey, tvalue, compare, tag>::lower_bound(const tkey& key) const
+{
+    node* current = _root;
+    node* result = nullptr;
+
+    while (current != nullptr)
+    {
+        if (!compare::operator()(current->data.first, key))
+        {
+            result = current;
+            current = current->left_subtree;
+        }
+        else
+        {
+            current = current->right_subtree;
+        }
+    }
+    return infix_const_iterator(result);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+typename binary_search_tree<tkey, tvalue, compare, tag>::infix_iterator
+binary_search_tree<tkey, tvalue, compare, tag>::upper_bound(const tkey& key)
+{
+    node* current = _root;
+    node* result = nullptr;
+
+    while (current != nullptr)
+    {
+        if (compare::operator()(key, current->data.first))
+        {
+            result = current;
+            current = current->left_subtree;
+        }
+        else
+        {
+            current = current->right_subtree;
+        }
+    }
+    return infix_iterator(result);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+typename binary_search_tree<tkey, tvalue, compare, tag>::infix_const_iterator
+binary_search_tree<tkey, tvalue, compare, tag>::upper_bound(const tkey& key) const
+{
+    node* current = _root;
+    node* result = nullptr;
+
+    while (current != nullptr)
+    {
+        if (compare::operator()(key, current->data.first))
+        {
+            result = current;
+            current = current->left_subtree;
+        }
+        else
+        {
+            current = current->right_subtree;
+        }
+    }
+    return infix_const_iterator(result);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+typename binary_search_tree<tkey, tvalue, compare, tag>::infix_iterator
+binary_search_tree<tkey, tvalue, compare, tag>::lower_bound(infix_const_iterator hint, const tkey& key)
+{
+    node* finger = hint_node(hint);
+    if (finger == nullptr)
+    {
+        return end();
+    }
+
+    node* result;
+    node* current = finger_subtree(finger, key, result);
+
+    while (current != nullptr)
+    {
+        if (!compare::operator()(current->data.first, key))
+        {
+            result = current;
+            current = current->left_subtree;
+        }
+        else
+        {
+            current = current->right_subtree;
+        }
+    }
+    return infix_iterator(result);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+typename binary_search_tree<tkey, tvalue, compare, tag>::infix_const_iterator
+binary_search_tree<tkey, tvalue, compare, tag>::lower_bound(infix_const_iterator hint, const tkey& key) const
+{
+    return const_cast<binary_search_tree*>(this)->lower_bound(hint, key);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+template<typename K>
+typename binary_search_tree<tkey, tvalue, compare, tag>::node*
+binary_search_tree<tkey, tvalue, compare, tag>::find_node(const K& key) const
+{
+    node* current = _root;
+    while (current != nullptr)
+    {
+        if (compare::operator()(key, current->data.first))
+        {
+            current = current->left_subtree;
+        }
+        else if (compare::operator()(current->data.first, key))
+        {
+            current = current->right_subtree;
+        }
+        else
+        {
+            return current;
+        }
+    }
+    return nullptr;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+template<typename K>
+typename binary_search_tree<tkey, tvalue, compare, tag>::node*
+binary_search_tree<tkey, tvalue, compare, tag>::lower_bound_node(const K& key) const
+{
+    node* current = _root;
+    node* result = nullptr;
+
+    while (current != nullptr)
+    {
+        if (!compare::operator()(current->data.first, key))
+        {
+            result = current;
+            current = current->left_subtree;
+        }
+        else
+        {
+            current = current->right_subtree;
+        }
+    }
+    return result;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+template<typename K>
+typename binary_search_tree<tkey, tvalue, compare, tag>::node*
+binary_search_tree<tkey, tvalue, compare, tag>::upper_bound_node(const K& key) const
+{
+    node* current = _root;
+    node* result = nullptr;
+
+    while (current != nullptr)
+    {
+        if (compare::operator()(key, current->data.first))
+        {
+            result = current;
+            current = current->left_subtree;
+        }
+        else
+        {
+            current = current->right_subtree;
+        }
+    }
+    return result;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+template<typename K> requires transparent_compare<compare>
+tvalue& binary_search_tree<tkey, tvalue, compare, tag>::at(const K& key)
+{
+    node* found = find_node(key);
+    if (found == nullptr)
+    {
+        throw std::out_of_range("Key not found");
+    }
+    return found->data.second;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+template<typename K> requires transparent_compare<compare>
+const tvalue& binary_search_tree<tkey, tvalue, compare, tag>::at(const K& key) const
+{
+    const node* found = find_node(key);
+    if (found == nullptr)
+    {
+        throw std::out_of_range("Key not found");
+    }
+    return found->data.second;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+template<typename K> requires transparent_compare<compare>
+bool binary_search_tree<tkey, tvalue, compare, tag>::contains(const K& key) const
+{
+    return find_node(key) != nullptr;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+template<typename K> requires transparent_compare<compare>
+typename binary_search_tree<tkey, tvalue, compare, tag>::infix_iterator
+binary_search_tree<tkey, tvalue, compare, tag>::find(const K& key)
+{
+    node* found = find_node(key);
+    return found == nullptr ? end() : infix_iterator(found);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+template<typename K> requires transparent_compare<compare>
+typename binary_search_tree<tkey, tvalue, compare, tag>::infix_const_iterator
+binary_search_tree<tkey, tvalue, compare, tag>::find(const K& key) const
+{
+    const node* found = find_node(key);
+    return found == nullptr ? cend() : infix_const_iterator(found);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+template<typename K> requires transparent_compare<compare>
+typename binary_search_tree<tkey, tvalue, compare, tag>::infix_iterator
+binary_search_tree<tkey, tvalue, compare, tag>::lower_bound(const K& key)
+{
+    return infix_iterator(lower_bound_node(key));
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+template<typename K> requires transparent_compare<compare>
+typename binary_search_tree<tkey, tvalue, compare, tag>::infix_const_iterator
+binary_search_tree<tkey, tvalue, compare, tag>::lower_bound(const K& key) const
+{
+    return infix_const_iterator(lower_bound_node(key));
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+template<typename K> requires transparent_compare<compare>
+typename binary_search_tree<tkey, tvalue, compare, tag>::infix_iterator
+binary_search_tree<tkey, tvalue, compare, tag>::upper_bound(const K& key)
+{
+    return infix_iterator(upper_bound_node(key));
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+template<typename K> requires transparent_compare<compare>
+typename binary_search_tree<tkey, tvalue, compare, tag>::infix_const_iterator
+binary_search_tree<tkey, tvalue, compare, tag>::upper_bound(const K& key) const
+{
+    return infix_const_iterator(upper_bound_node(key));
+}
+
+template <typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+typename binary_search_tree<tkey, tvalue, compare, tag>::infix_iterator binary_search_tree<
+        tkey, tvalue, compare, tag>::erase(infix_iterator pos)
+{
+    if (pos == end())
+    {
+        return end();
+    }
+
+    auto to_delete = pos;
+    node *target = pos._data;
+    node *next = nullptr;
+
+    auto next_temp = ++pos;
+
+    if (target->left_subtree)
+    {
+        next = target->left_subtree;
+        while (next->right_subtree)
+        {
+            next = next->right_subtree;
+        }
+    }
+    else
+    {
+        node *parent = target->parent;
+        while (parent && target == parent->right_subtree)
+        {
+            target = parent;
+            parent = parent->parent;
+        }
+        next = parent;
+    }
+
+    __detail::bst_impl<tkey, tvalue, compare, tag>::erase(*this, &to_delete._data);
+
+    auto iter = infix_iterator(next);
+
+    return infix_iterator(next);
+}
+
+template <typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+typename binary_search_tree<tkey, tvalue, compare, tag>::infix_iterator binary_search_tree<
+        tkey, tvalue, compare, tag>::erase(infix_const_iterator pos)
+{
+    if (pos == end())
+    {
+        throw std::out_of_range("Iterator out of range");
+    }
+    return __detail::bst_impl<tkey, tvalue, compare, tag>::erase(*this, &pos._base._data);
+}
+
+template <typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+typename binary_search_tree<tkey, tvalue, compare, tag>::infix_iterator binary_search_tree<
+        tkey, tvalue, compare, tag>::erase(infix_iterator first, infix_iterator last)
+{
+    auto it = first;
+    while (it != last)
+    {
+        it = erase(it);
+    }
+    return infix_iterator(it._base._data);
+}
+
+template <typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+typename binary_search_tree<tkey, tvalue, compare, tag>::infix_iterator binary_search_tree<
+        tkey, tvalue, compare, tag>::erase(infix_const_iterator first, infix_const_iterator last)
+{
+    auto it = first;
+    while (it != last)
+    {
+        it = erase(it);
+    }
+    return infix_iterator(it._base._data);
+}
+
+template <typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+size_t binary_search_tree<tkey, tvalue, compare, tag>::erase(const tkey &key)
+{
+
+    auto it = find(key);
+    if (it == end())
+    {
+        return 0;
+    }
+    erase(it);
+    return 1;
+}
+
+// endregion binary_search_tree methods_search and methods_erase implementation
+
+// region binary_search_tree order statistics implementation
+
+template <typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+constexpr bool binary_search_tree<tkey, tvalue, compare, tag>::order_statistics() noexcept
+{
+    return _order_statistics;
+}
+
+template <typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+typename binary_search_tree<tkey, tvalue, compare, tag>::infix_iterator
+binary_search_tree<tkey, tvalue, compare, tag>::select(size_t k)
+{
+    node *found = select_node(k);
+    return found == nullptr ? end() : infix_iterator(found);
+}
+
+template <typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+typename binary_search_tree<tkey, tvalue, compare, tag>::infix_const_iterator
+binary_search_tree<tkey, tvalue, compare, tag>::select(size_t k) const
+{
+    node *found = select_node(k);
+    return found == nullptr ? cend() : infix_const_iterator(found);
+}
+
+template <typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+size_t binary_search_tree<tkey, tvalue, compare, tag>::rank(const tkey &key) const
+{
+    return position(lower_bound_node(key));
+}
+
+template <typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+ptrdiff_t binary_search_tree<tkey, tvalue, compare, tag>::distance(infix_const_iterator first, infix_const_iterator last) const
+{
+    return static_cast<ptrdiff_t>(position(last._base._data)) - static_cast<ptrdiff_t>(position(first._base._data));
+}
+
+template <typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+typename binary_search_tree<tkey, tvalue, compare, tag>::infix_iterator
+binary_search_tree<tkey, tvalue, compare, tag>::advance(infix_const_iterator it, ptrdiff_t n)
+{
+    const ptrdiff_t target = static_cast<ptrdiff_t>(position(it._base._data)) + n;
+    return target < 0 ? end() : select(static_cast<size_t>(target));
+}
+
+template <typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+typename binary_search_tree<tkey, tvalue, compare, tag>::infix_const_iterator
+binary_search_tree<tkey, tvalue, compare, tag>::advance(infix_const_iterator it, ptrdiff_t n) const
+{
+    const ptrdiff_t target = static_cast<ptrdiff_t>(position(it._base._data)) + n;
+    return target < 0 ? cend() : select(static_cast<size_t>(target));
+}
+
+template <typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+size_t binary_search_tree<tkey, tvalue, compare, tag>::subtree_size(const node *n) noexcept
+{
+    return n == nullptr ? 0 : n->subtree_size;
+}
+
+template <typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+void binary_search_tree<tkey, tvalue, compare, tag>::copy_size(node *to, const node *from) noexcept
+{
+    if constexpr (_order_statistics)
+    {
+        to->subtree_size = from->subtree_size;
+    }
+}
+
+template <typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+void binary_search_tree<tkey, tvalue, compare, tag>::recalculate_size(node *n) noexcept
+{
+    if constexpr (_order_statistics)
+    {
+        if (n != nullptr)
+        {
+            n->subtree_size = 1 + subtree_size(n->left_subtree) + subtree_size(n->right_subtree);
+        }
+    }
+}
+
+template <typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+void binary_search_tree<tkey, tvalue, compare, tag>::count_insert(node *parent) noexcept
+{
+    if constexpr (_order_statistics)
+    {
+        for (; parent != nullptr; parent = parent->parent)
+        {
+            ++parent->subtree_size;
+        }
+    }
+}
+
+template <typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+void binary_search_tree<tkey, tvalue, compare, tag>::count_erase(node *target, node *replacement) noexcept
+{
+    if constexpr (_order_statistics)
+    {
+        // Физически из дерева уходит место replacement (или самого target), target лежит на этом пути
+        for (node *current = replacement != nullptr ? replacement->parent : target->parent; current != nullptr; current = current->parent)
+        {
+            --current->subtree_size;
+        }
+        if (replacement != nullptr)
+        {
+            copy_size(replacement, target);
+        }
+    }
+}
+
+template <typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+size_t binary_search_tree<tkey, tvalue, compare, tag>::position(const node *n) const
+{
+    if (n == nullptr)
+    {
+        return _size;
+    }
+
+    if constexpr (!_order_statistics)
+    {
+        size_t result = 0;
+        for (auto it = cbegin(); it._base._data != n; ++it)
+        {
+            ++result;
+        }
+        return result;
+    }
+    else
+    {
+        // Левее n всё его левое поддерево, а на каждом подъёме справа - родитель и его левое поддерево
+        size_t result = subtree_size(n->left_subtree);
+        for (; n->parent != nullptr; n = n->parent)
+        {
+            if (n == n->parent->right_subtree)
+            {
+                result += subtree_size(n->parent->left_subtree) + 1;
+            }
+        }
+        return result;
+    }
+}
+
+template <typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+typename binary_search_tree<tkey, tvalue, compare, tag>::node *
+binary_search_tree<tkey, tvalue, compare, tag>::select_node(size_t k) const
+{
+    if (k >= _size)
+    {
+        return nullptr;
+    }
+
+    if constexpr (!_order_statistics)
+    {
+        auto it = cbegin();
+        for (; k != 0; --k)
+        {
+            ++it;
+        }
+        return it._base._data;
+    }
+    else
+    {
+        node *current = _root;
+        while (true)
+        {
+            const size_t left = subtree_size(current->left_subtree);
+            if (k < left)
+            {
+                current = current->left_subtree;
+            }
+            else if (k == left)
+            {
+                return current;
+            }
+            else
+            {
+                k -= left + 1;
+                current = current->right_subtree;
+            }
+        }
+    }
+}
+
+// endregion binary_search_tree order statistics implementation
+
+// region binary_search_tree join-based set operations implementation
+
+template <typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+binary_search_tree<tkey, tvalue, compare, tag>::set_operation::set_operation(work_stealing_pool *pool, size_t smaller) noexcept
+    : pool(pool), parallel_depth(0), discarded(nullptr)
+{
+    if (pool != nullptr)
+    {
+        // На глубине d работают 2^d задач: по несколько на поток, чтобы было что красть, но не меньше grain узлов меньшего дерева
+        parallel_depth = std::min<size_t>(std::bit_width(pool->thread_count() + 1) + 2, std::bit_width(smaller / grain));
+    }
+}
+
+template <typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+void binary_search_tree<tkey, tvalue, compare, tag>::set_operation::discard(node *subtree_root) noexcept
+{
+    node *head = discarded.load(std::memory_order_relaxed);
+    do
+    {
+        subtree_root->parent = head;
+    }
+    while (!discarded.compare_exchange_weak(head, subtree_root, std::memory_order_release, std::memory_order_relaxed));
+}
+
+template <typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+template<typename F1, typename F2>
+void binary_search_tree<tkey, tvalue, compare, tag>::run_both(set_operation &operation, size_t depth, F1 &&first, F2 &&second)
+{
+    if (operation.pool != nullptr && depth < operation.parallel_depth)
+    {
+        operation.pool->invoke(std::forward<F1>(first), std::forward<F2>(second));
+    }
+    else
+    {
+        first();
+        second();
+    }
+}
+
+template <typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+template<typename subtree>
+std::tuple<subtree, typename binary_search_tree<tkey, tvalue, compare, tag>::node *, subtree>
+binary_search_tree<tkey, tvalue, compare, tag>::split_subtree(subtree tree, const tkey &key)
+{
+    using impl = __detail::bst_impl<tkey, tvalue, compare, tag>;
+
+    if (tree.root == nullptr)
+    {
+        return {tree, nullptr, tree};
+    }
 
-        std::terminate();
+    // Спуск по пути поиска key: на обратном ходу отрезанные части собираются join с корнями пути
+    auto [left, root, right] = impl::expose(*this, tree);
+    if (compare_keys(key, root->data.first))
+    {
+        auto [less, middle, greater] = split_subtree(left, key);
+        return {less, middle, impl::join(*this, greater, root, right)};
+    }
+    if (compare_keys(root->data.first, key))
+    {
+        auto [less, middle, greater] = split_subtree(right, key);
+        return {impl::join(*this, left, root, less), middle, greater};
     }
+    return {left, root, right};
 }
 
-// endregion binary_search_tree swap_method implementation
+template <typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+template<typename subtree>
+std::pair<subtree, typename binary_search_tree<tkey, tvalue, compare, tag>::node *>
+binary_search_tree<tkey, tvalue, compare, tag>::split_last(subtree tree)
+{
+    using impl = __detail::bst_impl<tkey, tvalue, compare, tag>;
 
-// region binary_search_tree methods_search and methods_erase implementation
+    auto [left, root, right] = impl::expose(*this, tree);
+    if (right.root == nullptr)
+    {
+        return {left, root};
+    }
+    auto [rest, last] = split_last(right);
+    return {impl::join(*this, left, root, rest), last};
+}
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-bool binary_search_tree<tkey, tvalue, compare, tag>::contains(const tkey& key) const
+template <typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+template<typename subtree>
+subtree binary_search_tree<tkey, tvalue, compare, tag>::join_subtrees(subtree left, subtree right)
 {
-    node* current = _root;
-    while (current != nullptr)
+    if (left.root == nullptr)
     {
-        if (compare::operator()(key, current->data.first))
-        {
-            current = current->left_subtree;
-        }
-        else if (compare::operator()(current->data.first, key))
-        {
-            current = current->right_subtree;
-        }
-        else
-        {
-            return true;
-        }
+        return right;
     }
-    return false;
+    auto [rest, last] = split_last(left);
+    return __detail::bst_impl<tkey, tvalue, compare, tag>::join(*this, rest, last, right);
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-typename binary_search_tree<tkey, tvalue, compare, tag>::infix_iterator
-binary_search_tree<tkey, tvalue, compare, tag>::find(const tkey& key)
+template <typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+template<typename subtree>
+subtree binary_search_tree<tkey, tvalue, compare, tag>::union_subtrees(subtree lhs, subtree rhs, set_operation &operation, size_t depth)
 {
-    node* current = _root;
-    while (current != nullptr)
+    using impl = __detail::bst_impl<tkey, tvalue, compare, tag>;
+
+    if (rhs.root == nullptr)
     {
-        if (compare::operator()(key, current->data.first))
-        {
-            current = current->left_subtree;
-        }
-        else if (compare::operator()(current->data.first, key))
-        {
-            current = current->right_subtree;
-        }
-        else
-        {
-            return infix_iterator(current);
-        }
+        return lhs;
     }
-    return end();
+    if (lhs.root == nullptr)
+    {
+        return rhs;
+    }
+
+    auto [lhs_less, root, lhs_greater] = impl::expose(*this, lhs);
+    auto [rhs_less, duplicate, rhs_greater] = split_subtree(rhs, root->data.first);
+    if (duplicate != nullptr)
+    {
+        // При равных ключах остаётся значение из *this
+        operation.discard(duplicate);
+    }
+
+    subtree less, greater;
+    run_both(operation, depth,
+             [&, lhs_less = lhs_less, rhs_less = rhs_less]() { less = union_subtrees(lhs_less, rhs_less, operation, depth + 1); },
+             [&, lhs_greater = lhs_greater, rhs_greater = rhs_greater]() { greater = union_subtrees(lhs_greater, rhs_greater, operation, depth + 1); });
+    return impl::join(*this, less, root, greater);
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-typename binary_search_tree<tkey, tvalue, compare, tag>::infix_const_iterator
-binary_search_tree<tkey, tvalue, compare, tag>::find(const tkey& key) const
+template <typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+template<typename subtree>
+subtree binary_search_tree<tkey, tvalue, compare, tag>::intersect_subtrees(subtree lhs, const node *rhs, set_operation &operation, size_t depth)
 {
-    const node* current = _root;
-    while (current != nullptr)
+    if (lhs.root == nullptr)
     {
-        if (compare::operator()(key, current->data.first))
-        {
-            current = current->left_subtree;
-        }
-        else if (compare::operator()(current->data.first, key))
-        {
-            current = current->right_subtree;
-        }
-        else
-        {
-            return infix_const_iterator(current);
-        }
+        return lhs;
     }
-    return cend();
+    if (rhs == nullptr)
+    {
+        operation.discard(lhs.root);
+        return subtree{};
+    }
+
+    auto [lhs_less, middle, lhs_greater] = split_subtree(lhs, rhs->data.first);
+
+    subtree less, greater;
+    run_both(operation, depth,
+             [&, lhs_less = lhs_less]() { less = intersect_subtrees(lhs_less, rhs->left_subtree, operation, depth + 1); },
+             [&, lhs_greater = lhs_greater]() { greater = intersect_subtrees(lhs_greater, rhs->right_subtree, operation, depth + 1); });
+    return middle != nullptr
+           ? __detail::bst_impl<tkey, tvalue, compare, tag>::join(*this, less, middle, greater)
+           : join_subtrees(less, greater);
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-typename binary_search_tree<tkey, tvalue, compare, tag>::infix_iterator
-binary_search_tree<tkey, tvalue, compare, tag>::lower_bound(const tkey& key)
+template <typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+template<typename subtree>
+subtree binary_search_tree<tkey, tvalue, compare, tag>::difference_subtrees(subtree lhs, const node *rhs, set_operation &operation, size_t depth)
 {
-    node* current = _root;
-    node* result = nullptr;
+    if (lhs.root == nullptr || rhs == nullptr)
+    {
+        return lhs;
+    }
 
-    while (current != nullptr)
+    auto [lhs_less, middle, lhs_greater] = split_subtree(lhs, rhs->data.first);
+    if (middle != nullptr)
     {
-        if (!compare::operator()(current->data.first, key))
-        {
-            result = current;
-            current = current->left_subtree;
-        }
-        else
-        {
-            current = current->right_subtree;
-        }
+        operation.discard(middle);
     }
-    return infix_iterator(result);
+
+    subtree less, greater;
+    run_both(operation, depth,
+             [&, lhs_less = lhs_less]() { less = difference_subtrees(lhs_less, rhs->left_subtree, operation, depth + 1); },
+             [&, lhs_greater = lhs_greater]() { greater = difference_subtrees(lhs_greater, rhs->right_subtree, operation, depth + 1); });
+    return join_subtrees(less, greater);
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-typename binary_search_tree<tkey, tvalue, compare, tag>::infix_const_iterator
-binary_search_tree<tkey, tvalue, compare, tag>::lower_bound(const tkey& key) const
+template <typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+binary_search_tree<tkey, tvalue, compare, tag> binary_search_tree<tkey, tvalue, compare, tag>::clone_foreign(const binary_search_tree &other)
 {
-    node* current = _root;
-    node* result = nullptr;
+    binary_search_tree copy(static_cast<const compare &>(*this), _allocator, _logger);
+    copy._root = copy.clone(other._root);
+    copy._size = other._size;
+    return copy;
+}
 
-    while (current != nullptr)
+template <typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+size_t binary_search_tree<tkey, tvalue, compare, tag>::release(set_operation &operation) noexcept
+{
+    // Дети освобождаемого узла встают на его место в цепочке, так что обход не требует ни стека, ни рекурсии
+    size_t released = 0;
+    node *pending = operation.discarded.exchange(nullptr, std::memory_order_acquire);
+    while (pending != nullptr)
     {
-        if (!compare::operator()(current->data.first, key))
-        {
-            result = current;
-            current = current->left_subtree;
-        }
-        else
+        node *current = pending;
+        pending = current->parent;
+        for (node *child : {current->left_subtree, current->right_subtree})
         {
-            current = current->right_subtree;
+            if (child != nullptr)
+            {
+                child->parent = pending;
+                pending = child;
+            }
         }
+        __detail::bst_impl<tkey, tvalue, compare, tag>::delete_node(*this, &current);
+        ++released;
     }
-    return infix_const_iterator(result);
+    return released;
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-typename binary_search_tree<tkey, tvalue, compare, tag>::infix_iterator
-binary_search_tree<tkey, tvalue, compare, tag>::upper_bound(const tkey& key)
+template <typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+void binary_search_tree<tkey, tvalue, compare, tag>::merge_union(binary_search_tree &other, work_stealing_pool *pool)
 {
-    node* current = _root;
-    node* result = nullptr;
+    using impl = __detail::bst_impl<tkey, tvalue, compare, tag>;
 
-    while (current != nullptr)
+    if (this == &other || other._root == nullptr)
     {
-        if (compare::operator()(key, current->data.first))
-        {
-            result = current;
-            current = current->left_subtree;
-        }
-        else
-        {
-            current = current->right_subtree;
-        }
+        return;
+    }
+    if (!(_allocator == other._allocator))
+    {
+        // Узлы чужого аллокатора не переносятся: объединяется их копия
+        binary_search_tree copy = clone_foreign(other);
+        merge_union(copy, pool);
+        return;
     }
-    return infix_iterator(result);
-}
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-typename binary_search_tree<tkey, tvalue, compare, tag>::infix_const_iterator
-binary_search_tree<tkey, tvalue, compare, tag>::upper_bound(const tkey& key) const
-{
-    node* current = _root;
-    node* result = nullptr;
+    set_operation operation(pool, std::min(_size, other._size));
+    const size_t total = _size + other._size;
+    _root = union_subtrees(impl::make_subtree(*this, _root), impl::make_subtree(*this, other._root), operation, 0).root;
+    other._root = nullptr;
+    other._size = 0;
+    _size = total - release(operation);
 
-    while (current != nullptr)
+    if (_logger)
     {
-        if (compare::operator()(key, current->data.first))
-        {
-            result = current;
-            current = current->left_subtree;
-        }
-        else
-        {
-            current = current->right_subtree;
-        }
+        _logger->log("Union of trees completed", logger::severity::debug);
     }
-    return infix_const_iterator(result);
 }
 
 template <typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-typename binary_search_tree<tkey, tvalue, compare, tag>::infix_iterator binary_search_tree<
-        tkey, tvalue, compare, tag>::erase(infix_iterator pos)
+void binary_search_tree<tkey, tvalue, compare, tag>::merge_intersection(const binary_search_tree &other, work_stealing_pool *pool)
 {
-    if (pos == end())
+    using impl = __detail::bst_impl<tkey, tvalue, compare, tag>;
+
+    if (this == &other)
     {
-        return end();
+        return;
     }
 
-    auto to_delete = pos;
-    node *target = pos._data;
-    node *next = nullptr;
+    set_operation operation(pool, std::min(_size, other._size));
+    _root = intersect_subtrees(impl::make_subtree(*this, _root), other._root, operation, 0).root;
+    _size -= release(operation);
 
-    auto next_temp = ++pos;
+    if (_logger)
+    {
+        _logger->log("Intersection of trees completed", logger::severity::debug);
+    }
+}
 
-    if (target->left_subtree)
+template <typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+void binary_search_tree<tkey, tvalue, compare, tag>::merge_difference(const binary_search_tree &other, work_stealing_pool *pool)
+{
+    using impl = __detail::bst_impl<tkey, tvalue, compare, tag>;
+
+    set_operation operation(pool, std::min(_size, other._size));
+    if (this == &other)
     {
-        next = target->left_subtree;
-        while (next->right_subtree)
+        if (_root != nullptr)
         {
-            next = next->right_subtree;
+            operation.discard(_root);
         }
+        _root = nullptr;
     }
     else
     {
-        node *parent = target->parent;
-        while (parent && target == parent->right_subtree)
-        {
-            target = parent;
-            parent = parent->parent;
-        }
-        next = parent;
+        _root = difference_subtrees(impl::make_subtree(*this, _root), other._root, operation, 0).root;
     }
+    _size -= release(operation);
 
-    __detail::bst_impl<tkey, tvalue, compare, tag>::erase(*this, &to_delete._data);
-
-    auto iter = infix_iterator(next);
-
-    return infix_iterator(next);
+    if (_logger)
+    {
+        _logger->log("Difference of trees completed", logger::severity::debug);
+    }
 }
 
 template <typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-typename binary_search_tree<tkey, tvalue, compare, tag>::infix_iterator binary_search_tree<
-        tkey, tvalue, compare, tag>::erase(infix_const_iterator pos)
+void binary_search_tree<tkey, tvalue, compare, tag>::join_trees(value_type &&middle, binary_search_tree &right)
 {
-    if (pos == end())
+    using impl = __detail::bst_impl<tkey, tvalue, compare, tag>;
+
+    if (!(_allocator == right._allocator))
     {
-        throw std::out_of_range("Iterator out of range");
+        binary_search_tree copy = clone_foreign(right);
+        join_trees(std::move(middle), copy);
+        return;
     }
-    return __detail::bst_impl<tkey, tvalue, compare, tag>::erase(*this, &pos._base._data);
+
+    node *middle_node = impl::create_node(*this, nullptr, std::move(middle));
+    _root = impl::join(*this, impl::make_subtree(*this, _root), middle_node, impl::make_subtree(*this, right._root)).root;
+    _size += right._size + 1;
+    right._root = nullptr;
+    right._size = 0;
 }
 
 template <typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-typename binary_search_tree<tkey, tvalue, compare, tag>::infix_iterator binary_search_tree<
-        tkey, tvalue, compare, tag>::erase(infix_iterator first, infix_iterator last)
+void binary_search_tree<tkey, tvalue, compare, tag>::split_trees(const tkey &key, binary_search_tree &greater)
 {
-    auto it = first;
-    while (it != last)
+    using impl = __detail::bst_impl<tkey, tvalue, compare, tag>;
+
+    static_cast<compare &>(greater) = static_cast<const compare &>(*this);
+    greater._allocator = _allocator;
+    greater._logger = _logger;
+
+    auto [less, middle, rest] = split_subtree(impl::make_subtree(*this, _root), key);
+    if (middle != nullptr)
     {
-        it = erase(it);
+        rest = impl::join(*this, decltype(rest){}, middle, rest);
     }
-    return infix_iterator(it._base._data);
-}
 
-template <typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-typename binary_search_tree<tkey, tvalue, compare, tag>::infix_iterator binary_search_tree<
-        tkey, tvalue, compare, tag>::erase(infix_const_iterator first, infix_const_iterator last)
-{
-    auto it = first;
-    while (it != last)
+    const size_t total = _size;
+    _root = less.root;
+    greater._root = rest.root;
+    if constexpr (_order_statistics)
     {
-        it = erase(it);
+        _size = subtree_size(_root);
     }
-    return infix_iterator(it._base._data);
+    else
+    {
+        // Без размеров поддеревьев меньшая часть пересчитывается обходом
+        _size = 0;
+        for (auto it = begin(); it != end(); ++it)
+        {
+            ++_size;
+        }
+    }
+    greater._size = total - _size;
 }
 
 template <typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-size_t binary_search_tree<tkey, tvalue, compare, tag>::erase(const tkey &key)
+template<std::ranges::input_range R>
+void binary_search_tree<tkey, tvalue, compare, tag>::bulk_insert(R &&rg, work_stealing_pool *pool)
 {
-
-    auto it = find(key);
-    if (it == end())
+    std::vector<std::pair<std::remove_const_t<tkey>, tvalue>> items;
+    for (auto &&item : rg)
     {
-        return 0;
+        items.emplace_back(std::forward<decltype(item)>(item));
     }
-    erase(it);
-    return 1;
+    std::stable_sort(items.begin(), items.end(), [this](auto const &lhs, auto const &rhs)
+    {
+        return compare_keys(lhs.first, rhs.first);
+    });
+    // stable_sort сохранил порядок равных ключей, unique оставляет первый из них
+    items.erase(std::unique(items.begin(), items.end(), [this](auto const &lhs, auto const &rhs)
+    {
+        return !compare_keys(lhs.first, rhs.first);
+    }), items.end());
+
+    binary_search_tree batch(static_cast<const compare &>(*this), _allocator, _logger);
+    batch.assign_sorted(std::make_move_iterator(items.begin()), items.size());
+    merge_union(batch, pool);
 }
 
-// endregion binary_search_tree methods_search and methods_erase implementation
+// endregion binary_search_tree join-based set operations implementation
 
 // region infix_iterators requests implementation
 
@@ -3701,6 +5357,10 @@ void binary_search_tree<tkey, tvalue, compare, tag>::small_left_rotation(node*&
 
     new_root->left_subtree = subtree_root;
 
+    // Новый корень занимает всё поддерево, старый теряет правую часть
+    copy_size(new_root, subtree_root);
+    recalculate_size(subtree_root);
+
     node* old_parent = subtree_root->parent;
     subtree_root->parent = new_root;
     new_root->parent = old_parent;
@@ -3739,6 +5399,9 @@ void binary_search_tree<tkey, tvalue, compare, tag>::small_right_rotation(node*&
 
     new_root->right_subtree = subtree_root;
 
+    copy_size(new_root, subtree_root);
+    recalculate_size(subtree_root);
+
     node* old_parent = subtree_root->parent;
     subtree_root->parent = new_root;
     new_root->parent = old_parent;
@@ -3832,6 +5495,13 @@ namespace __detail {
         return new_node;
     }
 
+    template<typename tkey, typename tvalue, typename compare, typename tag>
+    typename binary_search_tree<tkey, tvalue, compare, tag>::node*
+    bst_impl<tkey, tvalue, compare, tag>::clone_node(binary_search_tree<tkey, tvalue, compare, tag>& cont, const binary_search_tree<tkey, tvalue, compare, tag>::node* source, binary_search_tree<tkey, tvalue, compare, tag>::node* parent)
+    {
+        return create_node(cont, parent, source->data);
+    }
+
     template<typename tkey, typename tvalue, typename compare, typename tag>
     void bst_impl<tkey, tvalue, compare, tag>::delete_node(binary_search_tree<tkey, tvalue, compare, tag>& cont, binary_search_tree<tkey, tvalue, compare, tag>::node** node)
     {
@@ -3855,9 +5525,12 @@ namespace __detail {
         const bool has_left = node->left_subtree != nullptr;
         const bool has_right = node->right_subtree != nullptr;
 
+        --cont._size;
+
         if (!has_left && !has_right)
         {
             // Лист
+            cont.count_erase(node, nullptr);
             if (node->parent)
             {
                 if (node->parent->left_subtree == node)
@@ -3879,6 +5552,7 @@ namespace __detail {
         {
             // Один ребенок
             node_type* child = has_left ? node->left_subtree : node->right_subtree;
+            cont.count_erase(node, nullptr);
             child->parent = node->parent; // Обновляем родителя у потомка
 
             if (node->parent)
@@ -3909,15 +5583,17 @@ namespace __detail {
             }
 
             node_type* successor = *successor_ptr;
+            cont.count_erase(node, successor);
 
-            // Удаляем successor из его текущего положения
+            // Удаляем successor из его текущего положения; правого ребёнка у наибольшего в левом поддереве нет,
+            // на его место поднимается левый
             if (successor->parent->left_subtree == successor)
-                successor->parent->left_subtree = successor->right_subtree;
+                successor->parent->left_subtree = successor->left_subtree;
             else
-                successor->parent->right_subtree = successor->right_subtree;
+                successor->parent->right_subtree = successor->left_subtree;
 
-            if (successor->right_subtree)
-                successor->right_subtree->parent = successor->parent;
+            if (successor->left_subtree)
+                successor->left_subtree->parent = successor->parent;
 
             // Подставляем successor вместо удаляемого узла
             successor->left_subtree = node->left_subtree;
@@ -3948,4 +5624,4 @@ namespace __detail {
     }
 }
 
-#endif //MATH_PRACTICE_AND_OPERATING_SYSTEMS_BINARY_SEARCH_TREE_H
\ No newline at end of file
+#endif //MATH_PRACTICE_AND_OPERATING_SYSTEMS_BINARY_SEARCH_TREE_H
\ No newline at end of file
@@ -5,43 +5,86 @@
 
 namespace __detail
 {
+    template<bool order_statistics>
     class RB_TAG;
 
-    template<typename tkey, typename tvalue, typename compare>
-    class bst_impl<tkey, tvalue, compare, RB_TAG>
+    template<typename tkey, typename tvalue, typename compare, bool order_statistics>
+    class bst_impl<tkey, tvalue, compare, RB_TAG<order_statistics>>
 
     {
-        friend class binary_search_tree<tkey, tvalue, compare, RB_TAG>;
+        friend class binary_search_tree<tkey, tvalue, compare, RB_TAG<order_statistics>>;
         template<class ...Args>
-        static binary_search_tree<tkey, tvalue, compare, RB_TAG>::node* create_node(binary_search_tree<tkey, tvalue, compare, RB_TAG>& cont, Args&& ...args);
+        static binary_search_tree<tkey, tvalue, compare, RB_TAG<order_statistics>>::node* create_node(binary_search_tree<tkey, tvalue, compare, RB_TAG<order_statistics>>& cont, Args&& ...args);
 
-        static void delete_node(binary_search_tree<tkey, tvalue, compare, RB_TAG>& cont, binary_search_tree<tkey, tvalue, compare, RB_TAG>::node**);
+        static void delete_node(binary_search_tree<tkey, tvalue, compare, RB_TAG<order_statistics>>& cont, binary_search_tree<tkey, tvalue, compare, RB_TAG<order_statistics>>::node**);
+
+        // New unlinked node with the value and metadata of source, child of parent
+        static binary_search_tree<tkey, tvalue, compare, RB_TAG<order_statistics>>::node* clone_node(binary_search_tree<tkey, tvalue, compare, RB_TAG<order_statistics>>& cont, const binary_search_tree<tkey, tvalue, compare, RB_TAG<order_statistics>>::node* source, binary_search_tree<tkey, tvalue, compare, RB_TAG<order_statistics>>::node* parent);
 
         //Does not invalidate node*, needed for splay tree
-        static void post_search(binary_search_tree<tkey, tvalue, compare, RB_TAG>::node**){}
+        static void post_search(binary_search_tree<tkey, tvalue, compare, RB_TAG<order_statistics>>::node**){}
 
         //Does not invalidate node*
-        static void post_insert(binary_search_tree<tkey, tvalue, compare, RB_TAG>& cont, binary_search_tree<tkey, tvalue, compare, RB_TAG>::node**);
+        static void post_insert(binary_search_tree<tkey, tvalue, compare, RB_TAG<order_statistics>>& cont, binary_search_tree<tkey, tvalue, compare, RB_TAG<order_statistics>>::node**);
+
+        // Metadata of a node of a tree built from sorted data, called once both subtrees are linked
+        static void post_build(binary_search_tree<tkey, tvalue, compare, RB_TAG<order_statistics>>::node*, size_t depth, size_t height);
 
-        static void erase(binary_search_tree<tkey, tvalue, compare, RB_TAG>& cont, binary_search_tree<tkey, tvalue, compare, RB_TAG>::node**);
+        static void erase(binary_search_tree<tkey, tvalue, compare, RB_TAG<order_statistics>>& cont, binary_search_tree<tkey, tvalue, compare, RB_TAG<order_statistics>>::node**);
 
         static void fix_double_black(
-                binary_search_tree<tkey, tvalue, compare, RB_TAG>& cont,
-                binary_search_tree<tkey, tvalue, compare, RB_TAG>::node* node);
+                binary_search_tree<tkey, tvalue, compare, RB_TAG<order_statistics>>& cont,
+                binary_search_tree<tkey, tvalue, compare, RB_TAG<order_statistics>>::node* node);
 
         static void replace_node(
-                binary_search_tree<tkey, tvalue, compare, RB_TAG>& cont,
-                binary_search_tree<tkey, tvalue, compare, RB_TAG>::node* old_node,
-                binary_search_tree<tkey, tvalue, compare, RB_TAG>::node* new_node);
+                binary_search_tree<tkey, tvalue, compare, RB_TAG<order_statistics>>& cont,
+                binary_search_tree<tkey, tvalue, compare, RB_TAG<order_statistics>>::node* old_node,
+                binary_search_tree<tkey, tvalue, compare, RB_TAG<order_statistics>>::node* new_node);
+
+        static void swap(binary_search_tree<tkey, tvalue, compare, RB_TAG<order_statistics>>& lhs, binary_search_tree<tkey, tvalue, compare, RB_TAG<order_statistics>>& rhs) noexcept;
+
+        using tree = binary_search_tree<tkey, tvalue, compare, RB_TAG<order_statistics>>;
+        using base_node = typename tree::node;
+
+        // Detached subtree for join and split: the root has no parent and is black, nullptr for an empty one.
+        // black_height counts the black nodes on any path from the root down to an empty leaf
+        struct subtree
+        {
+            base_node* root = nullptr;
+            size_t black_height = 0;
+        };
+
+        static subtree make_subtree(tree& cont, base_node* root) noexcept;
+
+        // Both subtrees of the root and the root itself left without children
+        static std::tuple<subtree, base_node*, subtree> expose(tree& cont, subtree source) noexcept;
 
-        static void swap(binary_search_tree<tkey, tvalue, compare, RB_TAG>& lhs, binary_search_tree<tkey, tvalue, compare, RB_TAG>& rhs) noexcept;
+        // Keys of left < key of middle < keys of right. O(|black_height(left) - black_height(right)| + 1)
+        static subtree join(tree& cont, subtree left, base_node* middle, subtree right) noexcept;
+
+        // Middle goes red down the spine of the higher tree to a black subtree of the black height of the other one
+        static subtree join_right(tree& cont, subtree left, base_node* middle, subtree right) noexcept;
+        static subtree join_left(tree& cont, subtree left, base_node* middle, subtree right) noexcept;
+
+        // Recounts sizes from node up to the root, blackens a red root and returns the joined tree
+        static subtree finish_join(tree& cont, base_node* node, size_t black_height) noexcept;
+
+        static bool is_red(const base_node* node) noexcept;
+
+        static void set_red(base_node* node, bool red) noexcept;
+
+        static void link(base_node* node, base_node* left, base_node* right) noexcept;
+
+        // These rotations return the new root of the subtree and leave relinking it to the caller, never touching cont._root
+        static base_node* rotate_left(tree& cont, base_node* node) noexcept;
+        static base_node* rotate_right(tree& cont, base_node* node) noexcept;
 
 
     };
 }
 
-template<typename tkey,typename tvalue, compator<tkey> compare = std::less<tkey>>
-class red_black_tree final: public binary_search_tree<tkey, tvalue, compare, __detail::RB_TAG>
+template<typename tkey, typename tvalue, compator<tkey> compare = std::less<tkey>, bool order_statistics = false>
+class red_black_tree final: public binary_search_tree<tkey, tvalue, compare, __detail::RB_TAG<order_statistics>>
 {
 
 public:
@@ -54,22 +97,24 @@ public:
 
 private:
 
-    using parent = binary_search_tree<tkey, tvalue, compare, __detail::RB_TAG>;
-    friend class __detail::bst_impl<tkey, tvalue, compare, __detail::RB_TAG>;
+    using parent = binary_search_tree<tkey, tvalue, compare, __detail::RB_TAG<order_statistics>>;
+    friend class __detail::bst_impl<tkey, tvalue, compare, __detail::RB_TAG<order_statistics>>;
     struct node final:
         parent::node
     {
-        node_color color;
+        // The colour is the low bit of the parent pointer: a red-black node is no larger than a plain one
+        node_color get_color() const noexcept;
+
+        void set_color(node_color color) noexcept;
 
         template<class ...Args>
         node(parent::node* par, Args&&... args);
         explicit node(parent::node* par)
-                : parent::node(par), color(node_color::BLACK)
+                : parent::node(par)
         {
             this->left_subtree = this->right_subtree = nullptr;
+            set_color(node_color::BLACK);
         }
-
-        ~node() noexcept override =default;
     };
 
 public:
@@ -100,7 +145,7 @@ private:
             std::cout << "    ";
         }
         std::cout << current->data.first << "("
-                  << (current->color == node_color::RED ? "R" : "B") << ")";
+                  << (current->get_color() == node_color::RED ? "R" : "B") << ")";
 
         if (current->parent != nullptr)
         {
@@ -139,14 +184,24 @@ public:
             pp_allocator<value_type> alloc = pp_allocator<value_type>(),
             logger* logger = nullptr);
 
+    template<input_iterator_for_pair<tkey, tvalue> iterator>
+    red_black_tree(sorted_unique_t, iterator begin, iterator end, const compare& cmp = compare(),
+            pp_allocator<value_type> alloc = pp_allocator<value_type>(),
+            logger* logger = nullptr);
+
+    template<std::ranges::input_range Range>
+    red_black_tree(sorted_unique_t, Range&& range, const compare& cmp = compare(),
+            pp_allocator<value_type> alloc = pp_allocator<value_type>(),
+            logger* logger = nullptr);
+
 
     // region iterator definition
 
 
     class prefix_iterator : public parent::prefix_iterator
     {
-        friend binary_search_tree<tkey, tvalue, compare, __detail::RB_TAG>;
-        friend class __detail::bst_impl<tkey, tvalue, compare, __detail::RB_TAG>;
+        friend binary_search_tree<tkey, tvalue, compare, __detail::RB_TAG<order_statistics>>;
+        friend class __detail::bst_impl<tkey, tvalue, compare, __detail::RB_TAG<order_statistics>>;
     public:
 
         using value_type = parent::prefix_iterator::value_type;
@@ -253,8 +308,8 @@ public:
 
     class infix_iterator : public parent::infix_iterator
     {
-        friend binary_search_tree<tkey, tvalue, compare, __detail::RB_TAG>;
-        friend class __detail::bst_impl<tkey, tvalue, compare, __detail::RB_TAG>;
+        friend binary_search_tree<tkey, tvalue, compare, __detail::RB_TAG<order_statistics>>;
+        friend class __detail::bst_impl<tkey, tvalue, compare, __detail::RB_TAG<order_statistics>>;
     public:
 
         using value_type = parent::infix_iterator::value_type;
@@ -361,8 +416,8 @@ public:
 
     class postfix_iterator : public parent::postfix_iterator
     {
-        friend binary_search_tree<tkey, tvalue, compare, __detail::RB_TAG>;
-        friend class __detail::bst_impl<tkey, tvalue, compare, __detail::RB_TAG>;
+        friend binary_search_tree<tkey, tvalue, compare, __detail::RB_TAG<order_statistics>>;
+        friend class __detail::bst_impl<tkey, tvalue, compare, __detail::RB_TAG<order_statistics>>;
     public:
 
         using value_type = parent::postfix_iterator::value_type;
@@ -605,6 +660,17 @@ public:
     template<class ...Args>
     infix_iterator emplace_or_assign(Args&&...args);
 
+    template<class ...Args>
+    std::pair<infix_iterator, bool> try_emplace(const tkey& key, Args&&...args);
+    template<class ...Args>
+    std::pair<infix_iterator, bool> try_emplace(tkey&& key, Args&&...args);
+
+    infix_iterator insert(typename parent::infix_const_iterator hint, const value_type&);
+    infix_iterator insert(typename parent::infix_const_iterator hint, value_type&&);
+
+    template<class ...Args>
+    infix_iterator emplace_hint(typename parent::infix_const_iterator hint, Args&&...args);
+
     infix_iterator find(const tkey&);
     infix_const_iterator find(const tkey&) const;
 
@@ -614,15 +680,69 @@ public:
     infix_iterator upper_bound(const tkey&);
     infix_const_iterator upper_bound(const tkey&) const;
 
+    infix_iterator lower_bound(typename parent::infix_const_iterator hint, const tkey&);
+    infix_const_iterator lower_bound(typename parent::infix_const_iterator hint, const tkey&) const;
+
+    infix_iterator select(size_t k);
+    infix_const_iterator select(size_t k) const;
+
+    infix_iterator advance(typename parent::infix_const_iterator it, ptrdiff_t n);
+    infix_const_iterator advance(typename parent::infix_const_iterator it, ptrdiff_t n) const;
+
+    template<typename K> requires transparent_compare<compare>
+    infix_iterator find(const K&);
+    template<typename K> requires transparent_compare<compare>
+    infix_const_iterator find(const K&) const;
+
+    template<typename K> requires transparent_compare<compare>
+    infix_iterator lower_bound(const K&);
+    template<typename K> requires transparent_compare<compare>
+    infix_const_iterator lower_bound(const K&) const;
+
+    template<typename K> requires transparent_compare<compare>
+    infix_iterator upper_bound(const K&);
+    template<typename K> requires transparent_compare<compare>
+    infix_const_iterator upper_bound(const K&) const;
+
     infix_iterator erase(infix_iterator pos);
     infix_iterator erase(infix_const_iterator pos);
 
     infix_iterator erase(infix_iterator first, infix_iterator last);
     infix_iterator erase(infix_const_iterator first, infix_const_iterator last);
 
+    /** Tree of left, middle and right made of their nodes in O(|height(left) - height(right)| + 1).
+     *  Every key of left must be less than middle.first and every key of right greater; this is trusted, not checked.
+     *  The nodes of right are copied if its allocator differs from the one of left
+     */
+    static red_black_tree join(red_black_tree&& left, value_type middle, red_black_tree&& right);
+
+    /** Splits tree into the keys less than key and the rest in O(log n) relinking. Without order statistics
+     *  the size of the first part is counted by walking it
+     */
+    static std::pair<red_black_tree, red_black_tree> split(red_black_tree&& tree, const tkey& key);
+
+    /** Set operations by split and join: O(m log(n / m + 1)) for trees of m <= n elements, against O(m log n)
+     *  of inserting or erasing one by one. With a pool the halves of the upper levels of the recursion run in parallel.
+     *  On equal keys *this keeps its value. The nodes of an rvalue other are reused when it shares the allocator
+     */
+    void union_with(red_black_tree&& other, work_stealing_pool* pool = nullptr);
+    void union_with(const red_black_tree& other, work_stealing_pool* pool = nullptr);
+
+    void intersect_with(const red_black_tree& other, work_stealing_pool* pool = nullptr);
+
+    void difference(const red_black_tree& other, work_stealing_pool* pool = nullptr);
+
+    /** Sorts the range, builds a balanced tree of it and unions it in; of repeated keys the first one is inserted
+     */
+    template<std::ranges::input_range R>
+    void insert_range(R&& rg);
+    template<std::ranges::input_range R>
+    void insert_range(R&& rg, work_stealing_pool* pool);
+
     using parent::erase;
     using parent::insert;
     using parent::insert_or_assign;
+    using parent::insert_range;
 };
 
 
@@ -649,57 +769,90 @@ red_black_tree(std::initializer_list<std::pair<tkey, tvalue>> data, const compar
         pp_allocator<U> alloc = pp_allocator<U>(),
         logger* logger = nullptr) -> red_black_tree<tkey, tvalue, compare>;
 
+template<typename compare, typename U, typename iterator>
+red_black_tree(sorted_unique_t, iterator begin, iterator end, const compare& cmp = compare(),
+        pp_allocator<U> alloc = pp_allocator<U>(),
+        logger* logger = nullptr) -> red_black_tree<const typename std::iterator_traits<iterator>::value_type::first_type, typename std::iterator_traits<iterator>::value_type::second_type, compare>;
+
+template<typename compare, typename U, std::ranges::forward_range Range>
+red_black_tree(sorted_unique_t, Range&& range, const compare& cmp = compare(),
+        pp_allocator<U> alloc = pp_allocator<U>(),
+        logger* logger = nullptr) -> red_black_tree<const typename std::iterator_traits<typename std::ranges::iterator_t<Range>>::value_type::first_type, typename std::iterator_traits<typename std::ranges::iterator_t<Range>>::value_type::second_type, compare>;
+
 namespace __detail {
 
+    template<bool order_statistics>
     class RB_TAG {};
 
-    template<typename tkey, typename tvalue, typename compare>
+    template<typename tkey, typename tvalue, typename compare, bool order_statistics>
     template<class ...Args>
-    binary_search_tree<tkey, tvalue, compare, RB_TAG>::node* bst_impl<tkey, tvalue, compare, RB_TAG>::create_node(
-            binary_search_tree<tkey, tvalue, compare, RB_TAG>& cont, Args&& ...args)
+    binary_search_tree<tkey, tvalue, compare, RB_TAG<order_statistics>>::node* bst_impl<tkey, tvalue, compare, RB_TAG<order_statistics>>::create_node(
+            binary_search_tree<tkey, tvalue, compare, RB_TAG<order_statistics>>& cont, Args&& ...args)
     {
-        using node_type = typename red_black_tree<tkey, tvalue, compare>::node;
+        using node_type = typename red_black_tree<tkey, tvalue, compare, order_statistics>::node;
         auto *new_node = cont._allocator.template new_object<node_type>(std::forward<Args>(args)...);
         return new_node;
     }
 
-    template<typename tkey, typename tvalue, typename compare>
-    void bst_impl<tkey, tvalue, compare, RB_TAG>::delete_node(
-            binary_search_tree<tkey, tvalue, compare, RB_TAG>& cont,
-            typename binary_search_tree<tkey, tvalue, compare, RB_TAG>::node** node)
+    template<typename tkey, typename tvalue, typename compare, bool order_statistics>
+    typename binary_search_tree<tkey, tvalue, compare, RB_TAG<order_statistics>>::node* bst_impl<tkey, tvalue, compare, RB_TAG<order_statistics>>::clone_node(
+            binary_search_tree<tkey, tvalue, compare, RB_TAG<order_statistics>>& cont, const binary_search_tree<tkey, tvalue, compare, RB_TAG<order_statistics>>::node* source, binary_search_tree<tkey, tvalue, compare, RB_TAG<order_statistics>>::node* parent)
+    {
+        using node_type = typename red_black_tree<tkey, tvalue, compare, order_statistics>::node;
+        auto *copy = static_cast<node_type*>(create_node(cont, parent, source->data));
+        copy->set_color(static_cast<const node_type*>(source)->get_color());
+        return copy;
+    }
+
+    template<typename tkey, typename tvalue, typename compare, bool order_statistics>
+    void bst_impl<tkey, tvalue, compare, RB_TAG<order_statistics>>::post_build(
+            binary_search_tree<tkey, tvalue, compare, RB_TAG<order_statistics>>::node* node, size_t depth, size_t height)
     {
-        using node_type = typename binary_search_tree<tkey, tvalue, compare, RB_TAG>::node;
+        // Все уровни выше последнего полные: чёрные они дают одинаковую чёрную высоту,
+        // а красный неполный последний уровень её не меняет
+        using node_type = typename red_black_tree<tkey, tvalue, compare, order_statistics>::node;
+        static_cast<node_type*>(node)->set_color(depth == height && depth != 0
+                                                 ? red_black_tree<tkey, tvalue, compare, order_statistics>::node_color::RED
+                                                 : red_black_tree<tkey, tvalue, compare, order_statistics>::node_color::BLACK);
+    }
+
+    template<typename tkey, typename tvalue, typename compare, bool order_statistics>
+    void bst_impl<tkey, tvalue, compare, RB_TAG<order_statistics>>::delete_node(
+            binary_search_tree<tkey, tvalue, compare, RB_TAG<order_statistics>>& cont,
+            typename binary_search_tree<tkey, tvalue, compare, RB_TAG<order_statistics>>::node** node)
+    {
+        using node_type = typename red_black_tree<tkey, tvalue, compare, order_statistics>::node;
         if (node && *node)
         {
-            cont._allocator.template delete_object<node_type>(*node);
+            cont._allocator.template delete_object<node_type>(static_cast<node_type*>(*node));
             *node = nullptr;
         }
     }
 
-    template<typename tkey, typename tvalue, typename compare>
-    void bst_impl<tkey, tvalue, compare, RB_TAG>::post_insert(
-            binary_search_tree<tkey, tvalue, compare, RB_TAG>& cont,
-            typename binary_search_tree<tkey, tvalue, compare, RB_TAG>::node** node_ptr) {
+    template<typename tkey, typename tvalue, typename compare, bool order_statistics>
+    void bst_impl<tkey, tvalue, compare, RB_TAG<order_statistics>>::post_insert(
+            binary_search_tree<tkey, tvalue, compare, RB_TAG<order_statistics>>& cont,
+            typename binary_search_tree<tkey, tvalue, compare, RB_TAG<order_statistics>>::node** node_ptr) {
 
-        using rb_node = typename red_black_tree<tkey, tvalue, compare>::node;
-        using node_type = typename binary_search_tree<tkey, tvalue, compare, RB_TAG>::node;
-        using color_type = typename red_black_tree<tkey, tvalue, compare>::node_color;
+        using rb_node = typename red_black_tree<tkey, tvalue, compare, order_statistics>::node;
+        using node_type = typename binary_search_tree<tkey, tvalue, compare, RB_TAG<order_statistics>>::node;
+        using color_type = typename red_black_tree<tkey, tvalue, compare, order_statistics>::node_color;
 
         if (node_ptr == nullptr || *node_ptr == nullptr) return;
 
         auto* t = static_cast<rb_node*>(*node_ptr);
 
-        while (t != nullptr && t->parent != nullptr && static_cast<rb_node*>(t->parent)->color == color_type::RED) {
+        while (t != nullptr && t->parent != nullptr && static_cast<rb_node*>(t->parent)->get_color() == color_type::RED) {
             auto* parent = static_cast<rb_node*>(t->parent);
             auto* grandparent = static_cast<rb_node*>(parent->parent);
 
             if (parent == grandparent->left_subtree) {
                 auto* uncle = static_cast<rb_node*>(grandparent->right_subtree);
 
-                if (uncle && uncle->color == color_type::RED) {
-                    parent->color = color_type::BLACK;
-                    uncle->color = color_type::BLACK;
-                    grandparent->color = color_type::RED;
+                if (uncle && uncle->get_color() == color_type::RED) {
+                    parent->set_color(color_type::BLACK);
+                    uncle->set_color(color_type::BLACK);
+                    grandparent->set_color(color_type::RED);
                     t = grandparent;
                 } else {
                     if (t == parent->right_subtree) {
@@ -709,18 +862,18 @@ namespace __detail {
                         parent = static_cast<rb_node*>(t->parent);
                         grandparent = g; // Восстанавливаем
                     }
-                    parent->color = color_type::BLACK;
-                    grandparent->color = color_type::RED;
+                    parent->set_color(color_type::BLACK);
+                    grandparent->set_color(color_type::RED);
                     cont.small_right_rotation(reinterpret_cast<node_type*&>(grandparent));
                 }
 
             } else {
                 auto* uncle = static_cast<rb_node*>(grandparent->left_subtree);
 
-                if (uncle && uncle->color == color_type::RED) {
-                    parent->color = color_type::BLACK;
-                    uncle->color = color_type::BLACK;
-                    grandparent->color = color_type::RED;
+                if (uncle && uncle->get_color() == color_type::RED) {
+                    parent->set_color(color_type::BLACK);
+                    uncle->set_color(color_type::BLACK);
+                    grandparent->set_color(color_type::RED);
                     t = grandparent;
                 } else {
                     if (t == parent->left_subtree) {
@@ -730,42 +883,46 @@ namespace __detail {
                         parent = static_cast<rb_node*>(t->parent);
                         grandparent = g;
                     }
-                    parent->color = color_type::BLACK;
-                    grandparent->color = color_type::RED;
+                    parent->set_color(color_type::BLACK);
+                    grandparent->set_color(color_type::RED);
                     cont.small_left_rotation(reinterpret_cast<node_type*&>(grandparent));
                 }
             }
         }
 
-        static_cast<rb_node*>(cont._root)->color = color_type::BLACK;
+        static_cast<rb_node*>(cont._root)->set_color(color_type::BLACK);
     }
 
-    template<typename tkey, typename tvalue, typename compare>
-    void bst_impl<tkey, tvalue, compare, RB_TAG>::erase(
-            binary_search_tree<tkey, tvalue, compare, RB_TAG>& tree,
-            typename binary_search_tree<tkey, tvalue, compare, RB_TAG>::node** node_to_delete_ptr)
+    template<typename tkey, typename tvalue, typename compare, bool order_statistics>
+    void bst_impl<tkey, tvalue, compare, RB_TAG<order_statistics>>::erase(
+            binary_search_tree<tkey, tvalue, compare, RB_TAG<order_statistics>>& tree,
+            typename binary_search_tree<tkey, tvalue, compare, RB_TAG<order_statistics>>::node** node_to_delete_ptr)
     {
-        using rb_node = typename red_black_tree<tkey, tvalue, compare>::node;
-        using node_type = typename binary_search_tree<tkey, tvalue, compare, RB_TAG>::node;
-        using color_type = typename red_black_tree<tkey, tvalue, compare>::node_color;
+        using rb_node = typename red_black_tree<tkey, tvalue, compare, order_statistics>::node;
+        using node_type = typename binary_search_tree<tkey, tvalue, compare, RB_TAG<order_statistics>>::node;
+        using color_type = typename red_black_tree<tkey, tvalue, compare, order_statistics>::node_color;
 
         if (!(*node_to_delete_ptr)) return;
         auto* node_to_delete = static_cast<rb_node*>(*node_to_delete_ptr);
 
         rb_node* replacement_node = node_to_delete; // Узел, который фактически удаляется
-        color_type replacement_original_color = replacement_node->color;
+        color_type replacement_original_color = replacement_node->get_color();
 
         rb_node* child_node = nullptr; // Ребенок replacement_node, который займет его место
         rb_node* child_parent = nullptr; // Родитель child_node
 
+        --tree._size;
+
         if (node_to_delete->left_subtree == nullptr) {
             child_node = static_cast<rb_node*>(node_to_delete->right_subtree);
             child_parent = static_cast<rb_node*>(node_to_delete->parent);
+            tree.count_erase(node_to_delete, nullptr);
             replace_node(tree, node_to_delete, child_node);
         }
         else if (node_to_delete->right_subtree == nullptr) {
             child_node = static_cast<rb_node*>(node_to_delete->left_subtree);
             child_parent = static_cast<rb_node*>(node_to_delete->parent);
+            tree.count_erase(node_to_delete, nullptr);
             replace_node(tree, node_to_delete, child_node);
         }
         else {
@@ -773,8 +930,9 @@ namespace __detail {
             while (replacement_node->right_subtree != nullptr) {
                 replacement_node = static_cast<rb_node*>(replacement_node->right_subtree);
             }
-            replacement_original_color = replacement_node->color;
+            replacement_original_color = replacement_node->get_color();
             child_node = static_cast<rb_node*>(replacement_node->left_subtree);
+            tree.count_erase(node_to_delete, replacement_node);
 
             if (replacement_node->parent == node_to_delete) {
                 child_parent = replacement_node;
@@ -792,7 +950,7 @@ namespace __detail {
             if (replacement_node->right_subtree) {
                 static_cast<rb_node*>(replacement_node->right_subtree)->parent = replacement_node;
             }
-            replacement_node->color = node_to_delete->color;
+            replacement_node->set_color(node_to_delete->get_color());
         }
         delete_node(tree, node_to_delete_ptr);
 
@@ -803,7 +961,11 @@ namespace __detail {
             }
             else if (child_parent != nullptr) {
                 auto* temp_nil = new rb_node(static_cast<node_type*>(child_parent));
-                temp_nil->color = color_type::BLACK;
+                temp_nil->set_color(color_type::BLACK);
+                // Временный узел не элемент дерева и не должен попасть в размеры поддеревьев при поворотах
+                if constexpr (order_statistics) {
+                    temp_nil->subtree_size = 0;
+                }
 
                 // Прикрепляем временный узел в нужное место
                 if (child_parent == replacement_node) {
@@ -838,15 +1000,15 @@ namespace __detail {
 
         // Корень всегда должен быть черным
         if (tree._root != nullptr) {
-            static_cast<rb_node*>(tree._root)->color = color_type::BLACK;
+            static_cast<rb_node*>(tree._root)->set_color(color_type::BLACK);
         }
     }
 
-    template<typename tkey, typename tvalue, typename compare>
-    void bst_impl<tkey, tvalue, compare, RB_TAG>::replace_node(
-            binary_search_tree<tkey, tvalue, compare, RB_TAG>& cont,
-            typename binary_search_tree<tkey, tvalue, compare, RB_TAG>::node* old_node, // u
-            typename binary_search_tree<tkey, tvalue, compare, RB_TAG>::node* new_node) // v
+    template<typename tkey, typename tvalue, typename compare, bool order_statistics>
+    void bst_impl<tkey, tvalue, compare, RB_TAG<order_statistics>>::replace_node(
+            binary_search_tree<tkey, tvalue, compare, RB_TAG<order_statistics>>& cont,
+            typename binary_search_tree<tkey, tvalue, compare, RB_TAG<order_statistics>>::node* old_node, // u
+            typename binary_search_tree<tkey, tvalue, compare, RB_TAG<order_statistics>>::node* new_node) // v
     {
         if (old_node->parent == nullptr) {
             cont._root = new_node;
@@ -863,18 +1025,18 @@ namespace __detail {
     }
 
 
-    template<typename tkey, typename tvalue, typename compare>
-    void bst_impl<tkey, tvalue, compare, RB_TAG>::fix_double_black(
-            binary_search_tree<tkey, tvalue, compare, RB_TAG>& cont,
-            typename binary_search_tree<tkey, tvalue, compare, RB_TAG>::node* x_node)
+    template<typename tkey, typename tvalue, typename compare, bool order_statistics>
+    void bst_impl<tkey, tvalue, compare, RB_TAG<order_statistics>>::fix_double_black(
+            binary_search_tree<tkey, tvalue, compare, RB_TAG<order_statistics>>& cont,
+            typename binary_search_tree<tkey, tvalue, compare, RB_TAG<order_statistics>>::node* x_node)
     {
-        using node_type = typename binary_search_tree<tkey, tvalue, compare, RB_TAG>::node;
-        using rb_node = typename red_black_tree<tkey, tvalue, compare>::node;
-        using color_type = typename red_black_tree<tkey, tvalue, compare>::node_color;
+        using node_type = typename binary_search_tree<tkey, tvalue, compare, RB_TAG<order_statistics>>::node;
+        using rb_node = typename red_black_tree<tkey, tvalue, compare, order_statistics>::node;
+        using color_type = typename red_black_tree<tkey, tvalue, compare, order_statistics>::node_color;
 
         auto* current_x = static_cast<rb_node*>(x_node);
 
-        while (current_x != cont._root && current_x->color == color_type::BLACK) {
+        while (current_x != cont._root && current_x->get_color() == color_type::BLACK) {
             auto* parent = static_cast<rb_node*>(current_x->parent);
 
             bool is_left_child = (current_x == parent->left_subtree);
@@ -890,9 +1052,9 @@ namespace __detail {
             node_type** ptr_to_rotate_target_in_structure;
 
             // Случай 1: Брат красный
-            if (sibling->color == color_type::RED) {
-                parent->color = color_type::RED;
-                sibling->color = color_type::BLACK;
+            if (sibling->get_color() == color_type::RED) {
+                parent->set_color(color_type::RED);
+                sibling->set_color(color_type::BLACK);
 
                 if (parent->parent == nullptr) {
                     ptr_to_rotate_target_in_structure = &cont._root;
@@ -923,12 +1085,12 @@ namespace __detail {
             auto* sibling_left = static_cast<rb_node*>(sibling->left_subtree);
             auto* sibling_right = static_cast<rb_node*>(sibling->right_subtree);
 
-            bool sibling_left_is_black = (sibling_left == nullptr || sibling_left->color == color_type::BLACK);
-            bool sibling_right_is_black = (sibling_right == nullptr || sibling_right->color == color_type::BLACK);
+            bool sibling_left_is_black = (sibling_left == nullptr || sibling_left->get_color() == color_type::BLACK);
+            bool sibling_right_is_black = (sibling_right == nullptr || sibling_right->get_color() == color_type::BLACK);
 
             // Случай 2: Брат черный, и оба его ребенка черные.
             if (sibling_left_is_black && sibling_right_is_black) {
-                sibling->color = color_type::RED;
+                sibling->set_color(color_type::RED);
                 current_x = parent;
                 continue;
             }
@@ -936,17 +1098,17 @@ namespace __detail {
             if (is_left_child) { // current_x - левый ребенок, sibling - правый.
                 // Случай 3: Правый ребенок sibling черный (значит, левый ребенок sibling красный).
                 if (sibling_right_is_black) {
-                    if (sibling_left) sibling_left->color = color_type::BLACK;
-                    sibling->color = color_type::RED;
+                    if (sibling_left) sibling_left->set_color(color_type::BLACK);
+                    sibling->set_color(color_type::RED);
                     cont.small_right_rotation(parent->right_subtree);
                     sibling = static_cast<rb_node*>(parent->right_subtree);
                     sibling_right = (sibling) ? static_cast<rb_node*>(sibling->right_subtree) : nullptr;
                 }
                 // Случай 4: Правый ребенок sibling красный.
-                sibling->color = parent->color;
-                parent->color = color_type::BLACK;
+                sibling->set_color(parent->get_color());
+                parent->set_color(color_type::BLACK);
                 if (sibling_right) { // Этот ребенок был красным (или стал после случая 3).
-                    sibling_right->color = color_type::BLACK;
+                    sibling_right->set_color(color_type::BLACK);
                 }
                 // Левый поворот вокруг parent.
                 if (parent->parent == nullptr) { ptr_to_rotate_target_in_structure = &cont._root; }
@@ -959,17 +1121,17 @@ namespace __detail {
             } else { // current_x - правый ребенок, sibling - левый (симметрично).
                 // Случай 3: Левый ребенок sibling черный (значит, правый ребенок sibling красный).
                 if (sibling_left_is_black) {
-                    if (sibling_right) sibling_right->color = color_type::BLACK;
-                    sibling->color = color_type::RED;
+                    if (sibling_right) sibling_right->set_color(color_type::BLACK);
+                    sibling->set_color(color_type::RED);
                     cont.small_left_rotation(parent->left_subtree);
                     sibling = static_cast<rb_node*>(parent->left_subtree);
                     sibling_left = (sibling) ? static_cast<rb_node*>(sibling->left_subtree) : nullptr;
                 }
                 // Случай 4: Левый ребенок sibling красный.
-                sibling->color = parent->color;
-                parent->color = color_type::BLACK;
+                sibling->set_color(parent->get_color());
+                parent->set_color(color_type::BLACK);
                 if (sibling_left) {
-                    sibling_left->color = color_type::BLACK;
+                    sibling_left->set_color(color_type::BLACK);
                 }
                 // Правый поворот вокруг parent.
                 if (parent->parent == nullptr) { ptr_to_rotate_target_in_structure = &cont._root; }
@@ -983,412 +1145,675 @@ namespace __detail {
         }
 
         if (current_x != nullptr) {
-            current_x->color = color_type::BLACK;
+            current_x->set_color(color_type::BLACK);
         }
     }
 
-    template<typename tkey, typename tvalue, typename compare>
-    void bst_impl<tkey, tvalue, compare, RB_TAG>::swap(binary_search_tree<tkey, tvalue, compare, RB_TAG> &lhs,
-                                                                            binary_search_tree<tkey, tvalue, compare, RB_TAG> &rhs) noexcept
+    template<typename tkey, typename tvalue, typename compare, bool order_statistics>
+    void bst_impl<tkey, tvalue, compare, RB_TAG<order_statistics>>::swap(binary_search_tree<tkey, tvalue, compare, RB_TAG<order_statistics>> &lhs,
+                                                                            binary_search_tree<tkey, tvalue, compare, RB_TAG<order_statistics>> &rhs) noexcept
     {
         using std::swap;
-        swap(lhs.root, rhs.root);
+        swap(lhs._root, rhs._root);
         swap(lhs._logger, rhs._logger);
         swap(lhs._size, rhs._size);
         swap(lhs._allocator, rhs._allocator);
     }
+
+    template<typename tkey, typename tvalue, typename compare, bool order_statistics>
+    typename bst_impl<tkey, tvalue, compare, RB_TAG<order_statistics>>::subtree bst_impl<tkey, tvalue, compare, RB_TAG<order_statistics>>::make_subtree(
+            tree&, base_node* root) noexcept
+    {
+        if (root == nullptr)
+        {
+            return {};
+        }
+
+        root->parent = nullptr;
+        set_red(root, false);
+        size_t black_height = 0;
+        for (const base_node* current = root; current != nullptr; current = current->left_subtree)
+        {
+            black_height += is_red(current) ? 0 : 1;
+        }
+        return {root, black_height};
+    }
+
+    template<typename tkey, typename tvalue, typename compare, bool order_statistics>
+    std::tuple<typename bst_impl<tkey, tvalue, compare, RB_TAG<order_statistics>>::subtree, typename bst_impl<tkey, tvalue, compare, RB_TAG<order_statistics>>::base_node*, typename bst_impl<tkey, tvalue, compare, RB_TAG<order_statistics>>::subtree>
+    bst_impl<tkey, tvalue, compare, RB_TAG<order_statistics>>::expose(tree&, subtree source) noexcept
+    {
+        base_node* root = source.root;
+        subtree children[2] = {{root->left_subtree, source.black_height - 1}, {root->right_subtree, source.black_height - 1}};
+        for (subtree& child : children)
+        {
+            if (child.root == nullptr)
+            {
+                continue;
+            }
+            child.root->parent = nullptr;
+            // Красный корень поддерева перекрашивается: чёрная высота растёт на один
+            if (is_red(child.root))
+            {
+                set_red(child.root, false);
+                ++child.black_height;
+            }
+        }
+        root->left_subtree = root->right_subtree = nullptr;
+        return {children[0], root, children[1]};
+    }
+
+    template<typename tkey, typename tvalue, typename compare, bool order_statistics>
+    typename bst_impl<tkey, tvalue, compare, RB_TAG<order_statistics>>::subtree bst_impl<tkey, tvalue, compare, RB_TAG<order_statistics>>::join(
+            tree& cont, subtree left, base_node* middle, subtree right) noexcept
+    {
+        if (left.black_height > right.black_height)
+        {
+            return join_right(cont, left, middle, right);
+        }
+        if (right.black_height > left.black_height)
+        {
+            return join_left(cont, left, middle, right);
+        }
+
+        link(middle, left.root, right.root);
+        middle->parent = nullptr;
+        set_red(middle, false);
+        cont.recalculate_size(middle);
+        return {middle, left.black_height + 1};
+    }
+
+    template<typename tkey, typename tvalue, typename compare, bool order_statistics>
+    typename bst_impl<tkey, tvalue, compare, RB_TAG<order_statistics>>::subtree bst_impl<tkey, tvalue, compare, RB_TAG<order_statistics>>::join_right(
+            tree& cont, subtree left, base_node* middle, subtree right) noexcept
+    {
+        // Спуск по правому краю left до чёрного узла (или пустого места) с чёрной высотой right
+        base_node* parent = nullptr;
+        base_node* current = left.root;
+        size_t black_height = left.black_height;
+        while (current != nullptr && (is_red(current) || black_height != right.black_height))
+        {
+            black_height -= is_red(current) ? 0 : 1;
+            parent = current;
+            current = current->right_subtree;
+        }
+
+        link(middle, current, right.root);
+        set_red(middle, true);
+        middle->parent = parent;
+        parent->right_subtree = middle;
+        cont.recalculate_size(middle);
+
+        // Красный под красным: перекраска поднимает нарушение на два уровня, поворот снимает его совсем.
+        // Всё происходит на правом краю, поэтому дядя всегда левый ребёнок деда
+        for (base_node* node = middle; is_red(node->parent); )
+        {
+            base_node* up = node->parent;
+            base_node* grand = up->parent;
+            if (is_red(grand->left_subtree))
+            {
+                set_red(grand->left_subtree, false);
+                set_red(up, false);
+                set_red(grand, true);
+                node = grand;
+                continue;
+            }
+
+            base_node* top = rotate_left(cont, grand);
+            if (top->parent != nullptr)
+            {
+                top->parent->right_subtree = top;
+            }
+            set_red(top, false);
+            set_red(grand, true);
+            break;
+        }
+        return finish_join(cont, middle, left.black_height);
+    }
+
+    template<typename tkey, typename tvalue, typename compare, bool order_statistics>
+    typename bst_impl<tkey, tvalue, compare, RB_TAG<order_statistics>>::subtree bst_impl<tkey, tvalue, compare, RB_TAG<order_statistics>>::join_left(
+            tree& cont, subtree left, base_node* middle, subtree right) noexcept
+    {
+        base_node* parent = nullptr;
+        base_node* current = right.root;
+        size_t black_height = right.black_height;
+        while (current != nullptr && (is_red(current) || black_height != left.black_height))
+        {
+            black_height -= is_red(current) ? 0 : 1;
+            parent = current;
+            current = current->left_subtree;
+        }
+
+        link(middle, left.root, current);
+        set_red(middle, true);
+        middle->parent = parent;
+        parent->left_subtree = middle;
+        cont.recalculate_size(middle);
+
+        for (base_node* node = middle; is_red(node->parent); )
+        {
+            base_node* up = node->parent;
+            base_node* grand = up->parent;
+            if (is_red(grand->right_subtree))
+            {
+                set_red(grand->right_subtree, false);
+                set_red(up, false);
+                set_red(grand, true);
+                node = grand;
+                continue;
+            }
+
+            base_node* top = rotate_right(cont, grand);
+            if (top->parent != nullptr)
+            {
+                top->parent->left_subtree = top;
+            }
+            set_red(top, false);
+            set_red(grand, true);
+            break;
+        }
+        return finish_join(cont, middle, right.black_height);
+    }
+
+    template<typename tkey, typename tvalue, typename compare, bool order_statistics>
+    typename bst_impl<tkey, tvalue, compare, RB_TAG<order_statistics>>::subtree bst_impl<tkey, tvalue, compare, RB_TAG<order_statistics>>::finish_join(
+            tree& cont, base_node* node, size_t black_height) noexcept
+    {
+        base_node* root = node;
+        for (; node != nullptr; node = node->parent)
+        {
+            cont.recalculate_size(node);
+            root = node;
+        }
+        if (is_red(root))
+        {
+            set_red(root, false);
+            ++black_height;
+        }
+        return {root, black_height};
+    }
+
+    template<typename tkey, typename tvalue, typename compare, bool order_statistics>
+    bool bst_impl<tkey, tvalue, compare, RB_TAG<order_statistics>>::is_red(const base_node* node) noexcept
+    {
+        using node_type = typename red_black_tree<tkey, tvalue, compare, order_statistics>::node;
+        return node != nullptr && static_cast<const node_type*>(node)->get_color() == red_black_tree<tkey, tvalue, compare, order_statistics>::node_color::RED;
+    }
+
+    template<typename tkey, typename tvalue, typename compare, bool order_statistics>
+    void bst_impl<tkey, tvalue, compare, RB_TAG<order_statistics>>::set_red(base_node* node, bool red) noexcept
+    {
+        using node_type = typename red_black_tree<tkey, tvalue, compare, order_statistics>::node;
+        static_cast<node_type*>(node)->set_color(red ? red_black_tree<tkey, tvalue, compare, order_statistics>::node_color::RED
+                                                     : red_black_tree<tkey, tvalue, compare, order_statistics>::node_color::BLACK);
+    }
+
+    template<typename tkey, typename tvalue, typename compare, bool order_statistics>
+    void bst_impl<tkey, tvalue, compare, RB_TAG<order_statistics>>::link(base_node* node, base_node* left, base_node* right) noexcept
+    {
+        node->left_subtree = left;
+        node->right_subtree = right;
+        if (left != nullptr)
+        {
+            left->parent = node;
+        }
+        if (right != nullptr)
+        {
+            right->parent = node;
+        }
+    }
+
+    template<typename tkey, typename tvalue, typename compare, bool order_statistics>
+    typename bst_impl<tkey, tvalue, compare, RB_TAG<order_statistics>>::base_node* bst_impl<tkey, tvalue, compare, RB_TAG<order_statistics>>::rotate_left(
+            tree& cont, base_node* node) noexcept
+    {
+        base_node* pivot = node->right_subtree;
+        node->right_subtree = pivot->left_subtree;
+        if (node->right_subtree != nullptr)
+        {
+            node->right_subtree->parent = node;
+        }
+        pivot->left_subtree = node;
+        pivot->parent = node->parent;
+        node->parent = pivot;
+        cont.recalculate_size(node);
+        cont.recalculate_size(pivot);
+        return pivot;
+    }
+
+    template<typename tkey, typename tvalue, typename compare, bool order_statistics>
+    typename bst_impl<tkey, tvalue, compare, RB_TAG<order_statistics>>::base_node* bst_impl<tkey, tvalue, compare, RB_TAG<order_statistics>>::rotate_right(
+            tree& cont, base_node* node) noexcept
+    {
+        base_node* pivot = node->left_subtree;
+        node->left_subtree = pivot->right_subtree;
+        if (node->left_subtree != nullptr)
+        {
+            node->left_subtree->parent = node;
+        }
+        pivot->right_subtree = node;
+        pivot->parent = node->parent;
+        node->parent = pivot;
+        cont.recalculate_size(node);
+        cont.recalculate_size(pivot);
+        return pivot;
+    }
 }
 
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
 template<class ...Args>
-red_black_tree<tkey, tvalue, compare>::node::node(parent::node* par, Args&&... args)
-        : parent::node(par, std::forward<Args>(args)...), color(node_color::RED)
+red_black_tree<tkey, tvalue, compare, order_statistics>::node::node(parent::node* par, Args&&... args)
+        : parent::node(par, std::forward<Args>(args)...)
+{
+    set_color(node_color::RED);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+typename red_black_tree<tkey, tvalue, compare, order_statistics>::node_color red_black_tree<tkey, tvalue, compare, order_statistics>::node::get_color() const noexcept
+{
+    return this->parent.flag() ? node_color::RED : node_color::BLACK;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+void red_black_tree<tkey, tvalue, compare, order_statistics>::node::set_color(node_color color) noexcept
 {
+    this->parent.set_flag(color == node_color::RED);
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-red_black_tree<tkey, tvalue, compare>::red_black_tree(
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+red_black_tree<tkey, tvalue, compare, order_statistics>::red_black_tree(
         const compare& comp,
         pp_allocator<value_type> alloc,
         logger *logger) : parent(comp, alloc, logger)
 {
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-red_black_tree<tkey, tvalue, compare>::red_black_tree(
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+red_black_tree<tkey, tvalue, compare, order_statistics>::red_black_tree(
         pp_allocator<value_type> alloc,
         const compare& comp,
         logger *logger) : parent(alloc, comp, logger)
 {
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
 template<input_iterator_for_pair<tkey, tvalue> iterator>
-red_black_tree<tkey, tvalue, compare>::red_black_tree(
+red_black_tree<tkey, tvalue, compare, order_statistics>::red_black_tree(
         iterator begin, iterator end,
         const compare& cmp,
         pp_allocator<value_type> alloc,
-        logger* logger) : parent(cmp, alloc, logger)
+        logger* logger) : parent(begin, end, cmp, alloc, logger)
 {
-    for (auto it = begin; it != end; ++it)
-    {
-        this->emplace(*it);
-    }
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
 template<std::ranges::input_range Range>
-red_black_tree<tkey, tvalue, compare>::red_black_tree(
+red_black_tree<tkey, tvalue, compare, order_statistics>::red_black_tree(
         Range&& range,
         const compare& cmp,
         pp_allocator<value_type> alloc,
-        logger* logger): parent(range, cmp, alloc, logger)
+        logger* logger): parent(std::forward<Range>(range), cmp, alloc, logger)
 {
-    for (auto &&element : range)
-    {
-        emplace(std::forward<decltype(element)>(element));
-    }
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-red_black_tree<tkey, tvalue, compare>::red_black_tree(
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+red_black_tree<tkey, tvalue, compare, order_statistics>::red_black_tree(
         std::initializer_list<std::pair<tkey, tvalue>> data,
         const compare& cmp,
         pp_allocator<value_type> alloc,
-        logger* logger) : parent(cmp, alloc, logger)
+        logger* logger) : parent(data, cmp, alloc, logger)
+{
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+template<input_iterator_for_pair<tkey, tvalue> iterator>
+red_black_tree<tkey, tvalue, compare, order_statistics>::red_black_tree(
+        sorted_unique_t tag,
+        iterator begin, iterator end,
+        const compare& cmp,
+        pp_allocator<value_type> alloc,
+        logger* logger) : parent(tag, begin, end, cmp, alloc, logger)
+{
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+template<std::ranges::input_range Range>
+red_black_tree<tkey, tvalue, compare, order_statistics>::red_black_tree(
+        sorted_unique_t tag,
+        Range&& range,
+        const compare& cmp,
+        pp_allocator<value_type> alloc,
+        logger* logger) : parent(tag, std::forward<Range>(range), cmp, alloc, logger)
 {
-    for (const auto &element : data)
-    {
-        emplace(element.first, element.second);
-    }
 }
 
 // region iterator implementation
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-red_black_tree<tkey, tvalue, compare>::prefix_iterator::prefix_iterator(parent::node* n) noexcept : parent::prefix_iterator(n)
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+red_black_tree<tkey, tvalue, compare, order_statistics>::prefix_iterator::prefix_iterator(parent::node* n) noexcept : parent::prefix_iterator(n)
 {
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-red_black_tree<tkey, tvalue, compare>::prefix_iterator::prefix_iterator(parent::prefix_iterator it) noexcept : parent::prefix_iterator(it)
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+red_black_tree<tkey, tvalue, compare, order_statistics>::prefix_iterator::prefix_iterator(parent::prefix_iterator it) noexcept : parent::prefix_iterator(it)
 {
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename red_black_tree<tkey, tvalue, compare>::node_color
-red_black_tree<tkey, tvalue, compare>::prefix_iterator::get_color() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+typename red_black_tree<tkey, tvalue, compare, order_statistics>::node_color
+red_black_tree<tkey, tvalue, compare, order_statistics>::prefix_iterator::get_color() const noexcept
 {
-    return static_cast<node*>(this->_data)->color;
+    return static_cast<node*>(this->_data)->get_color();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-red_black_tree<tkey, tvalue, compare>::prefix_const_iterator::prefix_const_iterator(parent::node* n) noexcept : parent::prefix_const_iterator(n)
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+red_black_tree<tkey, tvalue, compare, order_statistics>::prefix_const_iterator::prefix_const_iterator(parent::node* n) noexcept : parent::prefix_const_iterator(n)
 {
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-red_black_tree<tkey, tvalue, compare>::prefix_const_iterator::prefix_const_iterator(parent::prefix_const_iterator it) noexcept : parent::prefix_const_iterator(it)
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+red_black_tree<tkey, tvalue, compare, order_statistics>::prefix_const_iterator::prefix_const_iterator(parent::prefix_const_iterator it) noexcept : parent::prefix_const_iterator(it)
 {
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename red_black_tree<tkey, tvalue, compare>::node_color
-red_black_tree<tkey, tvalue, compare>::prefix_const_iterator::get_color() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+typename red_black_tree<tkey, tvalue, compare, order_statistics>::node_color
+red_black_tree<tkey, tvalue, compare, order_statistics>::prefix_const_iterator::get_color() const noexcept
 {
     return prefix_iterator(this->_base).get_color();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-red_black_tree<tkey, tvalue, compare>::prefix_const_iterator::prefix_const_iterator(prefix_iterator it) noexcept : parent::prefix_const_iterator(it)
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+red_black_tree<tkey, tvalue, compare, order_statistics>::prefix_const_iterator::prefix_const_iterator(prefix_iterator it) noexcept : parent::prefix_const_iterator(it)
 {
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-red_black_tree<tkey, tvalue, compare>::prefix_reverse_iterator::prefix_reverse_iterator(parent::node* n) noexcept : parent::prefix_reverse_iterator(n)
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+red_black_tree<tkey, tvalue, compare, order_statistics>::prefix_reverse_iterator::prefix_reverse_iterator(parent::node* n) noexcept : parent::prefix_reverse_iterator(n)
 {
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-red_black_tree<tkey, tvalue, compare>::prefix_reverse_iterator::prefix_reverse_iterator(parent::prefix_reverse_iterator it) noexcept : parent::prefix_reverse_iterator(it)
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+red_black_tree<tkey, tvalue, compare, order_statistics>::prefix_reverse_iterator::prefix_reverse_iterator(parent::prefix_reverse_iterator it) noexcept : parent::prefix_reverse_iterator(it)
 {
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename red_black_tree<tkey, tvalue, compare>::node_color
-red_black_tree<tkey, tvalue, compare>::prefix_reverse_iterator::get_color() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+typename red_black_tree<tkey, tvalue, compare, order_statistics>::node_color
+red_black_tree<tkey, tvalue, compare, order_statistics>::prefix_reverse_iterator::get_color() const noexcept
 {
-    return prefix_iterator(this->_base)->color;
+    return prefix_iterator(this->_base)->get_color();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-red_black_tree<tkey, tvalue, compare>::prefix_reverse_iterator::prefix_reverse_iterator(prefix_iterator it) noexcept : parent::prefix_reverse_iterator(it)
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+red_black_tree<tkey, tvalue, compare, order_statistics>::prefix_reverse_iterator::prefix_reverse_iterator(prefix_iterator it) noexcept : parent::prefix_reverse_iterator(it)
 {
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-red_black_tree<tkey, tvalue, compare>::prefix_reverse_iterator::operator red_black_tree<tkey, tvalue, compare>::prefix_iterator() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+red_black_tree<tkey, tvalue, compare, order_statistics>::prefix_reverse_iterator::operator red_black_tree<tkey, tvalue, compare, order_statistics>::prefix_iterator() const noexcept
 {
     return parent::prefix_reverse_iterator::operator prefix_iterator();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename red_black_tree<tkey, tvalue, compare>::prefix_iterator
-red_black_tree<tkey, tvalue, compare>::prefix_reverse_iterator::base() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+typename red_black_tree<tkey, tvalue, compare, order_statistics>::prefix_iterator
+red_black_tree<tkey, tvalue, compare, order_statistics>::prefix_reverse_iterator::base() const noexcept
 {
     return parent::prefix_reverse_iterator::base();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-red_black_tree<tkey, tvalue, compare>::prefix_const_reverse_iterator::prefix_const_reverse_iterator(parent::node* n) noexcept : parent::prefix_const_reverse_iterator(n)
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+red_black_tree<tkey, tvalue, compare, order_statistics>::prefix_const_reverse_iterator::prefix_const_reverse_iterator(parent::node* n) noexcept : parent::prefix_const_reverse_iterator(n)
 {
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-red_black_tree<tkey, tvalue, compare>::prefix_const_reverse_iterator::prefix_const_reverse_iterator(parent::prefix_const_reverse_iterator it) noexcept : parent::prefix_const_reverse_iterator(it)
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+red_black_tree<tkey, tvalue, compare, order_statistics>::prefix_const_reverse_iterator::prefix_const_reverse_iterator(parent::prefix_const_reverse_iterator it) noexcept : parent::prefix_const_reverse_iterator(it)
 {
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename red_black_tree<tkey, tvalue, compare>::node_color
-red_black_tree<tkey, tvalue, compare>::prefix_const_reverse_iterator::get_color() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+typename red_black_tree<tkey, tvalue, compare, order_statistics>::node_color
+red_black_tree<tkey, tvalue, compare, order_statistics>::prefix_const_reverse_iterator::get_color() const noexcept
 {
-    return prefix_iterator(this->_base)->color;
+    return prefix_iterator(this->_base)->get_color();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-red_black_tree<tkey, tvalue, compare>::prefix_const_reverse_iterator::prefix_const_reverse_iterator(prefix_const_iterator it) noexcept : parent::prefix_const_reverse_iterator(it)
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+red_black_tree<tkey, tvalue, compare, order_statistics>::prefix_const_reverse_iterator::prefix_const_reverse_iterator(prefix_const_iterator it) noexcept : parent::prefix_const_reverse_iterator(it)
 {
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-red_black_tree<tkey, tvalue, compare>::prefix_const_reverse_iterator::operator red_black_tree<tkey, tvalue, compare>::prefix_const_iterator() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+red_black_tree<tkey, tvalue, compare, order_statistics>::prefix_const_reverse_iterator::operator red_black_tree<tkey, tvalue, compare, order_statistics>::prefix_const_iterator() const noexcept
 {
     return parent::prefix_const_reverse_iterator::operator prefix_const_iterator();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename red_black_tree<tkey, tvalue, compare>::prefix_const_iterator
-red_black_tree<tkey, tvalue, compare>::prefix_const_reverse_iterator::base() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+typename red_black_tree<tkey, tvalue, compare, order_statistics>::prefix_const_iterator
+red_black_tree<tkey, tvalue, compare, order_statistics>::prefix_const_reverse_iterator::base() const noexcept
 {
     return parent::prefix_const_reverse_iterator::base();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-red_black_tree<tkey, tvalue, compare>::infix_iterator::infix_iterator(parent::node* n) noexcept : parent::infix_iterator(n)
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+red_black_tree<tkey, tvalue, compare, order_statistics>::infix_iterator::infix_iterator(parent::node* n) noexcept : parent::infix_iterator(n)
 {
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-red_black_tree<tkey, tvalue, compare>::infix_iterator::infix_iterator(parent::infix_iterator it) noexcept : parent::infix_iterator(it)
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+red_black_tree<tkey, tvalue, compare, order_statistics>::infix_iterator::infix_iterator(parent::infix_iterator it) noexcept : parent::infix_iterator(it)
 {
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename red_black_tree<tkey, tvalue, compare>::node_color
-red_black_tree<tkey, tvalue, compare>::infix_iterator::get_color() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+typename red_black_tree<tkey, tvalue, compare, order_statistics>::node_color
+red_black_tree<tkey, tvalue, compare, order_statistics>::infix_iterator::get_color() const noexcept
 {
-    return static_cast<node*>(this->_data)->color;
+    return static_cast<node*>(this->_data)->get_color();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-red_black_tree<tkey, tvalue, compare>::infix_const_iterator::infix_const_iterator(parent::node* n) noexcept : parent::infix_const_iterator(n)
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+red_black_tree<tkey, tvalue, compare, order_statistics>::infix_const_iterator::infix_const_iterator(parent::node* n) noexcept : parent::infix_const_iterator(n)
 {
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-red_black_tree<tkey, tvalue, compare>::infix_const_iterator::infix_const_iterator(parent::infix_const_iterator it) noexcept : parent::infix_const_iterator(it)
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+red_black_tree<tkey, tvalue, compare, order_statistics>::infix_const_iterator::infix_const_iterator(parent::infix_const_iterator it) noexcept : parent::infix_const_iterator(it)
 {
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename red_black_tree<tkey, tvalue, compare>::node_color
-red_black_tree<tkey, tvalue, compare>::infix_const_iterator::get_color() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+typename red_black_tree<tkey, tvalue, compare, order_statistics>::node_color
+red_black_tree<tkey, tvalue, compare, order_statistics>::infix_const_iterator::get_color() const noexcept
 {
     return infix_iterator(this->_base).get_color();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-red_black_tree<tkey, tvalue, compare>::infix_const_iterator::infix_const_iterator(infix_iterator it) noexcept : parent::infix_const_iterator(it)
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+red_black_tree<tkey, tvalue, compare, order_statistics>::infix_const_iterator::infix_const_iterator(infix_iterator it) noexcept : parent::infix_const_iterator(it)
 {
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-red_black_tree<tkey, tvalue, compare>::infix_reverse_iterator::infix_reverse_iterator(parent::node* n) noexcept : parent::infix_reverse_iterator(n)
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+red_black_tree<tkey, tvalue, compare, order_statistics>::infix_reverse_iterator::infix_reverse_iterator(parent::node* n) noexcept : parent::infix_reverse_iterator(n)
 {
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-red_black_tree<tkey, tvalue, compare>::infix_reverse_iterator::infix_reverse_iterator(parent::infix_reverse_iterator it) noexcept : parent::infix_reverse_iterator(it)
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+red_black_tree<tkey, tvalue, compare, order_statistics>::infix_reverse_iterator::infix_reverse_iterator(parent::infix_reverse_iterator it) noexcept : parent::infix_reverse_iterator(it)
 {
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename red_black_tree<tkey, tvalue, compare>::node_color
-red_black_tree<tkey, tvalue, compare>::infix_reverse_iterator::get_color() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+typename red_black_tree<tkey, tvalue, compare, order_statistics>::node_color
+red_black_tree<tkey, tvalue, compare, order_statistics>::infix_reverse_iterator::get_color() const noexcept
 {
     return infix_iterator(this->_base)->get_color();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-red_black_tree<tkey, tvalue, compare>::infix_reverse_iterator::infix_reverse_iterator(infix_iterator it) noexcept : parent::infix_reverse_iterator(it)
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+red_black_tree<tkey, tvalue, compare, order_statistics>::infix_reverse_iterator::infix_reverse_iterator(infix_iterator it) noexcept : parent::infix_reverse_iterator(it)
 {
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-red_black_tree<tkey, tvalue, compare>::infix_reverse_iterator::operator red_black_tree<tkey, tvalue, compare>::infix_iterator() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+red_black_tree<tkey, tvalue, compare, order_statistics>::infix_reverse_iterator::operator red_black_tree<tkey, tvalue, compare, order_statistics>::infix_iterator() const noexcept
 {
     return parent::infix_reverse_iterator::operator infix_iterator();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename red_black_tree<tkey, tvalue, compare>::infix_iterator
-red_black_tree<tkey, tvalue, compare>::infix_reverse_iterator::base() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+typename red_black_tree<tkey, tvalue, compare, order_statistics>::infix_iterator
+red_black_tree<tkey, tvalue, compare, order_statistics>::infix_reverse_iterator::base() const noexcept
 {
     return parent::infix_reverse_iterator::base();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-red_black_tree<tkey, tvalue, compare>::infix_const_reverse_iterator::infix_const_reverse_iterator(parent::node* n) noexcept : parent::infix_const_reverse_iterator(n)
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+red_black_tree<tkey, tvalue, compare, order_statistics>::infix_const_reverse_iterator::infix_const_reverse_iterator(parent::node* n) noexcept : parent::infix_const_reverse_iterator(n)
 {
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-red_black_tree<tkey, tvalue, compare>::infix_const_reverse_iterator::infix_const_reverse_iterator(parent::infix_const_reverse_iterator it) noexcept : parent::infix_const_reverse_iterator(it)
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+red_black_tree<tkey, tvalue, compare, order_statistics>::infix_const_reverse_iterator::infix_const_reverse_iterator(parent::infix_const_reverse_iterator it) noexcept : parent::infix_const_reverse_iterator(it)
 {
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename red_black_tree<tkey, tvalue, compare>::node_color
-red_black_tree<tkey, tvalue, compare>::infix_const_reverse_iterator::get_color() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+typename red_black_tree<tkey, tvalue, compare, order_statistics>::node_color
+red_black_tree<tkey, tvalue, compare, order_statistics>::infix_const_reverse_iterator::get_color() const noexcept
 {
     return infix_iterator(this->_base)->get_color();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-red_black_tree<tkey, tvalue, compare>::infix_const_reverse_iterator::infix_const_reverse_iterator(infix_const_iterator it) noexcept : parent::infix_const_reverse_iterator(it)
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+red_black_tree<tkey, tvalue, compare, order_statistics>::infix_const_reverse_iterator::infix_const_reverse_iterator(infix_const_iterator it) noexcept : parent::infix_const_reverse_iterator(it)
 {
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-red_black_tree<tkey, tvalue, compare>::infix_const_reverse_iterator::operator red_black_tree<tkey, tvalue, compare>::infix_const_iterator() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+red_black_tree<tkey, tvalue, compare, order_statistics>::infix_const_reverse_iterator::operator red_black_tree<tkey, tvalue, compare, order_statistics>::infix_const_iterator() const noexcept
 {
     return parent::infix_const_reverse_iterator::operator infix_const_iterator();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename red_black_tree<tkey, tvalue, compare>::infix_const_iterator
-red_black_tree<tkey, tvalue, compare>::infix_const_reverse_iterator::base() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+typename red_black_tree<tkey, tvalue, compare, order_statistics>::infix_const_iterator
+red_black_tree<tkey, tvalue, compare, order_statistics>::infix_const_reverse_iterator::base() const noexcept
 {
     return parent::infix_const_reverse_iterator::base();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-red_black_tree<tkey, tvalue, compare>::postfix_iterator::postfix_iterator(parent::node* n) noexcept : parent::postfix_iterator(n)
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+red_black_tree<tkey, tvalue, compare, order_statistics>::postfix_iterator::postfix_iterator(parent::node* n) noexcept : parent::postfix_iterator(n)
 {
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-red_black_tree<tkey, tvalue, compare>::postfix_iterator::postfix_iterator(parent::postfix_iterator it) noexcept : parent::postfix_iterator(it)
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+red_black_tree<tkey, tvalue, compare, order_statistics>::postfix_iterator::postfix_iterator(parent::postfix_iterator it) noexcept : parent::postfix_iterator(it)
 {
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename red_black_tree<tkey, tvalue, compare>::node_color
-red_black_tree<tkey, tvalue, compare>::postfix_iterator::get_color() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+typename red_black_tree<tkey, tvalue, compare, order_statistics>::node_color
+red_black_tree<tkey, tvalue, compare, order_statistics>::postfix_iterator::get_color() const noexcept
 {
-    return static_cast<node*>(this->_data)->color;
+    return static_cast<node*>(this->_data)->get_color();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-red_black_tree<tkey, tvalue, compare>::postfix_const_iterator::postfix_const_iterator(parent::node* n) noexcept : parent::postfix_const_iterator(n)
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+red_black_tree<tkey, tvalue, compare, order_statistics>::postfix_const_iterator::postfix_const_iterator(parent::node* n) noexcept : parent::postfix_const_iterator(n)
 {
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-red_black_tree<tkey, tvalue, compare>::postfix_const_iterator::postfix_const_iterator(parent::postfix_const_iterator it) noexcept : parent::postfix_const_iterator(it)
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+red_black_tree<tkey, tvalue, compare, order_statistics>::postfix_const_iterator::postfix_const_iterator(parent::postfix_const_iterator it) noexcept : parent::postfix_const_iterator(it)
 {
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename red_black_tree<tkey, tvalue, compare>::node_color
-red_black_tree<tkey, tvalue, compare>::postfix_const_iterator::get_color() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+typename red_black_tree<tkey, tvalue, compare, order_statistics>::node_color
+red_black_tree<tkey, tvalue, compare, order_statistics>::postfix_const_iterator::get_color() const noexcept
 {
     return postfix_iterator(this->_base).get_color();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-red_black_tree<tkey, tvalue, compare>::postfix_const_iterator::postfix_const_iterator(postfix_iterator it) noexcept : parent::postfix_const_iterator(it)
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+red_black_tree<tkey, tvalue, compare, order_statistics>::postfix_const_iterator::postfix_const_iterator(postfix_iterator it) noexcept : parent::postfix_const_iterator(it)
 {
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-red_black_tree<tkey, tvalue, compare>::postfix_reverse_iterator::postfix_reverse_iterator(parent::node* n) noexcept : parent::postfix_reverse_iterator(n)
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+red_black_tree<tkey, tvalue, compare, order_statistics>::postfix_reverse_iterator::postfix_reverse_iterator(parent::node* n) noexcept : parent::postfix_reverse_iterator(n)
 {
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-red_black_tree<tkey, tvalue, compare>::postfix_reverse_iterator::postfix_reverse_iterator(parent::postfix_reverse_iterator it) noexcept : parent::postfix_reverse_iterator(it)
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+red_black_tree<tkey, tvalue, compare, order_statistics>::postfix_reverse_iterator::postfix_reverse_iterator(parent::postfix_reverse_iterator it) noexcept : parent::postfix_reverse_iterator(it)
 {
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename red_black_tree<tkey, tvalue, compare>::node_color
-red_black_tree<tkey, tvalue, compare>::postfix_reverse_iterator::get_color() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+typename red_black_tree<tkey, tvalue, compare, order_statistics>::node_color
+red_black_tree<tkey, tvalue, compare, order_statistics>::postfix_reverse_iterator::get_color() const noexcept
 {
     return postfix_iterator(this->_base).get_color();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-red_black_tree<tkey, tvalue, compare>::postfix_reverse_iterator::postfix_reverse_iterator(postfix_iterator it) noexcept : parent::postfix_reverse_iterator(it)
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+red_black_tree<tkey, tvalue, compare, order_statistics>::postfix_reverse_iterator::postfix_reverse_iterator(postfix_iterator it) noexcept : parent::postfix_reverse_iterator(it)
 {
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-red_black_tree<tkey, tvalue, compare>::postfix_reverse_iterator::operator red_black_tree<tkey, tvalue, compare>::postfix_iterator() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+red_black_tree<tkey, tvalue, compare, order_statistics>::postfix_reverse_iterator::operator red_black_tree<tkey, tvalue, compare, order_statistics>::postfix_iterator() const noexcept
 {
     return parent::postfix_reverse_iterator::operator postfix_iterator();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename red_black_tree<tkey, tvalue, compare>::postfix_iterator
-red_black_tree<tkey, tvalue, compare>::postfix_reverse_iterator::base() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+typename red_black_tree<tkey, tvalue, compare, order_statistics>::postfix_iterator
+red_black_tree<tkey, tvalue, compare, order_statistics>::postfix_reverse_iterator::base() const noexcept
 {
     return parent::postfix_reverse_iterator::base();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-red_black_tree<tkey, tvalue, compare>::postfix_const_reverse_iterator::postfix_const_reverse_iterator(parent::node* n) noexcept : parent::postfix_reverse_iterator(n)
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+red_black_tree<tkey, tvalue, compare, order_statistics>::postfix_const_reverse_iterator::postfix_const_reverse_iterator(parent::node* n) noexcept : parent::postfix_reverse_iterator(n)
 {
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-red_black_tree<tkey, tvalue, compare>::postfix_const_reverse_iterator::postfix_const_reverse_iterator(parent::postfix_const_reverse_iterator it) noexcept : parent::postfix_reverse_iterator(it)
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+red_black_tree<tkey, tvalue, compare, order_statistics>::postfix_const_reverse_iterator::postfix_const_reverse_iterator(parent::postfix_const_reverse_iterator it) noexcept : parent::postfix_reverse_iterator(it)
 {
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename red_black_tree<tkey, tvalue, compare>::node_color
-red_black_tree<tkey, tvalue, compare>::postfix_const_reverse_iterator::get_color() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+typename red_black_tree<tkey, tvalue, compare, order_statistics>::node_color
+red_black_tree<tkey, tvalue, compare, order_statistics>::postfix_const_reverse_iterator::get_color() const noexcept
 {
     return postfix_iterator(this->_base).get_color();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-red_black_tree<tkey, tvalue, compare>::postfix_const_reverse_iterator::postfix_const_reverse_iterator(postfix_const_iterator it) noexcept : parent::postfix_const_reverse_iterator(it)
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+red_black_tree<tkey, tvalue, compare, order_statistics>::postfix_const_reverse_iterator::postfix_const_reverse_iterator(postfix_const_iterator it) noexcept : parent::postfix_const_reverse_iterator(it)
 {
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-red_black_tree<tkey, tvalue, compare>::postfix_const_reverse_iterator::operator red_black_tree<tkey, tvalue, compare>::postfix_const_iterator() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+red_black_tree<tkey, tvalue, compare, order_statistics>::postfix_const_reverse_iterator::operator red_black_tree<tkey, tvalue, compare, order_statistics>::postfix_const_iterator() const noexcept
 {
     return parent::postfix_const_reverse_iterator::operator postfix_const_iterator();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename red_black_tree<tkey, tvalue, compare>::postfix_const_iterator
-red_black_tree<tkey, tvalue, compare>::postfix_const_reverse_iterator::base() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+typename red_black_tree<tkey, tvalue, compare, order_statistics>::postfix_const_iterator
+red_black_tree<tkey, tvalue, compare, order_statistics>::postfix_const_reverse_iterator::base() const noexcept
 {
     return parent::postfix_const_reverse_iterator::base();
 }
@@ -1397,338 +1822,338 @@ red_black_tree<tkey, tvalue, compare>::postfix_const_reverse_iterator::base() co
 
 // region iterator requests implementation
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename red_black_tree<tkey, tvalue, compare>::infix_iterator
-red_black_tree<tkey, tvalue, compare>::begin() noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+typename red_black_tree<tkey, tvalue, compare, order_statistics>::infix_iterator
+red_black_tree<tkey, tvalue, compare, order_statistics>::begin() noexcept
 {
     return parent::begin();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename red_black_tree<tkey, tvalue, compare>::infix_iterator
-red_black_tree<tkey, tvalue, compare>::end() noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+typename red_black_tree<tkey, tvalue, compare, order_statistics>::infix_iterator
+red_black_tree<tkey, tvalue, compare, order_statistics>::end() noexcept
 {
     return parent::end();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename red_black_tree<tkey, tvalue, compare>::infix_const_iterator
-red_black_tree<tkey, tvalue, compare>::begin() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+typename red_black_tree<tkey, tvalue, compare, order_statistics>::infix_const_iterator
+red_black_tree<tkey, tvalue, compare, order_statistics>::begin() const noexcept
 {
     return parent::begin();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename red_black_tree<tkey, tvalue, compare>::infix_const_iterator
-red_black_tree<tkey, tvalue, compare>::end() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+typename red_black_tree<tkey, tvalue, compare, order_statistics>::infix_const_iterator
+red_black_tree<tkey, tvalue, compare, order_statistics>::end() const noexcept
 {
     return parent::end();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename red_black_tree<tkey, tvalue, compare>::infix_const_iterator
-red_black_tree<tkey, tvalue, compare>::cbegin() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+typename red_black_tree<tkey, tvalue, compare, order_statistics>::infix_const_iterator
+red_black_tree<tkey, tvalue, compare, order_statistics>::cbegin() const noexcept
 {
     return parent::cbegin();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename red_black_tree<tkey, tvalue, compare>::infix_const_iterator
-red_black_tree<tkey, tvalue, compare>::cend() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+typename red_black_tree<tkey, tvalue, compare, order_statistics>::infix_const_iterator
+red_black_tree<tkey, tvalue, compare, order_statistics>::cend() const noexcept
 {
     return parent::cend();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename red_black_tree<tkey, tvalue, compare>::infix_reverse_iterator
-red_black_tree<tkey, tvalue, compare>::rbegin() noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+typename red_black_tree<tkey, tvalue, compare, order_statistics>::infix_reverse_iterator
+red_black_tree<tkey, tvalue, compare, order_statistics>::rbegin() noexcept
 {
     return parent::rbegin();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename red_black_tree<tkey, tvalue, compare>::infix_reverse_iterator
-red_black_tree<tkey, tvalue, compare>::rend() noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+typename red_black_tree<tkey, tvalue, compare, order_statistics>::infix_reverse_iterator
+red_black_tree<tkey, tvalue, compare, order_statistics>::rend() noexcept
 {
     return parent::rend();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename red_black_tree<tkey, tvalue, compare>::infix_const_reverse_iterator
-red_black_tree<tkey, tvalue, compare>::rbegin() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+typename red_black_tree<tkey, tvalue, compare, order_statistics>::infix_const_reverse_iterator
+red_black_tree<tkey, tvalue, compare, order_statistics>::rbegin() const noexcept
 {
     return parent::rbegin();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename red_black_tree<tkey, tvalue, compare>::infix_const_reverse_iterator
-red_black_tree<tkey, tvalue, compare>::rend() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+typename red_black_tree<tkey, tvalue, compare, order_statistics>::infix_const_reverse_iterator
+red_black_tree<tkey, tvalue, compare, order_statistics>::rend() const noexcept
 {
     return parent::rend();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename red_black_tree<tkey, tvalue, compare>::infix_const_reverse_iterator
-red_black_tree<tkey, tvalue, compare>::crbegin() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+typename red_black_tree<tkey, tvalue, compare, order_statistics>::infix_const_reverse_iterator
+red_black_tree<tkey, tvalue, compare, order_statistics>::crbegin() const noexcept
 {
     return parent::crbegin();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename red_black_tree<tkey, tvalue, compare>::infix_const_reverse_iterator
-red_black_tree<tkey, tvalue, compare>::crend() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+typename red_black_tree<tkey, tvalue, compare, order_statistics>::infix_const_reverse_iterator
+red_black_tree<tkey, tvalue, compare, order_statistics>::crend() const noexcept
 {
     return parent::crend();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename red_black_tree<tkey, tvalue, compare>::prefix_iterator
-red_black_tree<tkey, tvalue, compare>::begin_prefix() noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+typename red_black_tree<tkey, tvalue, compare, order_statistics>::prefix_iterator
+red_black_tree<tkey, tvalue, compare, order_statistics>::begin_prefix() noexcept
 {
     return parent::begin_prefix();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename red_black_tree<tkey, tvalue, compare>::prefix_iterator
-red_black_tree<tkey, tvalue, compare>::end_prefix() noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+typename red_black_tree<tkey, tvalue, compare, order_statistics>::prefix_iterator
+red_black_tree<tkey, tvalue, compare, order_statistics>::end_prefix() noexcept
 {
     return parent::end_prefix();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename red_black_tree<tkey, tvalue, compare>::prefix_const_iterator
-red_black_tree<tkey, tvalue, compare>::begin_prefix() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+typename red_black_tree<tkey, tvalue, compare, order_statistics>::prefix_const_iterator
+red_black_tree<tkey, tvalue, compare, order_statistics>::begin_prefix() const noexcept
 {
     return parent::begin_prefix();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename red_black_tree<tkey, tvalue, compare>::prefix_const_iterator
-red_black_tree<tkey, tvalue, compare>::end_prefix() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+typename red_black_tree<tkey, tvalue, compare, order_statistics>::prefix_const_iterator
+red_black_tree<tkey, tvalue, compare, order_statistics>::end_prefix() const noexcept
 {
     return parent::end_prefix();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename red_black_tree<tkey, tvalue, compare>::prefix_const_iterator
-red_black_tree<tkey, tvalue, compare>::cbegin_prefix() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+typename red_black_tree<tkey, tvalue, compare, order_statistics>::prefix_const_iterator
+red_black_tree<tkey, tvalue, compare, order_statistics>::cbegin_prefix() const noexcept
 {
     return parent::cbegin_prefix();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename red_black_tree<tkey, tvalue, compare>::prefix_const_iterator
-red_black_tree<tkey, tvalue, compare>::cend_prefix() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+typename red_black_tree<tkey, tvalue, compare, order_statistics>::prefix_const_iterator
+red_black_tree<tkey, tvalue, compare, order_statistics>::cend_prefix() const noexcept
 {
     return parent::cend_prefix();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename red_black_tree<tkey, tvalue, compare>::prefix_reverse_iterator
-red_black_tree<tkey, tvalue, compare>::rbegin_prefix() noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+typename red_black_tree<tkey, tvalue, compare, order_statistics>::prefix_reverse_iterator
+red_black_tree<tkey, tvalue, compare, order_statistics>::rbegin_prefix() noexcept
 {
     return parent::rbegin_prefix();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename red_black_tree<tkey, tvalue, compare>::prefix_reverse_iterator
-red_black_tree<tkey, tvalue, compare>::rend_prefix() noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+typename red_black_tree<tkey, tvalue, compare, order_statistics>::prefix_reverse_iterator
+red_black_tree<tkey, tvalue, compare, order_statistics>::rend_prefix() noexcept
 {
     return parent::rend_prefix();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename red_black_tree<tkey, tvalue, compare>::prefix_const_reverse_iterator
-red_black_tree<tkey, tvalue, compare>::rbegin_prefix() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+typename red_black_tree<tkey, tvalue, compare, order_statistics>::prefix_const_reverse_iterator
+red_black_tree<tkey, tvalue, compare, order_statistics>::rbegin_prefix() const noexcept
 {
     return parent::rbegin_prefix();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename red_black_tree<tkey, tvalue, compare>::prefix_const_reverse_iterator
-red_black_tree<tkey, tvalue, compare>::rend_prefix() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+typename red_black_tree<tkey, tvalue, compare, order_statistics>::prefix_const_reverse_iterator
+red_black_tree<tkey, tvalue, compare, order_statistics>::rend_prefix() const noexcept
 {
     return parent::rend_prefix();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename red_black_tree<tkey, tvalue, compare>::prefix_const_reverse_iterator
-red_black_tree<tkey, tvalue, compare>::crbegin_prefix() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+typename red_black_tree<tkey, tvalue, compare, order_statistics>::prefix_const_reverse_iterator
+red_black_tree<tkey, tvalue, compare, order_statistics>::crbegin_prefix() const noexcept
 {
     return parent::crbegin_prefix();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename red_black_tree<tkey, tvalue, compare>::prefix_const_reverse_iterator
-red_black_tree<tkey, tvalue, compare>::crend_prefix() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+typename red_black_tree<tkey, tvalue, compare, order_statistics>::prefix_const_reverse_iterator
+red_black_tree<tkey, tvalue, compare, order_statistics>::crend_prefix() const noexcept
 {
     return parent::crend_prefix();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename red_black_tree<tkey, tvalue, compare>::infix_iterator
-red_black_tree<tkey, tvalue, compare>::begin_infix() noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+typename red_black_tree<tkey, tvalue, compare, order_statistics>::infix_iterator
+red_black_tree<tkey, tvalue, compare, order_statistics>::begin_infix() noexcept
 {
     return parent::begin_infix();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename red_black_tree<tkey, tvalue, compare>::infix_iterator
-red_black_tree<tkey, tvalue, compare>::end_infix() noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+typename red_black_tree<tkey, tvalue, compare, order_statistics>::infix_iterator
+red_black_tree<tkey, tvalue, compare, order_statistics>::end_infix() noexcept
 {
     return parent::end_infix();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename red_black_tree<tkey, tvalue, compare>::infix_const_iterator
-red_black_tree<tkey, tvalue, compare>::begin_infix() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+typename red_black_tree<tkey, tvalue, compare, order_statistics>::infix_const_iterator
+red_black_tree<tkey, tvalue, compare, order_statistics>::begin_infix() const noexcept
 {
     return parent::begin_infix();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename red_black_tree<tkey, tvalue, compare>::infix_const_iterator
-red_black_tree<tkey, tvalue, compare>::end_infix() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+typename red_black_tree<tkey, tvalue, compare, order_statistics>::infix_const_iterator
+red_black_tree<tkey, tvalue, compare, order_statistics>::end_infix() const noexcept
 {
     return parent::end_infix();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename red_black_tree<tkey, tvalue, compare>::infix_const_iterator
-red_black_tree<tkey, tvalue, compare>::cbegin_infix() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+typename red_black_tree<tkey, tvalue, compare, order_statistics>::infix_const_iterator
+red_black_tree<tkey, tvalue, compare, order_statistics>::cbegin_infix() const noexcept
 {
     return parent::cbegin_infix();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename red_black_tree<tkey, tvalue, compare>::infix_const_iterator
-red_black_tree<tkey, tvalue, compare>::cend_infix() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+typename red_black_tree<tkey, tvalue, compare, order_statistics>::infix_const_iterator
+red_black_tree<tkey, tvalue, compare, order_statistics>::cend_infix() const noexcept
 {
     return parent::cend_infix();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename red_black_tree<tkey, tvalue, compare>::infix_reverse_iterator
-red_black_tree<tkey, tvalue, compare>::rbegin_infix() noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+typename red_black_tree<tkey, tvalue, compare, order_statistics>::infix_reverse_iterator
+red_black_tree<tkey, tvalue, compare, order_statistics>::rbegin_infix() noexcept
 {
     return parent::rbegin_infix();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename red_black_tree<tkey, tvalue, compare>::infix_reverse_iterator
-red_black_tree<tkey, tvalue, compare>::rend_infix() noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+typename red_black_tree<tkey, tvalue, compare, order_statistics>::infix_reverse_iterator
+red_black_tree<tkey, tvalue, compare, order_statistics>::rend_infix() noexcept
 {
     return parent::rend_infix();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename red_black_tree<tkey, tvalue, compare>::infix_const_reverse_iterator
-red_black_tree<tkey, tvalue, compare>::rbegin_infix() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+typename red_black_tree<tkey, tvalue, compare, order_statistics>::infix_const_reverse_iterator
+red_black_tree<tkey, tvalue, compare, order_statistics>::rbegin_infix() const noexcept
 {
     return parent::rbegin_infix();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename red_black_tree<tkey, tvalue, compare>::infix_const_reverse_iterator
-red_black_tree<tkey, tvalue, compare>::rend_infix() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+typename red_black_tree<tkey, tvalue, compare, order_statistics>::infix_const_reverse_iterator
+red_black_tree<tkey, tvalue, compare, order_statistics>::rend_infix() const noexcept
 {
     return parent::rend_infix();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename red_black_tree<tkey, tvalue, compare>::infix_const_reverse_iterator
-red_black_tree<tkey, tvalue, compare>::crbegin_infix() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+typename red_black_tree<tkey, tvalue, compare, order_statistics>::infix_const_reverse_iterator
+red_black_tree<tkey, tvalue, compare, order_statistics>::crbegin_infix() const noexcept
 {
     return parent::crbegin_infix();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename red_black_tree<tkey, tvalue, compare>::infix_const_reverse_iterator
-red_black_tree<tkey, tvalue, compare>::crend_infix() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+typename red_black_tree<tkey, tvalue, compare, order_statistics>::infix_const_reverse_iterator
+red_black_tree<tkey, tvalue, compare, order_statistics>::crend_infix() const noexcept
 {
     return parent::crend_infix();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename red_black_tree<tkey, tvalue, compare>::postfix_iterator
-red_black_tree<tkey, tvalue, compare>::begin_postfix() noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+typename red_black_tree<tkey, tvalue, compare, order_statistics>::postfix_iterator
+red_black_tree<tkey, tvalue, compare, order_statistics>::begin_postfix() noexcept
 {
     return parent::begin_postfix();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename red_black_tree<tkey, tvalue, compare>::postfix_iterator
-red_black_tree<tkey, tvalue, compare>::end_postfix() noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+typename red_black_tree<tkey, tvalue, compare, order_statistics>::postfix_iterator
+red_black_tree<tkey, tvalue, compare, order_statistics>::end_postfix() noexcept
 {
     return parent::end_postfix();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename red_black_tree<tkey, tvalue, compare>::postfix_const_iterator
-red_black_tree<tkey, tvalue, compare>::begin_postfix() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+typename red_black_tree<tkey, tvalue, compare, order_statistics>::postfix_const_iterator
+red_black_tree<tkey, tvalue, compare, order_statistics>::begin_postfix() const noexcept
 {
     return parent::begin_postfix();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename red_black_tree<tkey, tvalue, compare>::postfix_const_iterator
-red_black_tree<tkey, tvalue, compare>::end_postfix() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+typename red_black_tree<tkey, tvalue, compare, order_statistics>::postfix_const_iterator
+red_black_tree<tkey, tvalue, compare, order_statistics>::end_postfix() const noexcept
 {
     return parent::end_postfix();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename red_black_tree<tkey, tvalue, compare>::postfix_const_iterator
-red_black_tree<tkey, tvalue, compare>::cbegin_postfix() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+typename red_black_tree<tkey, tvalue, compare, order_statistics>::postfix_const_iterator
+red_black_tree<tkey, tvalue, compare, order_statistics>::cbegin_postfix() const noexcept
 {
     return parent::cbegin_postfix();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename red_black_tree<tkey, tvalue, compare>::postfix_const_iterator
-red_black_tree<tkey, tvalue, compare>::cend_postfix() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+typename red_black_tree<tkey, tvalue, compare, order_statistics>::postfix_const_iterator
+red_black_tree<tkey, tvalue, compare, order_statistics>::cend_postfix() const noexcept
 {
     return parent::cend_postfix();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename red_black_tree<tkey, tvalue, compare>::postfix_reverse_iterator
-red_black_tree<tkey, tvalue, compare>::rbegin_postfix() noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+typename red_black_tree<tkey, tvalue, compare, order_statistics>::postfix_reverse_iterator
+red_black_tree<tkey, tvalue, compare, order_statistics>::rbegin_postfix() noexcept
 {
     return parent::rbegin_postfix();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename red_black_tree<tkey, tvalue, compare>::postfix_reverse_iterator
-red_black_tree<tkey, tvalue, compare>::rend_postfix() noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+typename red_black_tree<tkey, tvalue, compare, order_statistics>::postfix_reverse_iterator
+red_black_tree<tkey, tvalue, compare, order_statistics>::rend_postfix() noexcept
 {
     return parent::rend_postfix();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename red_black_tree<tkey, tvalue, compare>::postfix_const_reverse_iterator
-red_black_tree<tkey, tvalue, compare>::rbegin_postfix() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+typename red_black_tree<tkey, tvalue, compare, order_statistics>::postfix_const_reverse_iterator
+red_black_tree<tkey, tvalue, compare, order_statistics>::rbegin_postfix() const noexcept
 {
     return parent::rbegin_postfix();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename red_black_tree<tkey, tvalue, compare>::postfix_const_reverse_iterator
-red_black_tree<tkey, tvalue, compare>::rend_postfix() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+typename red_black_tree<tkey, tvalue, compare, order_statistics>::postfix_const_reverse_iterator
+red_black_tree<tkey, tvalue, compare, order_statistics>::rend_postfix() const noexcept
 {
     return parent::rend_postfix();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename red_black_tree<tkey, tvalue, compare>::postfix_const_reverse_iterator
-red_black_tree<tkey, tvalue, compare>::crbegin_postfix() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+typename red_black_tree<tkey, tvalue, compare, order_statistics>::postfix_const_reverse_iterator
+red_black_tree<tkey, tvalue, compare, order_statistics>::crbegin_postfix() const noexcept
 {
     return parent::crbegin_postfix();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename red_black_tree<tkey, tvalue, compare>::postfix_const_reverse_iterator
-red_black_tree<tkey, tvalue, compare>::crend_postfix() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+typename red_black_tree<tkey, tvalue, compare, order_statistics>::postfix_const_reverse_iterator
+red_black_tree<tkey, tvalue, compare, order_statistics>::crend_postfix() const noexcept
 {
     return parent::crend_postfix();
 }
@@ -1737,14 +2162,14 @@ red_black_tree<tkey, tvalue, compare>::crend_postfix() const noexcept
 
 // region rb_tree implementation
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-red_black_tree<tkey, tvalue, compare>::red_black_tree(red_black_tree const &other) : parent(other)
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+red_black_tree<tkey, tvalue, compare, order_statistics>::red_black_tree(red_black_tree const &other) : parent(other)
 {
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-red_black_tree<tkey, tvalue, compare> &
-red_black_tree<tkey, tvalue, compare>::operator=(red_black_tree const &other)
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+red_black_tree<tkey, tvalue, compare, order_statistics> &
+red_black_tree<tkey, tvalue, compare, order_statistics>::operator=(red_black_tree const &other)
 {
     if (this != &other) {
         parent::operator=(other);
@@ -1752,14 +2177,14 @@ red_black_tree<tkey, tvalue, compare>::operator=(red_black_tree const &other)
     return *this;
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-red_black_tree<tkey, tvalue, compare>::red_black_tree(red_black_tree &&other) noexcept : parent(std::move(other))
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+red_black_tree<tkey, tvalue, compare, order_statistics>::red_black_tree(red_black_tree &&other) noexcept : parent(std::move(other))
 {
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-red_black_tree<tkey, tvalue, compare> &
-red_black_tree<tkey, tvalue, compare>::operator=(red_black_tree &&other) noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+red_black_tree<tkey, tvalue, compare, order_statistics> &
+red_black_tree<tkey, tvalue, compare, order_statistics>::operator=(red_black_tree &&other) noexcept
 {
     if(this != other){
         parent::operator=(std::move(other));
@@ -1767,8 +2192,8 @@ red_black_tree<tkey, tvalue, compare>::operator=(red_black_tree &&other) noexcep
     return *this;
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-void red_black_tree<tkey, tvalue, compare>::swap(parent& other) noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+void red_black_tree<tkey, tvalue, compare, order_statistics>::swap(parent& other) noexcept
 {
     if (this != &other)
     {
@@ -1778,123 +2203,306 @@ void red_black_tree<tkey, tvalue, compare>::swap(parent& other) noexcept
 
 // endregion rb_tree implementation
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-std::pair<typename red_black_tree<tkey, tvalue, compare>::infix_iterator, bool>
-red_black_tree<tkey, tvalue, compare>::insert(const value_type& value)
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+std::pair<typename red_black_tree<tkey, tvalue, compare, order_statistics>::infix_iterator, bool>
+red_black_tree<tkey, tvalue, compare, order_statistics>::insert(const value_type& value)
 {
     auto result = parent::insert(value);
     return result;
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-std::pair<typename red_black_tree<tkey, tvalue, compare>::infix_iterator, bool>
-red_black_tree<tkey, tvalue, compare>::insert(value_type&& value)
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+std::pair<typename red_black_tree<tkey, tvalue, compare, order_statistics>::infix_iterator, bool>
+red_black_tree<tkey, tvalue, compare, order_statistics>::insert(value_type&& value)
 {
     auto result = parent::insert(std::move(value));
     return result;
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
 template<class ...Args>
-std::pair<typename red_black_tree<tkey, tvalue, compare>::infix_iterator, bool>
-red_black_tree<tkey, tvalue, compare>::emplace(Args&&... args)
+std::pair<typename red_black_tree<tkey, tvalue, compare, order_statistics>::infix_iterator, bool>
+red_black_tree<tkey, tvalue, compare, order_statistics>::emplace(Args&&... args)
 {
     return parent::emplace(std::forward<Args>(args)...);
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename red_black_tree<tkey, tvalue, compare>::infix_iterator
-red_black_tree<tkey, tvalue, compare>::insert_or_assign(const value_type& value)
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+typename red_black_tree<tkey, tvalue, compare, order_statistics>::infix_iterator
+red_black_tree<tkey, tvalue, compare, order_statistics>::insert_or_assign(const value_type& value)
 {
     auto result = parent::insert_or_assign(value);
     return result;
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename red_black_tree<tkey, tvalue, compare>::infix_iterator
-red_black_tree<tkey, tvalue, compare>::insert_or_assign(value_type&& value)
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+typename red_black_tree<tkey, tvalue, compare, order_statistics>::infix_iterator
+red_black_tree<tkey, tvalue, compare, order_statistics>::insert_or_assign(value_type&& value)
 {
     auto result = parent::insert_or_assign(std::move(value));
     return result;
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
 template<class ...Args>
-typename red_black_tree<tkey, tvalue, compare>::infix_iterator
-red_black_tree<tkey, tvalue, compare>::emplace_or_assign(Args&&... args)
+typename red_black_tree<tkey, tvalue, compare, order_statistics>::infix_iterator
+red_black_tree<tkey, tvalue, compare, order_statistics>::emplace_or_assign(Args&&... args)
 {
-    auto it = binary_search_tree<tkey, tvalue, compare, __detail::RB_TAG>::emplace_or_assign(std::forward<Args>(args)...);
+    auto it = binary_search_tree<tkey, tvalue, compare, __detail::RB_TAG<order_statistics>>::emplace_or_assign(std::forward<Args>(args)...);
     return it;
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename red_black_tree<tkey, tvalue, compare>::infix_iterator
-red_black_tree<tkey, tvalue, compare>::find(const tkey& key)
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+typename red_black_tree<tkey, tvalue, compare, order_statistics>::infix_iterator
+red_black_tree<tkey, tvalue, compare, order_statistics>::find(const tkey& key)
 {
     return parent::find(key);
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename red_black_tree<tkey, tvalue, compare>::infix_const_iterator
-red_black_tree<tkey, tvalue, compare>::find(const tkey& key) const
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+typename red_black_tree<tkey, tvalue, compare, order_statistics>::infix_const_iterator
+red_black_tree<tkey, tvalue, compare, order_statistics>::find(const tkey& key) const
 {
     return parent::find(key);
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename red_black_tree<tkey, tvalue, compare>::infix_iterator
-red_black_tree<tkey, tvalue, compare>::lower_bound(const tkey& key)
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+typename red_black_tree<tkey, tvalue, compare, order_statistics>::infix_iterator
+red_black_tree<tkey, tvalue, compare, order_statistics>::lower_bound(const tkey& key)
 {
     return parent::lower_bound(key);
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename red_black_tree<tkey, tvalue, compare>::infix_const_iterator
-red_black_tree<tkey, tvalue, compare>::lower_bound(const tkey& key) const
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+typename red_black_tree<tkey, tvalue, compare, order_statistics>::infix_const_iterator
+red_black_tree<tkey, tvalue, compare, order_statistics>::lower_bound(const tkey& key) const
 {
     return parent::lower_bound(key);
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename red_black_tree<tkey, tvalue, compare>::infix_iterator
-red_black_tree<tkey, tvalue, compare>::upper_bound(const tkey& key)
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+typename red_black_tree<tkey, tvalue, compare, order_statistics>::infix_iterator
+red_black_tree<tkey, tvalue, compare, order_statistics>::upper_bound(const tkey& key)
 {
     return parent::upper_bound(key);
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename red_black_tree<tkey, tvalue, compare>::infix_const_iterator
-red_black_tree<tkey, tvalue, compare>::upper_bound(const tkey& key) const
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+typename red_black_tree<tkey, tvalue, compare, order_statistics>::infix_const_iterator
+red_black_tree<tkey, tvalue, compare, order_statistics>::upper_bound(const tkey& key) const
 {
     return parent::upper_bound(key);
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename red_black_tree<tkey, tvalue, compare>::infix_iterator
-red_black_tree<tkey, tvalue, compare>::erase(infix_iterator pos)
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+template<class ...Args>
+std::pair<typename red_black_tree<tkey, tvalue, compare, order_statistics>::infix_iterator, bool>
+red_black_tree<tkey, tvalue, compare, order_statistics>::try_emplace(const tkey& key, Args&&... args)
+{
+    return parent::try_emplace(key, std::forward<Args>(args)...);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+template<class ...Args>
+std::pair<typename red_black_tree<tkey, tvalue, compare, order_statistics>::infix_iterator, bool>
+red_black_tree<tkey, tvalue, compare, order_statistics>::try_emplace(tkey&& key, Args&&... args)
+{
+    return parent::try_emplace(std::move(key), std::forward<Args>(args)...);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+typename red_black_tree<tkey, tvalue, compare, order_statistics>::infix_iterator
+red_black_tree<tkey, tvalue, compare, order_statistics>::insert(typename parent::infix_const_iterator hint, const value_type& value)
+{
+    return parent::insert(hint, value);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+typename red_black_tree<tkey, tvalue, compare, order_statistics>::infix_iterator
+red_black_tree<tkey, tvalue, compare, order_statistics>::insert(typename parent::infix_const_iterator hint, value_type&& value)
+{
+    return parent::insert(hint, std::move(value));
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+template<class ...Args>
+typename red_black_tree<tkey, tvalue, compare, order_statistics>::infix_iterator
+red_black_tree<tkey, tvalue, compare, order_statistics>::emplace_hint(typename parent::infix_const_iterator hint, Args&&... args)
+{
+    return parent::emplace_hint(hint, std::forward<Args>(args)...);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+typename red_black_tree<tkey, tvalue, compare, order_statistics>::infix_iterator
+red_black_tree<tkey, tvalue, compare, order_statistics>::lower_bound(typename parent::infix_const_iterator hint, const tkey& key)
+{
+    return parent::lower_bound(hint, key);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+typename red_black_tree<tkey, tvalue, compare, order_statistics>::infix_const_iterator
+red_black_tree<tkey, tvalue, compare, order_statistics>::lower_bound(typename parent::infix_const_iterator hint, const tkey& key) const
+{
+    return parent::lower_bound(hint, key);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+typename red_black_tree<tkey, tvalue, compare, order_statistics>::infix_iterator
+red_black_tree<tkey, tvalue, compare, order_statistics>::select(size_t k)
+{
+    return parent::select(k);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+typename red_black_tree<tkey, tvalue, compare, order_statistics>::infix_const_iterator
+red_black_tree<tkey, tvalue, compare, order_statistics>::select(size_t k) const
+{
+    return parent::select(k);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+typename red_black_tree<tkey, tvalue, compare, order_statistics>::infix_iterator
+red_black_tree<tkey, tvalue, compare, order_statistics>::advance(typename parent::infix_const_iterator it, ptrdiff_t n)
+{
+    return parent::advance(it, n);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+typename red_black_tree<tkey, tvalue, compare, order_statistics>::infix_const_iterator
+red_black_tree<tkey, tvalue, compare, order_statistics>::advance(typename parent::infix_const_iterator it, ptrdiff_t n) const
+{
+    return parent::advance(it, n);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+template<typename K> requires transparent_compare<compare>
+typename red_black_tree<tkey, tvalue, compare, order_statistics>::infix_iterator
+red_black_tree<tkey, tvalue, compare, order_statistics>::find(const K& key)
+{
+    return parent::find(key);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+template<typename K> requires transparent_compare<compare>
+typename red_black_tree<tkey, tvalue, compare, order_statistics>::infix_const_iterator
+red_black_tree<tkey, tvalue, compare, order_statistics>::find(const K& key) const
+{
+    return parent::find(key);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+template<typename K> requires transparent_compare<compare>
+typename red_black_tree<tkey, tvalue, compare, order_statistics>::infix_iterator
+red_black_tree<tkey, tvalue, compare, order_statistics>::lower_bound(const K& key)
+{
+    return parent::lower_bound(key);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+template<typename K> requires transparent_compare<compare>
+typename red_black_tree<tkey, tvalue, compare, order_statistics>::infix_const_iterator
+red_black_tree<tkey, tvalue, compare, order_statistics>::lower_bound(const K& key) const
+{
+    return parent::lower_bound(key);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+template<typename K> requires transparent_compare<compare>
+typename red_black_tree<tkey, tvalue, compare, order_statistics>::infix_iterator
+red_black_tree<tkey, tvalue, compare, order_statistics>::upper_bound(const K& key)
+{
+    return parent::upper_bound(key);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+template<typename K> requires transparent_compare<compare>
+typename red_black_tree<tkey, tvalue, compare, order_statistics>::infix_const_iterator
+red_black_tree<tkey, tvalue, compare, order_statistics>::upper_bound(const K& key) const
+{
+    return parent::upper_bound(key);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+typename red_black_tree<tkey, tvalue, compare, order_statistics>::infix_iterator
+red_black_tree<tkey, tvalue, compare, order_statistics>::erase(infix_iterator pos)
 {
     return parent::erase(pos);
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename red_black_tree<tkey, tvalue, compare>::infix_iterator
-red_black_tree<tkey, tvalue, compare>::erase(infix_const_iterator pos)
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+typename red_black_tree<tkey, tvalue, compare, order_statistics>::infix_iterator
+red_black_tree<tkey, tvalue, compare, order_statistics>::erase(infix_const_iterator pos)
 {
     return parent::erase(pos);
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename red_black_tree<tkey, tvalue, compare>::infix_iterator
-red_black_tree<tkey, tvalue, compare>::erase(infix_iterator first, infix_iterator last)
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+typename red_black_tree<tkey, tvalue, compare, order_statistics>::infix_iterator
+red_black_tree<tkey, tvalue, compare, order_statistics>::erase(infix_iterator first, infix_iterator last)
 {
     return parent::erase(first, last);
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename red_black_tree<tkey, tvalue, compare>::infix_iterator
-red_black_tree<tkey, tvalue, compare>::erase(infix_const_iterator first, infix_const_iterator last)
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+typename red_black_tree<tkey, tvalue, compare, order_statistics>::infix_iterator
+red_black_tree<tkey, tvalue, compare, order_statistics>::erase(infix_const_iterator first, infix_const_iterator last)
 {
     return parent::erase(first, last);
 }
 
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+red_black_tree<tkey, tvalue, compare, order_statistics> red_black_tree<tkey, tvalue, compare, order_statistics>::join(red_black_tree&& left, value_type middle, red_black_tree&& right)
+{
+    left.join_trees(std::move(middle), right);
+    return std::move(left);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+std::pair<red_black_tree<tkey, tvalue, compare, order_statistics>, red_black_tree<tkey, tvalue, compare, order_statistics>> red_black_tree<tkey, tvalue, compare, order_statistics>::split(red_black_tree&& tree, const tkey& key)
+{
+    // Опустевший tree получает большую часть
+    red_black_tree less(std::move(tree));
+    less.split_trees(key, tree);
+    return {std::move(less), std::move(tree)};
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+void red_black_tree<tkey, tvalue, compare, order_statistics>::union_with(red_black_tree&& other, work_stealing_pool* pool)
+{
+    this->merge_union(other, pool);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+void red_black_tree<tkey, tvalue, compare, order_statistics>::union_with(const red_black_tree& other, work_stealing_pool* pool)
+{
+    auto copy = this->clone_foreign(other);
+    this->merge_union(copy, pool);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+void red_black_tree<tkey, tvalue, compare, order_statistics>::intersect_with(const red_black_tree& other, work_stealing_pool* pool)
+{
+    this->merge_intersection(other, pool);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+void red_black_tree<tkey, tvalue, compare, order_statistics>::difference(const red_black_tree& other, work_stealing_pool* pool)
+{
+    this->merge_difference(other, pool);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+template<std::ranges::input_range R>
+void red_black_tree<tkey, tvalue, compare, order_statistics>::insert_range(R&& rg)
+{
+    this->bulk_insert(std::forward<R>(rg), nullptr);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+template<std::ranges::input_range R>
+void red_black_tree<tkey, tvalue, compare, order_statistics>::insert_range(R&& rg, work_stealing_pool* pool)
+{
+    this->bulk_insert(std::forward<R>(rg), pool);
+}
+
 #endif //MATH_PRACTICE_AND_OPERATING_SYSTEMS_RED_BLACK_TREE_H
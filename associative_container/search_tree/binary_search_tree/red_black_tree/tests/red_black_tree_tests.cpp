@@ -4,6 +4,7 @@
 #include <client_logger_builder.h>
 #include <iostream>
 #include <map>
+#include <string_view>
 
 
 logger *create_logger(
@@ -628,6 +629,297 @@ TEST(redBlackTreePositiveTests, test17)
 }
 
 
+TEST(redBlackTreePositiveTests, test18)
+{
+    std::unique_ptr<logger> logger(create_logger(std::vector<std::pair<std::string, logger::severity>>
+                                                         {
+                                                                 {
+                                                                         "red_black_tree_tests_logs.txt",
+                                                                         logger::severity::trace
+                                                                 },
+                                                         }));
+    
+    logger->trace("redBlackTreePositiveTests.test18 started");
+
+    auto rb1 = std::make_unique<red_black_tree<int, std::string>>(std::less<int>(), nullptr, logger.get());
+    
+    rb1->emplace(6, "l");
+    rb1->emplace(8, "c");
+    rb1->emplace(15, "l");
+    rb1->emplace(11, "o");
+    rb1->emplace(9, "h");
+    rb1->emplace(2, "e");
+    rb1->emplace(4, "b");
+    rb1->emplace(18, "e");
+    
+    std::vector<test_data<int, std::string>> expected_result =
+        {
+                test_data<int, std::string>(0, 8, "c", red_black_tree<int, std::string>::node_color::BLACK),
+                test_data<int, std::string>(1, 4, "b", red_black_tree<int, std::string>::node_color::BLACK),
+                test_data<int, std::string>(2, 2, "e", red_black_tree<int, std::string>::node_color::RED),
+                test_data<int, std::string>(2, 6, "l", red_black_tree<int, std::string>::node_color::RED),
+                test_data<int, std::string>(1, 11, "o", red_black_tree<int, std::string>::node_color::RED),
+                test_data<int, std::string>(2, 9, "h", red_black_tree<int, std::string>::node_color::BLACK),
+                test_data<int, std::string>(2, 15, "l", red_black_tree<int, std::string>::node_color::BLACK),
+                test_data<int, std::string>(3, 18, "e", red_black_tree<int, std::string>::node_color::RED)
+        };
+    
+    red_black_tree<int, std::string> rb2(*rb1);
+    
+    EXPECT_TRUE(prefix_iterator_test(rb2, expected_result));
+    EXPECT_EQ(rb2.size(), 8);
+    
+    rb2.erase(15);
+    rb2.at(8) = "x";
+    
+    EXPECT_TRUE(prefix_iterator_test(*rb1, expected_result));
+    
+    red_black_tree<int, std::string> rb3(std::less<int>(), nullptr, logger.get());
+    rb3.emplace(1, "a");
+    rb3 = *rb1;
+    rb1.reset();
+    
+    EXPECT_TRUE(prefix_iterator_test(rb3, expected_result));
+    EXPECT_EQ(rb3.size(), 8);
+    
+    logger->trace("redBlackTreePositiveTests.test18 finished");
+}
+
+TEST(redBlackTreePositiveTests, test19)
+{
+    std::unique_ptr<logger> logger(create_logger(std::vector<std::pair<std::string, logger::severity>>
+                                                         {
+                                                                 {
+                                                                         "red_black_tree_tests_logs.txt",
+                                                                         logger::severity::trace
+                                                                 },
+                                                         }));
+    
+    logger->trace("redBlackTreePositiveTests.test19 started");
+
+    std::vector<std::pair<int, std::string>> sorted =
+        {
+            { 1, "a" },
+            { 2, "b" },
+            { 3, "c" },
+            { 4, "d" },
+            { 5, "e" },
+            { 6, "f" }
+        };
+
+    red_black_tree<int, std::string> rb(sorted_unique, sorted, std::less<int>(), nullptr, logger.get());
+    
+    std::vector<test_data<int, std::string>> expected_result =
+        {
+                test_data<int, std::string>(0, 4, "d", red_black_tree<int, std::string>::node_color::BLACK),
+                test_data<int, std::string>(1, 2, "b", red_black_tree<int, std::string>::node_color::BLACK),
+                test_data<int, std::string>(2, 1, "a", red_black_tree<int, std::string>::node_color::RED),
+                test_data<int, std::string>(2, 3, "c", red_black_tree<int, std::string>::node_color::RED),
+                test_data<int, std::string>(1, 6, "f", red_black_tree<int, std::string>::node_color::BLACK),
+                test_data<int, std::string>(2, 5, "e", red_black_tree<int, std::string>::node_color::RED)
+        };
+    
+    EXPECT_TRUE(prefix_iterator_test(rb, expected_result));
+    EXPECT_EQ(rb.size(), 6);
+    
+    rb.emplace(7, "g");
+    
+    std::vector<test_data<int, std::string>> expected_after_insert =
+        {
+                test_data<int, std::string>(0, 4, "d", red_black_tree<int, std::string>::node_color::BLACK),
+                test_data<int, std::string>(1, 2, "b", red_black_tree<int, std::string>::node_color::BLACK),
+                test_data<int, std::string>(2, 1, "a", red_black_tree<int, std::string>::node_color::RED),
+                test_data<int, std::string>(2, 3, "c", red_black_tree<int, std::string>::node_color::RED),
+                test_data<int, std::string>(1, 6, "f", red_black_tree<int, std::string>::node_color::BLACK),
+                test_data<int, std::string>(2, 5, "e", red_black_tree<int, std::string>::node_color::RED),
+                test_data<int, std::string>(2, 7, "g", red_black_tree<int, std::string>::node_color::RED)
+        };
+    
+    EXPECT_TRUE(prefix_iterator_test(rb, expected_after_insert));
+    
+    logger->trace("redBlackTreePositiveTests.test19 finished");
+}
+
+TEST(redBlackTreePositiveTests, test20)
+{
+    std::unique_ptr<logger> logger(create_logger(std::vector<std::pair<std::string, logger::severity>>
+                                                         {
+                                                                 {
+                                                                         "red_black_tree_tests_logs.txt",
+                                                                         logger::severity::trace
+                                                                 },
+                                                         }));
+    
+    logger->trace("redBlackTreePositiveTests.test20 started");
+
+    using tree = red_black_tree<std::string, int, std::less<>>;
+    tree rb(std::less<>(), nullptr, logger.get());
+    
+    EXPECT_TRUE(rb.try_emplace("a", 1).second);
+    EXPECT_TRUE(rb.try_emplace("b", 2).second);
+    EXPECT_TRUE(rb.try_emplace("c", 3).second);
+    EXPECT_FALSE(rb.try_emplace("b", 20).second);
+    EXPECT_EQ(rb.size(), 3);
+    
+    std::string_view a = "a", b = "b", c = "c";
+    EXPECT_EQ(rb.find(b)->second, 2);
+    EXPECT_EQ(rb.find(b).get_color(), tree::node_color::BLACK);
+    EXPECT_EQ(rb.find(a).get_color(), tree::node_color::RED);
+    EXPECT_EQ(rb.find(c).get_color(), tree::node_color::RED);
+    EXPECT_TRUE(rb.contains(c));
+    EXPECT_FALSE(rb.contains(std::string_view("d")));
+    EXPECT_EQ(rb.at(a), 1);
+    EXPECT_EQ(rb.lower_bound(std::string_view("bb"))->first, "c");
+    EXPECT_EQ(rb.upper_bound(a)->first, "b");
+    
+    logger->trace("redBlackTreePositiveTests.test20 finished");
+}
+
+TEST(redBlackTreePositiveTests, test21)
+{
+    std::unique_ptr<logger> logger(create_logger(std::vector<std::pair<std::string, logger::severity>>
+                                                         {
+                                                                 {
+                                                                         "red_black_tree_tests_logs.txt",
+                                                                         logger::severity::trace
+                                                                 },
+                                                         }));
+    
+    logger->trace("redBlackTreePositiveTests.test21 started");
+
+    red_black_tree<int, std::string> rb(std::less<int>(), nullptr, logger.get());
+    
+    auto hint = rb.end();
+    for (int key = 1; key <= 7; ++key)
+    {
+        hint = rb.insert(hint, std::make_pair(key, std::string(1, static_cast<char>('a' + key - 1))));
+    }
+    
+    std::vector<test_data<int, std::string>> expected_result =
+        {
+                test_data<int, std::string>(0, 2, "b", red_black_tree<int, std::string>::node_color::BLACK),
+                test_data<int, std::string>(1, 1, "a", red_black_tree<int, std::string>::node_color::BLACK),
+                test_data<int, std::string>(1, 4, "d", red_black_tree<int, std::string>::node_color::RED),
+                test_data<int, std::string>(2, 3, "c", red_black_tree<int, std::string>::node_color::BLACK),
+                test_data<int, std::string>(2, 6, "f", red_black_tree<int, std::string>::node_color::BLACK),
+                test_data<int, std::string>(3, 5, "e", red_black_tree<int, std::string>::node_color::RED),
+                test_data<int, std::string>(3, 7, "g", red_black_tree<int, std::string>::node_color::RED)
+        };
+    
+    EXPECT_TRUE(prefix_iterator_test(rb, expected_result));
+    EXPECT_EQ(rb.size(), 7);
+    
+    EXPECT_EQ(rb.insert(rb.find(1), std::make_pair(4, std::string("x")))->second, "d");
+    EXPECT_EQ(rb.lower_bound(rb.find(7), 0)->first, 1);
+    using node_color = red_black_tree<int, std::string>::node_color;
+    EXPECT_TRUE(rb.lower_bound(rb.find(1), 6).get_color() == node_color::BLACK);
+    
+    logger->trace("redBlackTreePositiveTests.test21 finished");
+}
+
+TEST(redBlackTreePositiveTests, test22)
+{
+    std::unique_ptr<logger> logger(create_logger(std::vector<std::pair<std::string, logger::severity>>
+                                                         {
+                                                                 {
+                                                                         "red_black_tree_tests_logs.txt",
+                                                                         logger::severity::trace
+                                                                 },
+                                                         }));
+    
+    logger->trace("redBlackTreePositiveTests.test22 started");
+
+    red_black_tree<int, int, std::less<int>, true> rb(std::less<int>(), nullptr, logger.get());
+    
+    for (int key = 1; key <= 100; ++key)
+    {
+        rb.emplace(key, key * 10);
+    }
+    for (int key = 2; key <= 100; key += 2)
+    {
+        rb.erase(key);
+    }
+    
+    EXPECT_EQ(rb.size(), 50);
+    for (size_t k = 0; k < rb.size(); ++k)
+    {
+        EXPECT_EQ(rb.select(k)->first, static_cast<int>(2 * k + 1));
+    }
+    EXPECT_EQ(rb.rank(50), 25);
+    EXPECT_EQ(rb.rank(51), 25);
+    EXPECT_EQ(rb.advance(rb.find(21), 10)->second, 410);
+    EXPECT_EQ(rb.advance(rb.find(21), -10)->first, 1);
+    EXPECT_EQ(rb.distance(rb.find(99), rb.find(1)), -49);
+    
+    red_black_tree<int, int, std::less<int>, true> copy(rb);
+    EXPECT_TRUE(copy.order_statistics());
+    EXPECT_FALSE((red_black_tree<int, int>::order_statistics()));
+    EXPECT_EQ(copy.select(49)->first, 99);
+    
+    logger->trace("redBlackTreePositiveTests.test22 finished");
+}
+
+TEST(redBlackTreePositiveTests, test23)
+{
+    std::unique_ptr<logger> logger(create_logger(std::vector<std::pair<std::string, logger::severity>>
+                                                         {
+                                                                 {
+                                                                         "red_black_tree_tests_logs.txt",
+                                                                         logger::severity::trace
+                                                                 },
+                                                         }));
+    
+    logger->trace("redBlackTreePositiveTests.test23 started");
+
+    // Операции над множествами принимают деревья одного типа
+    using counted_tree = red_black_tree<int, int, std::less<int>, true>;
+    counted_tree evens(std::less<int>(), nullptr, logger.get());
+    counted_tree threes(std::less<int>(), nullptr, logger.get());
+    for (int key = 0; key < 30000; key += 2)
+    {
+        evens.emplace(key, 2);
+    }
+    for (int key = 0; key < 30000; key += 3)
+    {
+        threes.emplace(key, 3);
+    }
+    work_stealing_pool pool(2);
+    
+    counted_tree both(evens);
+    both.intersect_with(threes, &pool);
+    EXPECT_EQ(both.size(), 5000);
+    EXPECT_EQ(both.select(4999)->first, 29994);
+    
+    counted_tree only(evens);
+    only.difference(threes, &pool);
+    EXPECT_EQ(only.size(), 10000);
+    EXPECT_EQ(only.rank(6), 2);
+    
+    evens.union_with(threes, &pool);
+    EXPECT_EQ(evens.size(), 20000);
+    EXPECT_EQ(threes.size(), 10000);
+    EXPECT_EQ(evens.at(6), 2);
+    EXPECT_EQ(evens.select(3)->first, 4);
+    
+    auto [less, greater] = counted_tree::split(std::move(evens), 15000);
+    EXPECT_EQ(less.size(), 10000);
+    EXPECT_EQ(greater.size(), 10000);
+    EXPECT_EQ(greater.select(0)->first, 15000);
+    
+    greater.erase(15000);
+    counted_tree joined = counted_tree::join(std::move(less), {15000, 7}, std::move(greater));
+    EXPECT_EQ(joined.size(), 20000);
+    EXPECT_EQ(joined.select(10000)->second, 7);
+    
+    joined.insert_range(std::vector<std::pair<int, int>>{{1, 100}, {30001, 1}, {30001, 2}, {6, 100}});
+    EXPECT_EQ(joined.size(), 20002);
+    EXPECT_EQ(joined.at(30001), 1);
+    EXPECT_EQ(joined.at(6), 2);
+    EXPECT_EQ(joined.rank(30001), 20001);
+    
+    logger->trace("redBlackTreePositiveTests.test23 finished");
+}
+
 int main(
     int argc,
     char **argv)
@@ -3,18 +3,31 @@
 
 #include <binary_search_tree.h>
 #include <iterator>
+#include <stdexcept>
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+class scapegoat_tree;
 
 namespace __detail
 {
     class SPG_TAG;
 
+    // Размеры поддеревьев нужны для поиска разбалансированного узла, поэтому узлы дерева козла отпущения хранят их всегда
+    template<>
+    constexpr bool keeps_subtree_sizes<SPG_TAG> = true;
+
     template<typename tkey, typename tvalue, typename compare>
     class bst_impl<tkey, tvalue, compare, SPG_TAG>
     {
+        friend class binary_search_tree<tkey, tvalue, compare, SPG_TAG>;
+        friend class scapegoat_tree<tkey, tvalue, compare>;
         template<class ...Args>
         static binary_search_tree<tkey, tvalue, compare, SPG_TAG>::node* create_node(binary_search_tree<tkey, tvalue, compare, SPG_TAG>& cont, Args&& ...args);
 
-        static void delete_node(binary_search_tree<tkey, tvalue, compare, SPG_TAG>& cont);
+        static void delete_node(binary_search_tree<tkey, tvalue, compare, SPG_TAG>& cont, binary_search_tree<tkey, tvalue, compare, SPG_TAG>::node**);
+
+        // New unlinked node with the value and metadata of source, child of parent
+        static binary_search_tree<tkey, tvalue, compare, SPG_TAG>::node* clone_node(binary_search_tree<tkey, tvalue, compare, SPG_TAG>& cont, const binary_search_tree<tkey, tvalue, compare, SPG_TAG>::node* source, binary_search_tree<tkey, tvalue, compare, SPG_TAG>::node* parent);
 
         //Does not invalidate node*, needed for splay tree
         static void post_search(binary_search_tree<tkey, tvalue, compare, SPG_TAG>::node**){}
@@ -22,9 +35,24 @@ namespace __detail
         //Does not invalidate node*
         static void post_insert(binary_search_tree<tkey, tvalue, compare, SPG_TAG>& cont, binary_search_tree<tkey, tvalue, compare, SPG_TAG>::node**);
 
+        // Metadata of a node of a tree built from sorted data, called once both subtrees are linked;
+        // subtree sizes are already set by the build
+        static void post_build(binary_search_tree<tkey, tvalue, compare, SPG_TAG>::node*, size_t, size_t){}
+
         static void erase(binary_search_tree<tkey, tvalue, compare, SPG_TAG>& cont, binary_search_tree<tkey, tvalue, compare, SPG_TAG>::node**);
 
         static void swap(binary_search_tree<tkey, tvalue, compare, SPG_TAG>& lhs, binary_search_tree<tkey, tvalue, compare, SPG_TAG>& rhs) noexcept;
+
+        // Rebuilds the highest alpha-unbalanced node on the way from node to the root, if any
+        static void rebalance(binary_search_tree<tkey, tvalue, compare, SPG_TAG>& cont, binary_search_tree<tkey, tvalue, compare, SPG_TAG>::node* node);
+
+        // Perfectly balances the subtree of node in place: the subtree is flattened into a right vine by rotations,
+        // then the vine nodes are relinked in key order into the shape of a tree built from sorted data.
+        // Allocates nothing; the relinking recurses O(log n) deep
+        static void rebuild(binary_search_tree<tkey, tvalue, compare, SPG_TAG>& cont, binary_search_tree<tkey, tvalue, compare, SPG_TAG>::node* node);
+
+        // Balanced subtree of the first count nodes of the vine, vine is moved past them
+        static binary_search_tree<tkey, tvalue, compare, SPG_TAG>::node* build_from_vine(binary_search_tree<tkey, tvalue, compare, SPG_TAG>::node*& vine, size_t count) noexcept;
     };
 }
 
@@ -36,21 +64,19 @@ class scapegoat_tree final:
 private:
 
     using parent = binary_search_tree<tkey, tvalue, compare, __detail::SPG_TAG>;
-    
+    friend class __detail::bst_impl<tkey, tvalue, compare, __detail::SPG_TAG>;
+
+    /** Subtree sizes live in the base node: a scapegoat tree always keeps order statistics on
+     */
     struct node final:
         parent::node
     {
-        size_t size;
-
-        node(tkey const &key_, tvalue &&value_);
-        node(tkey const &key_, const tvalue& value_);
-
         template<class ...Args>
         node(parent::node* par, Args&&... args);
 
-        void recalculate_size() noexcept;
+        /** A child holds more than alpha of the subtree. O(1)
+         */
         bool is_disbalanced(double alpha) noexcept;
-        
     };
 
 public:
@@ -82,20 +108,34 @@ public:
             pp_allocator<value_type> alloc = pp_allocator<value_type>(),
             logger* log = nullptr, double alpha = 0.7);
 
+    template<input_iterator_for_pair<tkey, tvalue> iterator>
+    scapegoat_tree(sorted_unique_t, iterator begin, iterator end, const compare& cmp = compare(),
+            pp_allocator<value_type> alloc = pp_allocator<value_type>(),
+            logger* log = nullptr, double alpha = 0.7);
+
+    template<std::ranges::input_range Range>
+    scapegoat_tree(sorted_unique_t, Range&& range, const compare& cmp = compare(),
+            pp_allocator<value_type> alloc = pp_allocator<value_type>(),
+            logger* log = nullptr, double alpha = 0.7);
+
 public:
-    
-    ~scapegoat_tree() noexcept final;
-    
+
+    ~scapegoat_tree() noexcept final = default;
+
     scapegoat_tree(scapegoat_tree const &other);
-    
+
     scapegoat_tree &operator=(scapegoat_tree const &other);
-    
-    scapegoat_tree(scapegoat_tree &&other) noexcept;
-    
-    scapegoat_tree &operator=(scapegoat_tree &&other) noexcept;
+
+    scapegoat_tree(scapegoat_tree &&other) noexcept = default;
+
+    scapegoat_tree &operator=(scapegoat_tree &&other) noexcept = default;
 
 public:
-    
+
+    /** Balance factor in [0.5, 1): after an insertion or an erasure the highest node on its path whose child holds
+     *  more than alpha of the subtree is rebuilt. Smaller alpha keeps the tree lower at the cost of more rebuilds.
+     *  Takes effect from the next insertion or erasure, the current shape is left as it is
+     */
     void setup_alpha(double alpha);
 
 private:
@@ -118,37 +158,30 @@ scapegoat_tree(std::initializer_list<std::pair<tkey, tvalue>> data, const compar
         pp_allocator<U> alloc = pp_allocator<U>(),
         logger* log = nullptr, double alpha = 0.7) -> scapegoat_tree<tkey, tvalue, compare>;
 
-// region implementation
+template<typename compare, typename U, typename iterator>
+scapegoat_tree(sorted_unique_t, iterator begin, iterator end, const compare& cmp = compare(),
+        pp_allocator<U> alloc = pp_allocator<U>(),
+        logger* log = nullptr, double alpha = 0.7) -> scapegoat_tree<const typename std::iterator_traits<iterator>::value_type::first_type, typename std::iterator_traits<iterator>::value_type::second_type, compare>;
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-scapegoat_tree<tkey, tvalue, compare>::node::node(tkey const &key_, tvalue &&value_)
-{
-    throw not_implemented("template<typename tkey, typename tvalue, compator<tkey> compare> scapegoat_tree<tkey, tvalue, compare>::node::node(tkey const &key_, tvalue &&value_)", "your code should be here...");
-}
+template<typename compare, typename U, std::ranges::forward_range Range>
+scapegoat_tree(sorted_unique_t, Range&& range, const compare& cmp = compare(),
+        pp_allocator<U> alloc = pp_allocator<U>(),
+        logger* log = nullptr, double alpha = 0.7) -> scapegoat_tree<const typename std::iterator_traits<typename std::ranges::iterator_t<Range>>::value_type::first_type, typename std::iterator_traits<typename std::ranges::iterator_t<Range>>::value_type::second_type, compare>;
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-scapegoat_tree<tkey, tvalue, compare>::node::node(tkey const &key_, const tvalue& value_)
-{
-    throw not_implemented("template<typename tkey, typename tvalue, compator<tkey> compare> scapegoat_tree<tkey, tvalue, compare>::node::node(tkey const &key_, const tvalue& value_)", "your code should be here...");
-}
+// region implementation
 
 template<typename tkey, typename tvalue, compator<tkey> compare>
 template<class ...Args>
-scapegoat_tree<tkey, tvalue, compare>::node::node(parent::node* par, Args&&... args)
-{
-    throw not_implemented("template<typename tkey, typename tvalue, compator<tkey> compare> template<class ...Args> scapegoat_tree<tkey, tvalue, compare>::node::node(parent::node* par, Args&&... args)", "your code should be here...");
-}
-
-template<typename tkey, typename tvalue, compator<tkey> compare>
-void scapegoat_tree<tkey, tvalue, compare>::node::recalculate_size() noexcept
+scapegoat_tree<tkey, tvalue, compare>::node::node(parent::node* par, Args&&... args) : parent::node(par, std::forward<Args>(args)...)
 {
-    throw not_implemented("template<typename tkey, typename tvalue, compator<tkey> compare> void scapegoat_tree<tkey, tvalue, compare>::node::recalculate_size() noexcept ", "your code should be here...");
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare>
 bool scapegoat_tree<tkey, tvalue, compare>::node::is_disbalanced(double alpha) noexcept
 {
-    throw not_implemented("template<typename tkey, typename tvalue, compator<tkey> compare> bool scapegoat_tree<tkey, tvalue, compare>::node::is_disbalanced(double alpha) noexcept ", "your code should be here...");
+    const double limit = alpha * static_cast<double>(this->subtree_size);
+    return (this->left_subtree != nullptr && static_cast<double>(this->left_subtree->subtree_size) > limit)
+           || (this->right_subtree != nullptr && static_cast<double>(this->right_subtree->subtree_size) > limit);
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare>
@@ -156,9 +189,9 @@ scapegoat_tree<tkey, tvalue, compare>::scapegoat_tree(
         const compare& comp,
         pp_allocator<value_type> alloc,
         logger *log,
-        double alpha)
+        double alpha) : parent(comp, alloc, log)
 {
-    throw not_implemented("emplate<typename tkey, typename tvalue, compator<tkey> compare> scapegoat_tree<tkey, tvalue, compare>::scapegoat_tree(const compare& comp, pp_allocator<value_type> alloc, logger *log, double alpha)", "your code should be here...");
+    setup_alpha(alpha);
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare>
@@ -166,11 +199,13 @@ scapegoat_tree<tkey, tvalue, compare>::scapegoat_tree(
         pp_allocator<value_type> alloc,
         const compare& comp,
         logger *log,
-        double alpha)
+        double alpha) : parent(alloc, comp, log)
 {
-    throw not_implemented("template<typename tkey, typename tvalue, compator<tkey> compare> scapegoat_tree<tkey, tvalue, compare>::scapegoat_tree(pp_allocator<value_type> alloc, const compare& comp, logger *log, double alpha)", "your code should be here...");
+    setup_alpha(alpha);
 }
 
+// Элементы вставляются уже в теле: post_insert читает _alpha, которого у базы ещё нет
+
 template<typename tkey, typename tvalue, compator<tkey> compare>
 template<input_iterator_for_pair<tkey, tvalue> iterator>
 scapegoat_tree<tkey, tvalue, compare>::scapegoat_tree(
@@ -179,9 +214,17 @@ scapegoat_tree<tkey, tvalue, compare>::scapegoat_tree(
         const compare& cmp,
         pp_allocator<value_type> alloc,
         logger* log,
-        double alpha)
+        double alpha) : parent(cmp, alloc, log)
 {
-    throw not_implemented("template<typename tkey, typename tvalue, compator<tkey> compare> template<input_iterator_for_pair<tkey, tvalue> iterator> scapegoat_tree<tkey, tvalue, compare>::scapegoat_tree(iterator begin, iterator end, const compare& cmp, pp_allocator<value_type> alloc, logger* log,double alpha)", "your code should be here...");
+    setup_alpha(alpha);
+    if (this->try_assign_sorted(std::ranges::subrange(begin, end)))
+    {
+        return;
+    }
+    for (auto it = begin; it != end; ++it)
+    {
+        this->emplace(it->first, it->second);
+    }
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare>
@@ -191,9 +234,17 @@ scapegoat_tree<tkey, tvalue, compare>::scapegoat_tree(
         const compare& cmp,
         pp_allocator<value_type> alloc,
         logger* log,
-        double alpha)
+        double alpha) : parent(cmp, alloc, log)
 {
-    throw not_implemented("template<typename tkey, typename tvalue, compator<tkey> compare> template<std::ranges::input_range Range>scapegoat_tree<tkey, tvalue, compare>::scapegoat_tree(Range&& range, const compare& cmp, pp_allocator<value_type> alloc, logger* log, double alpha)", "your code should be here...");
+    setup_alpha(alpha);
+    if (this->try_assign_sorted(range))
+    {
+        return;
+    }
+    for (auto &&element : range)
+    {
+        this->emplace(std::forward<decltype(element)>(element));
+    }
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare>
@@ -202,47 +253,283 @@ scapegoat_tree<tkey, tvalue, compare>::scapegoat_tree(
         const compare& cmp,
         pp_allocator<value_type> alloc,
         logger* log,
-        double alpha)
+        double alpha) : parent(cmp, alloc, log)
 {
-    throw not_implemented("template<typename tkey, typename tvalue, compator<tkey> compare> scapegoat_tree<tkey, tvalue, compare>::scapegoat_tree(std::initializer_list<std::pair<tkey, tvalue>> data, const compare& cmp, pp_allocator<value_type> alloc, logger* log, double alpha)", "your code should be here...");
+    setup_alpha(alpha);
+    if (this->try_assign_sorted(data))
+    {
+        return;
+    }
+    for (const auto &element : data)
+    {
+        this->emplace(element.first, element.second);
+    }
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare>
-scapegoat_tree<tkey, tvalue, compare>::~scapegoat_tree() noexcept
+template<input_iterator_for_pair<tkey, tvalue> iterator>
+scapegoat_tree<tkey, tvalue, compare>::scapegoat_tree(
+        sorted_unique_t tag,
+        iterator begin,
+        iterator end,
+        const compare& cmp,
+        pp_allocator<value_type> alloc,
+        logger* log,
+        double alpha) : parent(tag, begin, end, cmp, alloc, log)
 {
-    throw not_implemented("template<typename tkey, typename tvalue, compator<tkey> compare> scapegoat_tree<tkey, tvalue, compare>::~scapegoat_tree() noexcept", "your code should be here...");
+    setup_alpha(alpha);
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare>
-scapegoat_tree<tkey, tvalue, compare>::scapegoat_tree(scapegoat_tree const &other)
+template<std::ranges::input_range Range>
+scapegoat_tree<tkey, tvalue, compare>::scapegoat_tree(
+        sorted_unique_t tag,
+        Range&& range,
+        const compare& cmp,
+        pp_allocator<value_type> alloc,
+        logger* log,
+        double alpha) : parent(tag, std::forward<Range>(range), cmp, alloc, log)
 {
-    throw not_implemented("template<typename tkey, typename tvalue, compator<tkey> compare> scapegoat_tree<tkey, tvalue, compare>::scapegoat_tree(scapegoat_tree const &other)", "your code should be here...");
+    setup_alpha(alpha);
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare>
-scapegoat_tree<tkey, tvalue, compare> &scapegoat_tree<tkey, tvalue, compare>::operator=(scapegoat_tree const &other)
+scapegoat_tree<tkey, tvalue, compare>::scapegoat_tree(scapegoat_tree const &other) : parent(other), _alpha(other._alpha)
 {
-    throw not_implemented("template<typename tkey, typename tvalue, compator<tkey> compare> scapegoat_tree<tkey, tvalue, compare> &scapegoat_tree<tkey, tvalue, compare>::operator=(scapegoat_tree const &other) ", "your code should be here...");
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare>
-scapegoat_tree<tkey, tvalue, compare>::scapegoat_tree(scapegoat_tree &&other) noexcept
+scapegoat_tree<tkey, tvalue, compare> &scapegoat_tree<tkey, tvalue, compare>::operator=(scapegoat_tree const &other)
 {
-    throw not_implemented("template<typename tkey, typename tvalue, compator<tkey> compare> scapegoat_tree<tkey, tvalue, compare>::scapegoat_tree(scapegoat_tree &&other) noexcept", "your code should be here...");
+    if (this != &other) {
+        parent::operator=(other);
+        _alpha = other._alpha;
+    }
+    return *this;
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare>
-scapegoat_tree<tkey, tvalue, compare> &scapegoat_tree<tkey, tvalue, compare>::operator=(scapegoat_tree &&other) noexcept
+void scapegoat_tree<tkey, tvalue, compare>::setup_alpha(double alpha)
 {
-    throw not_implemented("template<typename tkey, typename tvalue, compator<tkey> compare> scapegoat_tree<tkey, tvalue, compare> &scapegoat_tree<tkey, tvalue, compare>::operator=(scapegoat_tree &&other) noexcept", "your code should be here...");
+    if (!(alpha >= 0.5 && alpha < 1.0))
+    {
+        throw std::invalid_argument("Scapegoat alpha must lie in [0.5, 1)");
+    }
+    _alpha = alpha;
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-void scapegoat_tree<tkey, tvalue, compare>::setup_alpha(double alpha)
+namespace __detail
 {
-    throw not_implemented("template<typename tkey, typename tvalue, compator<tkey> compare> void scapegoat_tree<tkey, tvalue, compare>::setup_alpha(double alpha)", "your code should be here...");
+    template<typename tkey, typename tvalue, typename compare>
+    template<class ...Args>
+    typename binary_search_tree<tkey, tvalue, compare, SPG_TAG>::node* bst_impl<tkey, tvalue, compare, SPG_TAG>::create_node(
+            binary_search_tree<tkey, tvalue, compare, SPG_TAG>& cont, Args&& ...args)
+    {
+        using node_type = typename scapegoat_tree<tkey, tvalue, compare>::node;
+        return cont._allocator.template new_object<node_type>(std::forward<Args>(args)...);
+    }
+
+    template<typename tkey, typename tvalue, typename compare>
+    void bst_impl<tkey, tvalue, compare, SPG_TAG>::delete_node(
+            binary_search_tree<tkey, tvalue, compare, SPG_TAG>& cont, binary_search_tree<tkey, tvalue, compare, SPG_TAG>::node** node)
+    {
+        using node_type = typename scapegoat_tree<tkey, tvalue, compare>::node;
+        if (node && *node)
+        {
+            cont._allocator.template delete_object<node_type>(static_cast<node_type*>(*node));
+            *node = nullptr;
+        }
+    }
+
+    template<typename tkey, typename tvalue, typename compare>
+    typename binary_search_tree<tkey, tvalue, compare, SPG_TAG>::node* bst_impl<tkey, tvalue, compare, SPG_TAG>::clone_node(
+            binary_search_tree<tkey, tvalue, compare, SPG_TAG>& cont, const binary_search_tree<tkey, tvalue, compare, SPG_TAG>::node* source, binary_search_tree<tkey, tvalue, compare, SPG_TAG>::node* parent)
+    {
+        return create_node(cont, parent, source->data);
+    }
+
+    template<typename tkey, typename tvalue, typename compare>
+    void bst_impl<tkey, tvalue, compare, SPG_TAG>::post_insert(
+            binary_search_tree<tkey, tvalue, compare, SPG_TAG>& cont, binary_search_tree<tkey, tvalue, compare, SPG_TAG>::node** node)
+    {
+        // Новый лист сбалансирован сам, нарушиться могли только его предки
+        rebalance(cont, (*node)->parent);
+    }
+
+    template<typename tkey, typename tvalue, typename compare>
+    void bst_impl<tkey, tvalue, compare, SPG_TAG>::erase(
+            binary_search_tree<tkey, tvalue, compare, SPG_TAG>& cont, binary_search_tree<tkey, tvalue, compare, SPG_TAG>::node** node_ptr)
+    {
+        using node_type = typename binary_search_tree<tkey, tvalue, compare, SPG_TAG>::node;
+
+        if (node_ptr == nullptr || *node_ptr == nullptr) return;
+
+        node_type *node = *node_ptr;
+        node_type *parent = node->parent;
+        // Самый нижний узел, чьё поддерево потеряло элемент
+        node_type *rebalance_start = parent;
+
+        if (node->left_subtree == nullptr || node->right_subtree == nullptr) {
+            node_type *child = node->left_subtree ? node->left_subtree : node->right_subtree;
+            cont.count_erase(node, nullptr);
+            if (child) {
+                child->parent = parent;
+            }
+
+            if (parent) {
+                if (parent->left_subtree == node) parent->left_subtree = child;
+                else parent->right_subtree = child;
+            } else {
+                cont._root = child;
+            }
+        } else {
+            node_type *predecessor = node->left_subtree;
+            while (predecessor->right_subtree) {
+                predecessor = predecessor->right_subtree;
+            }
+
+            cont.count_erase(node, predecessor);
+            rebalance_start = predecessor;
+
+            if (predecessor->parent != node) {
+                rebalance_start = predecessor->parent;
+                predecessor->parent->right_subtree = predecessor->left_subtree;
+                if (predecessor->left_subtree) {
+                    predecessor->left_subtree->parent = predecessor->parent;
+                }
+                predecessor->left_subtree = node->left_subtree;
+                predecessor->left_subtree->parent = predecessor;
+            }
+
+            predecessor->right_subtree = node->right_subtree;
+            predecessor->right_subtree->parent = predecessor;
+            predecessor->parent = parent;
+
+            if (parent) {
+                if (parent->left_subtree == node) parent->left_subtree = predecessor;
+                else parent->right_subtree = predecessor;
+            } else {
+                cont._root = predecessor;
+            }
+        }
+
+        delete_node(cont, node_ptr);
+        --cont._size;
+        rebalance(cont, rebalance_start);
+    }
+
+    template<typename tkey, typename tvalue, typename compare>
+    void bst_impl<tkey, tvalue, compare, SPG_TAG>::swap(binary_search_tree<tkey, tvalue, compare, SPG_TAG>& lhs, binary_search_tree<tkey, tvalue, compare, SPG_TAG>& rhs) noexcept
+    {
+        using std::swap;
+        swap(lhs._root, rhs._root);
+        swap(lhs._logger, rhs._logger);
+        swap(lhs._size, rhs._size);
+        swap(lhs._allocator, rhs._allocator);
+    }
+
+    template<typename tkey, typename tvalue, typename compare>
+    void bst_impl<tkey, tvalue, compare, SPG_TAG>::rebalance(
+            binary_search_tree<tkey, tvalue, compare, SPG_TAG>& cont, binary_search_tree<tkey, tvalue, compare, SPG_TAG>::node* node)
+    {
+        using node_type = typename binary_search_tree<tkey, tvalue, compare, SPG_TAG>::node;
+        using scapegoat_node = typename scapegoat_tree<tkey, tvalue, compare>::node;
+
+        const double alpha = static_cast<scapegoat_tree<tkey, tvalue, compare>&>(cont)._alpha;
+
+        // Перестраивается самый высокий разбалансированный узел: его перестройка покрывает все нижние
+        node_type *scapegoat = nullptr;
+        for (node_type *current = node; current != nullptr; current = current->parent)
+        {
+            if (static_cast<scapegoat_node*>(current)->is_disbalanced(alpha))
+            {
+                scapegoat = current;
+            }
+        }
+
+        if (scapegoat != nullptr)
+        {
+            rebuild(cont, scapegoat);
+        }
+    }
+
+    template<typename tkey, typename tvalue, typename compare>
+    void bst_impl<tkey, tvalue, compare, SPG_TAG>::rebuild(
+            binary_search_tree<tkey, tvalue, compare, SPG_TAG>& cont, binary_search_tree<tkey, tvalue, compare, SPG_TAG>::node* node)
+    {
+        using node_type = typename binary_search_tree<tkey, tvalue, compare, SPG_TAG>::node;
+
+        node_type *above = node->parent;
+        const bool is_left = above != nullptr && above->left_subtree == node;
+        const size_t count = node->subtree_size;
+
+        // Правыми поворотами поддерево вытягивается в цепочку по правым ссылкам; повороты сами
+        // переподвешивают её к above (или к корню) и поддерживают размеры
+        node_type *current = node;
+        while (current != nullptr)
+        {
+            if (current->left_subtree != nullptr)
+            {
+                cont.small_right_rotation(current);
+            }
+            else
+            {
+                current = current->right_subtree;
+            }
+        }
+
+        node_type *vine = above == nullptr ? cont._root : (is_left ? above->left_subtree : above->right_subtree);
+        node_type *built = build_from_vine(vine, count);
+        built->parent = above;
+
+        if (above == nullptr)
+        {
+            cont._root = built;
+        }
+        else if (is_left)
+        {
+            above->left_subtree = built;
+        }
+        else
+        {
+            above->right_subtree = built;
+        }
+    }
+
+    template<typename tkey, typename tvalue, typename compare>
+    typename binary_search_tree<tkey, tvalue, compare, SPG_TAG>::node* bst_impl<tkey, tvalue, compare, SPG_TAG>::build_from_vine(
+            binary_search_tree<tkey, tvalue, compare, SPG_TAG>::node*& vine, size_t count) noexcept
+    {
+        using node_type = typename binary_search_tree<tkey, tvalue, compare, SPG_TAG>::node;
+
+        if (count == 0)
+        {
+            return nullptr;
+        }
+
+        // Та же форма, что у build_sorted: левое поддерево не меньше правого
+        node_type *left = build_from_vine(vine, count / 2);
+        node_type *root = vine;
+        vine = vine->right_subtree;
+
+        root->left_subtree = left;
+        if (left != nullptr)
+        {
+            left->parent = root;
+        }
+
+        node_type *right = build_from_vine(vine, count - count / 2 - 1);
+        root->right_subtree = right;
+        if (right != nullptr)
+        {
+            right->parent = root;
+        }
+
+        root->subtree_size = count;
+        return root;
+    }
 }
 
 // endregion implementation
 
-#endif //MATH_PRACTICE_AND_OPERATING_SYSTEMS_SCAPEGOAT_TREE_H
\ No newline at end of file
+#endif //MATH_PRACTICE_AND_OPERATING_SYSTEMS_SCAPEGOAT_TREE_H
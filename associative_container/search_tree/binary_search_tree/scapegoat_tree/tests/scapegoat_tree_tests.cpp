@@ -3,6 +3,7 @@
 #include <logger_builder.h>
 #include <client_logger_builder.h>
 #include <iostream>
+#include <cmath>
 
 
 logger *create_logger(
@@ -40,14 +41,14 @@ bool compare_results(
         return false;
     }
 
-    for (auto&& val : std::views::zip(expected, actual))
+    for (size_t i = 0; i < expected.size(); ++i)
     {
-        if (std::get<0>(val).first != std::get<1>(val).first)
+        if (expected[i].first != actual[i].first)
         {
             return false;
         }
 
-        if (std::get<0>(val).second != std::get<1>(val).second)
+        if (expected[i].second != actual[i].second)
         {
             return false;
         }
@@ -517,6 +518,57 @@ TEST(scapegoatTreePositiveTests, test10)
     logger->trace("scapegoatTreePositiveTests.test10 finished");
 }
 
+TEST(scapegoatTreePositiveTests, test11)
+{
+    std::unique_ptr<logger> logger(create_logger(std::vector<std::pair<std::string, logger::severity>>
+                                                         {
+                                                                 {
+                                                                         "scapegoat_tree_tests_logs.txt",
+                                                                         logger::severity::trace
+                                                                 },
+                                                         }));
+
+    logger->trace("scapegoatTreePositiveTests.test11 started");
+
+    scapegoat_tree<int, std::string> sg(std::less<int>(), nullptr, logger.get(), 0.6);
+
+    // Возрастающие ключи - худший случай для дерева без балансировки
+    const int count = 100000;
+    for (int i = 0; i < count; ++i)
+    {
+        sg.emplace(i, "x");
+    }
+
+    size_t height = 0;
+    for (auto it = sg.begin_infix(); it != sg.end_infix(); ++it)
+    {
+        height = std::max(height, it.depth());
+    }
+    EXPECT_LE(height, static_cast<size_t>(std::log(count) / std::log(1 / 0.6)) + 1);
+
+    EXPECT_THROW(sg.setup_alpha(0.4), std::invalid_argument);
+    EXPECT_THROW(sg.setup_alpha(1.0), std::invalid_argument);
+    sg.setup_alpha(0.9);
+
+    for (int i = 0; i < count; i += 2)
+    {
+        sg.erase(i);
+    }
+    EXPECT_EQ(sg.size(), count / 2);
+
+    int expected_key = 1;
+    height = 0;
+    for (auto it = sg.begin_infix(); it != sg.end_infix(); ++it)
+    {
+        EXPECT_EQ(it->first, expected_key);
+        expected_key += 2;
+        height = std::max(height, it.depth());
+    }
+    EXPECT_LE(height, static_cast<size_t>(std::log(count / 2) / std::log(1 / 0.9)) + 1);
+
+    logger->trace("scapegoatTreePositiveTests.test11 finished");
+}
+
 int main(
     int argc,
     char **argv)
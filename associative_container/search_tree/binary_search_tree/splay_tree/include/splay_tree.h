@@ -2,46 +2,79 @@
 #define MATH_PRACTICE_AND_OPERATING_SYSTEMS_SPLAY_TREE_H
 
 #include <binary_search_tree.h>
+#include <random>
+#include <stdexcept>
+
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+class splay_tree;
 
 namespace __detail
 {
+    template<bool order_statistics>
     class SPL_TAG;
 
-    template<typename tkey, typename tvalue, typename compare>
-    class bst_impl<tkey, tvalue, compare, SPL_TAG>
+    template<typename tkey, typename tvalue, typename compare, bool order_statistics>
+    class bst_impl<tkey, tvalue, compare, SPL_TAG<order_statistics>>
     {
-        friend class binary_search_tree<tkey, tvalue, compare, SPL_TAG>;
+        friend class binary_search_tree<tkey, tvalue, compare, SPL_TAG<order_statistics>>;
+        friend class splay_tree<tkey, tvalue, compare, order_statistics>;
         template<class ...Args>
-        static binary_search_tree<tkey, tvalue, compare, SPL_TAG>::node* create_node(binary_search_tree<tkey, tvalue, compare, SPL_TAG>& cont, Args&& ...args);
+        static binary_search_tree<tkey, tvalue, compare, SPL_TAG<order_statistics>>::node* create_node(binary_search_tree<tkey, tvalue, compare, SPL_TAG<order_statistics>>& cont, Args&& ...args);
+
+        static void delete_node(binary_search_tree<tkey, tvalue, compare, SPL_TAG<order_statistics>>& cont, binary_search_tree<tkey, tvalue, compare, SPL_TAG<order_statistics>>::node**);
 
-        static void delete_node(binary_search_tree<tkey, tvalue, compare, SPL_TAG>& cont, binary_search_tree<tkey, tvalue, compare, SPL_TAG>::node**);
+        // New unlinked node with the value and metadata of source, child of parent
+        static binary_search_tree<tkey, tvalue, compare, SPL_TAG<order_statistics>>::node* clone_node(binary_search_tree<tkey, tvalue, compare, SPL_TAG<order_statistics>>& cont, const binary_search_tree<tkey, tvalue, compare, SPL_TAG<order_statistics>>::node* source, binary_search_tree<tkey, tvalue, compare, SPL_TAG<order_statistics>>::node* parent);
 
         //Does not invalidate node*, needed for splay tree
-        static void post_search(binary_search_tree<tkey, tvalue, compare, SPL_TAG>& cont,
-                                binary_search_tree<tkey, tvalue, compare, SPL_TAG>::node**);
+        static void post_search(binary_search_tree<tkey, tvalue, compare, SPL_TAG<order_statistics>>& cont,
+                                binary_search_tree<tkey, tvalue, compare, SPL_TAG<order_statistics>>::node**);
 
         //Does not invalidate node*
-        static void post_insert(binary_search_tree<tkey, tvalue, compare, SPL_TAG>& cont, binary_search_tree<tkey, tvalue, compare, SPL_TAG>::node**);
+        static void post_insert(binary_search_tree<tkey, tvalue, compare, SPL_TAG<order_statistics>>& cont, binary_search_tree<tkey, tvalue, compare, SPL_TAG<order_statistics>>::node**);
+
+        // Metadata of a node of a tree built from sorted data, called once both subtrees are linked
+        static void post_build(binary_search_tree<tkey, tvalue, compare, SPL_TAG<order_statistics>>::node*, size_t, size_t){}
+
+        static void erase(binary_search_tree<tkey, tvalue, compare, SPL_TAG<order_statistics>>& cont, binary_search_tree<tkey, tvalue, compare, SPL_TAG<order_statistics>>::node**);
+
+        static void swap(binary_search_tree<tkey, tvalue, compare, SPL_TAG<order_statistics>>& lhs, binary_search_tree<tkey, tvalue, compare, SPL_TAG<order_statistics>>& rhs) noexcept;
+        static void splay(binary_search_tree<tkey, tvalue, compare, SPL_TAG<order_statistics>>& cont,
+                binary_search_tree<tkey, tvalue, compare, SPL_TAG<order_statistics>>::node**);
 
-        static void erase(binary_search_tree<tkey, tvalue, compare, SPL_TAG>& cont, binary_search_tree<tkey, tvalue, compare, SPL_TAG>::node**);
+        // Top-down splay by key in one pass from the root: the node with key, or the last node of the search path,
+        // becomes the root and is returned. Parent pointers and subtree sizes are set as nodes are relinked
+        static binary_search_tree<tkey, tvalue, compare, SPL_TAG<order_statistics>>::node* splay_top_down(binary_search_tree<tkey, tvalue, compare, SPL_TAG<order_statistics>>& cont, const tkey& key);
 
-        static void swap(binary_search_tree<tkey, tvalue, compare, SPL_TAG>& lhs, binary_search_tree<tkey, tvalue, compare, SPL_TAG>& rhs) noexcept;
-        static void splay(binary_search_tree<tkey, tvalue, compare, SPL_TAG>& cont,
-                binary_search_tree<tkey, tvalue, compare, SPL_TAG>::node**);
-        static void replace_node_in_parent(binary_search_tree<tkey, tvalue, compare, SPL_TAG>& cont, binary_search_tree<tkey, tvalue, compare, SPL_TAG>::node** , binary_search_tree<tkey, tvalue, compare, SPL_TAG>::node* );
+        // Semi-splay: a zig-zig rotates only at the grandparent and goes on from the parent, so the path to the node
+        // is roughly halved rather than the node being moved to the root
+        static void semi_splay(binary_search_tree<tkey, tvalue, compare, SPL_TAG<order_statistics>>& cont,
+                binary_search_tree<tkey, tvalue, compare, SPL_TAG<order_statistics>>::node**);
+        static void replace_node_in_parent(binary_search_tree<tkey, tvalue, compare, SPL_TAG<order_statistics>>& cont, binary_search_tree<tkey, tvalue, compare, SPL_TAG<order_statistics>>::node** , binary_search_tree<tkey, tvalue, compare, SPL_TAG<order_statistics>>::node* );
     };
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare = std::less<tkey>>
-class splay_tree final: public binary_search_tree<tkey, tvalue, compare, __detail::SPL_TAG>
+template<typename tkey, typename tvalue, compator<tkey> compare = std::less<tkey>, bool order_statistics = false>
+class splay_tree final: public binary_search_tree<tkey, tvalue, compare, __detail::SPL_TAG<order_statistics>>
 {
 
-    using parent = binary_search_tree<tkey, tvalue, compare, __detail::SPL_TAG>;
-    friend class __detail::bst_impl<tkey, tvalue, compare, __detail::SPL_TAG>;
+    using parent = binary_search_tree<tkey, tvalue, compare, __detail::SPL_TAG<order_statistics>>;
+    using node = typename parent::node;
+    friend class __detail::bst_impl<tkey, tvalue, compare, __detail::SPL_TAG<order_statistics>>;
 public:
 
     using value_type = parent::value_type;
 
+    /** How a lookup restructures the tree: full moves the found node to the root, semi only halves the path to it
+     *  (semi-splaying), none leaves the tree as it is. When the key is absent the last node of the search path is used
+     */
+    enum class splay_mode
+    {
+        none,
+        full,
+        semi
+    };
+
     explicit splay_tree(
             const compare& comp = compare(),
             pp_allocator<value_type> alloc = pp_allocator<value_type>(),
@@ -67,6 +100,16 @@ public:
             pp_allocator<value_type> alloc = pp_allocator<value_type>(),
             logger* logger = nullptr);
 
+    template<input_iterator_for_pair<tkey, tvalue> iterator>
+    splay_tree(sorted_unique_t, iterator begin, iterator end, const compare& cmp = compare(),
+            pp_allocator<value_type> alloc = pp_allocator<value_type>(),
+            logger* logger = nullptr);
+
+    template<std::ranges::input_range Range>
+    splay_tree(sorted_unique_t, Range&& range, const compare& cmp = compare(),
+            pp_allocator<value_type> alloc = pp_allocator<value_type>(),
+            logger* logger = nullptr);
+
 public:
 
     ~splay_tree() noexcept final = default;
@@ -79,6 +122,36 @@ public:
 
     splay_tree &operator=(splay_tree &&other) noexcept = default;
 
+public:
+
+    /** Lookup policy: find, contains and at of a non-const tree splay by mode, and only when the node lies deeper than
+     *  depth_threshold and then with the given probability. By default every lookup splays fully, top-down in a single pass;
+     *  a threshold or a probability below 1 makes lookups of hot keys near the root read-only.
+     *  Const lookups never restructure the tree, insertion and erasure always splay
+     */
+    void setup_splay(splay_mode mode, size_t depth_threshold = 0, double probability = 1.0);
+
+    using parent::find;
+    using parent::contains;
+    using parent::at;
+
+    typename parent::infix_iterator find(const tkey& key);
+
+    bool contains(const tkey& key);
+
+    tvalue& at(const tkey& key);
+
+private:
+
+    /** Node with key or nullptr, the tree is restructured by the lookup policy
+     */
+    node* splay_lookup(const tkey& key);
+
+    splay_mode _splay_mode = splay_mode::full;
+    size_t _splay_depth = 0;
+    std::bernoulli_distribution _splay_chance{1.0};
+    std::minstd_rand _splay_random;
+
 };
 
 template<typename compare, typename U, typename iterator>
@@ -96,94 +169,221 @@ splay_tree(std::initializer_list<std::pair<tkey, tvalue>> data, const compare& c
         pp_allocator<U> alloc = pp_allocator<U>(),
         logger* logger = nullptr) -> splay_tree<tkey, tvalue, compare>;
 
+template<typename compare, typename U, typename iterator>
+splay_tree(sorted_unique_t, iterator begin, iterator end, const compare& cmp = compare(),
+        pp_allocator<U> alloc = pp_allocator<U>(),
+        logger* logger = nullptr) -> splay_tree<const typename std::iterator_traits<iterator>::value_type::first_type, typename std::iterator_traits<iterator>::value_type::second_type, compare>;
+
+template<typename compare, typename U, std::ranges::forward_range Range>
+splay_tree(sorted_unique_t, Range&& range, const compare& cmp = compare(),
+        pp_allocator<U> alloc = pp_allocator<U>(),
+        logger* logger = nullptr) -> splay_tree<const typename std::iterator_traits<typename std::ranges::iterator_t<Range>>::value_type::first_type, typename std::iterator_traits<typename std::ranges::iterator_t<Range>>::value_type::second_type, compare>;
+
 // region implementation
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-splay_tree<tkey, tvalue, compare>::splay_tree(
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+splay_tree<tkey, tvalue, compare, order_statistics>::splay_tree(
         const compare& comp,
         pp_allocator<value_type> alloc,
         logger *logger) : parent(comp, alloc, logger)
 {
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-splay_tree<tkey, tvalue, compare>::splay_tree(
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+splay_tree<tkey, tvalue, compare, order_statistics>::splay_tree(
         pp_allocator<value_type> alloc,
         const compare& comp,
         logger *logger) : parent(alloc, comp, logger)
 {
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
 template<input_iterator_for_pair<tkey, tvalue> iterator>
-splay_tree<tkey, tvalue, compare>::splay_tree(
+splay_tree<tkey, tvalue, compare, order_statistics>::splay_tree(
         iterator begin,
         iterator end,
         const compare& cmp,
         pp_allocator<value_type> alloc,
-        logger* logger) : parent(cmp, alloc, logger)
+        logger* logger) : parent(begin, end, cmp, alloc, logger)
 {
-    for (auto it = begin; it != end; ++it)
-    {
-        this->emplace(*it);
-    }
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
 template<std::ranges::input_range Range>
-splay_tree<tkey, tvalue, compare>::splay_tree(
+splay_tree<tkey, tvalue, compare, order_statistics>::splay_tree(
         Range&& range,
         const compare& cmp,
         pp_allocator<value_type> alloc,
-        logger* logger) : parent(cmp, alloc, logger)
+        logger* logger) : parent(std::forward<Range>(range), cmp, alloc, logger)
 {
-    for (auto &&element : range)
-    {
-        emplace(std::forward<decltype(element)>(element));
-    }
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-splay_tree<tkey, tvalue, compare>::splay_tree(
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+splay_tree<tkey, tvalue, compare, order_statistics>::splay_tree(
         std::initializer_list<std::pair<tkey, tvalue>> data,
         const compare& cmp,
         pp_allocator<value_type> alloc,
-        logger* logger) : parent(cmp, alloc, logger)
+        logger* logger) : parent(data, cmp, alloc, logger)
 {
-    for (const auto &element : data)
-    {
-        emplace(element.first, element.second);
-    }
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-splay_tree<tkey, tvalue, compare>::splay_tree(splay_tree const &other) : parent(other)
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+template<input_iterator_for_pair<tkey, tvalue> iterator>
+splay_tree<tkey, tvalue, compare, order_statistics>::splay_tree(
+        sorted_unique_t tag,
+        iterator begin, iterator end,
+        const compare& cmp,
+        pp_allocator<value_type> alloc,
+        logger* logger) : parent(tag, begin, end, cmp, alloc, logger)
 {
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-splay_tree<tkey, tvalue, compare> &splay_tree<tkey, tvalue, compare>::operator=(splay_tree const &other)
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+template<std::ranges::input_range Range>
+splay_tree<tkey, tvalue, compare, order_statistics>::splay_tree(
+        sorted_unique_t tag,
+        Range&& range,
+        const compare& cmp,
+        pp_allocator<value_type> alloc,
+        logger* logger) : parent(tag, std::forward<Range>(range), cmp, alloc, logger)
+{
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+splay_tree<tkey, tvalue, compare, order_statistics>::splay_tree(splay_tree const &other) : parent(other),
+        _splay_mode(other._splay_mode), _splay_depth(other._splay_depth), _splay_chance(other._splay_chance)
+{
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+splay_tree<tkey, tvalue, compare, order_statistics> &splay_tree<tkey, tvalue, compare, order_statistics>::operator=(splay_tree const &other)
 {
     if (this != &other) {
         parent::operator=(other);
+        _splay_mode = other._splay_mode;
+        _splay_depth = other._splay_depth;
+        _splay_chance = other._splay_chance;
     }
     return *this;
 }
 
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+void splay_tree<tkey, tvalue, compare, order_statistics>::setup_splay(splay_mode mode, size_t depth_threshold, double probability)
+{
+    if (!(probability >= 0.0 && probability <= 1.0))
+    {
+        throw std::invalid_argument("Splay probability must lie in [0, 1]");
+    }
+    _splay_mode = mode;
+    _splay_depth = depth_threshold;
+    _splay_chance = std::bernoulli_distribution(probability);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+typename splay_tree<tkey, tvalue, compare, order_statistics>::node* splay_tree<tkey, tvalue, compare, order_statistics>::splay_lookup(const tkey& key)
+{
+    using impl = __detail::bst_impl<tkey, tvalue, compare, __detail::SPL_TAG<order_statistics>>;
+
+    const bool always = _splay_chance.p() >= 1.0;
+    if (_splay_mode == splay_mode::full && _splay_depth == 0 && always)
+    {
+        // Поиск и подъём за один проход сверху вниз
+        node* root = impl::splay_top_down(*this, key);
+        if (root != nullptr && !this->compare_keys(key, root->data.first) && !this->compare_keys(root->data.first, key))
+        {
+            return root;
+        }
+        return nullptr;
+    }
+
+    // Сначала обычный поиск без записей: глубина последнего узла пути решает, перестраивать ли дерево
+    node* current = this->_root;
+    node* found = nullptr;
+    size_t depth = 0;
+    while (current != nullptr)
+    {
+        node* next;
+        if (this->compare_keys(key, current->data.first))
+        {
+            next = current->left_subtree;
+        }
+        else if (this->compare_keys(current->data.first, key))
+        {
+            next = current->right_subtree;
+        }
+        else
+        {
+            found = current;
+            break;
+        }
+        if (next == nullptr)
+        {
+            break;
+        }
+        current = next;
+        ++depth;
+    }
+
+    if (current != nullptr && _splay_mode != splay_mode::none && depth > _splay_depth
+        && (always || _splay_chance(_splay_random)))
+    {
+        if (_splay_mode == splay_mode::full)
+        {
+            impl::splay(*this, &current);
+        }
+        else
+        {
+            impl::semi_splay(*this, &current);
+        }
+    }
+    return found;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+typename splay_tree<tkey, tvalue, compare, order_statistics>::parent::infix_iterator splay_tree<tkey, tvalue, compare, order_statistics>::find(const tkey& key)
+{
+    node* found = splay_lookup(key);
+    return found == nullptr ? this->end() : typename parent::infix_iterator(found);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+bool splay_tree<tkey, tvalue, compare, order_statistics>::contains(const tkey& key)
+{
+    return splay_lookup(key) != nullptr;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, bool order_statistics>
+tvalue& splay_tree<tkey, tvalue, compare, order_statistics>::at(const tkey& key)
+{
+    node* found = splay_lookup(key);
+    if (found == nullptr)
+    {
+        throw std::out_of_range("Key not found");
+    }
+    return found->data.second;
+}
+
 namespace __detail
 {
-    template<typename tkey, typename tvalue, typename compare>
+    template<typename tkey, typename tvalue, typename compare, bool order_statistics>
     template<class ...Args>
-    binary_search_tree<tkey, tvalue, compare, SPL_TAG>::node* bst_impl<tkey, tvalue, compare, SPL_TAG>::create_node(binary_search_tree<tkey, tvalue, compare, SPL_TAG>& cont, Args&& ...args){
-        using node_type = typename splay_tree<tkey, tvalue, compare>::node;
+    binary_search_tree<tkey, tvalue, compare, SPL_TAG<order_statistics>>::node* bst_impl<tkey, tvalue, compare, SPL_TAG<order_statistics>>::create_node(binary_search_tree<tkey, tvalue, compare, SPL_TAG<order_statistics>>& cont, Args&& ...args){
+        using node_type = typename splay_tree<tkey, tvalue, compare, order_statistics>::node;
         auto *new_node = cont._allocator.template new_object<node_type>(std::forward<Args>(args)...);
         return new_node;
     }
 
-    template<typename tkey, typename tvalue, typename compare>
-    void bst_impl<tkey, tvalue, compare, SPL_TAG>::delete_node(
-            binary_search_tree<tkey, tvalue, compare, SPL_TAG>& cont, binary_search_tree<tkey, tvalue, compare, SPL_TAG>::node** node){
-        using node_type = typename binary_search_tree<tkey, tvalue, compare, SPL_TAG>::node;
+    template<typename tkey, typename tvalue, typename compare, bool order_statistics>
+    typename binary_search_tree<tkey, tvalue, compare, SPL_TAG<order_statistics>>::node* bst_impl<tkey, tvalue, compare, SPL_TAG<order_statistics>>::clone_node(
+            binary_search_tree<tkey, tvalue, compare, SPL_TAG<order_statistics>>& cont, const binary_search_tree<tkey, tvalue, compare, SPL_TAG<order_statistics>>::node* source, binary_search_tree<tkey, tvalue, compare, SPL_TAG<order_statistics>>::node* parent)
+    {
+        return create_node(cont, parent, source->data);
+    }
+
+    template<typename tkey, typename tvalue, typename compare, bool order_statistics>
+    void bst_impl<tkey, tvalue, compare, SPL_TAG<order_statistics>>::delete_node(
+            binary_search_tree<tkey, tvalue, compare, SPL_TAG<order_statistics>>& cont, binary_search_tree<tkey, tvalue, compare, SPL_TAG<order_statistics>>::node** node){
+        using node_type = typename binary_search_tree<tkey, tvalue, compare, SPL_TAG<order_statistics>>::node;
         if (node && *node)
         {
             cont._allocator.template delete_object<node_type>(*node);
@@ -191,9 +391,9 @@ namespace __detail
         }
     }
 
-    template<typename tkey, typename tvalue, typename compare>
-    void bst_impl<tkey, tvalue, compare, SPL_TAG>::post_search(binary_search_tree<tkey, tvalue, compare, SPL_TAG>& cont,
-                     typename binary_search_tree<tkey, tvalue, compare, SPL_TAG>::node** node)
+    template<typename tkey, typename tvalue, typename compare, bool order_statistics>
+    void bst_impl<tkey, tvalue, compare, SPL_TAG<order_statistics>>::post_search(binary_search_tree<tkey, tvalue, compare, SPL_TAG<order_statistics>>& cont,
+                     typename binary_search_tree<tkey, tvalue, compare, SPL_TAG<order_statistics>>::node** node)
     {
         // После поиска надо поднять узел в корень
         // Если не нашли, то последний посещённый поднимаем
@@ -204,10 +404,10 @@ namespace __detail
     }
 
         //Does not invalidate node*
-    template<typename tkey, typename tvalue, typename compare>
-    void bst_impl<tkey, tvalue, compare, SPL_TAG>::post_insert(
-            binary_search_tree<tkey, tvalue, compare, SPL_TAG>& cont,
-            typename binary_search_tree<tkey, tvalue, compare, SPL_TAG>::node** node){
+    template<typename tkey, typename tvalue, typename compare, bool order_statistics>
+    void bst_impl<tkey, tvalue, compare, SPL_TAG<order_statistics>>::post_insert(
+            binary_search_tree<tkey, tvalue, compare, SPL_TAG<order_statistics>>& cont,
+            typename binary_search_tree<tkey, tvalue, compare, SPL_TAG<order_statistics>>::node** node){
         //После вставки так же поднимаем узел в корень
         if (node && *node)
         {
@@ -215,11 +415,11 @@ namespace __detail
         }
     }
 
-    template<typename tkey, typename tvalue, typename compare>
-    void bst_impl<tkey, tvalue, compare, SPL_TAG>::erase(
-            binary_search_tree<tkey, tvalue, compare, SPL_TAG>& cont,
-            typename binary_search_tree<tkey, tvalue, compare, SPL_TAG>::node** node_ptr){
-        using node_type = typename binary_search_tree<tkey, tvalue, compare, SPL_TAG>::node;
+    template<typename tkey, typename tvalue, typename compare, bool order_statistics>
+    void bst_impl<tkey, tvalue, compare, SPL_TAG<order_statistics>>::erase(
+            binary_search_tree<tkey, tvalue, compare, SPL_TAG<order_statistics>>& cont,
+            typename binary_search_tree<tkey, tvalue, compare, SPL_TAG<order_statistics>>::node** node_ptr){
+        using node_type = typename binary_search_tree<tkey, tvalue, compare, SPL_TAG<order_statistics>>::node;
         if (node_ptr == nullptr || *node_ptr == nullptr)
             return;
 
@@ -251,9 +451,10 @@ namespace __detail
             auto* left_child = node_to_delete->left_subtree;
             if (left_child != max_left)
             {
-                // Временное отсоединение левого поддерева
+                // Временное отсоединение левого поддерева: без родителя у его корня splay поднимет max_left
+                // только до вершины этого поддерева
                 node_to_delete->left_subtree = nullptr;
-                max_left->parent = nullptr;
+                left_child->parent = nullptr;
 
                 // Поднимаем max_left в корень
                 auto** max_ptr = &max_left;
@@ -263,6 +464,7 @@ namespace __detail
                 max_left->right_subtree = node_to_delete->right_subtree;
                 if (node_to_delete->right_subtree)
                     node_to_delete->right_subtree->parent = max_left;
+                cont.recalculate_size(max_left);
 
                 // Заменяем удаляемый узел
                 replace_node_in_parent(cont, node_ptr, max_left);
@@ -272,6 +474,7 @@ namespace __detail
                 // Левый потомок уже является максимальным
                 max_left->right_subtree = node_to_delete->right_subtree;
                 node_to_delete->right_subtree->parent = max_left;
+                cont.recalculate_size(max_left);
                 replace_node_in_parent(cont, node_ptr, max_left);
             }
         }
@@ -280,20 +483,22 @@ namespace __detail
     }
 
 
-    template<typename tkey, typename tvalue, typename compare>
-    void bst_impl<tkey, tvalue, compare, SPL_TAG>::swap(binary_search_tree<tkey, tvalue, compare, SPL_TAG>& lhs, binary_search_tree<tkey, tvalue, compare, SPL_TAG>& rhs) noexcept{
+    template<typename tkey, typename tvalue, typename compare, bool order_statistics>
+    void bst_impl<tkey, tvalue, compare, SPL_TAG<order_statistics>>::swap(binary_search_tree<tkey, tvalue, compare, SPL_TAG<order_statistics>>& lhs, binary_search_tree<tkey, tvalue, compare, SPL_TAG<order_statistics>>& rhs) noexcept{
         using std::swap;
-        swap(lhs.root, rhs.root);
+        swap(lhs._root, rhs._root);
         swap(lhs._logger, rhs._logger);
         swap(lhs._size, rhs._size);
         swap(lhs._allocator, rhs._allocator);
     }
 
-    template<typename tkey, typename tvalue, typename compare>
-    void bst_impl<tkey, tvalue, compare, SPL_TAG>::splay(
-            binary_search_tree<tkey, tvalue, compare, SPL_TAG>& cont,
-            typename binary_search_tree<tkey, tvalue, compare, SPL_TAG>::node** node_ptr)
+    template<typename tkey, typename tvalue, typename compare, bool order_statistics>
+    void bst_impl<tkey, tvalue, compare, SPL_TAG<order_statistics>>::splay(
+            binary_search_tree<tkey, tvalue, compare, SPL_TAG<order_statistics>>& cont,
+            typename binary_search_tree<tkey, tvalue, compare, SPL_TAG<order_statistics>>::node** node_ptr)
     {
+        using node_type = typename binary_search_tree<tkey, tvalue, compare, SPL_TAG<order_statistics>>::node;
+
         if (node_ptr == nullptr || *node_ptr == nullptr || (*node_ptr)->parent == nullptr)
             return;
 
@@ -306,19 +511,19 @@ namespace __detail
             {
                 if (node == node->parent->left_subtree)
                 {
-                    auto parent = node->parent;
+                    node_type* parent = node->parent;
                     cont.small_right_rotation(parent);
                 }
                 else
                 {
-                    auto parent = node->parent;
+                    node_type* parent = node->parent;
                     cont.small_left_rotation(parent);
                 }
             }
             else
             {
-                auto parent = node->parent;
-                auto grandparent = parent->parent;
+                node_type* parent = node->parent;
+                node_type* grandparent = parent->parent;
 
                 // Zig-Zig (left-left or right-right)
                 if (node == parent->left_subtree && parent == grandparent->left_subtree)
@@ -347,17 +552,166 @@ namespace __detail
         cont._root = node;
     }
 
-    template<typename tkey, typename tvalue, typename compare>
-    void bst_impl<tkey, tvalue, compare, SPL_TAG>::replace_node_in_parent(
-            binary_search_tree<tkey, tvalue, compare, SPL_TAG>& cont,
-            typename binary_search_tree<tkey, tvalue, compare, SPL_TAG>::node** node_ptr,
-            typename binary_search_tree<tkey, tvalue, compare, SPL_TAG>::node* new_node)
+    template<typename tkey, typename tvalue, typename compare, bool order_statistics>
+    typename binary_search_tree<tkey, tvalue, compare, SPL_TAG<order_statistics>>::node* bst_impl<tkey, tvalue, compare, SPL_TAG<order_statistics>>::splay_top_down(
+            binary_search_tree<tkey, tvalue, compare, SPL_TAG<order_statistics>>& cont, const tkey& key)
+    {
+        using node_type = typename binary_search_tree<tkey, tvalue, compare, SPL_TAG<order_statistics>>::node;
+
+        node_type* current = cont._root;
+        if (current == nullptr)
+            return nullptr;
+
+        // Узлы меньше ключа собираются в левое дерево (каждый новый - на его правый край),
+        // больше ключа - в правое (на левый край); в конце оба дерева становятся детьми current
+        node_type* left_root = nullptr;
+        node_type* left_max = nullptr;
+        node_type* right_root = nullptr;
+        node_type* right_min = nullptr;
+
+        while (true)
+        {
+            if (cont.compare_keys(key, current->data.first))
+            {
+                node_type* child = current->left_subtree;
+                if (child == nullptr)
+                    break;
+                if (cont.compare_keys(key, child->data.first))
+                {
+                    // Zig-zig: правый поворот над current, его поддерево больше не меняется
+                    current->left_subtree = child->right_subtree;
+                    if (current->left_subtree != nullptr)
+                        current->left_subtree->parent = current;
+                    child->right_subtree = current;
+                    current->parent = child;
+                    cont.recalculate_size(current);
+                    current = child;
+                    if (current->left_subtree == nullptr)
+                        break;
+                }
+                if (right_min == nullptr)
+                    right_root = current;
+                else
+                    right_min->left_subtree = current;
+                current->parent = right_min;
+                right_min = current;
+                current = current->left_subtree;
+            }
+            else if (cont.compare_keys(current->data.first, key))
+            {
+                node_type* child = current->right_subtree;
+                if (child == nullptr)
+                    break;
+                if (cont.compare_keys(child->data.first, key))
+                {
+                    // Zig-zig: левый поворот над current
+                    current->right_subtree = child->left_subtree;
+                    if (current->right_subtree != nullptr)
+                        current->right_subtree->parent = current;
+                    child->left_subtree = current;
+                    current->parent = child;
+                    cont.recalculate_size(current);
+                    current = child;
+                    if (current->right_subtree == nullptr)
+                        break;
+                }
+                if (left_max == nullptr)
+                    left_root = current;
+                else
+                    left_max->right_subtree = current;
+                current->parent = left_max;
+                left_max = current;
+                current = current->right_subtree;
+            }
+            else
+            {
+                break;
+            }
+        }
+
+        if (left_max != nullptr)
+        {
+            left_max->right_subtree = current->left_subtree;
+            if (current->left_subtree != nullptr)
+                current->left_subtree->parent = left_max;
+            current->left_subtree = left_root;
+            left_root->parent = current;
+        }
+        if (right_min != nullptr)
+        {
+            right_min->left_subtree = current->right_subtree;
+            if (current->right_subtree != nullptr)
+                current->right_subtree->parent = right_min;
+            current->right_subtree = right_root;
+            right_root->parent = current;
+        }
+        current->parent = nullptr;
+        cont._root = current;
+
+        if constexpr (order_statistics)
+        {
+            // Размеры поменялись только у узлов на краях собранных деревьев - от нижнего до нового корня
+            for (node_type* n = left_max; n != nullptr && n != current; n = n->parent)
+                cont.recalculate_size(n);
+            for (node_type* n = right_min; n != nullptr && n != current; n = n->parent)
+                cont.recalculate_size(n);
+            cont.recalculate_size(current);
+        }
+        return current;
+    }
+
+    template<typename tkey, typename tvalue, typename compare, bool order_statistics>
+    void bst_impl<tkey, tvalue, compare, SPL_TAG<order_statistics>>::semi_splay(
+            binary_search_tree<tkey, tvalue, compare, SPL_TAG<order_statistics>>& cont,
+            typename binary_search_tree<tkey, tvalue, compare, SPL_TAG<order_statistics>>::node** node_ptr)
+    {
+        using node_type = typename binary_search_tree<tkey, tvalue, compare, SPL_TAG<order_statistics>>::node;
+
+        if (node_ptr == nullptr || *node_ptr == nullptr)
+            return;
+
+        node_type* node = *node_ptr;
+        while (node->parent != nullptr && node->parent->parent != nullptr)
+        {
+            node_type* parent = node->parent;
+            node_type* grandparent = parent->parent;
+            const bool node_left = node == parent->left_subtree;
+            const bool parent_left = parent == grandparent->left_subtree;
+
+            if (node_left == parent_left)
+            {
+                // Zig-zig: один поворот над дедом, подъём продолжается от родителя, вставшего на его место
+                if (parent_left)
+                    cont.small_right_rotation(grandparent);
+                else
+                    cont.small_left_rotation(grandparent);
+                node = parent;
+            }
+            else if (node_left)
+            {
+                // Zig-zag: как в полном splay, node встаёт на место деда
+                cont.small_right_rotation(parent);
+                cont.small_left_rotation(grandparent);
+            }
+            else
+            {
+                cont.small_left_rotation(parent);
+                cont.small_right_rotation(grandparent);
+            }
+        }
+    }
+
+    template<typename tkey, typename tvalue, typename compare, bool order_statistics>
+    void bst_impl<tkey, tvalue, compare, SPL_TAG<order_statistics>>::replace_node_in_parent(
+            binary_search_tree<tkey, tvalue, compare, SPL_TAG<order_statistics>>& cont,
+            typename binary_search_tree<tkey, tvalue, compare, SPL_TAG<order_statistics>>::node** node_ptr,
+            typename binary_search_tree<tkey, tvalue, compare, SPL_TAG<order_statistics>>::node* new_node)
                                 {
         if (node_ptr == nullptr || *node_ptr == nullptr)
             return;
 
         auto *old_node = *node_ptr;
-        auto *parent = old_node->parent;
+        typename binary_search_tree<tkey, tvalue, compare, SPL_TAG<order_statistics>>::node *parent = old_node->parent;
 
         if (parent == nullptr) {
             cont._root = new_node;
@@ -3,6 +3,9 @@
 #include <logger_builder.h>
 #include <client_logger_builder.h>
 #include <iostream>
+#include <list>
+#include <stdexcept>
+#include <utility>
 
 
 
@@ -510,6 +513,198 @@ TEST(splayTreePositiveTests, test10)
     logger->trace("splayTreePositiveTests.test10 finished");
 }
 
+TEST(splayTreePositiveTests, test11)
+{
+    std::unique_ptr<logger> logger (create_logger(std::vector<std::pair<std::string, logger::severity>>
+                                                          {
+                                                                  {
+                                                                          "splay_tree_tests_logs.txt",
+                                                                          logger::severity::trace
+                                                                  },
+                                                          }));
+
+    logger->trace("splayTreePositiveTests.test11 started");
+
+    std::list<std::pair<int, int>> sorted =
+        {
+            { 1, 5 },
+            { 2, 12 },
+            { 3, 67 },
+            { 4, 45 },
+            { 15, 1 }
+        };
+
+    splay_tree<int, int> splay(sorted, std::less<int>(), nullptr, logger.get());
+
+    std::vector<test_data<int, int>> expected_result =
+        {
+                test_data<int, int>(0, 3, 67),
+                test_data<int, int>(1, 2, 12),
+                test_data<int, int>(2, 1, 5),
+                test_data<int, int>(1, 15, 1),
+                test_data<int, int>(2, 4, 45)
+        };
+
+    EXPECT_TRUE(prefix_iterator_test(splay, expected_result));
+    EXPECT_EQ(splay.size(), 5);
+
+    logger->trace("splayTreePositiveTests.test11 finished");
+}
+
+TEST(splayTreePositiveTests, test12)
+{
+    std::unique_ptr<logger> logger (create_logger(std::vector<std::pair<std::string, logger::severity>>
+                                                          {
+                                                                  {
+                                                                          "splay_tree_tests_logs.txt",
+                                                                          logger::severity::trace
+                                                                  },
+                                                          }));
+
+    logger->trace("splayTreePositiveTests.test12 started");
+
+    splay_tree<int, int, std::less<int>, true> splay(std::less<int>(), nullptr, logger.get());
+
+    for (int key : {50, 20, 80, 10, 30, 25, 35, 70, 90})
+    {
+        splay.emplace(key, key);
+    }
+
+    // Корень 35 с двумя поддеревьями, наибольший слева - 30, а не левый ребёнок
+    splay.erase(35);
+    splay.erase(80);
+    EXPECT_EQ(splay.size(), 7);
+
+    std::vector<int> keys;
+    for (size_t k = 0; k < splay.size(); ++k)
+    {
+        keys.push_back(splay.select(k)->first);
+    }
+    EXPECT_EQ(keys, std::vector<int>({10, 20, 25, 30, 50, 70, 90}));
+    EXPECT_EQ(splay.rank(60), 5);
+    EXPECT_EQ(splay.distance(splay.begin(), splay.end()), 7);
+
+    logger->trace("splayTreePositiveTests.test12 finished");
+}
+
+TEST(splayTreePositiveTests, test13)
+{
+    std::unique_ptr<logger> logger (create_logger(std::vector<std::pair<std::string, logger::severity>>
+                                                          {
+                                                                  {
+                                                                          "splay_tree_tests_logs.txt",
+                                                                          logger::severity::trace
+                                                                  },
+                                                          }));
+
+    logger->trace("splayTreePositiveTests.test13 started");
+
+    // Возрастающие ключи вытягивают дерево в цепочку из миллиона узлов, рекурсивный разбор переполнил бы стек
+    const int count = 1'000'000;
+    splay_tree<int, int> splay;
+    for (int key = 0; key < count; ++key)
+    {
+        splay.emplace(key, key);
+    }
+    EXPECT_EQ(splay.size(), count);
+
+    splay.clear();
+    EXPECT_TRUE(splay.empty());
+    EXPECT_EQ(splay.size(), 0);
+    EXPECT_TRUE(splay.begin() == splay.end());
+
+    for (int key = 0; key < count; ++key)
+    {
+        splay.emplace(key, -key);
+    }
+    EXPECT_EQ(splay.size(), count);
+    EXPECT_EQ(splay.begin()->second, 0);
+
+    logger->trace("splayTreePositiveTests.test13 finished");
+}
+
+TEST(splayTreePositiveTests, test14)
+{
+    std::unique_ptr<logger> logger (create_logger(std::vector<std::pair<std::string, logger::severity>>
+                                                          {
+                                                                  {
+                                                                          "splay_tree_tests_logs.txt",
+                                                                          logger::severity::trace
+                                                                  },
+                                                          }));
+
+    logger->trace("splayTreePositiveTests.test14 started");
+
+    splay_tree<int, int> full(std::less<int>(), nullptr, logger.get());
+    splay_tree<int, int> semi(std::less<int>(), nullptr, logger.get());
+    splay_tree<int, int> lazy(std::less<int>(), nullptr, logger.get());
+
+    // Возрастающие ключи дают цепочку 7 - 6 - ... - 1 по левым детям
+    for (int key = 1; key <= 7; ++key)
+    {
+        full.emplace(key, key * 10);
+        semi.emplace(key, key * 10);
+        lazy.emplace(key, key * 10);
+    }
+    semi.setup_splay(splay_tree<int, int>::splay_mode::semi);
+    lazy.setup_splay(splay_tree<int, int>::splay_mode::full, 6);
+
+    EXPECT_EQ(full.find(1)->second, 10);
+    std::vector<test_data<int, int>> expected_full =
+        {
+            test_data<int, int>(0, 1, 10),
+            test_data<int, int>(1, 6, 60),
+            test_data<int, int>(2, 4, 40),
+            test_data<int, int>(3, 2, 20),
+            test_data<int, int>(4, 3, 30),
+            test_data<int, int>(3, 5, 50),
+            test_data<int, int>(2, 7, 70)
+        };
+    EXPECT_TRUE(prefix_iterator_test(full, expected_full));
+
+    // Полупоиск только вдвое укорачивает путь: узел 1 с глубины 6 поднимается на 3
+    EXPECT_TRUE(semi.contains(1));
+    std::vector<test_data<int, int>> expected_semi =
+        {
+            test_data<int, int>(0, 6, 60),
+            test_data<int, int>(1, 4, 40),
+            test_data<int, int>(2, 2, 20),
+            test_data<int, int>(3, 1, 10),
+            test_data<int, int>(3, 3, 30),
+            test_data<int, int>(2, 5, 50),
+            test_data<int, int>(1, 7, 70)
+        };
+    EXPECT_TRUE(prefix_iterator_test(semi, expected_semi));
+
+    std::vector<test_data<int, int>> expected_chain;
+    for (int key = 7; key >= 1; --key)
+    {
+        expected_chain.emplace_back(7 - key, key, key * 10);
+    }
+
+    // Глубина 6 не больше порога, константный поиск не перестраивает дерево никогда
+    EXPECT_EQ(lazy.at(1), 10);
+    EXPECT_FALSE(lazy.contains(0));
+    EXPECT_TRUE(std::as_const(lazy).contains(1));
+    EXPECT_TRUE(prefix_iterator_test(lazy, expected_chain));
+
+    lazy.setup_splay(splay_tree<int, int>::splay_mode::full, 0, 0.0);
+    EXPECT_EQ(lazy.find(1)->second, 10);
+    EXPECT_TRUE(prefix_iterator_test(lazy, expected_chain));
+
+    // Отсутствующий ключ поднимает последний узел пути, но корень 7 лежит не глубже порога
+    lazy.setup_splay(splay_tree<int, int>::splay_mode::full, 5);
+    EXPECT_TRUE(lazy.find(8) == lazy.end());
+    EXPECT_TRUE(prefix_iterator_test(lazy, expected_chain));
+    EXPECT_TRUE(lazy.find(1) != lazy.end());
+    EXPECT_TRUE(prefix_iterator_test(lazy, expected_full));
+
+    EXPECT_THROW(lazy.setup_splay(splay_tree<int, int>::splay_mode::semi, 0, 1.5), std::invalid_argument);
+    EXPECT_THROW(full.at(8), std::out_of_range);
+
+    logger->trace("splayTreePositiveTests.test14 finished");
+}
+
 int main(
     int argc,
     char **argv)
@@ -4,6 +4,8 @@
 #include <client_logger_builder.h>
 #include <allocator_sorted_list.h>
 #include <iostream>
+#include <string_view>
+#include <memory_resource>
 
 logger *create_logger(
     std::vector<std::pair<std::string, logger::severity>> const &output_file_streams_setup,
@@ -545,6 +547,326 @@ TEST(binarySearchTreePositiveTests, test10)
 }
 
 
+TEST(binarySearchTreePositiveTests, test11)
+{
+    std::unique_ptr<logger> logger(create_logger(std::vector<std::pair<std::string, logger::severity>>
+        {
+            {
+                "binary_search_tree_tests_logs.txt",
+                logger::severity::trace
+            }
+        }));
+    logger->trace("binarySearchTreePositiveTests.test11 started");
+    
+    auto bst1 = std::make_unique<binary_search_tree<int, std::string>>(std::less<int>(), nullptr, logger.get());
+    
+    bst1->emplace(6, "l");
+    bst1->emplace(8, "c");
+    bst1->emplace(15, "l");
+    bst1->emplace(11, "o");
+    bst1->emplace(9, "h");
+    bst1->emplace(2, "e");
+    bst1->emplace(4, "b");
+    bst1->emplace(18, "e");
+    
+    std::vector<test_data<int, std::string>> expected_result =
+        {
+                test_data<int, std::string>(0, 6, "l"),
+                test_data<int, std::string>(1, 2, "e"),
+                test_data<int, std::string>(2, 4, "b"),
+                test_data<int, std::string>(1, 8, "c"),
+                test_data<int, std::string>(2, 15, "l"),
+                test_data<int, std::string>(3, 11, "o"),
+                test_data<int, std::string>(4, 9, "h"),
+                test_data<int, std::string>(3, 18, "e")
+        };
+    
+    binary_search_tree<int, std::string> bst2(*bst1);
+    
+    EXPECT_TRUE(prefix_iterator_test(bst2, expected_result));
+    EXPECT_EQ(bst2.size(), 8);
+    
+    bst2.erase(15);
+    bst2.at(6) = "x";
+    
+    EXPECT_TRUE(prefix_iterator_test(*bst1, expected_result));
+    
+    binary_search_tree<int, std::string> bst3(std::less<int>(), nullptr, logger.get());
+    bst3.emplace(1, "a");
+    bst3 = *bst1;
+    bst1.reset();
+    
+    EXPECT_TRUE(prefix_iterator_test(bst3, expected_result));
+    EXPECT_EQ(bst3.size(), 8);
+    
+    logger->trace("binarySearchTreePositiveTests.test11 finished");
+}
+
+TEST(binarySearchTreePositiveTests, test12)
+{
+    std::unique_ptr<logger> logger(create_logger(std::vector<std::pair<std::string, logger::severity>>
+        {
+            {
+                "binary_search_tree_tests_logs.txt",
+                logger::severity::trace
+            }
+        }));
+    logger->trace("binarySearchTreePositiveTests.test12 started");
+    
+    std::vector<std::pair<int, std::string>> sorted =
+        {
+            { 1, "a" },
+            { 2, "b" },
+            { 3, "c" },
+            { 4, "d" },
+            { 5, "e" },
+            { 6, "f" },
+            { 7, "g" }
+        };
+    
+    binary_search_tree<int, std::string> bst1(sorted, std::less<int>(), nullptr, logger.get());
+    
+    std::vector<test_data<int, std::string>> expected_result =
+        {
+                test_data<int, std::string>(0, 4, "d"),
+                test_data<int, std::string>(1, 2, "b"),
+                test_data<int, std::string>(2, 1, "a"),
+                test_data<int, std::string>(2, 3, "c"),
+                test_data<int, std::string>(1, 6, "f"),
+                test_data<int, std::string>(2, 5, "e"),
+                test_data<int, std::string>(2, 7, "g")
+        };
+    
+    EXPECT_TRUE(prefix_iterator_test(bst1, expected_result));
+    EXPECT_EQ(bst1.size(), 7);
+    
+    binary_search_tree<int, std::string> bst2(std::less<int>(), nullptr, logger.get());
+    bst2.insert_range(sorted_unique, sorted);
+    
+    EXPECT_TRUE(prefix_iterator_test(bst2, expected_result));
+    
+    bst2.emplace(8, "h");
+    EXPECT_EQ(bst2.at(8), "h");
+    EXPECT_EQ(bst2.at(1), "a");
+    
+    logger->trace("binarySearchTreePositiveTests.test12 finished");
+}
+
+TEST(binarySearchTreePositiveTests, test13)
+{
+    std::unique_ptr<logger> logger(create_logger(std::vector<std::pair<std::string, logger::severity>>
+        {
+            {
+                "binary_search_tree_tests_logs.txt",
+                logger::severity::trace
+            }
+        }));
+    logger->trace("binarySearchTreePositiveTests.test13 started");
+    
+    binary_search_tree<std::string, std::string, std::less<>> bst(std::less<>(), nullptr, logger.get());
+    
+    EXPECT_TRUE(bst.try_emplace("b", 3, 'b').second);
+    EXPECT_TRUE(bst.try_emplace("a", "a").second);
+    EXPECT_TRUE(bst.try_emplace(std::string("d"), "d").second);
+    
+    std::string value = "other";
+    auto [it, inserted] = bst.try_emplace("b", std::move(value));
+    EXPECT_FALSE(inserted);
+    EXPECT_EQ(it->second, "bbb");
+    EXPECT_EQ(value, "other");
+    EXPECT_EQ(bst.size(), 3);
+    
+    std::string_view b = "b", c = "c";
+    EXPECT_TRUE(bst.contains(b));
+    EXPECT_FALSE(bst.contains(c));
+    EXPECT_EQ(bst.find(b)->first, "b");
+    EXPECT_TRUE(bst.find(c) == bst.end());
+    EXPECT_EQ(bst.at(b), "bbb");
+    EXPECT_THROW(bst.at(c), std::out_of_range);
+    EXPECT_EQ(bst.lower_bound(c)->first, "d");
+    EXPECT_EQ(bst.upper_bound(b)->first, "d");
+    EXPECT_EQ(bst.lower_bound("a")->first, "a");
+    
+    const auto &cbst = bst;
+    EXPECT_EQ(cbst.at(std::string_view("a")), "a");
+    EXPECT_EQ(cbst.find(b)->second, "bbb");
+    
+    logger->trace("binarySearchTreePositiveTests.test13 finished");
+}
+
+TEST(binarySearchTreePositiveTests, test14)
+{
+    std::unique_ptr<logger> logger(create_logger(std::vector<std::pair<std::string, logger::severity>>
+        {
+            {
+                "binary_search_tree_tests_logs.txt",
+                logger::severity::trace
+            }
+        }));
+    logger->trace("binarySearchTreePositiveTests.test14 started");
+    
+    binary_search_tree<int, std::string> bst(std::less<int>(), nullptr, logger.get());
+    
+    auto hint = bst.insert(bst.end(), std::make_pair(4, std::string("d")));
+    hint = bst.insert(hint, std::make_pair(2, std::string("b")));
+    hint = bst.emplace_hint(hint, 3, "c");
+    hint = bst.emplace_hint(bst.end(), 6, "f");
+    bst.insert(hint, std::make_pair(5, std::string("e")));
+    bst.emplace_hint(bst.begin(), 7, "g");
+    bst.emplace_hint(bst.find(7), 1, "a");
+    
+    std::vector<test_data<int, std::string>> expected_result =
+        {
+                test_data<int, std::string>(0, 4, "d"),
+                test_data<int, std::string>(1, 2, "b"),
+                test_data<int, std::string>(2, 1, "a"),
+                test_data<int, std::string>(2, 3, "c"),
+                test_data<int, std::string>(1, 6, "f"),
+                test_data<int, std::string>(2, 5, "e"),
+                test_data<int, std::string>(2, 7, "g")
+        };
+    
+    EXPECT_TRUE(prefix_iterator_test(bst, expected_result));
+    EXPECT_EQ(bst.size(), 7);
+    
+    auto existing = bst.emplace_hint(bst.find(1), 6, "x");
+    EXPECT_EQ(existing->second, "f");
+    EXPECT_EQ(bst.size(), 7);
+    
+    for (int from = 1; from <= 7; ++from)
+    {
+        for (int key = 0; key <= 8; ++key)
+        {
+            auto it = bst.lower_bound(bst.find(from), key);
+            if (key > 7)
+            {
+                EXPECT_TRUE(it == bst.end());
+            }
+            else
+            {
+                EXPECT_EQ(it->first, std::max(key, 1));
+            }
+        }
+    }
+    EXPECT_EQ(bst.lower_bound(bst.end(), 0)->first, 1);
+    
+    logger->trace("binarySearchTreePositiveTests.test14 finished");
+}
+
+TEST(binarySearchTreePositiveTests, test15)
+{
+    std::unique_ptr<logger> logger(create_logger(std::vector<std::pair<std::string, logger::severity>>
+        {
+            {
+                "binary_search_tree_tests_logs.txt",
+                logger::severity::trace
+            }
+        }));
+    logger->trace("binarySearchTreePositiveTests.test15 started");
+    
+    binary_search_tree<int, std::string> bst(std::less<int>(), nullptr, logger.get());
+    
+    bst.emplace(5, "e");
+    bst.emplace(2, "b");
+    bst.emplace(8, "h");
+    bst.emplace(1, "a");
+    bst.emplace(4, "d");
+    bst.emplace(3, "c");
+    bst.emplace(7, "g");
+    
+    EXPECT_FALSE(bst.order_statistics());
+    EXPECT_EQ(bst.select(2)->first, 3);
+    EXPECT_EQ(bst.rank(6), 5);
+    
+    binary_search_tree<int, std::string, std::less<int>, __detail::BST_TAG<true>> counted(std::less<int>(), nullptr, logger.get());
+    for (auto const &[key, value] : bst)
+    {
+        counted.emplace(key, value);
+    }
+    EXPECT_TRUE(counted.order_statistics());
+    
+    for (size_t k = 0; k < counted.size(); ++k)
+    {
+        auto it = counted.select(k);
+        EXPECT_EQ(counted.rank(it->first), k);
+        EXPECT_EQ(counted.distance(counted.begin(), it), static_cast<ptrdiff_t>(k));
+    }
+    EXPECT_TRUE(counted.select(7) == counted.end());
+    EXPECT_EQ(counted.rank(0), 0);
+    EXPECT_EQ(counted.rank(9), 7);
+    EXPECT_EQ(counted.distance(counted.find(7), counted.find(2)), -4);
+    EXPECT_EQ(counted.distance(counted.find(7), counted.end()), 2);
+    EXPECT_EQ(counted.advance(counted.find(2), 3)->first, 5);
+    EXPECT_EQ(counted.advance(counted.find(8), -6)->first, 1);
+    EXPECT_TRUE(counted.advance(counted.find(8), 1) == counted.end());
+    EXPECT_TRUE(counted.advance(counted.find(1), -1) == counted.end());
+    
+    // У 5 два ребёнка, на её место встаёт 4, а 3 поднимается на место 4
+    counted.erase(5);
+    counted.erase(1);
+    EXPECT_EQ(counted.size(), 5);
+    
+    std::vector<int> keys;
+    for (size_t k = 0; k < counted.size(); ++k)
+    {
+        keys.push_back(counted.select(k)->first);
+    }
+    EXPECT_EQ(keys, std::vector<int>({2, 3, 4, 7, 8}));
+    EXPECT_EQ(counted.rank(5), 3);
+    
+    logger->trace("binarySearchTreePositiveTests.test15 finished");
+}
+
+TEST(binarySearchTreePositiveTests, test16)
+{
+    std::unique_ptr<logger> logger(create_logger(std::vector<std::pair<std::string, logger::severity>>
+        {
+            {
+                "binary_search_tree_tests_logs.txt",
+                logger::severity::trace
+            }
+        }));
+    logger->trace("binarySearchTreePositiveTests.test16 started");
+    
+    std::pmr::monotonic_buffer_resource arena;
+    std::pmr::unsynchronized_pool_resource pool;
+    
+    binary_search_tree<int, std::string> in_arena(std::less<int>(), &arena, logger.get());
+    binary_search_tree<int, std::string> in_pool(std::less<int>(), &pool, logger.get());
+    binary_search_tree<int, std::string> plain(std::less<int>(), nullptr, logger.get());
+    
+    for (int key : {50, 20, 80, 10, 30, 70, 90})
+    {
+        // Строки длиннее малого буфера, так что деструкторы элементов обязаны отработать
+        in_arena.emplace(key, std::string(64, 'a'));
+        in_pool.emplace(key, std::string(64, 'p'));
+        plain.emplace(key, std::string(64, 'x'));
+    }
+    
+    EXPECT_TRUE(in_arena.clear_and_release());
+    EXPECT_TRUE(in_pool.clear_and_release());
+    EXPECT_FALSE(plain.clear_and_release());
+    
+    for (auto *bst : {&in_arena, &in_pool, &plain})
+    {
+        EXPECT_TRUE(bst->empty());
+        EXPECT_EQ(bst->size(), 0);
+        EXPECT_TRUE(bst->begin() == bst->end());
+        
+        bst->emplace(2, "b");
+        bst->emplace(1, "a");
+        EXPECT_EQ(bst->size(), 2);
+        EXPECT_EQ(bst->begin()->second, "a");
+        
+        bst->clear();
+        EXPECT_TRUE(bst->empty());
+        bst->emplace(3, "c");
+        EXPECT_EQ(bst->at(3), "c");
+    }
+    
+    logger->trace("binarySearchTreePositiveTests.test16 finished");
+}
+
 int main(
     int argc,
     char **argv)
@@ -183,6 +183,16 @@ public:
 
     const tvalue &at(const tkey &) const;
 
+    /*
+     * With a transparent compare (std::less<> etc.) key may be any type comparable with tkey,
+     * e.g. std::string_view for std::string keys, and no tkey is built for the search
+     */
+    template<typename K> requires transparent_compare<compare>
+    tvalue &at(const K &);
+
+    template<typename K> requires transparent_compare<compare>
+    const tvalue &at(const K &) const;
+
     /*
      * If key not exists, makes default initialization of value
      */
@@ -231,6 +241,27 @@ public:
 
     bool contains(const tkey &key) const;
 
+    template<typename K> requires transparent_compare<compare>
+    bptree_iterator find(const K &key);
+
+    template<typename K> requires transparent_compare<compare>
+    bptree_const_iterator find(const K &key) const;
+
+    template<typename K> requires transparent_compare<compare>
+    bptree_iterator lower_bound(const K &key);
+
+    template<typename K> requires transparent_compare<compare>
+    bptree_const_iterator lower_bound(const K &key) const;
+
+    template<typename K> requires transparent_compare<compare>
+    bptree_iterator upper_bound(const K &key);
+
+    template<typename K> requires transparent_compare<compare>
+    bptree_const_iterator upper_bound(const K &key) const;
+
+    template<typename K> requires transparent_compare<compare>
+    bool contains(const K &key) const;
+
     // endregion lookup declaration
 
     // region modifiers declaration
@@ -275,7 +306,28 @@ public:
     // endregion modifiers declaration
 
 private:
-    bptree_node_term *find_leaf(const tkey &key) const;
+    /*
+     * K is tkey or, with a transparent compare, any type comparable with it
+     */
+    template<typename K>
+    bptree_node_term *find_leaf(const K &key) const;
+
+    /*
+     * One descent to the leaf and a binary search in it; end() if there is no such element
+     */
+    template<typename K>
+    bptree_iterator locate(const K &key) const;
+
+    template<typename K>
+    bptree_iterator locate_lower_bound(const K &key) const;
+
+    template<typename K>
+    bptree_iterator locate_upper_bound(const K &key) const;
+
+    /*
+     * Position index of leaf, or the first element of the following leaves if index is past its end
+     */
+    static bptree_iterator first_from(bptree_node_term *leaf, size_t index);
 
     void split_node(bptree_node_term *node);
 
@@ -287,7 +339,7 @@ private:
 
     void rebalance_internal_after_delete(bptree_node_middle *node);
 
-    void clear_recursive(bptree_node_base *node) noexcept;
+    void clear_subtree(bptree_node_base *subtree) noexcept;
 };
 
 template<std::input_iterator iterator, compator<typename std::iterator_traits<iterator>::value_type::first_type> compare
@@ -504,6 +556,26 @@ const tvalue &BP_tree<tkey, tvalue, compare, t>::at(const tkey &key) const {
     return it->second;
 }
 
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
+template<typename K> requires transparent_compare<compare>
+tvalue &BP_tree<tkey, tvalue, compare, t>::at(const K &key) {
+    bptree_iterator it = locate(key);
+    if (it == end()) {
+        throw std::out_of_range("Key not found in B+ tree");
+    }
+    return it->second;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
+template<typename K> requires transparent_compare<compare>
+const tvalue &BP_tree<tkey, tvalue, compare, t>::at(const K &key) const {
+    bptree_iterator it = locate(key);
+    if (it == bptree_iterator()) {
+        throw std::out_of_range("Key not found in B+ tree");
+    }
+    return it->second;
+}
+
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 tvalue &BP_tree<tkey, tvalue, compare, t>::operator[](const tkey &key) {
     bptree_iterator it = find(key);
@@ -769,7 +841,7 @@ BP_tree<tkey, tvalue, compare, t> &BP_tree<tkey, tvalue, compare, t>::operator=(
     }
 
     if (_root) {
-        clear_recursive(_root);
+        clear_subtree(_root);
     }
 
 
@@ -790,7 +862,7 @@ BP_tree<tkey, tvalue, compare, t> &BP_tree<tkey, tvalue, compare, t>::operator=(
     }
 
     if (_root) {
-        clear_recursive(_root);
+        clear_subtree(_root);
     }
 
 
@@ -878,138 +950,191 @@ bool BP_tree<tkey, tvalue, compare, t>::empty() const noexcept {
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 typename BP_tree<tkey, tvalue, compare, t>::bptree_iterator BP_tree<tkey, tvalue, compare, t>::find(const tkey &key) {
-    if (empty()) {
-        return end();
-    }
-
-    bptree_node_term *leaf = find_leaf(key);
-
-    // Ищем ключ в листе
-    for (size_t i = 0; i < leaf->_data.size(); ++i) {
-        // Проверяем на эквивалентность (не меньше и не больше)
-        if (!compare_keys(leaf->_data[i].first, key) && !compare_keys(key, leaf->_data[i].first)) {
-            return bptree_iterator(leaf, i);
-        }
-    }
-
-    return end();
+    return locate(key);
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 typename BP_tree<tkey, tvalue, compare, t>::bptree_const_iterator BP_tree<tkey, tvalue, compare, t>::find(
     const tkey &key) const {
-    if (empty()) {
-        return end();
-    }
-
-    bptree_node_term *leaf = find_leaf(key);
-
-    // Ищем ключ в листе
-    for (size_t i = 0; i < leaf->_data.size(); ++i) {
-        if (!compare_keys(leaf->_data[i].first, key) && !compare_keys(key, leaf->_data[i].first)) {
-            return bptree_const_iterator(leaf, i);
-        }
-    }
-
-    return end();
+    return locate(key);
 }
+
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 bool BP_tree<tkey, tvalue, compare, t>::contains(const tkey &key) const {
-    return find(key) != end();
+    return locate(key) != bptree_iterator();
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 typename BP_tree<tkey, tvalue, compare, t>::bptree_iterator
 BP_tree<tkey, tvalue, compare, t>::lower_bound(const tkey &key) {
-    if (empty()) {
-        return end();
-    }
-
-    auto it = begin();
-    while (it != end() && compare_keys(it->first, key)) {
-        ++it;
-    }
-    return it;
+    return locate_lower_bound(key);
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 typename BP_tree<tkey, tvalue, compare, t>::bptree_const_iterator
 BP_tree<tkey, tvalue, compare, t>::lower_bound(const tkey &key) const {
-    if (empty()) {
-        return end();
-    }
-
-    auto it = begin();
-    while (it != end() && compare_keys(it->first, key)) {
-        ++it;
-    }
-    return it;
+    return locate_lower_bound(key);
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 typename BP_tree<tkey, tvalue, compare, t>::bptree_iterator
 BP_tree<tkey, tvalue, compare, t>::upper_bound(const tkey &key) {
-    if (empty()) {
-        return end();
-    }
-
-    auto it = begin();
-    while (it != end() && !compare_keys(key, it->first)) {
-        ++it;
-    }
-    return it;
+    return locate_upper_bound(key);
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 typename BP_tree<tkey, tvalue, compare, t>::bptree_const_iterator
 BP_tree<tkey, tvalue, compare, t>::upper_bound(const tkey &key) const {
-    if (empty()) {
-        return end();
+    return locate_upper_bound(key);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
+template<typename K> requires transparent_compare<compare>
+typename BP_tree<tkey, tvalue, compare, t>::bptree_iterator BP_tree<tkey, tvalue, compare, t>::find(const K &key) {
+    return locate(key);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
+template<typename K> requires transparent_compare<compare>
+typename BP_tree<tkey, tvalue, compare, t>::bptree_const_iterator BP_tree<tkey, tvalue, compare, t>::find(const K &key) const {
+    return locate(key);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
+template<typename K> requires transparent_compare<compare>
+bool BP_tree<tkey, tvalue, compare, t>::contains(const K &key) const {
+    return locate(key) != bptree_iterator();
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
+template<typename K> requires transparent_compare<compare>
+typename BP_tree<tkey, tvalue, compare, t>::bptree_iterator BP_tree<tkey, tvalue, compare, t>::lower_bound(const K &key) {
+    return locate_lower_bound(key);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
+template<typename K> requires transparent_compare<compare>
+typename BP_tree<tkey, tvalue, compare, t>::bptree_const_iterator BP_tree<tkey, tvalue, compare, t>::lower_bound(const K &key) const {
+    return locate_lower_bound(key);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
+template<typename K> requires transparent_compare<compare>
+typename BP_tree<tkey, tvalue, compare, t>::bptree_iterator BP_tree<tkey, tvalue, compare, t>::upper_bound(const K &key) {
+    return locate_upper_bound(key);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
+template<typename K> requires transparent_compare<compare>
+typename BP_tree<tkey, tvalue, compare, t>::bptree_const_iterator BP_tree<tkey, tvalue, compare, t>::upper_bound(const K &key) const {
+    return locate_upper_bound(key);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
+template<typename K>
+typename BP_tree<tkey, tvalue, compare, t>::bptree_iterator BP_tree<tkey, tvalue, compare, t>::locate(const K &key) const {
+    bptree_node_term *leaf = find_leaf(key);
+    if (leaf == nullptr) {
+        return bptree_iterator();
     }
 
-    auto it = begin();
-    while (it != end() && !compare_keys(key, it->first)) {
-        ++it;
+    // Данные листа упорядочены, поэтому ищем двоичным поиском
+    auto it = std::lower_bound(leaf->_data.begin(), leaf->_data.end(), key,
+                               [this](const tree_data_type &p, const K &k) { return compare::operator()(p.first, k); });
+    if (it == leaf->_data.end() || compare::operator()(key, it->first)) {
+        return bptree_iterator();
     }
-    return it;
+    return bptree_iterator(leaf, std::distance(leaf->_data.begin(), it));
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
-void BP_tree<tkey, tvalue, compare, t>::clear_recursive(bptree_node_base *node) noexcept {
-    if (node == nullptr) {
-        return;
+template<typename K>
+typename BP_tree<tkey, tvalue, compare, t>::bptree_iterator BP_tree<tkey, tvalue, compare, t>::locate_lower_bound(const K &key) const {
+    bptree_node_term *leaf = find_leaf(key);
+    if (leaf == nullptr) {
+        return bptree_iterator();
+    }
+
+    auto it = std::lower_bound(leaf->_data.begin(), leaf->_data.end(), key,
+                               [this](const tree_data_type &p, const K &k) { return compare::operator()(p.first, k); });
+    return first_from(leaf, std::distance(leaf->_data.begin(), it));
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
+template<typename K>
+typename BP_tree<tkey, tvalue, compare, t>::bptree_iterator BP_tree<tkey, tvalue, compare, t>::locate_upper_bound(const K &key) const {
+    bptree_node_term *leaf = find_leaf(key);
+    if (leaf == nullptr) {
+        return bptree_iterator();
     }
 
-    // Если это внутренний узел, сначала освобождаем всех его потомков
-    if (!node->_is_terminate) {
-        bptree_node_middle *middle_node = static_cast<bptree_node_middle *>(node);
+    auto it = std::upper_bound(leaf->_data.begin(), leaf->_data.end(), key,
+                               [this](const K &k, const tree_data_type &p) { return compare::operator()(k, p.first); });
+    return first_from(leaf, std::distance(leaf->_data.begin(), it));
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
+typename BP_tree<tkey, tvalue, compare, t>::bptree_iterator BP_tree<tkey, tvalue, compare, t>::first_from(bptree_node_term *leaf, size_t index) {
+    // Все ключи следующих листов не меньше разделителя, а значит больше искомого
+    while (leaf != nullptr && index == leaf->_data.size()) {
+        leaf = leaf->_next;
+        index = 0;
+    }
+    return bptree_iterator(leaf, index);
+}
 
-        // Рекурсивно освобождаем память для всех потомков
-        for (size_t i = 0; i < middle_node->_pointers.size(); ++i) {
-            clear_recursive(middle_node->_pointers[i]);
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
+void BP_tree<tkey, tvalue, compare, t>::clear_subtree(bptree_node_base *subtree) noexcept {
+    // Узлы освобождаются без рекурсии и без стека: спуск идёт по последним указателям до листа, освобождённый узел
+    // снимается с родителя, и разбор продолжается с его соседа. Опустевший внутренний узел сам становится листом
+    // разбора, и спуск к нему начинается заново от корня поддерева; такие спуски нужны лишь внутренним узлам
+    bptree_node_middle *parent = nullptr;
+    bptree_node_base *current = subtree;
+    while (current != nullptr) {
+        if (!current->_is_terminate) {
+            bptree_node_middle *middle_node = static_cast<bptree_node_middle *>(current);
+            while (!middle_node->_pointers.empty() && middle_node->_pointers.back() == nullptr) {
+                middle_node->_pointers.pop_back();
+            }
+            if (!middle_node->_pointers.empty()) {
+                parent = middle_node;
+                current = middle_node->_pointers.back();
+                continue;
+            }
+            get_allocator().template delete_object<bptree_node_middle>(middle_node);
+        } else {
+            get_allocator().template delete_object<bptree_node_term>(static_cast<bptree_node_term *>(current));
         }
 
-        // Удаляем внутренний узел
-        get_allocator().template delete_object<bptree_node_middle>(middle_node);
-    } else {
-        // Удаляем листовой узел
-        get_allocator().template delete_object<bptree_node_term>(static_cast<bptree_node_term *>(node));
+        if (parent == nullptr) {
+            break;
+        }
+        parent->_pointers.pop_back();
+        while (!parent->_pointers.empty() && parent->_pointers.back() == nullptr) {
+            parent->_pointers.pop_back();
+        }
+        if (parent->_pointers.empty()) {
+            parent = nullptr;
+            current = subtree;
+        } else {
+            current = parent->_pointers.back();
+        }
     }
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 void BP_tree<tkey, tvalue, compare, t>::clear() noexcept {
-    // Вызываем вспомогательный метод для рекурсивного удаления узлов
     if (_root != nullptr) {
-        clear_recursive(_root);
+        clear_subtree(_root);
         _root = nullptr;
         _size = 0;
     }
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
+template<typename K>
 typename BP_tree<tkey, tvalue, compare, t>::bptree_node_term *
-BP_tree<tkey, tvalue, compare, t>::find_leaf(const tkey &key) const {
+BP_tree<tkey, tvalue, compare, t>::find_leaf(const K &key) const {
     if (_root == nullptr) {
         return nullptr;
     }
@@ -1022,7 +1147,7 @@ BP_tree<tkey, tvalue, compare, t>::find_leaf(const tkey &key) const {
         size_t i;
 
         for (i = 0; i < middle_node->_keys.size(); ++i) {
-            if (compare_keys(key, middle_node->_keys[i])) {
+            if (compare::operator()(key, middle_node->_keys[i])) {
                 break;
             }
         }
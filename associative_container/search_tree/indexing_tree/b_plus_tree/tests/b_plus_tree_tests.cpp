@@ -1,5 +1,6 @@
 #include <gtest/gtest.h>
 #include <string>
+#include <string_view>
 #include <vector>
 #include <algorithm>
 #include <random>
@@ -370,6 +371,46 @@ TEST(BPlusTreeStressTest, TreeOrderBoundaryTest) {
     }
 }
 
+// Поиск по std::string_view с прозрачным компаратором, в том числе границ после удалений
+TEST(BPlusTreeStressTest, HeterogeneousLookupTest) {
+    BP_tree<std::string, int, std::less<>, 2> tree;
+
+    for (int i = 0; i < 200; ++i) {
+        tree.insert({std::to_string(1000 + i), i});
+    }
+    // Оставляем только чётные, часть листов пустеет и сливается
+    for (int i = 1; i < 200; i += 2) {
+        tree.erase(std::to_string(1000 + i));
+    }
+
+    const auto &ctree = tree;
+    for (int i = 0; i < 200; ++i) {
+        std::string text = std::to_string(1000 + i);
+        std::string_view key = text;
+
+        EXPECT_EQ(tree.contains(key), i % 2 == 0);
+        if (i % 2 == 0) {
+            EXPECT_EQ(tree.find(key)->second, i);
+            EXPECT_EQ(ctree.at(key), i);
+        } else {
+            EXPECT_EQ(tree.find(key), tree.end());
+            EXPECT_THROW(tree.at(key), std::out_of_range);
+        }
+
+        int lower = i + i % 2, upper = i + 2 - i % 2;
+        if (lower < 200) {
+            EXPECT_EQ(tree.lower_bound(key)->second, lower);
+            EXPECT_EQ(ctree.lower_bound(key)->second, lower);
+        }
+        if (upper < 200) {
+            EXPECT_EQ(tree.upper_bound(key)->second, upper);
+            EXPECT_EQ(tree.upper_bound(text)->second, upper);
+        } else {
+            EXPECT_EQ(tree.upper_bound(key), tree.end());
+        }
+    }
+}
+
 // Запускаем тесты
 int main(int argc, char **argv) {
     ::testing::InitGoogleTest(&argc, argv);
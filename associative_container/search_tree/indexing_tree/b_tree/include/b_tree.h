@@ -275,6 +275,14 @@ public:
     tvalue& at(const tkey&);
     const tvalue& at(const tkey&) const;
 
+    /** With a transparent compare (std::less<> etc.) key may be any type comparable with tkey,
+     *  e.g. std::string_view for std::string keys, and no tkey is built for the search
+     */
+    template<typename K> requires transparent_compare<compare>
+    tvalue& at(const K&);
+    template<typename K> requires transparent_compare<compare>
+    const tvalue& at(const K&) const;
+
 
     tvalue& operator[](const tkey& key);
     tvalue& operator[](tkey&& key);
@@ -320,6 +328,24 @@ public:
 
     bool contains(const tkey& key) const;
 
+    template<typename K> requires transparent_compare<compare>
+    btree_iterator find(const K& key);
+    template<typename K> requires transparent_compare<compare>
+    btree_const_iterator find(const K& key) const;
+
+    template<typename K> requires transparent_compare<compare>
+    btree_iterator lower_bound(const K& key);
+    template<typename K> requires transparent_compare<compare>
+    btree_const_iterator lower_bound(const K& key) const;
+
+    template<typename K> requires transparent_compare<compare>
+    btree_iterator upper_bound(const K& key);
+    template<typename K> requires transparent_compare<compare>
+    btree_const_iterator upper_bound(const K& key) const;
+
+    template<typename K> requires transparent_compare<compare>
+    bool contains(const K& key) const;
+
     void clear() noexcept;
 
     std::pair<btree_iterator, bool> insert(const tree_data_type& data);
@@ -345,6 +371,19 @@ public:
 
     btree_iterator erase(const tkey& key);
 
+private:
+
+    /** Descent shared by the lookups: the key equivalent to key, the first not less than key and the first greater than key;
+     *  end() if there is none. K is tkey or, with a transparent compare, any type comparable with it
+     */
+    template<typename K>
+    btree_iterator locate(const K& key);
+
+    template<typename K>
+    btree_iterator locate_lower_bound(const K& key);
+
+    template<typename K>
+    btree_iterator locate_upper_bound(const K& key);
 
 };
 
@@ -1323,6 +1362,26 @@ const tvalue& B_tree<tkey, tvalue, compare, t>::at(const tkey& key) const
     return it->second;
 }
 
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
+template<typename K> requires transparent_compare<compare>
+tvalue& B_tree<tkey, tvalue, compare, t>::at(const K& key)
+{
+    if (this->_logger) this->_logger->trace("B_tree non-const heterogeneous at() called.");
+    btree_iterator it = this->locate(key);
+    if (it == this->end()) {
+        throw std::out_of_range("Key not found in B_tree::at()");
+    }
+    return it->second;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
+template<typename K> requires transparent_compare<compare>
+const tvalue& B_tree<tkey, tvalue, compare, t>::at(const K& key) const
+{
+    if (this->_logger) this->_logger->trace("B_tree const heterogeneous at() called.");
+    return const_cast<B_tree*>(this)->at(key);
+}
+
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 tvalue& B_tree<tkey, tvalue, compare, t>::operator[](const tkey& key)
 {
@@ -1502,288 +1561,215 @@ bool B_tree<tkey, tvalue, compare, t>::empty() const noexcept
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 typename B_tree<tkey, tvalue, compare, t>::btree_iterator B_tree<tkey, tvalue, compare, t>::find(const tkey& key)
 {
-    if (this->_logger) this->_logger->trace("B_tree const find called.");
-    if (!this->_root) {
-        return this->end();
-    }
-    std::stack<std::pair<btree_node**, size_t>> path_stack;
-
-    btree_node** current_node_ptr_ptr =
-            const_cast<btree_node**>(&this->_root);
+    if (this->_logger) this->_logger->trace("B_tree non-const find called.");
+    return this->locate(key);
+}
 
-    btree_node* current_node_obj = this->_root;
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
+typename B_tree<tkey, tvalue, compare, t>::btree_const_iterator B_tree<tkey, tvalue, compare, t>::find(const tkey& key) const
+{
+    if (this->_logger) this->_logger->trace("B_tree const find called.");
+    return const_cast<B_tree*>(this)->locate(key);
+}
 
-    size_t child_idx_from_parent = static_cast<size_t>(-1);
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
+typename B_tree<tkey, tvalue, compare, t>::btree_iterator B_tree<tkey, tvalue, compare, t>::lower_bound(const tkey& key)
+{
+    if (this->_logger) this->_logger->trace("B_tree non-const lower_bound called.");
+    return this->locate_lower_bound(key);
+}
 
-    while (current_node_obj != nullptr) {
-        path_stack.push({current_node_ptr_ptr, child_idx_from_parent});
-        auto lower_it = std::lower_bound(
-                current_node_obj->_keys.begin(),
-                current_node_obj->_keys.begin() + current_node_obj->_keys.size(),
-                key,
-                [this](const tree_data_type& pair_in_node, const tkey& key_to_find) {
-                    return this->compare_keys(pair_in_node.first, key_to_find);
-                });
-        size_t key_idx_in_node = std::distance(current_node_obj->_keys.begin(), lower_it);
-        if (key_idx_in_node < current_node_obj->_keys.size() &&
-            !this->compare_keys(key, current_node_obj->_keys[key_idx_in_node].first))
-        {
-            return btree_iterator(path_stack, key_idx_in_node);
-        }
-        if (current_node_obj->_pointers.empty()) {
-            return this->end();
-        }
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
+typename B_tree<tkey, tvalue, compare, t>::btree_const_iterator B_tree<tkey, tvalue, compare, t>::lower_bound(const tkey& key) const
+{
+    if (this->_logger) this->_logger->trace("B_tree const lower_bound called.");
+    return const_cast<B_tree*>(this)->locate_lower_bound(key);
+}
 
-        else {
-            if (key_idx_in_node >= current_node_obj->_pointers.size() || current_node_obj->_pointers[key_idx_in_node] == nullptr) {
-                if (this->_logger) this->_logger->error("find: Invalid descent path encountered.");
-                return this->end();
-            }
-            child_idx_from_parent = key_idx_in_node;
-            current_node_ptr_ptr = const_cast<btree_node**>(
-                    &(current_node_obj->_pointers[child_idx_from_parent])
-            );
-            current_node_obj = current_node_obj->_pointers[child_idx_from_parent];
-        }
-    }
-    return this->end();
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
+typename B_tree<tkey, tvalue, compare, t>::btree_iterator B_tree<tkey, tvalue, compare, t>::upper_bound(const tkey& key)
+{
+    if (this->_logger) this->_logger->trace("B_tree non-const upper_bound called.");
+    return this->locate_upper_bound(key);
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
-typename B_tree<tkey, tvalue, compare, t>::btree_const_iterator B_tree<tkey, tvalue, compare, t>::find(const tkey& key) const
+typename B_tree<tkey, tvalue, compare, t>::btree_const_iterator B_tree<tkey, tvalue, compare, t>::upper_bound(const tkey& key) const
 {
-    if (this->_logger) this->_logger->trace("B_tree non-const find called.");
-    if (!this->_root) return this->end();
-    std::stack<std::pair<btree_node**, size_t>> path_stack;
-    btree_node** current_node_ptr_ptr = &this->_root;
-    btree_node* current_node_obj = this->_root;
-    size_t child_idx_from_parent = static_cast<size_t>(-1);
+    if (this->_logger) this->_logger->trace("B_tree const upper_bound called.");
+    return const_cast<B_tree*>(this)->locate_upper_bound(key);
+}
 
-    while (current_node_obj != nullptr) {
-        path_stack.push({current_node_ptr_ptr, child_idx_from_parent});
-        auto lower_it = std::lower_bound(
-                current_node_obj->_keys.begin(), current_node_obj->_keys.begin() + current_node_obj->_keys.size(), key,
-                [this](const tree_data_type& p, const tkey& k){ return this->compare_keys(p.first, k); });
-        size_t key_idx_in_node = std::distance(current_node_obj->_keys.begin(), lower_it);
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
+template<typename K> requires transparent_compare<compare>
+typename B_tree<tkey, tvalue, compare, t>::btree_iterator B_tree<tkey, tvalue, compare, t>::find(const K& key)
+{
+    if (this->_logger) this->_logger->trace("B_tree non-const heterogeneous find called.");
+    return this->locate(key);
+}
 
-        if (key_idx_in_node < current_node_obj->_keys.size() && !this->compare_keys(key, current_node_obj->_keys[key_idx_in_node].first)) {
-            return btree_const_iterator(path_stack, key_idx_in_node);
-        }
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
+template<typename K> requires transparent_compare<compare>
+typename B_tree<tkey, tvalue, compare, t>::btree_const_iterator B_tree<tkey, tvalue, compare, t>::find(const K& key) const
+{
+    if (this->_logger) this->_logger->trace("B_tree const heterogeneous find called.");
+    return const_cast<B_tree*>(this)->locate(key);
+}
 
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
+template<typename K> requires transparent_compare<compare>
+typename B_tree<tkey, tvalue, compare, t>::btree_iterator B_tree<tkey, tvalue, compare, t>::lower_bound(const K& key)
+{
+    if (this->_logger) this->_logger->trace("B_tree non-const heterogeneous lower_bound called.");
+    return this->locate_lower_bound(key);
+}
 
-        if (current_node_obj->_pointers.empty()) {
-            return this->end();
-        } else {
-            if (key_idx_in_node >= current_node_obj->_pointers.size() || current_node_obj->_pointers[key_idx_in_node] == nullptr) {
-                return this->cend();
-            }
-            child_idx_from_parent = key_idx_in_node;
-            current_node_ptr_ptr = &(current_node_obj->_pointers[child_idx_from_parent]);
-            current_node_obj = current_node_obj->_pointers[child_idx_from_parent];
-        }
-    }
-    return this->cend();
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
+template<typename K> requires transparent_compare<compare>
+typename B_tree<tkey, tvalue, compare, t>::btree_const_iterator B_tree<tkey, tvalue, compare, t>::lower_bound(const K& key) const
+{
+    if (this->_logger) this->_logger->trace("B_tree const heterogeneous lower_bound called.");
+    return const_cast<B_tree*>(this)->locate_lower_bound(key);
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
-typename B_tree<tkey, tvalue, compare, t>::btree_iterator B_tree<tkey, tvalue, compare, t>::lower_bound(const tkey& key)
+template<typename K> requires transparent_compare<compare>
+typename B_tree<tkey, tvalue, compare, t>::btree_iterator B_tree<tkey, tvalue, compare, t>::upper_bound(const K& key)
 {
-    if (this->_logger) this->_logger->trace("B_tree non-const lower_bound called.");
+    if (this->_logger) this->_logger->trace("B_tree non-const heterogeneous upper_bound called.");
+    return this->locate_upper_bound(key);
+}
 
-    if (!this->_root) {
-        return this->end();
-    }
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
+template<typename K> requires transparent_compare<compare>
+typename B_tree<tkey, tvalue, compare, t>::btree_const_iterator B_tree<tkey, tvalue, compare, t>::upper_bound(const K& key) const
+{
+    if (this->_logger) this->_logger->trace("B_tree const heterogeneous upper_bound called.");
+    return const_cast<B_tree*>(this)->locate_upper_bound(key);
+}
 
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
+template<typename K>
+typename B_tree<tkey, tvalue, compare, t>::btree_iterator B_tree<tkey, tvalue, compare, t>::locate(const K& key)
+{
     std::stack<std::pair<btree_node**, size_t>> path_stack;
     btree_node** current_node_ptr_ptr = &this->_root;
-    btree_node* current_node_obj = this->_root;
     size_t child_idx_from_parent = static_cast<size_t>(-1);
 
-
-    std::stack<std::pair<btree_node**, size_t>> best_path_stack;
-    size_t best_key_idx = static_cast<size_t>(-1);
-
-    while (current_node_obj != nullptr) {
+    while (*current_node_ptr_ptr != nullptr) {
+        btree_node* current_node_obj = *current_node_ptr_ptr;
         path_stack.push({current_node_ptr_ptr, child_idx_from_parent});
 
         auto lower_it = std::lower_bound(
-                current_node_obj->_keys.begin(),
-                current_node_obj->_keys.begin() + current_node_obj->_keys.size(),
-                key,
-                [this](const tree_data_type& p, const tkey& k){ return this->compare_keys(p.first, k); });
+                current_node_obj->_keys.begin(), current_node_obj->_keys.end(), key,
+                [this](const tree_data_type& p, const K& k){ return compare::operator()(p.first, k); });
         size_t key_idx_in_node = std::distance(current_node_obj->_keys.begin(), lower_it);
 
-        if (key_idx_in_node < current_node_obj->_keys.size()) {
-            // current_key >= key
-            if (!this->compare_keys(current_node_obj->_keys[key_idx_in_node].first, key)) {
-                best_path_stack = path_stack;
-                best_key_idx = key_idx_in_node;
-            }
+        if (key_idx_in_node < current_node_obj->_keys.size() && !compare::operator()(key, lower_it->first)) {
+            return btree_iterator(path_stack, key_idx_in_node);
         }
         if (current_node_obj->_pointers.empty()) {
             break;
-        } else { // Спускаемся в узел, где ключи < current_key
-
-            if (current_node_obj->_pointers[key_idx_in_node] == nullptr) {
-                break;
-            }
-
-            child_idx_from_parent = key_idx_in_node;
-            current_node_ptr_ptr = &(current_node_obj->_pointers[child_idx_from_parent]);
-            current_node_obj = current_node_obj->_pointers[child_idx_from_parent];
         }
+
+        // ключи в key_idx_in_node-м потомке лежат между соседними ключами узла
+        child_idx_from_parent = key_idx_in_node;
+        current_node_ptr_ptr = &(current_node_obj->_pointers[child_idx_from_parent]);
     }
-    if (best_key_idx != static_cast<size_t>(-1)) {
-        return btree_iterator(best_path_stack, best_key_idx);
-    } else {
-        return this->end();
-    }
+    return this->end();
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
-typename B_tree<tkey, tvalue, compare, t>::btree_const_iterator B_tree<tkey, tvalue, compare, t>::lower_bound(const tkey& key) const
+template<typename K>
+typename B_tree<tkey, tvalue, compare, t>::btree_iterator B_tree<tkey, tvalue, compare, t>::locate_lower_bound(const K& key)
 {
-    if (this->_logger) this->_logger->trace("B_tree const lower_bound called.");
-
-    if (!this->_root) return this->cend();
-
     std::stack<std::pair<btree_node**, size_t>> path_stack;
-
-    btree_node** current_node_ptr_ptr = const_cast<btree_node**>(&this->_root);
-    btree_node* current_node_obj = this->_root;
-
+    btree_node** current_node_ptr_ptr = &this->_root;
     size_t child_idx_from_parent = static_cast<size_t>(-1);
 
     std::stack<std::pair<btree_node**, size_t>> best_path_stack;
     size_t best_key_idx = static_cast<size_t>(-1);
 
-    while (current_node_obj != nullptr) {
+    while (*current_node_ptr_ptr != nullptr) {
+        btree_node* current_node_obj = *current_node_ptr_ptr;
         path_stack.push({current_node_ptr_ptr, child_idx_from_parent});
+
         auto lower_it = std::lower_bound(
-                current_node_obj->_keys.begin(), current_node_obj->_keys.begin() + current_node_obj->_keys.size(), key,
-                [this](const tree_data_type& p, const tkey& k){ return this->compare_keys(p.first, k); });
+                current_node_obj->_keys.begin(), current_node_obj->_keys.end(), key,
+                [this](const tree_data_type& p, const K& k){ return compare::operator()(p.first, k); });
         size_t key_idx_in_node = std::distance(current_node_obj->_keys.begin(), lower_it);
 
+        // ключ узла не меньше key; ниже по пути может найтись меньший из таких
         if (key_idx_in_node < current_node_obj->_keys.size()) {
-            if (!this->compare_keys(current_node_obj->_keys[key_idx_in_node].first, key)) {
-                best_path_stack = path_stack;
-                best_key_idx = key_idx_in_node;
-            }
+            best_path_stack = path_stack;
+            best_key_idx = key_idx_in_node;
         }
-
-        if (current_node_obj->_pointers.empty()) { break; }
-
-        else {
-            if (key_idx_in_node >= current_node_obj->_pointers.size() || current_node_obj->_pointers[key_idx_in_node] == nullptr) { break; }
-            child_idx_from_parent = key_idx_in_node;
-            current_node_ptr_ptr = const_cast<btree_node**>(&(current_node_obj->_pointers[child_idx_from_parent]));
-            current_node_obj = current_node_obj->_pointers[child_idx_from_parent];
+        if (current_node_obj->_pointers.empty()) {
+            break;
         }
+
+        child_idx_from_parent = key_idx_in_node;
+        current_node_ptr_ptr = &(current_node_obj->_pointers[child_idx_from_parent]);
     }
     if (best_key_idx != static_cast<size_t>(-1)) {
-        return btree_const_iterator(best_path_stack, best_key_idx);
-    } else {
-        return this->cend();
+        return btree_iterator(best_path_stack, best_key_idx);
     }
+    return this->end();
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
-typename B_tree<tkey, tvalue, compare, t>::btree_iterator B_tree<tkey, tvalue, compare, t>::upper_bound(const tkey& key)
+template<typename K>
+typename B_tree<tkey, tvalue, compare, t>::btree_iterator B_tree<tkey, tvalue, compare, t>::locate_upper_bound(const K& key)
 {
-    if (this->_logger) this->_logger->trace("B_tree non-const upper_bound called.");
-
-    if (!this->_root) return this->end();
     std::stack<std::pair<btree_node**, size_t>> path_stack;
     btree_node** current_node_ptr_ptr = &this->_root;
-    btree_node* current_node_obj = this->_root;
     size_t child_idx_from_parent = static_cast<size_t>(-1);
+
     std::stack<std::pair<btree_node**, size_t>> best_path_stack;
     size_t best_key_idx = static_cast<size_t>(-1);
 
-    while (current_node_obj != nullptr) {
+    while (*current_node_ptr_ptr != nullptr) {
+        btree_node* current_node_obj = *current_node_ptr_ptr;
         path_stack.push({current_node_ptr_ptr, child_idx_from_parent});
-        auto upper_it = std::upper_bound(
-                current_node_obj->_keys.begin(),
-                current_node_obj->_keys.begin() + current_node_obj->_keys.size(),
-                key,
-                [this](const tkey& k, const tree_data_type& p){ return this->compare_keys(k, p.first); });
 
+        auto upper_it = std::upper_bound(
+                current_node_obj->_keys.begin(), current_node_obj->_keys.end(), key,
+                [this](const K& k, const tree_data_type& p){ return compare::operator()(k, p.first); });
         size_t key_idx_in_node = std::distance(current_node_obj->_keys.begin(), upper_it);
 
-
         if (key_idx_in_node < current_node_obj->_keys.size()) {
             best_path_stack = path_stack;
             best_key_idx = key_idx_in_node;
         }
-        auto lower_it = std::lower_bound(
-                current_node_obj->_keys.begin(),
-                current_node_obj->_keys.begin() + current_node_obj->_keys.size(),
-                key,
-                [this](const tree_data_type& p, const tkey& k){ return this->compare_keys(p.first, k); });
-        size_t descend_idx = std::distance(current_node_obj->_keys.begin(), lower_it);
-
-        if (current_node_obj->_pointers.empty()) { break; }
-        else {
-            if (descend_idx >= current_node_obj->_pointers.size() || current_node_obj->_pointers[descend_idx] == nullptr) { break; }
-            child_idx_from_parent = descend_idx;
-            current_node_ptr_ptr = &(current_node_obj->_pointers[child_idx_from_parent]);
-            current_node_obj = current_node_obj->_pointers[child_idx_from_parent];
+        if (current_node_obj->_pointers.empty()) {
+            break;
         }
+
+        // спуск по upper_bound: в потомке слева от равного ключа все ключи меньше key
+        child_idx_from_parent = key_idx_in_node;
+        current_node_ptr_ptr = &(current_node_obj->_pointers[child_idx_from_parent]);
     }
     if (best_key_idx != static_cast<size_t>(-1)) {
         return btree_iterator(best_path_stack, best_key_idx);
-    } else {
-        return this->end();
     }
+    return this->end();
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
-typename B_tree<tkey, tvalue, compare, t>::btree_const_iterator B_tree<tkey, tvalue, compare, t>::upper_bound(const tkey& key) const
+bool B_tree<tkey, tvalue, compare, t>::contains(const tkey& key) const
 {
-    if (this->_logger) this->_logger->trace("B_tree const upper_bound called.");
-
-    if (!this->_root) return this->cend();
-    std::stack<std::pair<btree_node**, size_t>> path_stack;
-    btree_node** current_node_ptr_ptr = const_cast<btree_node**>(&this->_root);
-    btree_node* current_node_obj = this->_root;
-    size_t child_idx_from_parent = static_cast<size_t>(-1);
-    std::stack<std::pair<btree_node**, size_t>> best_path_stack;
-    size_t best_key_idx = static_cast<size_t>(-1);
+    if (this->_logger) this->_logger->trace("B_tree contains called.");
 
-    while (current_node_obj != nullptr) {
-        path_stack.push({current_node_ptr_ptr, child_idx_from_parent});
-        auto upper_it = std::upper_bound(
-                current_node_obj->_keys.begin(), current_node_obj->_keys.begin() + current_node_obj->_keys.size(), key,
-                [this](const tkey& k, const tree_data_type& p){ return this->compare_keys(k, p.first); });
-        size_t key_idx_in_node = std::distance(current_node_obj->_keys.begin(), upper_it);
-        if (key_idx_in_node < current_node_obj->_keys.size()) {
-            best_path_stack = path_stack; best_key_idx = key_idx_in_node;
-        }
-        auto lower_it = std::lower_bound(
-                current_node_obj->_keys.begin(), current_node_obj->_keys.begin() + current_node_obj->_keys.size(), key,
-                [this](const tree_data_type& p, const tkey& k){ return this->compare_keys(p.first, k); });
-        size_t descend_idx = std::distance(current_node_obj->_keys.begin(), lower_it);
-        if (current_node_obj->_pointers.empty()) { break; }
-        else {
-            if (descend_idx >= current_node_obj->_pointers.size() || current_node_obj->_pointers[descend_idx] == nullptr) { break; }
-            child_idx_from_parent = descend_idx;
-            current_node_ptr_ptr = const_cast<btree_node**>(&(current_node_obj->_pointers[child_idx_from_parent]));
-            current_node_obj = current_node_obj->_pointers[child_idx_from_parent];
-        }
-    }
-    if (best_key_idx != static_cast<size_t>(-1)) {
-        return btree_const_iterator(best_path_stack, best_key_idx);
-    } else {
-        return this->cend();
-    }
+    return this->find(key) != this->cend();
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
-bool B_tree<tkey, tvalue, compare, t>::contains(const tkey& key) const
+template<typename K> requires transparent_compare<compare>
+bool B_tree<tkey, tvalue, compare, t>::contains(const K& key) const
 {
-    if (this->_logger) this->_logger->trace("B_tree contains called.");
+    if (this->_logger) this->_logger->trace("B_tree heterogeneous contains called.");
 
-    return this->find(key) != this->cend();
+    return const_cast<B_tree*>(this)->locate(key) != const_cast<B_tree*>(this)->end();
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
@@ -2134,35 +2120,35 @@ void B_tree<tkey, tvalue, compare, t>::clear() noexcept {
         return;
     }
 
-    std::stack<btree_node*> s1;
-    std::stack<btree_node*> s2;
-
-    s1.push(this->_root);
-
-    while (!s1.empty()) {
-
-        btree_node* current = s1.top();
-        s1.pop();
-
-        if (current) {
-            s2.push(current);
-            if (!current->_pointers.empty()) {
-                for (size_t i = 0; i < current->_pointers.size(); ++i) {
-                    if (current->_pointers[i] != nullptr) {
-                        s1.push(current->_pointers[i]);
-                    }
-                }
-            }
+    // Узлы освобождаются без стека: спуск идёт по последним указателям до листа, освобождённый узел снимается
+    // с родителя, и разбор продолжается с его соседа. Опустевший внутренний узел сам становится листом, и спуск
+    // к нему начинается заново от корня; такие спуски нужны лишь внутренним узлам, так что работа линейна
+    pp_allocator<btree_node> node_alloc = this->get_allocator();
+    btree_node* parent = nullptr;
+    btree_node* current = this->_root;
+    while (current != nullptr) {
+        while (!current->_pointers.empty() && current->_pointers.back() == nullptr) {
+            current->_pointers.pop_back();
+        }
+        if (!current->_pointers.empty()) {
+            parent = current;
+            current = current->_pointers.back();
+            continue;
         }
-    }
-
 
-    pp_allocator<btree_node> node_alloc = this->get_allocator();
-    while (!s2.empty()) {
-        btree_node* node_to_free = s2.top();
-        s2.pop();
-        if (node_to_free) {
-            node_alloc.delete_object(node_to_free);
+        node_alloc.delete_object(current);
+        if (parent == nullptr) {
+            break;
+        }
+        parent->_pointers.pop_back();
+        while (!parent->_pointers.empty() && parent->_pointers.back() == nullptr) {
+            parent->_pointers.pop_back();
+        }
+        if (parent->_pointers.empty()) {
+            parent = nullptr;
+            current = this->_root;
+        } else {
+            current = parent->_pointers.back();
         }
     }
 
@@ -2,6 +2,8 @@
 
 #include <list>
 #include <random>
+#include <string>
+#include <string_view>
 #include <vector>
 #include <b_tree.h>
 #include <client_logger_builder.h>
@@ -545,6 +547,61 @@ TEST(bTreePositiveTests, test9)
     logger->trace("bTreePositiveTests.test9 finished");
 }
 
+TEST(bTreePositiveTests, test10)
+{
+    std::unique_ptr<logger> logger( create_logger(std::vector<std::pair<std::string, logger::severity>>
+                                                          {
+                                                                  { "b_tree_tests_logs.txt", logger::severity::trace }
+                                                          }));
+
+    logger->trace("bTreePositiveTests.test10 started");
+
+    B_tree<std::string, int, std::less<>, 2> tree(std::less<>(), nullptr, logger.get());
+
+    for (int i = 0; i < 100; i += 2)
+    {
+        tree.emplace(std::to_string(100 + i), i);
+    }
+
+    const auto &ctree = tree;
+    for (int i = 0; i < 100; ++i)
+    {
+        std::string text = std::to_string(100 + i);
+        std::string_view key = text;
+
+        EXPECT_EQ(tree.contains(key), i % 2 == 0);
+        if (i % 2 == 0)
+        {
+            EXPECT_EQ(tree.find(key)->second, i);
+            EXPECT_EQ(ctree.at(key), i);
+        }
+        else
+        {
+            EXPECT_TRUE(tree.find(key) == tree.end());
+            EXPECT_THROW(tree.at(key), std::out_of_range);
+        }
+
+        // ближайшие чётные ключи: не меньший и строго больший
+        int lower = i + i % 2, upper = i + 2 - i % 2;
+        if (lower < 100)
+        {
+            EXPECT_EQ(tree.lower_bound(key)->second, lower);
+            EXPECT_EQ(ctree.lower_bound(key)->second, lower);
+        }
+        if (upper < 100)
+        {
+            EXPECT_EQ(tree.upper_bound(key)->second, upper);
+            EXPECT_EQ(tree.upper_bound(text)->second, upper);
+        }
+        else
+        {
+            EXPECT_TRUE(tree.upper_bound(key) == tree.end());
+        }
+    }
+
+    logger->trace("bTreePositiveTests.test10 finished");
+}
+
 TEST(bTreeNegativeTests, test1)
 {
     std::unique_ptr<logger> logger( create_logger(std::vector<std::pair<std::string, logger::severity>>
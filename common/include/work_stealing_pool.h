@@ -0,0 +1,173 @@
+#ifndef MATH_PRACTICE_AND_OPERATING_SYSTEMS_COMMON_WORK_STEALING_POOL_H
+#define MATH_PRACTICE_AND_OPERATING_SYSTEMS_COMMON_WORK_STEALING_POOL_H
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/** Fork-join thread pool. Every worker owns a deque: it pushes and pops its own tasks at the back,
+ *  idle workers steal from the front of the others. A thread waiting in join runs pending tasks
+ *  instead of blocking, so nested fork-join from inside tasks cannot deadlock
+ */
+class work_stealing_pool final
+{
+
+public:
+
+    /** Tasks forked by one parent. join waits until all of them have finished
+     */
+    class task_group final
+    {
+
+        friend class work_stealing_pool;
+
+        std::atomic<size_t> _pending{0};
+        std::mutex _error_mutex;
+        std::exception_ptr _error;
+
+    public:
+
+        task_group() = default;
+
+        task_group(task_group const &) = delete;
+
+        task_group &operator=(task_group const &) = delete;
+
+    };
+
+private:
+
+    struct task
+    {
+        std::function<void()> function;
+        task_group *group;
+    };
+
+    struct task_queue
+    {
+        std::mutex mutex;
+        std::deque<task> tasks;
+    };
+
+    // Очереди рабочих потоков и последняя - общая для внешних потоков
+    std::vector<std::unique_ptr<task_queue>> _queues;
+    std::vector<std::thread> _threads;
+
+    std::atomic<size_t> _queued{0};
+    std::atomic<bool> _stopping{false};
+    std::mutex _sleep_mutex;
+    std::condition_variable _wake;
+
+    size_t home_queue() const noexcept;
+
+    void push(task &&item);
+
+    /** Runs one pending task: own queue first, then steals. false if every queue is empty
+     */
+    bool try_run_one(size_t home);
+
+    static void run(task &item) noexcept;
+
+    void worker_loop(size_t index);
+
+public:
+
+    /** threads workers; the thread that calls join takes part as well
+     */
+    explicit work_stealing_pool(size_t threads);
+
+    work_stealing_pool(work_stealing_pool const &) = delete;
+
+    work_stealing_pool &operator=(work_stealing_pool const &) = delete;
+
+    ~work_stealing_pool() noexcept;
+
+    size_t thread_count() const noexcept;
+
+    template<typename F>
+    void fork(task_group &group, F &&function);
+
+    /** Runs pending tasks until every task of the group has finished.
+     *  @throw the first exception thrown by a task of the group
+     */
+    void join(task_group &group);
+
+    /** Runs second on the pool and first on the calling thread, returns when both have finished
+     */
+    template<typename F1, typename F2>
+    void invoke(F1 &&first, F2 &&second);
+
+    /** Calls function(first, last) for consecutive ranges of [0, count) no shorter than grain
+     */
+    template<typename F>
+    void parallel_for(size_t count, size_t grain, F const &function);
+
+};
+
+template<typename F>
+void work_stealing_pool::fork(task_group &group, F &&function)
+{
+    group._pending.fetch_add(1, std::memory_order_relaxed);
+    push(task{std::function<void()>(std::forward<F>(function)), &group});
+}
+
+template<typename F1, typename F2>
+void work_stealing_pool::invoke(F1 &&first, F2 &&second)
+{
+    task_group group;
+    fork(group, std::forward<F2>(second));
+    try
+    {
+        first();
+    }
+    catch (...)
+    {
+        // второй задаче нужны живые ссылки вызывающего: дожидаемся её и до выхода по исключению
+        try
+        {
+            join(group);
+        }
+        catch (...)
+        {
+        }
+        throw;
+    }
+    join(group);
+}
+
+template<typename F>
+void work_stealing_pool::parallel_for(size_t count, size_t grain, F const &function)
+{
+    const size_t parts = std::max<size_t>(1, std::min(count / std::max<size_t>(grain, 1), 4 * (thread_count() + 1)));
+    task_group group;
+    for (size_t part = 1; part < parts; ++part)
+    {
+        fork(group, [&function, part, parts, count]() { function(count * part / parts, count * (part + 1) / parts); });
+    }
+    try
+    {
+        function(0, count / parts);
+    }
+    catch (...)
+    {
+        try
+        {
+            join(group);
+        }
+        catch (...)
+        {
+        }
+        throw;
+    }
+    join(group);
+}
+
+#endif //MATH_PRACTICE_AND_OPERATING_SYSTEMS_COMMON_WORK_STEALING_POOL_H
@@ -0,0 +1,168 @@
+#include "../include/work_stealing_pool.h"
+
+#include <utility>
+
+namespace
+{
+    // Пул и очередь, которым принадлежит текущий поток; у внешних потоков пула нет
+    thread_local work_stealing_pool const *current_pool = nullptr;
+    thread_local size_t current_index = 0;
+}
+
+work_stealing_pool::work_stealing_pool(
+    size_t threads)
+{
+    for (size_t i = 0; i <= threads; ++i)
+    {
+        _queues.push_back(std::make_unique<task_queue>());
+    }
+
+    _threads.reserve(threads);
+    for (size_t i = 0; i < threads; ++i)
+    {
+        _threads.emplace_back([this, i]() { worker_loop(i); });
+    }
+}
+
+work_stealing_pool::~work_stealing_pool() noexcept
+{
+    _stopping.store(true);
+    {
+        std::lock_guard<std::mutex> lock(_sleep_mutex);
+    }
+    _wake.notify_all();
+
+    for (auto &thread : _threads)
+    {
+        thread.join();
+    }
+}
+
+size_t work_stealing_pool::thread_count() const noexcept
+{
+    return _threads.size();
+}
+
+size_t work_stealing_pool::home_queue() const noexcept
+{
+    return current_pool == this ? current_index : _queues.size() - 1;
+}
+
+void work_stealing_pool::push(
+    task &&item)
+{
+    task_queue &queue = *_queues[home_queue()];
+    {
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.tasks.push_back(std::move(item));
+    }
+    _queued.fetch_add(1);
+
+    // Счётчик меняется до захвата мьютекса сна: уснуть, пропустив задачу, нельзя
+    {
+        std::lock_guard<std::mutex> lock(_sleep_mutex);
+    }
+    _wake.notify_one();
+}
+
+bool work_stealing_pool::try_run_one(
+    size_t home)
+{
+    task item;
+    bool found = false;
+
+    {
+        task_queue &own = *_queues[home];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.tasks.empty())
+        {
+            // своя очередь - с конца: последняя задача меньше и её данные ещё в кэше
+            item = std::move(own.tasks.back());
+            own.tasks.pop_back();
+            found = true;
+        }
+    }
+
+    for (size_t step = 1; !found && step < _queues.size(); ++step)
+    {
+        // чужие - с начала: там задачи верхних уровней рекурсии, самые крупные
+        task_queue &victim = *_queues[(home + step) % _queues.size()];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.tasks.empty())
+        {
+            item = std::move(victim.tasks.front());
+            victim.tasks.pop_front();
+            found = true;
+        }
+    }
+
+    if (!found)
+    {
+        return false;
+    }
+
+    _queued.fetch_sub(1);
+    run(item);
+    return true;
+}
+
+void work_stealing_pool::run(
+    task &item) noexcept
+{
+    try
+    {
+        item.function();
+    }
+    catch (...)
+    {
+        std::lock_guard<std::mutex> lock(item.group->_error_mutex);
+        if (!item.group->_error)
+        {
+            item.group->_error = std::current_exception();
+        }
+    }
+
+    // После уменьшения счётчика группа может быть уже разрушена ожидающим потоком
+    item.function = nullptr;
+    item.group->_pending.fetch_sub(1, std::memory_order_release);
+}
+
+void work_stealing_pool::worker_loop(
+    size_t index)
+{
+    current_pool = this;
+    current_index = index;
+
+    while (true)
+    {
+        if (try_run_one(index))
+        {
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(_sleep_mutex);
+        _wake.wait(lock, [this]() { return _stopping.load() || _queued.load() != 0; });
+        if (_stopping.load())
+        {
+            return;
+        }
+    }
+}
+
+void work_stealing_pool::join(
+    task_group &group)
+{
+    const size_t home = home_queue();
+    while (group._pending.load(std::memory_order_acquire) != 0)
+    {
+        if (!try_run_one(home))
+        {
+            std::this_thread::yield();
+        }
+    }
+
+    if (group._error)
+    {
+        std::rethrow_exception(std::exchange(group._error, nullptr));
+    }
+}